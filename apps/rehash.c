@@ -38,6 +38,7 @@
 #pragma names restore
 #endif
 
+#include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
@@ -99,6 +100,7 @@ static int evpmdsize;
 static const EVP_MD *evpmd;
 static int remove_links = 1;
 static int verbose = 0;
+static STACK_OF(X509) *index_certs = NULL;
 static BUCKET *hash_table[257];
 
 static const char *suffixes[] = { "", "r" };
@@ -265,6 +267,20 @@ static int do_file(const char *filename, const char *fullpath, enum Hash h)
     if (inf == NULL)
         goto end;
 
+    /* An index takes any number of certificates from each file */
+    if (index_certs != NULL) {
+        for (j = 0; j < sk_X509_INFO_num(inf); j++) {
+            tmp = sk_X509_INFO_value(inf, j);
+            if (tmp->x509 != NULL
+                && !X509_add_cert(index_certs, tmp->x509, X509_ADD_FLAG_UP_REF)) {
+                BIO_puts(bio_err, "out of memory\n");
+                ++errs;
+                goto end;
+            }
+        }
+        goto end;
+    }
+
     /* Count the number of certs and CRLs and make x point to the last X509_INFO */
     for (j = 0; j < sk_X509_INFO_num(inf); j++) {
         tmp = sk_X509_INFO_value(inf, j);
@@ -367,7 +383,7 @@ static int do_dir(const char *dirname, enum Hash h)
     char *buf = NULL, *copy = NULL;
     STACK_OF(OPENSSL_STRING) *files = NULL;
 
-    if (app_access(dirname, W_OK) < 0) {
+    if (index_certs == NULL && app_access(dirname, W_OK) < 0) {
         BIO_printf(bio_err, "Skipping %s, can't write\n", dirname);
         return 1;
     }
@@ -414,7 +430,8 @@ static int do_dir(const char *dirname, enum Hash h)
             continue;
         if (lstat(buf, &st) < 0)
             continue;
-        if (S_ISLNK(st.st_mode) && handle_symlink(filename, buf) == 0)
+        if (S_ISLNK(st.st_mode) && index_certs == NULL
+            && handle_symlink(filename, buf) == 0)
             continue;
         errs += do_file(filename, buf, h);
     }
@@ -497,6 +514,7 @@ typedef enum OPTION_choice {
     OPT_OLD,
     OPT_N,
     OPT_VERBOSE,
+    OPT_COMPILE,
     OPT_PROV_ENUM
 } OPTION_CHOICE;
 
@@ -512,6 +530,8 @@ const OPTIONS rehash_options[] = {
 
     OPT_SECTION("Output"),
     { "v", OPT_VERBOSE, '-', "Verbose output" },
+    { "compile", OPT_COMPILE, '>',
+        "Write a certificate index to this file instead of creating links" },
 
     OPT_PROV_OPTIONS,
 
@@ -520,9 +540,52 @@ const OPTIONS rehash_options[] = {
     { NULL }
 };
 
+/*
+ * Write the collected certificates to |indexfile|.  Processes may have the
+ * current index mapped, so it is never rewritten in place: the new index
+ * goes to a temporary file next to it, which is then renamed over it.
+ */
+static int write_index(const char *prog, const char *indexfile)
+{
+    char *tmpfile = NULL;
+    size_t len;
+    BIO *out;
+    int ok;
+
+    if (strcmp(indexfile, "-") == 0) {
+        out = dup_bio_out(FORMAT_BINARY);
+    } else {
+        len = strlen(indexfile) + sizeof(".new");
+        tmpfile = app_malloc(len, "index file name");
+        BIO_snprintf(tmpfile, len, "%s.new", indexfile);
+        out = BIO_new_file(tmpfile, "wb");
+    }
+    ok = out != NULL
+        && X509_cert_index_write(out, index_certs, app_get0_libctx(),
+            app_get0_propq())
+        && BIO_flush(out) > 0;
+    BIO_free_all(out);
+
+    if (tmpfile != NULL) {
+        if (ok && rename(tmpfile, indexfile) < 0) {
+            BIO_printf(bio_err, "%s: error: cannot rename %s to %s: %s\n",
+                prog, tmpfile, indexfile, strerror(errno));
+            ok = 0;
+        }
+        if (!ok)
+            unlink(tmpfile);
+        OPENSSL_free(tmpfile);
+    }
+    if (!ok) {
+        BIO_printf(bio_err, "%s: error: cannot write %s\n", prog, indexfile);
+        ERR_print_errors(bio_err);
+    }
+    return !ok;
+}
+
 int rehash_main(int argc, char **argv)
 {
-    const char *env, *prog;
+    const char *env, *prog, *indexfile = NULL;
     char *e, *m;
     int errs = 0;
     OPTION_CHOICE o;
@@ -550,6 +613,9 @@ int rehash_main(int argc, char **argv)
         case OPT_VERBOSE:
             verbose = 1;
             break;
+        case OPT_COMPILE:
+            indexfile = opt_arg();
+            break;
         case OPT_PROV_CASES:
             if (!opt_provider(o))
                 goto end;
@@ -566,6 +632,12 @@ int rehash_main(int argc, char **argv)
     if (evpmdsize <= 0 || evpmdsize > EVP_MAX_MD_SIZE)
         goto end;
 
+    if (indexfile != NULL && (index_certs = sk_X509_new_null()) == NULL) {
+        BIO_puts(bio_err, "out of memory\n");
+        errs = 1;
+        goto end;
+    }
+
     if (*argv != NULL) {
         while (*argv != NULL)
             errs += do_dir(*argv++, h);
@@ -584,7 +656,15 @@ int rehash_main(int argc, char **argv)
         errs += do_dir(X509_get_default_cert_dir(), h);
     }
 
+    if (indexfile != NULL) {
+        if (verbose)
+            BIO_printf(bio_out, "Writing %d certificates to %s\n",
+                sk_X509_num(index_certs), indexfile);
+        errs += write_index(prog, indexfile);
+    }
+
 end:
+    OSSL_STACK_OF_X509_free(index_certs);
     return errs;
 }
 
@@ -264,7 +264,7 @@ const OPTIONS speed_options[] = {
     OPT_SECTION("General"),
     { "help", OPT_HELP, '-', "Display this summary" },
     { "mb", OPT_MB, '-',
-        "Enable (tls1>=1) multi-block mode on EVP-named cipher" },
+        "Enable (tls1>=1) multi-block mode on EVP-named cipher, or hash several buffers at once with EVP-named digest" },
     { "mr", OPT_MR, '-', "Produce machine readable output" },
 #ifndef NO_FORK
     { "multi", OPT_MULTI, 'p', "Run benchmarks in parallel" },
@@ -583,6 +583,8 @@ static double kems_results[MAX_KEM_NUM][3]; /* keygen, encaps, decaps */
 static size_t sigs_algs_len = 0;
 static char *sigs_algname[MAX_SIG_NUM] = { NULL };
 static double sigs_results[MAX_SIG_NUM][3]; /* keygen, sign, verify */
+/* ML-DSA is also run with precomputed keys, under names with this suffix */
+#define ML_DSA_PRECOMPUTE_SUFFIX "-precompute"
 
 #define COND(unused_cond) (run && count < (testmode ? 1 : INT_MAX))
 #define COUNT(d) (count)
@@ -742,6 +744,36 @@ static int EVP_Digest_md_loop(void *args)
     return EVP_Digest_loop(evp_md_name, D_EVP, args);
 }
 
+/* The number of buffers hashed at once with -mb */
+#define MB_DIGEST_BUFFERS 8
+
+static int EVP_Digest_multi_loop(void *args)
+{
+    loopargs_t *tempargs = *(loopargs_t **)args;
+    unsigned char digest[MB_DIGEST_BUFFERS][EVP_MAX_MD_SIZE];
+    const unsigned char *in[MB_DIGEST_BUFFERS];
+    unsigned char *out[MB_DIGEST_BUFFERS];
+    size_t inl[MB_DIGEST_BUFFERS];
+    int count, i;
+    EVP_MD *md = NULL;
+
+    if (!opt_md_silent(evp_md_name, &md))
+        return -1;
+    for (i = 0; i < MB_DIGEST_BUFFERS; i++) {
+        in[i] = tempargs->buf;
+        inl[i] = (size_t)lengths[testnum];
+        out[i] = digest[i];
+    }
+    for (count = 0; COND(c[D_EVP][testnum]); count += MB_DIGEST_BUFFERS) {
+        if (!EVP_Digest_multi(md, MB_DIGEST_BUFFERS, in, inl, out)) {
+            count = -1;
+            break;
+        }
+    }
+    EVP_MD_free(md);
+    return count;
+}
+
 static int EVP_Digest_MD2_loop(void *args)
 {
     return EVP_Digest_loop("md2", D_MD2, args);
@@ -2202,6 +2234,21 @@ int speed_main(int argc, char **argv)
             /* activate this provider algorithm */
             sigs_doit[sigs_algs_len] = 1;
             sigs_algname[sigs_algs_len++] = OPENSSL_strdup(sig_name);
+
+            if (strncmp(sig_name, "ML-DSA-", 7) == 0) {
+                size_t len = strlen(sig_name) + sizeof(ML_DSA_PRECOMPUTE_SUFFIX);
+                char *name;
+
+                if (sigs_algs_len + 1 >= MAX_SIG_NUM) {
+                    BIO_puts(bio_err,
+                        "Too many signatures registered. Change MAX_SIG_NUM.\n");
+                    goto end;
+                }
+                name = app_malloc(len, "signature name");
+                BIO_snprintf(name, len, "%s%s", sig_name, ML_DSA_PRECOMPUTE_SUFFIX);
+                sigs_doit[sigs_algs_len] = 1;
+                sigs_algname[sigs_algs_len++] = name;
+            }
         }
     }
     sk_EVP_SIGNATURE_pop_free(sig_stack, EVP_SIGNATURE_free);
@@ -2366,11 +2413,12 @@ int speed_main(int argc, char **argv)
         }
     }
     if (multiblock) {
-        if (evp_cipher == NULL) {
+        if (evp_cipher == NULL && evp_md_name == NULL) {
             BIO_puts(bio_err, "-mb can be used only with a multi-block"
-                              " capable cipher\n");
+                              " capable cipher or a digest\n");
             goto end;
-        } else if (!(EVP_CIPHER_get_flags(evp_cipher) & EVP_CIPH_FLAG_TLS1_1_MULTIBLOCK)) {
+        } else if (evp_cipher != NULL
+            && !(EVP_CIPHER_get_flags(evp_cipher) & EVP_CIPH_FLAG_TLS1_1_MULTIBLOCK)) {
             BIO_printf(bio_err, "%s is not a multi-block capable\n",
                 EVP_CIPHER_get0_name(evp_cipher));
             goto end;
@@ -3006,7 +3054,9 @@ int speed_main(int argc, char **argv)
             for (testnum = 0; testnum < size_num; testnum++) {
                 print_message(names[D_EVP], lengths[testnum], seconds.sym);
                 Time_F(START);
-                count = run_benchmark(async_jobs, EVP_Digest_md_loop, loopargs);
+                count = run_benchmark(async_jobs,
+                    multiblock ? EVP_Digest_multi_loop : EVP_Digest_md_loop,
+                    loopargs);
                 d = Time_F(STOP);
                 print_result(D_EVP, testnum, count, d);
                 if (count < 0)
@@ -3907,10 +3957,23 @@ int speed_main(int argc, char **argv)
     for (testnum = 0; testnum < sigs_algs_len; testnum++) {
         int sig_checks = 1;
         const char *sig_name = sigs_algname[testnum];
+        const char *alg_name = sig_name;
+        char base_name[MAX_ALGNAME_SUFFIX];
+        size_t name_len = strlen(sig_name);
+        size_t sfx_len = strlen(ML_DSA_PRECOMPUTE_SUFFIX);
+        int precompute = 0;
 
         if (!sigs_doit[testnum] || !do_sigs)
             continue;
 
+        if (name_len > sfx_len
+            && name_len - sfx_len < sizeof(base_name)
+            && strcmp(sig_name + name_len - sfx_len, ML_DSA_PRECOMPUTE_SUFFIX) == 0) {
+            OPENSSL_strlcpy(base_name, sig_name, name_len - sfx_len + 1);
+            alg_name = base_name;
+            precompute = 1;
+        }
+
         for (i = 0; i < loopargs_len; i++) {
             EVP_PKEY *pkey = NULL;
             EVP_PKEY_CTX *ctx_params = NULL;
@@ -3944,6 +4007,9 @@ int speed_main(int argc, char **argv)
                     &bits);
                 use_params = 1;
             }
+            if (precompute)
+                params[0] = OSSL_PARAM_construct_int(OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE,
+                    &precompute);
 
             if (strncmp(sig_name, "dsa", 3) == 0) {
                 int dsa_nbits = 0;
@@ -3968,11 +4034,12 @@ int speed_main(int argc, char **argv)
 
             if (sig_gen_ctx == NULL)
                 sig_gen_ctx = EVP_PKEY_CTX_new_from_name(app_get0_libctx(),
-                    use_params == 1 ? "RSA" : sig_name,
+                    use_params == 1 ? "RSA" : alg_name,
                     app_get0_propq());
 
             if (!sig_gen_ctx || EVP_PKEY_keygen_init(sig_gen_ctx) <= 0
-                || (use_params && EVP_PKEY_CTX_set_params(sig_gen_ctx, params) <= 0)) {
+                || ((use_params || precompute)
+                    && EVP_PKEY_CTX_set_params(sig_gen_ctx, params) <= 0)) {
                 BIO_printf(bio_err, "Error initializing keygen ctx for %s.\n",
                     sig_name);
                 goto sig_err_break;
@@ -3989,7 +4056,7 @@ int speed_main(int argc, char **argv)
              * use in case the algorithm does not support EVP_PKEY_sign_init
              */
             ERR_set_mark();
-            alg = EVP_SIGNATURE_fetch(app_get0_libctx(), sig_name, app_get0_propq());
+            alg = EVP_SIGNATURE_fetch(app_get0_libctx(), alg_name, app_get0_propq());
             ERR_pop_to_mark();
 
             /* Now prepare signature data structs */
@@ -74,6 +74,7 @@ struct bio_addrinfo_st {
 #include "internal/cryptlib.h"
 #include "internal/bio.h"
 #include "internal/refcount.h"
+#include "internal/tsan_assist.h"
 #include "internal/time.h"
 
 typedef struct bio_f_buffer_ctx_struct {
@@ -186,6 +187,9 @@ typedef struct bio_dgram_data_st {
     OSSL_TIME socket_timeout;
     unsigned int peekmode;
     char local_addr_enabled;
+    char gso_enabled;
+    /* How many times GSO was disabled because the kernel rejected it */
+    TSAN_QUALIFIER unsigned int gso_fallbacks;
 } bio_dgram_data;
 #endif
 
@@ -28,6 +28,10 @@
 #define IP_MTU 14 /* linux is lame */
 #endif
 
+#if defined(OPENSSL_SYS_LINUX)
+#include <netinet/udp.h>
+#endif
+
 #if OPENSSL_USE_IPV6 && !defined(IPPROTO_IPV6)
 #define IPPROTO_IPV6 41 /* windows is lame */
 #endif
@@ -146,6 +150,21 @@
 #endif
 #endif
 
+/*
+ * UDP generic segmentation offload: a run of same-size datagrams to the same
+ * peer is handed to the kernel as one buffer, which is split into datagrams
+ * of the given segment size as late as possible in the stack.
+ */
+#if M_METHOD == M_METHOD_RECVMMSG && defined(UDP_SEGMENT) && defined(SOL_UDP)
+#define SUPPORT_GSO
+/* Kernel limit on the number of segments in a single GSO send */
+#define BIO_GSO_MAX_SEGS 64
+/* Largest UDP payload which fits in an IPv6 packet */
+#define BIO_GSO_MAX_BYTES (0xffff - 8 - 40)
+#define BIO_CMSG_GSO_ALLOC_LEN \
+    (BIO_CMSG_ALLOC_LEN + BIO_CMSG_SPACE(sizeof(uint16_t)))
+#endif
+
 #define BIO_MSG_N(array, stride, n) (*(BIO_MSG *)((char *)(array) + (n) * (stride)))
 
 static int dgram_write(BIO *h, const char *buf, int num);
@@ -1007,6 +1026,30 @@ static long dgram_ctrl(BIO *b, int cmd, long num, void *ptr)
         *(int *)ptr = data->local_addr_enabled;
         break;
 
+    case BIO_CTRL_DGRAM_GET_GSO_CAP:
+#if defined(SUPPORT_GSO)
+        ret = 1;
+#else
+        ret = 0;
+#endif
+        break;
+
+    case BIO_CTRL_DGRAM_SET_GSO_ENABLE:
+#if defined(SUPPORT_GSO)
+        data->gso_enabled = (char)(num > 0);
+#else
+        ret = 0;
+#endif
+        break;
+
+    case BIO_CTRL_DGRAM_GET_GSO_ENABLE:
+        *(int *)ptr = data->gso_enabled;
+        break;
+
+    case BIO_CTRL_DGRAM_GET_GSO_FALLBACKS:
+        ret = (long)tsan_load(&data->gso_fallbacks);
+        break;
+
     case BIO_CTRL_DGRAM_GET_EFFECTIVE_CAPS:
         ret = (long)(BIO_DGRAM_CAP_HANDLES_DST_ADDR
             | BIO_DGRAM_CAP_HANDLES_SRC_ADDR
@@ -1319,6 +1362,129 @@ static int translate_flags(uint64_t flags)
 }
 #endif
 
+#if defined(SUPPORT_GSO)
+static int dgram_addr_eq(const BIO_ADDR *a, const BIO_ADDR *b)
+{
+    if (a == b)
+        return 1;
+    if (a == NULL || b == NULL || a->sa.sa_family != b->sa.sa_family)
+        return 0;
+
+    switch (a->sa.sa_family) {
+    case AF_INET:
+        return a->s_in.sin_port == b->s_in.sin_port
+            && a->s_in.sin_addr.s_addr == b->s_in.sin_addr.s_addr;
+#if OPENSSL_USE_IPV6
+    case AF_INET6:
+        return a->s_in6.sin6_port == b->s_in6.sin6_port
+            && a->s_in6.sin6_scope_id == b->s_in6.sin6_scope_id
+            && memcmp(&a->s_in6.sin6_addr, &b->s_in6.sin6_addr,
+                   sizeof(a->s_in6.sin6_addr))
+            == 0;
+#endif
+    default:
+        return 0;
+    }
+}
+
+/* Appends a UDP_SEGMENT control message to the control buffer of mh. */
+static void pack_gso(struct msghdr *mh, unsigned char *control,
+    uint16_t seg_size)
+{
+    struct cmsghdr *cmsg;
+    size_t off = mh->msg_control != NULL ? mh->msg_controllen : 0;
+
+    cmsg = (struct cmsghdr *)(control + off);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = BIO_CMSG_LEN(sizeof(uint16_t));
+    memcpy(BIO_CMSG_DATA(cmsg), &seg_size, sizeof(seg_size));
+
+    mh->msg_control = control;
+    mh->msg_controllen = off + BIO_CMSG_SPACE(sizeof(uint16_t));
+}
+
+/*
+ * BIO_sendmmsg() with GSO: each run of messages with the same peer and local
+ * address, all of the same size but the last, which may be shorter, is sent
+ * as a single segmented message. The message data is not copied; each
+ * message becomes one iovec of the segmented message.
+ *
+ * Returns 1 or 0 as for BIO_sendmmsg(), or -1 if the kernel rejected GSO, in
+ * which case nothing has been sent.
+ */
+static int dgram_sendmmsg_gso(BIO *b, BIO_MSG *msg, size_t stride,
+    size_t num_msg, int sysflags, size_t *num_processed)
+{
+    bio_dgram_data *data = (bio_dgram_data *)b->ptr;
+    struct mmsghdr mh[BIO_GSO_MAX_SEGS];
+    struct iovec iov[BIO_GSO_MAX_SEGS];
+    unsigned char control[BIO_GSO_MAX_SEGS][BIO_CMSG_GSO_ALLOC_LEN] = { { 0 } };
+    size_t first[BIO_GSO_MAX_SEGS + 1];
+    size_t i, j, n = 0, total;
+    BIO_MSG *m, *next;
+    int ret, err;
+
+    if (num_msg > BIO_GSO_MAX_SEGS)
+        num_msg = BIO_GSO_MAX_SEGS;
+
+    for (i = 0; i < num_msg; i = j) {
+        m = &BIO_MSG_N(msg, stride, i);
+        translate_msg(b, &mh[n].msg_hdr, &iov[i], control[n], m);
+
+        if (m->local != NULL) {
+            if (!data->local_addr_enabled
+                || pack_local(b, &mh[n].msg_hdr, m->local) < 1) {
+                ERR_raise(ERR_LIB_BIO, BIO_R_LOCAL_ADDR_NOT_AVAILABLE);
+                *num_processed = 0;
+                return 0;
+            }
+        }
+
+        total = m->data_len;
+        for (j = i + 1; j < num_msg; ++j) {
+            next = &BIO_MSG_N(msg, stride, j);
+
+            /* A shorter message ends the run */
+            if (BIO_MSG_N(msg, stride, j - 1).data_len != m->data_len
+                || next->data_len == 0 || next->data_len > m->data_len
+                || total + next->data_len > BIO_GSO_MAX_BYTES
+                || !dgram_addr_eq(next->peer, m->peer)
+                || !dgram_addr_eq(next->local, m->local))
+                break;
+
+            iov[j].iov_base = next->data;
+            iov[j].iov_len = next->data_len;
+            total += next->data_len;
+        }
+
+        mh[n].msg_hdr.msg_iovlen = j - i;
+        if (j - i > 1)
+            pack_gso(&mh[n].msg_hdr, control[n], (uint16_t)m->data_len);
+        first[n++] = i;
+    }
+    first[n] = num_msg;
+
+    ret = sendmmsg(b->num, mh, (unsigned int)n, sysflags);
+    if (ret < 0) {
+        err = get_last_socket_error();
+        /* Possibly no GSO support for this socket or device */
+        if (err == EIO || err == EINVAL || err == ENOPROTOOPT)
+            return -1;
+        ERR_raise(ERR_LIB_SYS, err);
+        *num_processed = 0;
+        return 0;
+    }
+
+    /* UDP sends are all or nothing, so data_len is unchanged */
+    for (i = 0; i < first[ret]; ++i)
+        BIO_MSG_N(msg, stride, i).flags = 0;
+
+    *num_processed = first[ret];
+    return 1;
+}
+#endif
+
 static int dgram_sendmmsg(BIO *b, BIO_MSG *msg, size_t stride,
     size_t num_msg, uint64_t flags, size_t *num_processed)
 {
@@ -1327,7 +1493,7 @@ static int dgram_sendmmsg(BIO *b, BIO_MSG *msg, size_t stride,
 #endif
 #if M_METHOD == M_METHOD_RECVMMSG
 #define BIO_MAX_MSGS_PER_CALL 64
-    int sysflags;
+    int sysflags, gso_rejected = 0;
     bio_dgram_data *data = (bio_dgram_data *)b->ptr;
     size_t i;
     struct mmsghdr mh[BIO_MAX_MSGS_PER_CALL];
@@ -1367,6 +1533,16 @@ static int dgram_sendmmsg(BIO *b, BIO_MSG *msg, size_t stride,
 #endif
 
 #if M_METHOD == M_METHOD_RECVMMSG
+#if defined(SUPPORT_GSO)
+    if (data->gso_enabled && num_msg > 1) {
+        ret = dgram_sendmmsg_gso(b, msg, stride, num_msg, sysflags,
+            num_processed);
+        if (ret >= 0)
+            return ret;
+        gso_rejected = 1;
+    }
+#endif
+
     /*
      * In the sendmmsg/recvmmsg case, we need to allocate our translated struct
      * msghdr and struct iovec on the stack to support multithreaded use. Thus
@@ -1407,6 +1583,15 @@ static int dgram_sendmmsg(BIO *b, BIO_MSG *msg, size_t stride,
         return 0;
     }
 
+    /*
+     * The same messages could be sent without GSO, so it was GSO that the
+     * kernel rejected and it is not tried again
+     */
+    if (gso_rejected) {
+        data->gso_enabled = 0;
+        tsan_counter(&data->gso_fallbacks);
+    }
+
     for (i = 0; i < (size_t)ret; ++i) {
         BIO_MSG_N(msg, stride, i).data_len = mh[i].msg_len;
         BIO_MSG_N(msg, stride, i).flags = 0;
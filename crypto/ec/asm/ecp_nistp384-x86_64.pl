@@ -0,0 +1,648 @@
+#! /usr/bin/env perl
+# Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+#
+# Licensed under the Apache License 2.0 (the "License").  You may not use
+# this file except in compliance with the License.  You can obtain a copy
+# in the file LICENSE in the source distribution or at
+# https://www.openssl.org/source/license.html
+#
+# P-384 field multiplication and squaring for x86_64 with BMI2 and ADX, used
+# by ecp_nistp384.c in place of felem_mul_reduce and felem_square_reduce.
+#
+# The C code keeps field elements as seven 56-bit limbs, which may grow up to
+# 64 bits between reductions.  Here each operand is first converted to seven
+# 64-bit words, the 7x7-word product is computed with MULX and the two carry
+# chains of ADCX/ADOX, and the product is folded twice with
+#
+#	2^384 = 2^128 + 2^96 - 2^32 + 1 (mod p)
+#
+# to a value below 2^384 + 2^291.  That is then split back into limbs that
+# satisfy the felem_reduce() output bounds: out[i] < 2^56 for i < 6 and
+# out[6] <= 2^48.  As in the C code, no data-dependent branches or memory
+# accesses are performed.
+#
+# Most of the time of the C functions is spent in the 128-bit arithmetic of
+# felem_reduce, which the word-wise folding avoids:
+#
+#			mul+reduce	square+reduce
+# C, -O3		~120		~100		cycles, Ice Lake
+# this module		~100		~87
+#
+# AVX-512 IFMA is not used: its 52-bit multiplier does not fit the 56-bit
+# limbs, and converting a single field element to and from radix 2^52 costs
+# more than the vector multiplication saves.
+
+# $output is the last argument if it looks like a file (it has an extension)
+# $flavour is the first argument if it doesn't look like a file
+$output = $#ARGV >= 0 && $ARGV[$#ARGV] =~ m|\.\w+$| ? pop : undef;
+$flavour = $#ARGV >= 0 && $ARGV[0] !~ m|\.| ? shift : undef;
+
+$win64=0; $win64=1 if ($flavour =~ /[nm]asm|mingw64/ || $output =~ /\.asm$/);
+
+$0 =~ m/(.*[\/\\])[^\/\\]+$/; $dir=$1;
+( $xlate="${dir}x86_64-xlate.pl" and -f $xlate ) or
+( $xlate="${dir}../../perlasm/x86_64-xlate.pl" and -f $xlate) or
+die "can't locate x86_64-xlate.pl";
+
+open OUT,"| \"$^X\" \"$xlate\" $flavour \"$output\""
+    or die "can't call $xlate: $!";
+*STDOUT=*OUT;
+
+if (`$ENV{CC} -Wa,-v -c -o /dev/null -x assembler /dev/null 2>&1`
+		=~ /GNU assembler version ([2-9]\.[0-9]+)/) {
+	$addx = ($1>=2.23);
+}
+
+if (!$addx && $win64 && ($flavour =~ /nasm/ || $ENV{ASM} =~ /nasm/) &&
+	    `nasm -v 2>&1` =~ /NASM version ([2-9]\.[0-9]+)/) {
+	$addx = ($1>=2.10);
+}
+
+if (!$addx && $win64 && ($flavour =~ /masm/ || $ENV{ASM} =~ /ml64/) &&
+	    `ml64 2>&1` =~ /Version ([0-9]+)\./) {
+	$addx = ($1>=12);
+}
+
+if (!$addx && `$ENV{CC} -v 2>&1` =~ /((?:clang|LLVM) version|.*based on LLVM) ([0-9]+)\.([0-9]+)/) {
+	my $ver = $2 + $3/100.0;	# 3.1->3.01, 3.10->3.10
+	$addx = ($ver>=3.03);
+}
+
+if (!$addx && `$ENV{CC} -x c /dev/null -dM -E|grep __clang_major__`
+	=~ /#define __clang_major__.([0-9]+)/) {
+	if ($1) {
+		$addx = ($1>=11); #icx started with clang 11
+	}
+}
+
+$code.=<<___;
+.text
+___
+
+# Stack frame: the words of both operands and the low 13 words of their
+# product (the 14th is always zero, see below).
+my ($A, $B, $P) = (0, 8*7, 8*14);
+my $frame = 8*27;
+# The offset of the return address from %rsp in the function body, for the
+# Win64 unwind handler: the frame and the six saved registers.
+my $seh_frame = $frame + 8*6;
+
+if ($addx) {
+
+my @acc = map("%r$_", (8..15));
+
+# Convert the seven limbs at ($src), each < 2^64, to seven 64-bit words at
+# $dst(%rsp).  Limb i is multiplied by 2^(56*i - 64*(i-1)) to split it into
+# the parts that fall into words i-1 and i; MULX leaves the flags alone, so a
+# single carry chain collects the words.  The result is below 2^400 + 2^344,
+# so the top word is at most 2^16.
+sub to_words {
+my ($src, $dst) = @_;
+$code.=<<___;
+	mov	8*0($src),@acc[0]
+	mov	8*1($src),%rdx
+	mulx	.Lpow2+8*0(%rip),%rax,@acc[1]	# limb[1] * 2^56
+	mov	8*2($src),%rdx
+	mulx	.Lpow2+8*1(%rip),%rbx,@acc[2]	# limb[2] * 2^48
+	add	%rax,@acc[0]
+	adc	%rbx,@acc[1]
+	mov	8*3($src),%rdx
+	mulx	.Lpow2+8*2(%rip),%rax,@acc[3]	# limb[3] * 2^40
+	adc	%rax,@acc[2]
+	mov	8*4($src),%rdx
+	mulx	.Lpow2+8*3(%rip),%rbx,@acc[4]	# limb[4] * 2^32
+	adc	%rbx,@acc[3]
+	mov	8*5($src),%rdx
+	mulx	.Lpow2+8*4(%rip),%rax,@acc[5]	# limb[5] * 2^24
+	adc	%rax,@acc[4]
+	mov	8*6($src),%rdx
+	mulx	.Lpow2+8*5(%rip),%rbx,@acc[6]	# limb[6] * 2^16
+	adc	%rbx,@acc[5]
+	adc	\$0,@acc[6]
+	mov	@acc[0],$dst+8*0(%rsp)
+	mov	@acc[1],$dst+8*1(%rsp)
+	mov	@acc[2],$dst+8*2(%rsp)
+	mov	@acc[3],$dst+8*3(%rsp)
+	mov	@acc[4],$dst+8*4(%rsp)
+	mov	@acc[5],$dst+8*5(%rsp)
+	mov	@acc[6],$dst+8*6(%rsp)
+___
+}
+
+# Multiply the words at $A(%rsp) by the words at 0(%rbp) and store the low 13
+# words of the product at $P(%rsp).  Both operands are below 2^400 + 2^344, so
+# the product is below 2^801 and its 14th word is zero.  Row by row, one
+# accumulator retires per row; %rcx is kept zero.
+sub mul_words {
+my @a = @acc;
+
+$code.=<<___;
+	mov	$A+8*0(%rsp),%rdx		# a[0]
+	mulx	8*0(%rbp),@a[0],%rax
+	xor	%ecx,%ecx			# cf=0,of=0
+	mulx	8*1(%rbp),@a[1],%rbx
+	adcx	%rax,@a[1]
+	mulx	8*2(%rbp),@a[2],%rax
+	adcx	%rbx,@a[2]
+	mulx	8*3(%rbp),@a[3],%rbx
+	adcx	%rax,@a[3]
+	mulx	8*4(%rbp),@a[4],%rax
+	adcx	%rbx,@a[4]
+	mulx	8*5(%rbp),@a[5],%rbx
+	adcx	%rax,@a[5]
+	mulx	8*6(%rbp),@a[6],@a[7]
+	 mov	$A+8*1(%rsp),%rdx		# a[1]
+	adcx	%rbx,@a[6]
+	adcx	%rcx,@a[7]			# cf=0
+	mov	@a[0],$P+8*0(%rsp)
+___
+	push(@a, shift(@a));
+
+for (my $i = 1; $i < 7; $i++) {
+	for (my $j = 0; $j < 6; $j++) {
+$code.=<<___;
+	mulx	8*$j(%rbp),%rax,%rbx		# a[$i]*b[$j]
+___
+$code.=<<___	if ($j == 0);
+	xor	%ecx,%ecx			# cf=0,of=0
+___
+$code.=<<___;
+	adcx	%rax,@a[$j]
+	adox	%rbx,@a[$j+1]
+___
+	}
+$code.=<<___;
+	mulx	8*6(%rbp),%rax,@a[7]		# a[$i]*b[6]
+___
+$code.=<<___	if ($i < 6);
+	 mov	$A+8*($i+1)(%rsp),%rdx		# a[$i+1]
+___
+$code.=<<___;
+	adcx	%rax,@a[6]
+	adcx	%rcx,@a[7]			# cf=0
+	adox	%rcx,@a[7]			# of=0
+	mov	@a[0],$P+8*$i(%rsp)
+___
+	push(@a, shift(@a));
+}
+
+$code.=<<___;
+	mov	@a[0],$P+8*7(%rsp)
+	mov	@a[1],$P+8*8(%rsp)
+	mov	@a[2],$P+8*9(%rsp)
+	mov	@a[3],$P+8*10(%rsp)
+	mov	@a[4],$P+8*11(%rsp)
+	mov	@a[5],$P+8*12(%rsp)
+___
+}
+
+# Square the words at $A(%rsp) into $P(%rsp): the 21 cross products a[i]*a[j],
+# i < j, are summed first, with a register for each column of the sum that is
+# still open, and then doubled while the squares a[i]^2 are added.
+sub sqr_words {
+my @free = (@acc, "%rbp", "%rsi");
+my %col;
+
+for (my $i = 0; $i < 6; $i++) {
+$code.=<<___;
+	mov	$A+8*$i(%rsp),%rdx		# a[$i]
+___
+	for (my $j = $i + 1; $j < 7; $j++) {
+		my ($lo, $hi) = ("%rax", "%rbx");
+		$col{$i+$j} = $lo = shift(@free) if (!defined($col{$i+$j}));
+		$col{$i+$j+1} = $hi = shift(@free) if (!defined($col{$i+$j+1}));
+$code.=<<___;
+	mulx	$A+8*$j(%rsp),$lo,$hi		# a[$i]*a[$j]
+___
+$code.=<<___	if ($j == $i + 1);
+	xor	%ecx,%ecx			# cf=0,of=0
+___
+$code.=<<___	if ($lo eq "%rax");
+	adcx	%rax,$col{$i+$j}
+___
+$code.=<<___	if ($hi eq "%rbx");
+	adox	%rbx,$col{$i+$j+1}
+___
+	}
+$code.=<<___;
+	adcx	%rcx,$col{$i+7}			# cf=0
+	adox	%rcx,$col{$i+7}			# of=0
+___
+	# the next row starts at column 2*$i+3
+	foreach my $k (2*$i+1, 2*$i+2) {
+$code.=<<___;
+	mov	$col{$k},$P+8*$k(%rsp)
+___
+		push(@free, $col{$k});
+	}
+}
+
+# Double the sum of the cross products and add the squares
+$code.=<<___;
+	mov	$A+8*0(%rsp),%rdx
+	mulx	%rdx,%rax,%rbx			# a[0]^2
+	xor	%ecx,%ecx			# cf=0,of=0
+	mov	%rax,$P+8*0(%rsp)
+___
+for (my $k = 1; $k < 13; $k++) {
+	my $t = @acc[$k % 8];
+	my $sq = $k & 1 ? "%rbx" : "%rax";
+$code.=<<___	if (!($k & 1));
+	mov	$A+4*$k(%rsp),%rdx
+	mulx	%rdx,%rax,%rbx			# a[$k/2]^2
+___
+$code.=<<___;
+	mov	$P+8*$k(%rsp),$t
+	adcx	$t,$t
+	adox	$sq,$t
+	mov	$t,$P+8*$k(%rsp)
+___
+}
+}
+
+$code.=<<___;
+.globl	p384_felem_adx_eligible
+.type	p384_felem_adx_eligible,\@abi-omnipotent
+.align	32
+p384_felem_adx_eligible:
+.cfi_startproc
+	mov	OPENSSL_ia32cap_P+8(%rip),%ecx
+	xor	%eax,%eax
+	and	\$0x80100,%ecx
+	cmp	\$0x80100,%ecx
+	cmove	%ecx,%eax
+	ret
+.cfi_endproc
+.size	p384_felem_adx_eligible,.-p384_felem_adx_eligible
+
+.globl	p384_felem_mul_reduce_adx
+.type	p384_felem_mul_reduce_adx,\@function,3
+.align	32
+p384_felem_mul_reduce_adx:
+.cfi_startproc
+	push	%rbp
+.cfi_push	%rbp
+	push	%rbx
+.cfi_push	%rbx
+	push	%r12
+.cfi_push	%r12
+	push	%r13
+.cfi_push	%r13
+	push	%r14
+.cfi_push	%r14
+	push	%r15
+.cfi_push	%r15
+	lea	-$frame(%rsp),%rsp
+.cfi_adjust_cfa_offset	$frame
+.Lmul_reduce_body:
+
+	mov	%rdx,%rbp
+___
+	to_words("%rsi", $A);
+	to_words("%rbp", $B);
+$code.=<<___;
+	lea	$B(%rsp),%rbp
+___
+	mul_words();
+$code.=<<___;
+	jmp	.Lreduce
+.Lmul_reduce_epilogue:
+.cfi_endproc
+.size	p384_felem_mul_reduce_adx,.-p384_felem_mul_reduce_adx
+
+.globl	p384_felem_square_reduce_adx
+.type	p384_felem_square_reduce_adx,\@function,2
+.align	32
+p384_felem_square_reduce_adx:
+.cfi_startproc
+	push	%rbp
+.cfi_push	%rbp
+	push	%rbx
+.cfi_push	%rbx
+	push	%r12
+.cfi_push	%r12
+	push	%r13
+.cfi_push	%r13
+	push	%r14
+.cfi_push	%r14
+	push	%r15
+.cfi_push	%r15
+	lea	-$frame(%rsp),%rsp
+.cfi_adjust_cfa_offset	$frame
+.Lsquare_reduce_body:
+___
+	to_words("%rsi", $A);
+	sqr_words();
+
+################################################################
+# Reduction of the product p = L + H * 2^384, L = p[0..5], H = p[6..12]
+# with d = 2^128 + 2^96 - 2^32 + 1 = (1, 2^32 - 1, 2^64 - 2^32 + 1) in
+# words: r = L + H * d < 2^546 is accumulated in nine registers, row by
+# row of the multiplication by d, and folded once more with r[6..8] as H.
+my @r = (@acc, "%rbp");
+my $h = "%rsi";
+
+$code.=<<___;
+
+.align	32
+.Lreduce:
+	mov	$P+8*0(%rsp),@r[0]
+	mov	$P+8*1(%rsp),@r[1]
+	mov	$P+8*2(%rsp),@r[2]
+	mov	$P+8*3(%rsp),@r[3]
+	mov	$P+8*4(%rsp),@r[4]
+	mov	$P+8*5(%rsp),@r[5]
+	mov	.Ldelta+8*0(%rip),%rdx		# 2^64 - 2^32 + 1
+	xor	%ecx,%ecx			# cf=0,of=0
+	mov	%rcx,@r[6]
+	mov	%rcx,@r[7]
+	mov	%rcx,@r[8]
+___
+	for (my $j = 0; $j < 7; $j++) {
+$code.=<<___;
+	mulx	$P+8*(6+$j)(%rsp),%rax,%rbx	# h[$j]*d[0]
+	adcx	%rax,@r[$j]
+	adox	%rbx,@r[$j+1]
+___
+	}
+$code.=<<___;
+	 mov	.Ldelta+8*1(%rip),%rdx		# 2^32 - 1
+	adcx	%rcx,@r[7]			# cf=0, and of=0
+___
+	for (my $j = 0; $j < 7; $j++) {
+$code.=<<___;
+	mulx	$P+8*(6+$j)(%rsp),%rax,%rbx	# h[$j]*d[1]
+___
+$code.=<<___	if ($j == 0);
+	xor	%ecx,%ecx			# cf=0,of=0
+___
+$code.=<<___;
+	adcx	%rax,@r[$j+1]
+	adox	%rbx,@r[$j+2]
+___
+	}
+$code.=<<___;
+	adcx	%rcx,@r[8]			# cf=0, and of=0
+	xor	%ecx,%ecx			# cf=0,of=0
+___
+	for (my $j = 0; $j < 7; $j++) {
+$code.=<<___;
+	adcx	$P+8*(6+$j)(%rsp),@r[$j+2]	# h[$j]*d[2]
+___
+	}
+
+# Second fold with H = r[6..8] < 2^162: adds less than 2^291, so that the top
+# word becomes 0 or 1.  The result is not folded any further, the C code does
+# not need the limbs to be below p.
+$code.=<<___;
+	mov	.Ldelta+8*0(%rip),%rdx
+	xor	$h,$h				# cf=0,of=0
+___
+	for (my $j = 0; $j < 3; $j++) {
+$code.=<<___;
+	mulx	@r[6+$j],%rax,%rbx		# h[$j]*d[0]
+	adcx	%rax,@r[$j]
+	adox	%rbx,@r[$j+1]
+___
+	}
+$code.=<<___;
+	 mov	.Ldelta+8*1(%rip),%rdx
+	adcx	%rcx,@r[3]
+	adox	%rcx,@r[4]
+	adcx	%rcx,@r[4]
+	adox	%rcx,@r[5]
+	adcx	%rcx,@r[5]
+	adox	%rcx,$h
+	adcx	%rcx,$h				# cf=0,of=0
+___
+	for (my $j = 0; $j < 3; $j++) {
+$code.=<<___;
+	mulx	@r[6+$j],%rax,%rbx		# h[$j]*d[1]
+	adcx	%rax,@r[$j+1]
+	adox	%rbx,@r[$j+2]
+___
+	}
+$code.=<<___;
+	adcx	%rcx,@r[4]
+	adox	%rcx,@r[5]
+	adcx	%rcx,@r[5]
+	adox	%rcx,$h
+	adcx	%rcx,$h				# cf=0,of=0
+
+	add	@r[6],@r[2]			# h*d[2]
+	adc	@r[7],@r[3]
+	adc	@r[8],@r[4]
+	adc	\$0,@r[5]
+	adc	\$0,$h
+
+	################################################################
+	# Split into 56-bit limbs: as the value is below 2^384 + 2^291, the
+	# top one, which takes the top word, is at most 2^48
+
+	mov	.Lmask56(%rip),%rax
+	mov	@r[0],%rbx
+	and	%rax,%rbx
+	shrd	\$56,@r[1],@r[0]
+	and	%rax,@r[0]
+	shrd	\$48,@r[2],@r[1]
+	and	%rax,@r[1]
+	shrd	\$40,@r[3],@r[2]
+	and	%rax,@r[2]
+	shrd	\$32,@r[4],@r[3]
+	and	%rax,@r[3]
+	shrd	\$24,@r[5],@r[4]
+	and	%rax,@r[4]
+	shr	\$16,@r[5]
+	shl	\$48,$h
+	add	$h,@r[5]
+
+	mov	%rbx,8*0(%rdi)
+	mov	@r[0],8*1(%rdi)
+	mov	@r[1],8*2(%rdi)
+	mov	@r[2],8*3(%rdi)
+	mov	@r[3],8*4(%rdi)
+	mov	@r[4],8*5(%rdi)
+	mov	@r[5],8*6(%rdi)
+
+	mov	$frame+8*0(%rsp),%r15
+.cfi_restore	%r15
+	mov	$frame+8*1(%rsp),%r14
+.cfi_restore	%r14
+	mov	$frame+8*2(%rsp),%r13
+.cfi_restore	%r13
+	mov	$frame+8*3(%rsp),%r12
+.cfi_restore	%r12
+	mov	$frame+8*4(%rsp),%rbx
+.cfi_restore	%rbx
+	mov	$frame+8*5(%rsp),%rbp
+.cfi_restore	%rbp
+	lea	$seh_frame(%rsp),%rsp
+.cfi_adjust_cfa_offset	-$seh_frame
+.Lsquare_reduce_epilogue:
+	ret
+.cfi_endproc
+.size	p384_felem_square_reduce_adx,.-p384_felem_square_reduce_adx
+
+.section	.rodata align=64
+.align	64
+.Lpow2:
+.quad	1<<56, 1<<48, 1<<40, 1<<32, 1<<24, 1<<16
+.Ldelta:
+.quad	0xffffffff00000001, 0x00000000ffffffff
+.Lmask56:
+.quad	0x00ffffffffffffff
+.asciz	"P-384 field arithmetic for x86_64/ADX, CRYPTOGAMS by <https://github.com/dot-asm>"
+.previous
+___
+} else {
+$code.=<<___;
+.globl	p384_felem_adx_eligible
+.type	p384_felem_adx_eligible,\@abi-omnipotent
+.align	32
+p384_felem_adx_eligible:
+.cfi_startproc
+	xor	%eax,%eax
+	ret
+.cfi_endproc
+.size	p384_felem_adx_eligible,.-p384_felem_adx_eligible
+
+.globl	p384_felem_mul_reduce_adx
+.type	p384_felem_mul_reduce_adx,\@abi-omnipotent
+.globl	p384_felem_square_reduce_adx
+p384_felem_mul_reduce_adx:
+p384_felem_square_reduce_adx:
+.cfi_startproc
+	.byte	0x0f,0x0b	# ud2
+	ret
+.cfi_endproc
+.size	p384_felem_mul_reduce_adx,.-p384_felem_mul_reduce_adx
+___
+}
+
+# EXCEPTION_DISPOSITION handler (EXCEPTION_RECORD *rec,ULONG64 frame,
+#		CONTEXT *context,DISPATCHER_CONTEXT *disp)
+if ($win64 && $addx) {
+$rec="%rcx";
+$frame="%rdx";
+$context="%r8";
+$disp="%r9";
+
+$code.=<<___;
+.extern	__imp_RtlVirtualUnwind
+
+.type	full_handler,\@abi-omnipotent
+.align	16
+full_handler:
+	push	%rsi
+	push	%rdi
+	push	%rbx
+	push	%rbp
+	push	%r12
+	push	%r13
+	push	%r14
+	push	%r15
+	pushfq
+	sub	\$64,%rsp
+
+	mov	120($context),%rax	# pull context->Rax
+	mov	248($context),%rbx	# pull context->Rip
+
+	mov	8($disp),%rsi		# disp->ImageBase
+	mov	56($disp),%r11		# disp->HandlerData
+
+	mov	0(%r11),%r10d		# HandlerData[0]
+	lea	(%rsi,%r10),%r10	# end of prologue label
+	cmp	%r10,%rbx		# context->Rip<end of prologue label
+	jb	.Lcommon_seh_tail
+
+	mov	152($context),%rax	# pull context->Rsp
+
+	mov	4(%r11),%r10d		# HandlerData[1]
+	lea	(%rsi,%r10),%r10	# epilogue label
+	cmp	%r10,%rbx		# context->Rip>=epilogue label
+	jae	.Lcommon_seh_tail
+
+	mov	8(%r11),%r10d		# HandlerData[2]
+	lea	(%rax,%r10),%rax
+
+	mov	-8(%rax),%rbp
+	mov	-16(%rax),%rbx
+	mov	-24(%rax),%r12
+	mov	-32(%rax),%r13
+	mov	-40(%rax),%r14
+	mov	-48(%rax),%r15
+	mov	%rbx,144($context)	# restore context->Rbx
+	mov	%rbp,160($context)	# restore context->Rbp
+	mov	%r12,216($context)	# restore context->R12
+	mov	%r13,224($context)	# restore context->R13
+	mov	%r14,232($context)	# restore context->R14
+	mov	%r15,240($context)	# restore context->R15
+
+.Lcommon_seh_tail:
+	mov	8(%rax),%rdi
+	mov	16(%rax),%rsi
+	mov	%rax,152($context)	# restore context->Rsp
+	mov	%rsi,168($context)	# restore context->Rsi
+	mov	%rdi,176($context)	# restore context->Rdi
+
+	mov	40($disp),%rdi		# disp->ContextRecord
+	mov	$context,%rsi		# context
+	mov	\$154,%ecx		# sizeof(CONTEXT)
+	.long	0xa548f3fc		# cld; rep movsq
+
+	mov	$disp,%rsi
+	xor	%rcx,%rcx		# arg1, UNW_FLAG_NHANDLER
+	mov	8(%rsi),%rdx		# arg2, disp->ImageBase
+	mov	0(%rsi),%r8		# arg3, disp->ControlPc
+	mov	16(%rsi),%r9		# arg4, disp->FunctionEntry
+	mov	40(%rsi),%r10		# disp->ContextRecord
+	lea	56(%rsi),%r11		# &disp->HandlerData
+	lea	24(%rsi),%r12		# &disp->EstablisherFrame
+	mov	%r10,32(%rsp)		# arg5
+	mov	%r11,40(%rsp)		# arg6
+	mov	%r12,48(%rsp)		# arg7
+	mov	%rcx,56(%rsp)		# arg8, (NULL)
+	call	*__imp_RtlVirtualUnwind(%rip)
+
+	mov	\$1,%eax		# ExceptionContinueSearch
+	add	\$64,%rsp
+	popfq
+	pop	%r15
+	pop	%r14
+	pop	%r13
+	pop	%r12
+	pop	%rbp
+	pop	%rbx
+	pop	%rdi
+	pop	%rsi
+	ret
+.size	full_handler,.-full_handler
+
+.section	.pdata
+.align	4
+	.rva	.LSEH_begin_p384_felem_mul_reduce_adx
+	.rva	.LSEH_end_p384_felem_mul_reduce_adx
+	.rva	.LSEH_info_p384_felem_mul_reduce_adx
+
+	.rva	.LSEH_begin_p384_felem_square_reduce_adx
+	.rva	.LSEH_end_p384_felem_square_reduce_adx
+	.rva	.LSEH_info_p384_felem_square_reduce_adx
+
+.section	.xdata
+.align	8
+.LSEH_info_p384_felem_mul_reduce_adx:
+	.byte	9,0,0,0
+	.rva	full_handler
+	.rva	.Lmul_reduce_body,.Lmul_reduce_epilogue	# HandlerData[]
+	.long	$seh_frame,0
+.LSEH_info_p384_felem_square_reduce_adx:
+	.byte	9,0,0,0
+	.rva	full_handler
+	.rva	.Lsquare_reduce_body,.Lsquare_reduce_epilogue	# HandlerData[]
+	.long	$seh_frame,0
+___
+}
+
+$code =~ s/\`([^\`]*)\`/eval $1/gem;
+print $code;
+close STDOUT or die "error closing STDOUT: $!";
@@ -214,42 +214,7 @@ static void felem_scalar128(widefelem out, limb scalar)
         out[i] *= scalar;
 }
 
-/*-
- * felem_neg sets |out| to |-in|
- * On entry:
- *   in[i] < 2^60 - 2^29
- * On exit:
- *   out[i] < 2^60
- */
-static void felem_neg(felem out, const felem in)
-{
-    /*
-     * In order to prevent underflow, we add a multiple of p before subtracting.
-     * Use telescopic sums to represent 2^12 * p redundantly with each limb
-     * of the form 2^60 + ...
-     */
-    static const limb two60m52m4 = (((limb)1) << 60)
-        - (((limb)1) << 52)
-        - (((limb)1) << 4);
-    static const limb two60p44m12 = (((limb)1) << 60)
-        + (((limb)1) << 44)
-        - (((limb)1) << 12);
-    static const limb two60m28m4 = (((limb)1) << 60)
-        - (((limb)1) << 28)
-        - (((limb)1) << 4);
-    static const limb two60m4 = (((limb)1) << 60)
-        - (((limb)1) << 4);
-
-    out[0] = two60p44m12 - in[0];
-    out[1] = two60m52m4 - in[1];
-    out[2] = two60m28m4 - in[2];
-    out[3] = two60m4 - in[3];
-    out[4] = two60m4 - in[4];
-    out[5] = two60m4 - in[5];
-    out[6] = two60m4 - in[6];
-}
-
-#if defined(ECP_NISTP384_ASM)
+#if defined(ECP_NISTP384_ASM) && defined(_ARCH_PPC64)
 void p384_felem_diff64(felem out, const felem in);
 void p384_felem_diff128(widefelem out, const widefelem in);
 void p384_felem_diff_128_64(widefelem out, const felem in);
@@ -700,15 +665,18 @@ static ossl_inline void felem_mul_reduce_ref(felem out, const felem in1, const f
 #if defined(ECP_NISTP384_ASM)
 static void felem_square_wrapper(widefelem out, const felem in);
 static void felem_mul_wrapper(widefelem out, const felem in1, const felem in2);
+static void felem_square_reduce_wrapper(felem out, const felem in);
+static void felem_mul_reduce_wrapper(felem out, const felem in1, const felem in2);
 
 static void (*felem_square_p)(widefelem out, const felem in) = felem_square_wrapper;
 static void (*felem_mul_p)(widefelem out, const felem in1, const felem in2) = felem_mul_wrapper;
 
 static void (*felem_reduce_p)(felem out, const widefelem in) = felem_reduce_ref;
 
-static void (*felem_square_reduce_p)(felem out, const felem in) = felem_square_reduce_ref;
-static void (*felem_mul_reduce_p)(felem out, const felem in1, const felem in2) = felem_mul_reduce_ref;
+static void (*felem_square_reduce_p)(felem out, const felem in) = felem_square_reduce_wrapper;
+static void (*felem_mul_reduce_p)(felem out, const felem in1, const felem in2) = felem_mul_reduce_wrapper;
 
+#if defined(_ARCH_PPC64)
 void p384_felem_square(widefelem out, const felem in);
 void p384_felem_mul(widefelem out, const felem in1, const felem in2);
 void p384_felem_reduce(felem out, const widefelem in);
@@ -716,8 +684,11 @@ void p384_felem_reduce(felem out, const widefelem in);
 void p384_felem_square_reduce(felem out, const felem in);
 void p384_felem_mul_reduce(felem out, const felem in1, const felem in2);
 
-#if defined(_ARCH_PPC64)
 #include "arch/ppc_arch.h"
+#elif defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)
+int p384_felem_adx_eligible(void);
+void p384_felem_square_reduce_adx(felem out, const felem in);
+void p384_felem_mul_reduce_adx(felem out, const felem in1, const felem in2);
 #endif
 
 static void felem_select(void)
@@ -730,6 +701,17 @@ static void felem_select(void)
         felem_square_reduce_p = p384_felem_square_reduce;
         felem_mul_reduce_p = p384_felem_mul_reduce;
 
+        return;
+    }
+#elif defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)
+    /* Only the fused multiply/square and reduce are implemented with ADX */
+    if (p384_felem_adx_eligible()) {
+        felem_square_p = felem_square_ref;
+        felem_mul_p = felem_mul_ref;
+        felem_reduce_p = felem_reduce_ref;
+        felem_square_reduce_p = p384_felem_square_reduce_adx;
+        felem_mul_reduce_p = p384_felem_mul_reduce_adx;
+
         return;
     }
 #endif
@@ -754,6 +736,18 @@ static void felem_mul_wrapper(widefelem out, const felem in1, const felem in2)
     felem_mul_p(out, in1, in2);
 }
 
+static void felem_square_reduce_wrapper(felem out, const felem in)
+{
+    felem_select();
+    felem_square_reduce_p(out, in);
+}
+
+static void felem_mul_reduce_wrapper(felem out, const felem in1, const felem in2)
+{
+    felem_select();
+    felem_mul_reduce_p(out, in1, in2);
+}
+
 #define felem_square felem_square_p
 #define felem_mul felem_mul_p
 #define felem_reduce felem_reduce_p
@@ -846,6 +840,61 @@ static void felem_inv(felem out, const felem in)
     memcpy(out, ftmp, sizeof(felem));
 }
 
+/*-
+ * felem_neg sets |out| to |-in|
+ * On entry:
+ *   in[i] < 2^60 - 2^52 - 2^4
+ * On exit:
+ *   out[i] < 2^60 + 2^44
+ */
+static void felem_neg(felem out, const felem in)
+{
+    /*
+     * In order to prevent underflow, we subtract from a multiple of p.
+     * Use telescopic sums to represent 2^12 * p redundantly with each limb
+     * of the form 2^60 + ...
+     */
+    static const limb two60m52m4 = (((limb)1) << 60)
+        - (((limb)1) << 52)
+        - (((limb)1) << 4);
+    static const limb two60p44m12 = (((limb)1) << 60)
+        + (((limb)1) << 44)
+        - (((limb)1) << 12);
+    static const limb two60m28m4 = (((limb)1) << 60)
+        - (((limb)1) << 28)
+        - (((limb)1) << 4);
+    static const limb two60m4 = (((limb)1) << 60)
+        - (((limb)1) << 4);
+
+    out[0] = two60p44m12 - in[0];
+    out[1] = two60m52m4 - in[1];
+    out[2] = two60m28m4 - in[2];
+    out[3] = two60m4 - in[3];
+    out[4] = two60m4 - in[4];
+    out[5] = two60m4 - in[5];
+    out[6] = two60m4 - in[6];
+}
+
+/*-
+ * felem_reduce64 reduces |in| like felem_reduce, for values that are not
+ * the result of a multiplication
+ * On entry:
+ *   in[i] < 2^63
+ * On exit:
+ *   out[k] < 2^56, k < 6
+ *   out[6] <= 2^48
+ */
+static void felem_reduce64(felem out, const felem in)
+{
+    widefelem tmp;
+    unsigned int i;
+
+    memset(tmp, 0, sizeof(tmp));
+    for (i = 0; i < NLIMBS; i++)
+        tmp[i] = in[i];
+    felem_reduce(out, tmp);
+}
+
 /*
  * Zero-check: returns a limb with all bits set if |in| == 0 (mod p)
  * and 0 otherwise. We know that field elements are reduced to
@@ -1384,6 +1433,40 @@ static void select_point(const limb idx, unsigned int size,
     }
 }
 
+/*
+ * The precomputed table for the standard generator in ecp_nistp384_table.c:
+ * d * 2^(5i) * G for i = 0 .. 76 and d = 1 .. 16, as affine (x, y).
+ */
+extern const felem ossl_ec_nistp384_precomputed[77][16][2];
+
+/*
+ * select_base_point selects the point |idx| * 2^(5i) * G from |table|, the
+ * |i|th subtable of ossl_ec_nistp384_precomputed, and copies it to out,
+ * with z = 1, or sets out to the point at infinity if |idx| is 0.
+ */
+static void select_base_point(const limb idx, const felem table[16][2],
+    felem out[3])
+{
+    unsigned int i, j;
+    limb *outlimbs = &out[0][0];
+
+    memset(out, 0, sizeof(*out) * 3);
+
+    for (i = 0; i < 16; i++) {
+        const limb *inlimbs = &table[i][0][0];
+        limb mask = (i + 1) ^ idx;
+
+        mask |= mask >> 4;
+        mask |= mask >> 2;
+        mask |= mask >> 1;
+        mask &= 1;
+        mask--;
+        for (j = 0; j < NLIMBS * 2; j++)
+            outlimbs[j] |= inlimbs[j] & mask;
+        out[2][0] |= mask & 1;
+    }
+}
+
 /* get_bit returns the |i|th bit in |in| */
 static char get_bit(const felem_bytearray in, int i)
 {
@@ -1483,6 +1566,49 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
     felem_assign(z_out, nq[2]);
 }
 
+/*
+ * Multiplication of the standard generator by |scalar|, using the table of
+ * ossl_ec_nistp384_precomputed: the scalar is recoded into 77 signed 5-bit
+ * digits, and the multiples of G selected by them are added up, without any
+ * point doublings.
+ * Output point (X, Y, Z) is stored in x_out, y_out, z_out
+ */
+static void base_mul(felem x_out, felem y_out, felem z_out,
+    const felem_bytearray scalar)
+{
+    int i;
+    felem nq[3], tmp[4];
+    limb bits;
+    uint8_t sign, digit;
+
+    for (i = 0; i < 77; i++) {
+        bits = get_bit(scalar, 5 * i + 4) << 5;
+        bits |= get_bit(scalar, 5 * i + 3) << 4;
+        bits |= get_bit(scalar, 5 * i + 2) << 3;
+        bits |= get_bit(scalar, 5 * i + 1) << 2;
+        bits |= get_bit(scalar, 5 * i) << 1;
+        bits |= get_bit(scalar, 5 * i - 1);
+        ossl_ec_GFp_nistp_recode_scalar_bits(&sign, &digit, bits);
+
+        /* select the point to add or subtract, in constant time */
+        select_base_point(digit, ossl_ec_nistp384_precomputed[i], tmp);
+        felem_neg(tmp[3], tmp[1]); /* (X, -Y, Z) is the negative point */
+        copy_conditional(tmp[1], tmp[3], (-(limb)sign));
+
+        if (i != 0) {
+            /* The 1 argument below is for "mixed" */
+            point_add(nq[0], nq[1], nq[2],
+                nq[0], nq[1], nq[2], 1,
+                tmp[0], tmp[1], tmp[2]);
+        } else {
+            memcpy(nq, tmp, 3 * sizeof(felem));
+        }
+    }
+    felem_assign(x_out, nq[0]);
+    felem_assign(y_out, nq[1]);
+    felem_assign(z_out, nq[2]);
+}
+
 /* Precomputation for the group generator. */
 struct nistp384_pre_comp_st {
     felem g_pre_comp[16][3];
@@ -1881,18 +2007,29 @@ int ossl_ec_GFp_nistp384_points_mul(const EC_GROUP *group, EC_POINT *r,
         } else {
             num_bytes = BN_bn2lebinpad(scalar, g_secret, sizeof(g_secret));
         }
-        /* do the multiplication with generator precomputation */
-        batch_mul(x_out, y_out, z_out,
-            (const felem_bytearray(*))secrets, num_points,
-            g_secret,
-            mixed, (const felem(*)[17][3])pre_comp,
-            (const felem(*)[3])g_pre_comp);
+        if (num_points == 0
+            && memcmp(g_pre_comp[1], gmul[1], sizeof(gmul[1])) == 0) {
+            /* only a multiple of the standard generator, use the big table */
+            base_mul(x_out, y_out, z_out, g_secret);
+        } else {
+            /* do the multiplication with generator precomputation */
+            batch_mul(x_out, y_out, z_out,
+                (const felem_bytearray(*))secrets, num_points,
+                g_secret,
+                mixed, (const felem(*)[17][3])pre_comp,
+                (const felem(*)[3])g_pre_comp);
+        }
     } else {
         /* do the multiplication without generator precomputation */
         batch_mul(x_out, y_out, z_out,
             (const felem_bytearray(*))secrets, num_points,
             NULL, mixed, (const felem(*)[17][3])pre_comp, NULL);
     }
+    /*
+     * If the last point added was added to the point at infinity, it is
+     * returned as it is, with the unreduced Y of felem_neg() if negative
+     */
+    felem_reduce64(y_out, y_out);
     /* reduce the output to its unique minimal representation */
     felem_contract(x_in, x_out);
     felem_contract(y_in, y_out);
@@ -0,0 +1,117 @@
+#! /usr/bin/env perl
+# Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+#
+# Licensed under the Apache License 2.0 (the "License").  You may not use
+# this file except in compliance with the License.  You can obtain a copy
+# in the file LICENSE in the source distribution or at
+# https://www.openssl.org/source/license.html
+
+#
+# Generates ecp_nistp384_table.c, the table of multiples of the P-384
+# generator used by the fixed-base multiplication in ecp_nistp384.c:
+#
+#   perl ecp_nistp384_table.pl > ecp_nistp384_table.c
+#
+# Subtable i holds d * 2^(5i) * G for d = 1 .. 16, in affine coordinates
+# and in the seven 56-bit limb representation of ecp_nistp384.c.
+
+use strict;
+use warnings;
+use Math::BigInt try => 'GMP';
+
+my $p = Math::BigInt->new(2)**384 - Math::BigInt->new(2)**128
+    - Math::BigInt->new(2)**96 + Math::BigInt->new(2)**32 - 1;
+my $gx = Math::BigInt->from_hex("aa87ca22be8b05378eb1c71ef320ad746e1d3b62"
+    . "8ba79b9859f741e082542a385502f25dbf55296c3a545e3872760ab7");
+my $gy = Math::BigInt->from_hex("3617de4a96262c6f5d9e98bf9292dc29f8f41dbd"
+    . "289a147ce9da3113b5f0b8c00a60b1ce1d7e819d7a431d7c90ea0e5f");
+
+# Affine point addition, with undef as the point at infinity
+sub add {
+    my ($P, $Q) = @_;
+
+    return $Q if !defined $P;
+    return $P if !defined $Q;
+
+    my ($x1, $y1) = @$P;
+    my ($x2, $y2) = @$Q;
+    my $l;
+
+    if ($x1 == $x2) {
+        return undef if ($y1 + $y2) % $p == 0;
+        $l = (3 * $x1 * $x1 - 3) * (2 * $y1)->copy->bmodinv($p) % $p;
+    } else {
+        $l = ($y2 - $y1) * ($x2 - $x1)->copy->bmod($p)->bmodinv($p) % $p;
+    }
+
+    my $x3 = ($l * $l - $x1 - $x2) % $p;
+    my $y3 = ($l * ($x1 - $x3) - $y1) % $p;
+
+    return [ $x3, $y3 ];
+}
+
+# The seven 56-bit limbs of $v, formatted as in ecp_nistp384_table.c
+sub limbs {
+    my ($v) = @_;
+    my $mask = Math::BigInt->new(2)**56 - 1;
+    my @l;
+
+    for (my $i = 0; $i < 7; $i++) {
+        my $hex = (($v->copy >> (56 * $i)) & $mask)->as_hex;
+
+        $hex =~ s/^0x//;
+        push @l, sprintf("0x%016s", $hex) =~ tr/ /0/r;
+    }
+    return join(", ", @l[0 .. 3]) . ",\n" . " " x 14 . join(", ", @l[4 .. 6]);
+}
+
+print <<'___';
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * This is the precomputed table for the fixed-base multiplication in
+ * ecp_nistp384.c, for the standard generator. The table consists of 77
+ * subtables, one for each signed 5-bit digit of the recoded scalar, and each
+ * subtable contains 16 affine points:
+ * subtable 0:   1*  (2^0)*G, 2*  (2^0)*G, ... , 16*  (2^0)*G,
+ * subtable 1:   1*  (2^5)*G, 2*  (2^5)*G, ... , 16*  (2^5)*G,
+ * ...
+ * subtable 76:  1*(2^380)*G, 2*(2^380)*G, ... , 16*(2^380)*G,
+ *
+ * The affine points are encoded as fourteen uint64's, seven 56-bit limbs for
+ * the x coordinate and seven for the y, in the felem representation of
+ * ecp_nistp384.c. Both values are fully reduced and in little-endian order.
+ *
+ * It is generated by ecp_nistp384_table.pl.
+ */
+
+#include <openssl/e_os2.h>
+
+extern const uint64_t ossl_ec_nistp384_precomputed[77][16][2][7];
+const uint64_t ossl_ec_nistp384_precomputed[77][16][2][7] = {
+___
+
+my $B = [ $gx, $gy ];
+
+for (my $i = 0; $i < 77; $i++) {
+    my $P = $B;
+
+    print "    {\n";
+    for (my $d = 1; $d <= 16; $d++) {
+        print "        { { ", limbs($P->[0]), " },\n";
+        print "            { ", limbs($P->[1]), " } }",
+            $d < 16 ? "," : "", "\n";
+        $P = add($P, $B);
+    }
+    print "    }", $i < 76 ? "," : "", "\n";
+    $B = add($B, $B) for 1 .. 5;
+}
+
+print "};\n";
@@ -565,6 +565,51 @@ int EVP_Digest(const void *data, size_t count,
     return ret;
 }
 
+int EVP_Digest_multi(const EVP_MD *type, size_t n,
+    const unsigned char *const in[], const size_t inlen[],
+    unsigned char *const out[])
+{
+    EVP_MD *provmd = NULL;
+    size_t i;
+    int mdsize, ret = 1;
+
+    if (type == NULL
+        || (n > 0 && (in == NULL || inlen == NULL || out == NULL))) {
+        ERR_raise(ERR_LIB_EVP, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    if (type->prov == NULL) {
+#ifdef FIPS_MODULE
+        /* We only do explicit fetches inside the FIPS module */
+        ERR_raise(ERR_LIB_EVP, EVP_R_INITIALIZATION_ERROR);
+        return 0;
+#else
+        provmd = EVP_MD_fetch(NULL, OBJ_nid2sn(type->type), "");
+        if (provmd == NULL) {
+            ERR_raise(ERR_LIB_EVP, EVP_R_INITIALIZATION_ERROR);
+            return 0;
+        }
+        type = provmd;
+#endif
+    }
+
+    if ((mdsize = EVP_MD_get_size(type)) <= 0) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_INVALID_DIGEST);
+        ret = 0;
+    } else if (type->digest_multi != NULL) {
+        ret = type->digest_multi(ossl_provider_ctx(type->prov), n, in, inlen,
+            out, (size_t)mdsize);
+    } else {
+        /* Hash the messages one by one if the digest has no better way */
+        for (i = 0; ret && i < n; i++)
+            ret = EVP_Digest(in[i], inlen[i], out[i], NULL, type, NULL);
+    }
+
+    EVP_MD_free(provmd);
+    return ret;
+}
+
 int EVP_Q_digest(OSSL_LIB_CTX *libctx, const char *name, const char *propq,
     const void *data, size_t datalen,
     unsigned char *md, size_t *mdlen)
@@ -945,6 +990,10 @@ static void *evp_md_from_algorithm(int name_id,
             if (md->deserialize == NULL)
                 md->deserialize = OSSL_FUNC_digest_deserialize(fns);
             break;
+        case OSSL_FUNC_DIGEST_DIGEST_MULTI:
+            if (md->digest_multi == NULL)
+                md->digest_multi = OSSL_FUNC_digest_digest_multi(fns);
+            break;
         }
     }
     if ((fncnt != 0 && fncnt != 5 && fncnt != 6)
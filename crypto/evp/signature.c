@@ -158,6 +158,16 @@ static void *evp_signature_from_algorithm(int name_id,
             signature->verify_message_final
                 = OSSL_FUNC_signature_verify_message_final(fns);
             break;
+        case OSSL_FUNC_SIGNATURE_SIGN_BATCH:
+            if (signature->sign_batch != NULL)
+                break;
+            signature->sign_batch = OSSL_FUNC_signature_sign_batch(fns);
+            break;
+        case OSSL_FUNC_SIGNATURE_VERIFY_BATCH:
+            if (signature->verify_batch != NULL)
+                break;
+            signature->verify_batch = OSSL_FUNC_signature_verify_batch(fns);
+            break;
         case OSSL_FUNC_SIGNATURE_VERIFY_RECOVER_INIT:
             if (signature->verify_recover_init != NULL)
                 break;
@@ -1022,6 +1032,59 @@ int EVP_PKEY_sign(EVP_PKEY_CTX *ctx,
     return ret;
 }
 
+int EVP_PKEY_sign_batch(EVP_PKEY_CTX *ctx, size_t num,
+    unsigned char **sigs, size_t *siglens,
+    const unsigned char **tbs, const size_t *tbslens)
+{
+    EVP_SIGNATURE *signature;
+    const char *desc;
+    size_t i;
+    int ret = 1;
+
+    if (ctx == NULL || (num > 0 && (sigs == NULL || siglens == NULL
+                                       || tbs == NULL || tbslens == NULL))) {
+        ERR_raise(ERR_LIB_EVP, ERR_R_PASSED_NULL_PARAMETER);
+        return -1;
+    }
+
+    if (ctx->operation != EVP_PKEY_OP_SIGN
+        && ctx->operation != EVP_PKEY_OP_SIGNMSG) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_INITIALIZED);
+        return -1;
+    }
+
+    if (ctx->op.sig.algctx == NULL) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_SUPPORTED_FOR_THIS_KEYTYPE);
+        return -2;
+    }
+
+    signature = ctx->op.sig.signature;
+    desc = signature->description != NULL ? signature->description : "";
+    if (signature->sign_batch != NULL) {
+        ret = signature->sign_batch(ctx->op.sig.algctx, num, sigs, siglens,
+            tbs, tbslens);
+    } else if (signature->sign != NULL) {
+        /* Providers without batch support sign one message at a time */
+        for (i = 0; i < num && ret > 0; i++) {
+            if (sigs[i] == NULL) {
+                ERR_raise(ERR_LIB_EVP, ERR_R_PASSED_NULL_PARAMETER);
+                return -1;
+            }
+            ret = signature->sign(ctx->op.sig.algctx, sigs[i], &siglens[i],
+                siglens[i], tbs[i], tbslens[i]);
+        }
+    } else {
+        ERR_raise_data(ERR_LIB_EVP, EVP_R_PROVIDER_SIGNATURE_NOT_SUPPORTED,
+            "%s sign:%s", signature->type_name, desc);
+        return -2;
+    }
+
+    if (ret <= 0)
+        ERR_raise_data(ERR_LIB_EVP, EVP_R_PROVIDER_SIGNATURE_FAILURE,
+            "%s sign:%s", signature->type_name, desc);
+    return ret;
+}
+
 int EVP_PKEY_verify_init(EVP_PKEY_CTX *ctx)
 {
     return evp_pkey_signature_init(ctx, NULL, EVP_PKEY_OP_VERIFY, NULL);
@@ -1170,6 +1233,66 @@ int EVP_PKEY_verify(EVP_PKEY_CTX *ctx,
     return ret;
 }
 
+int EVP_PKEY_verify_batch(EVP_PKEY_CTX *ctx, size_t num,
+    const unsigned char **sigs, const size_t *siglens,
+    const unsigned char **tbs, const size_t *tbslens,
+    int *results)
+{
+    EVP_SIGNATURE *signature;
+    const char *desc;
+    size_t i;
+    int ret = 1, r;
+
+    if (ctx == NULL || (num > 0 && (sigs == NULL || siglens == NULL
+                                       || tbs == NULL || tbslens == NULL))) {
+        ERR_raise(ERR_LIB_EVP, ERR_R_PASSED_NULL_PARAMETER);
+        return -1;
+    }
+
+    if (ctx->operation != EVP_PKEY_OP_VERIFY
+        && ctx->operation != EVP_PKEY_OP_VERIFYMSG) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_INITIALIZED);
+        return -1;
+    }
+
+    if (ctx->op.sig.algctx == NULL) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_SUPPORTED_FOR_THIS_KEYTYPE);
+        return -2;
+    }
+
+    signature = ctx->op.sig.signature;
+    desc = signature->description != NULL ? signature->description : "";
+    if (signature->verify_batch != NULL) {
+        ret = signature->verify_batch(ctx->op.sig.algctx, num, sigs, siglens,
+            tbs, tbslens, results);
+    } else if (signature->verify != NULL) {
+        /*
+         * Providers without batch support verify one signature at a time.
+         * Without |results| there is no need to go on after a failure.
+         */
+        for (i = 0; i < num; i++) {
+            r = signature->verify(ctx->op.sig.algctx, sigs[i], siglens[i],
+                tbs[i], tbslens[i]);
+            if (results != NULL)
+                results[i] = r > 0;
+            if (r <= 0) {
+                ret = 0;
+                if (results == NULL)
+                    break;
+            }
+        }
+    } else {
+        ERR_raise_data(ERR_LIB_EVP, EVP_R_PROVIDER_SIGNATURE_NOT_SUPPORTED,
+            "%s verify:%s", signature->type_name, desc);
+        return -2;
+    }
+
+    if (ret <= 0)
+        ERR_raise_data(ERR_LIB_EVP, EVP_R_PROVIDER_SIGNATURE_FAILURE,
+            "%s verify:%s", signature->type_name, desc);
+    return ret;
+}
+
 int EVP_PKEY_verify_recover_init(EVP_PKEY_CTX *ctx)
 {
     return evp_pkey_signature_init(ctx, NULL, EVP_PKEY_OP_VERIFYRECOVER, NULL);
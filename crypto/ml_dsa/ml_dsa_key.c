@@ -1,5 +1,5 @@
 /*
- * Copyright 2024-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2024-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -142,6 +142,116 @@ int ossl_ml_dsa_key_priv_alloc(ML_DSA_KEY *key)
     return 1;
 }
 
+static size_t precomputed_num_polys(const ML_DSA_PARAMS *params)
+{
+    return params->k * params->l + params->l + 2 * params->k;
+}
+
+static int precomputed_alloc(ML_DSA_KEY *key)
+{
+    size_t k = key->params->k, l = key->params->l;
+    POLY *poly;
+
+    if (key->a_ntt.m_poly != NULL)
+        return 0;
+    poly = OPENSSL_secure_malloc_array(precomputed_num_polys(key->params),
+        sizeof(*poly));
+    if (poly == NULL)
+        return 0;
+    matrix_init(&key->a_ntt, poly, k, l);
+    poly += k * l;
+    vector_init(&key->s1_ntt, poly, l);
+    vector_init(&key->s2_ntt, poly + l, k);
+    vector_init(&key->t0_ntt, poly + l + k, k);
+    return 1;
+}
+
+static void precomputed_free(ML_DSA_KEY *key)
+{
+    if (key->a_ntt.m_poly == NULL)
+        return;
+    OPENSSL_secure_clear_free(key->a_ntt.m_poly,
+        precomputed_num_polys(key->params) * sizeof(POLY));
+    matrix_init(&key->a_ntt, NULL, 0, 0);
+    vector_init(&key->s1_ntt, NULL, 0);
+    vector_init(&key->s2_ntt, NULL, 0);
+    vector_init(&key->t0_ntt, NULL, 0);
+}
+
+/**
+ * @brief Compute the values that signing derives from a private key, i.e. the
+ * matrix A expanded from rho, and the NTT of s1, s2 and t0.
+ *
+ * @param key A private ML_DSA_KEY
+ * @param md_ctx A scratch digest context
+ * @param a_ntt, s1_ntt, s2_ntt, t0_ntt The preallocated outputs
+ * @returns 1 on success, or 0 on failure.
+ */
+int ossl_ml_dsa_key_expand_private(const ML_DSA_KEY *key, EVP_MD_CTX *md_ctx,
+    MATRIX *a_ntt, VECTOR *s1_ntt, VECTOR *s2_ntt, VECTOR *t0_ntt)
+{
+    const OSSL_ML_DSA_SAMPLE_OPS *sample_ops = ossl_ml_dsa_sample_ops();
+
+    if (!sample_ops->matrix_expand_A(md_ctx, key->shake128_md, key->rho, a_ntt))
+        return 0;
+
+    vector_copy(s1_ntt, &key->s1);
+    vector_ntt(s1_ntt);
+    vector_copy(s2_ntt, &key->s2);
+    vector_ntt(s2_ntt);
+    vector_copy(t0_ntt, &key->t0);
+    vector_ntt(t0_ntt);
+    return 1;
+}
+
+/**
+ * @brief Bring the precomputed signing values of a key in line with its
+ * ML_DSA_KEY_PRECOMPUTE flag: compute them for a private key with the flag
+ * set, and free them otherwise.
+ *
+ * @returns 1 on success, or 0 on failure.
+ */
+int ossl_ml_dsa_key_precompute(ML_DSA_KEY *key)
+{
+    EVP_MD_CTX *md_ctx;
+    int ret;
+
+    if ((key->prov_flags & ML_DSA_KEY_PRECOMPUTE) == 0
+        || key->s1.poly == NULL) {
+        precomputed_free(key);
+        return 1;
+    }
+    if (key->a_ntt.m_poly != NULL)
+        return 1;
+
+    if ((md_ctx = EVP_MD_CTX_new()) == NULL)
+        return 0;
+    ret = precomputed_alloc(key)
+        && ossl_ml_dsa_key_expand_private(key, md_ctx, &key->a_ntt,
+            &key->s1_ntt, &key->s2_ntt, &key->t0_ntt);
+    EVP_MD_CTX_free(md_ctx);
+    if (!ret)
+        precomputed_free(key);
+    return ret;
+}
+
+/**
+ * @brief Select whether a key keeps its private part precomputed for signing.
+ * A private key is precomputed straight away, otherwise once it is loaded.
+ *
+ * @param key An ML_DSA_KEY object
+ * @param precompute 1 to precompute the private key, 0 to not do so
+ * @returns 1 on success, or 0 on failure.
+ */
+int ossl_ml_dsa_key_set_precompute(ML_DSA_KEY *key, int precompute)
+{
+    if (precompute)
+        key->prov_flags |= ML_DSA_KEY_PRECOMPUTE;
+    else
+        key->prov_flags &= ~ML_DSA_KEY_PRECOMPUTE;
+    return ossl_ml_dsa_key_precompute(key);
+}
+
 /**
  * @brief Destroy an ML_DSA_KEY object
  */
@@ -165,6 +275,7 @@ void ossl_ml_dsa_key_reset(ML_DSA_KEY *key)
      * The allocation for |s1.poly| subsumes those for |s2| and |t0|, which we
      * must not access after |s1|'s poly is freed.
      */
+    precomputed_free(key);
     if (key->s1.poly != NULL) {
         const ML_DSA_PARAMS *params = key->params;
         size_t k = params->k, l = params->l;
@@ -235,6 +346,13 @@ ML_DSA_KEY *ossl_ml_dsa_key_dup(const ML_DSA_KEY *src, int selection)
                         vector_copy(&ret->s1, &src->s1);
                         vector_copy(&ret->s2, &src->s2);
                         vector_copy(&ret->t0, &src->t0);
+                        if (src->a_ntt.m_poly != NULL) {
+                            if (!precomputed_alloc(ret))
+                                goto err;
+                            memcpy(ret->a_ntt.m_poly, src->a_ntt.m_poly,
+                                precomputed_num_polys(src->params)
+                                    * sizeof(POLY));
+                        }
                     }
                     ret->priv_encoding = OPENSSL_secure_malloc(src->params->sk_len);
                     if (ret->priv_encoding == NULL)
@@ -470,7 +588,8 @@ static int keygen_internal(ML_DSA_KEY *out)
         && ossl_ml_dsa_pk_encode(out)
         && shake_xof(md_ctx, out->shake256_md, out->pub_encoding, out->params->pk_len,
             out->tr, sizeof(out->tr))
-        && ossl_ml_dsa_sk_encode(out);
+        && ossl_ml_dsa_sk_encode(out)
+        && ossl_ml_dsa_key_precompute(out);
 
 err:
     EVP_MD_CTX_free(md_ctx);
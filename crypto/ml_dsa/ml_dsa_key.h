@@ -1,5 +1,5 @@
 /*
- * Copyright 2024-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2024-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -13,6 +13,7 @@
 #include <openssl/e_os2.h>
 #include "ml_dsa_local.h"
 #include "ml_dsa_vector.h"
+#include "ml_dsa_matrix.h"
 
 /* NOTE - any changes to this struct may require updates to ossl_ml_dsa_dup() */
 struct ml_dsa_key_st {
@@ -56,6 +57,21 @@ struct ml_dsa_key_st {
     VECTOR s2; /* private secret of size K with short coefficients (-4..4) or (-2..2) */
     VECTOR s1; /* private secret of size L with short coefficients (-4..4) or (-2..2) */
     /* The s1->poly block is allocated and has space for s2 and t0 also */
+
+    /*
+     * With the ML_DSA_KEY_PRECOMPUTE flag, a private key also holds what
+     * signing derives from it: the matrix A and s1, s2, t0 in NTT form.
+     * The a_ntt.m_poly block is then allocated and has space for s1_ntt,
+     * s2_ntt and t0_ntt also, otherwise it is NULL.
+     */
+    MATRIX a_ntt;
+    VECTOR s1_ntt;
+    VECTOR s2_ntt;
+    VECTOR t0_ntt;
 };
 
+int ossl_ml_dsa_key_expand_private(const ML_DSA_KEY *key, EVP_MD_CTX *md_ctx,
+    MATRIX *a_ntt, VECTOR *s1_ntt, VECTOR *s2_ntt, VECTOR *t0_ntt);
+int ossl_ml_dsa_key_precompute(ML_DSA_KEY *key);
+
 #endif /* !defined(OSSL_LIBCRYPTO_ML_DSA_ML_DSA_KEY_H) */
@@ -1,5 +1,5 @@
 /*
- * Copyright 2024-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2024-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -424,7 +424,7 @@ static const OSSL_ML_DSA_SAMPLE_OPS ml_dsa_sample_generic_meth = {
 #include "ml_dsa_sample_hw_x86_64.inc"
 const OSSL_ML_DSA_SAMPLE_OPS *ossl_ml_dsa_sample_ops(void)
 {
-    if (SHA3_avx512vl_capable())
+    if (ossl_sha3_shake_x4_capable())
         return &ml_dsa_sample_x86_64;
     return &ml_dsa_sample_generic_meth;
 }
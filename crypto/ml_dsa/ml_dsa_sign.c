@@ -15,6 +15,7 @@
 #include <openssl/proverr.h>
 #include "internal/common.h"
 #include "internal/constant_time.h"
+#include "internal/thread.h"
 #include "ml_dsa_local.h"
 #include "ml_dsa_key.h"
 #include "ml_dsa_matrix.h"
@@ -22,6 +23,7 @@
 #include "ml_dsa_hash.h"
 
 #define ML_DSA_MAX_LAMBDA 256 /* bit strength for ML-DSA-87 */
+#define ML_DSA_MAX_THREADS 8 /* concurrent iterations of the rejection loop */
 
 /*
  * @brief Initialize a Signature object by pointing all of its objects to
@@ -145,6 +147,221 @@ int ossl_ml_dsa_mu_finalize(EVP_MD_CTX *md_ctx, uint8_t *mu, size_t mu_len)
     return EVP_DigestSqueeze(md_ctx, mu, mu_len);
 }
 
+/*
+ * The inputs of the rejection loop of ML-DSA.Sign_internal(), which its
+ * iterations only read.
+ */
+typedef struct {
+    const ML_DSA_KEY *priv;
+    const uint8_t *mu;
+    size_t mu_len;
+    const uint8_t *rho_prime;
+    const MATRIX *a_ntt;
+    const VECTOR *s1_ntt, *s2_ntt, *t0_ntt;
+    size_t w1_encoded_len;
+} ML_DSA_SIGN_CTX;
+
+/*
+ * The scratch space of an iteration of the rejection loop, which holds the
+ * signature once the iteration accepts it.
+ */
+typedef struct {
+    const ML_DSA_SIGN_CTX *sctx;
+    EVP_MD_CTX *md_ctx;
+    POLY *c_ntt;
+    VECTOR w, w1, cs1, cs2, y;
+    ML_DSA_SIG sig;
+    uint8_t *w1_encoded;
+    uint8_t c_tilde[ML_DSA_MAX_LAMBDA / 4];
+    uint32_t kappa;
+    int result;
+} ML_DSA_SIGN_ATTEMPT;
+
+/* The number of polynomials in the scratch space of an iteration */
+static size_t sign_attempt_num_polys(const ML_DSA_PARAMS *params)
+{
+    return 1 + 5 * params->k + 2 * params->l;
+}
+
+static int sign_attempt_init(ML_DSA_SIGN_ATTEMPT *t, const ML_DSA_SIGN_CTX *sctx,
+    POLY *p, uint8_t *w1_encoded)
+{
+    const ML_DSA_PARAMS *params = sctx->priv->params;
+    uint32_t k = (uint32_t)params->k, l = (uint32_t)params->l;
+
+    t->sctx = sctx;
+    t->w1_encoded = w1_encoded;
+    t->c_ntt = p++;
+    vector_init(&t->w, p, k);
+    vector_init(&t->w1, t->w.poly + k, k);
+    vector_init(&t->cs2, t->w1.poly + k, k);
+    p += 3 * k;
+    vector_init(&t->y, p, l);
+    vector_init(&t->cs1, p + l, l);
+    p += 2 * l;
+    signature_init(&t->sig, p, k, p + k, l, t->c_tilde,
+        params->bit_strength >> 2);
+    return (t->md_ctx = EVP_MD_CTX_new()) != NULL;
+}
+
+/*
+ * @brief An iteration of the rejection loop of FIPS 204, Algorithm 7, which
+ * signs with the mask of counter |kappa|.
+ *
+ * Iterations only depend on their counter, so they can be run in any order
+ * and concurrently, see sign_attempts().
+ *
+ * @returns 1 if the signature is accepted, 0 if it is rejected, or -1 on error.
+ */
+static int sign_attempt(ML_DSA_SIGN_ATTEMPT *t, uint32_t kappa)
+{
+    const ML_DSA_SIGN_CTX *sctx = t->sctx;
+    const ML_DSA_KEY *priv = sctx->priv;
+    const ML_DSA_PARAMS *params = priv->params;
+    const OSSL_ML_DSA_SAMPLE_OPS *sample_ops = ossl_ml_dsa_sample_ops();
+    uint32_t gamma1 = params->gamma1, gamma2 = params->gamma2;
+    size_t c_tilde_len = t->sig.c_tilde_len;
+    VECTOR *y_ntt = &t->cs1;
+    VECTOR *r0 = &t->w1;
+    VECTOR *ct0 = &t->w1;
+    uint32_t z_max, r0_max, ct0_max, h_ones;
+
+    sample_ops->vector_expand_mask(&t->y, sctx->rho_prime,
+        kappa, gamma1, t->md_ctx, priv->shake256_md);
+    vector_copy(y_ntt, &t->y);
+    vector_ntt(y_ntt);
+
+    matrix_mult_vector(sctx->a_ntt, y_ntt, &t->w);
+    vector_ntt_inverse(&t->w);
+
+    vector_high_bits(&t->w, gamma2, &t->w1);
+    ossl_ml_dsa_w1_encode(&t->w1, gamma2, t->w1_encoded, sctx->w1_encoded_len);
+
+    if (!shake_xof_2(t->md_ctx, priv->shake256_md, sctx->mu, sctx->mu_len,
+            t->w1_encoded, sctx->w1_encoded_len, t->c_tilde, c_tilde_len))
+        return -1;
+
+    if (!poly_sample_in_ball_ntt(t->c_ntt, t->c_tilde, (int)c_tilde_len,
+            t->md_ctx, priv->shake256_md, params->tau))
+        return -1;
+
+    vector_mult_scalar(sctx->s1_ntt, t->c_ntt, &t->cs1);
+    vector_ntt_inverse(&t->cs1);
+    vector_mult_scalar(sctx->s2_ntt, t->c_ntt, &t->cs2);
+    vector_ntt_inverse(&t->cs2);
+
+    vector_add(&t->y, &t->cs1, &t->sig.z);
+
+    /* r0 = lowbits(w - cs2) */
+    vector_sub(&t->w, &t->cs2, r0);
+    vector_low_bits(r0, gamma2, r0);
+
+    /*
+     * Leaking that the signature is rejected is fine: the next attempt
+     * is (indistinguishable from) independent of this one, so an
+     * observer learns nothing about the secret key beyond the number of
+     * iterations, which is itself safe to reveal.
+     * Declassify the bound-check output so that Valgrind does not flag
+     * these intentional leaks.
+     */
+    z_max = vector_max(&t->sig.z);
+    r0_max = vector_max_signed(r0);
+    if (constant_time_declassify_u32(
+            constant_time_ge(z_max, gamma1 - params->beta)
+            | constant_time_ge(r0_max, gamma2 - params->beta)))
+        return 0;
+
+    vector_mult_scalar(sctx->t0_ntt, t->c_ntt, ct0);
+    vector_ntt_inverse(ct0);
+    vector_make_hint(ct0, &t->cs2, &t->w, gamma2, &t->sig.hint);
+
+    ct0_max = vector_max(ct0);
+    h_ones = (uint32_t)vector_count_ones(&t->sig.hint);
+    /* Same reasoning applies to the leak as above */
+    if (constant_time_declassify_u32(
+            constant_time_ge(ct0_max, gamma2)
+            | constant_time_lt(params->omega, h_ones)))
+        return 0;
+
+    /*
+     * The iteration has passed both rejection tests: the signature is
+     * accepted.  Declassify all three public outputs before encoding.
+     *
+     * sig.z and sig.hint were computed from secret key material (s1,
+     * s2, t0) and carry taint, but the rejection checks above have
+     * verified they lie within the ranges required by the security
+     * proof, so they reveal nothing about the key.
+     *
+     * c_tilde = H(mu || w1) carries taint that propagated from the
+     * secret rho_prime through y → w → w1.  It is the Fiat-Shamir
+     * challenge commitment and is published as part of the signature.
+     * We defer its declassification to here (rather than immediately
+     * after the SHAKE call) so that Valgrind can check that
+     * poly_sample_in_ball_ntt and the NTT challenge arithmetic are
+     * data-oblivious with respect to their tainted inputs.
+     */
+    CONSTTIME_DECLASSIFY(t->c_tilde, c_tilde_len);
+    CONSTTIME_DECLASSIFY_VECTOR(t->sig.z);
+    CONSTTIME_DECLASSIFY_VECTOR(t->sig.hint);
+    return 1;
+}
+
+static CRYPTO_THREAD_RETVAL sign_attempt_thread(void *arg)
+{
+    ML_DSA_SIGN_ATTEMPT *t = arg;
+
+    t->result = sign_attempt(t, t->kappa);
+    return 0;
+}
+
+/*
+ * @brief Run the rejection loop with |n| iterations at a time, one on the
+ * calling thread and the others on the thread pool of the library context.
+ *
+ * The accepted signature is that of the first iteration in counter order
+ * that accepts, whichever thread finishes first, so it is the same as that
+ * of the serial loop.
+ *
+ * @returns the accepted attempt, or NULL on error.
+ */
+static ML_DSA_SIGN_ATTEMPT *sign_attempts(ML_DSA_SIGN_ATTEMPT *t, uint32_t n)
+{
+    OSSL_LIB_CTX *libctx = t->sctx->priv->libctx;
+    uint32_t l = (uint32_t)t->sctx->priv->params->l;
+    void *threads[ML_DSA_MAX_THREADS];
+    uint32_t kappa, i;
+
+    /*
+     * kappa must not exceed 2^16. But the probability of it
+     * exceeding even 1000 iterations is vanishingly small.
+     */
+    for (kappa = 0;; kappa += n * l) {
+        for (i = 1; i < n; i++) {
+            t[i].kappa = kappa + i * l;
+            threads[i] = ossl_crypto_thread_start(libctx, sign_attempt_thread,
+                &t[i]);
+        }
+        t[0].result = sign_attempt(&t[0], kappa);
+
+        for (i = 1; i < n; i++) {
+            /* Do the iterations of threads that could not be started here */
+            if (threads[i] == NULL) {
+                t[i].result = sign_attempt(&t[i], t[i].kappa);
+                continue;
+            }
+            if (!ossl_crypto_thread_join(threads[i], NULL))
+                t[i].result = -1;
+            ossl_crypto_thread_clean(threads[i]);
+        }
+        for (i = 0; i < n; i++) {
+            if (t[i].result == 1)
+                return &t[i];
+            if (t[i].result != 0)
+                return NULL;
+        }
+    }
+}
+
 /*
  * @brief FIPS 204, Algorithm 7, ML-DSA.Sign_internal()
  *
@@ -156,49 +373,62 @@ int ossl_ml_dsa_mu_finalize(EVP_MD_CTX *md_ctx, uint8_t *mu, size_t mu_len)
  * @param mu_len: The length of the mu buffer
  * @param rnd: The random buffer
  * @param rnd_len: The length of the random buffer
+ * @param threads: The maximum number of threads to run the rejection loop on
  * @param out_sig: The output signature buffer
  * @returns 1 on success, 0 on error
  */
 static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
     const uint8_t *mu, size_t mu_len, const uint8_t *rnd, size_t rnd_len,
-    uint8_t *out_sig)
+    uint32_t threads, uint8_t *out_sig)
 {
     int ret = 0;
-    const OSSL_ML_DSA_SAMPLE_OPS *sample_ops = ossl_ml_dsa_sample_ops();
     const ML_DSA_PARAMS *params = priv->params;
     EVP_MD_CTX *md_ctx = NULL;
     uint32_t k = (uint32_t)params->k, l = (uint32_t)params->l;
-    uint32_t gamma1 = params->gamma1, gamma2 = params->gamma2;
+    uint32_t gamma2 = params->gamma2;
     uint8_t *alloc = NULL, *w1_encoded = NULL;
     void *alloc_freeptr = NULL;
     size_t alloc_len, w1_encoded_len;
-    size_t num_polys_sig_k = 2 * k;
-    size_t num_polys_k = 5 * k;
-    size_t num_polys_l = 3 * l;
-    size_t num_polys_k_by_l = k * l;
+    size_t num_polys_attempt = sign_attempt_num_polys(params);
+    size_t num_polys_priv = 0;
     size_t poly_count;
-    POLY *p, *c_ntt;
-    VECTOR s1_ntt, s2_ntt, t0_ntt, w, w1, cs1, cs2, y;
+    uint32_t i, num_attempts = 0;
+    uint64_t avail;
+    POLY *p;
+    VECTOR s1_ntt, s2_ntt, t0_ntt;
     MATRIX a_ntt;
-    ML_DSA_SIG sig;
+    ML_DSA_SIGN_CTX sctx;
+    ML_DSA_SIGN_ATTEMPT attempts[ML_DSA_MAX_THREADS], *accepted;
     uint8_t rho_prime[ML_DSA_RHO_PRIME_BYTES];
-    uint8_t c_tilde[ML_DSA_MAX_LAMBDA / 4];
-    size_t c_tilde_len = params->bit_strength >> 2;
-    size_t kappa;
 
     if (mu_len != ML_DSA_MU_BYTES) {
         ERR_raise(ERR_LIB_PROV, PROV_R_BAD_LENGTH);
         return 0;
     }
 
-    /* Allocate w1_encoded buffer */
+    /* Run iterations concurrently only when the thread pool allows it */
+    if (threads > ML_DSA_MAX_THREADS)
+        threads = ML_DSA_MAX_THREADS;
+    if (threads > 1) {
+        avail = ossl_get_avail_threads(priv->libctx);
+        if (avail < threads - 1)
+            threads = (uint32_t)avail + 1;
+    }
+    if (threads == 0)
+        threads = 1;
+
+    /* Allocate the w1_encoded buffers */
     w1_encoded_len = k * (gamma2 == ML_DSA_GAMMA2_Q_MINUS1_DIV88 ? 192 : 128);
-    w1_encoded = OPENSSL_malloc(w1_encoded_len);
+    w1_encoded = OPENSSL_malloc_array(threads, w1_encoded_len);
     if (w1_encoded == NULL)
         return 0;
 
+    /* A and the NTT of s1, s2 and t0 are derived here, unless precomputed */
+    if (priv->a_ntt.m_poly == NULL)
+        num_polys_priv = k * l + l + 2 * k;
+
     /* Allocate aligned POLY array */
-    poly_count = 1 + num_polys_k + num_polys_l + num_polys_k_by_l + num_polys_sig_k;
+    poly_count = threads * num_polys_attempt + num_polys_priv;
     alloc_len = sizeof(*p) * poly_count;
     alloc = OPENSSL_aligned_alloc(alloc_len, 16, &alloc_freeptr);
     if (alloc == NULL)
@@ -208,22 +438,39 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
     if (md_ctx == NULL)
         goto err;
 
+    sctx.priv = priv;
+    sctx.mu = mu;
+    sctx.mu_len = mu_len;
+    sctx.rho_prime = rho_prime;
+    sctx.a_ntt = &a_ntt;
+    sctx.s1_ntt = &s1_ntt;
+    sctx.s2_ntt = &s2_ntt;
+    sctx.t0_ntt = &t0_ntt;
+    sctx.w1_encoded_len = w1_encoded_len;
+
     /* Init the temp vectors to point to the aligned polys blob */
     p = (POLY *)alloc;
-    c_ntt = p++;
-    matrix_init(&a_ntt, p, k, l);
-    p += num_polys_k_by_l;
-    vector_init(&s2_ntt, p, k);
-    vector_init(&t0_ntt, s2_ntt.poly + k, k);
-    vector_init(&w, t0_ntt.poly + k, k);
-    vector_init(&w1, w.poly + k, k);
-    vector_init(&cs2, w1.poly + k, k);
-    p += num_polys_k;
-    vector_init(&s1_ntt, p, l);
-    vector_init(&y, p + l, l);
-    vector_init(&cs1, p + 2 * l, l);
-    p += num_polys_l;
-    signature_init(&sig, p, k, p + k, l, c_tilde, c_tilde_len);
+    for (num_attempts = 0; num_attempts < threads; num_attempts++) {
+        if (!sign_attempt_init(&attempts[num_attempts], &sctx, p,
+                w1_encoded + num_attempts * w1_encoded_len)) {
+            num_attempts++;
+            goto err;
+        }
+        p += num_polys_attempt;
+    }
+    if (num_polys_priv != 0) {
+        matrix_init(&a_ntt, p, k, l);
+        p += k * l;
+        vector_init(&s1_ntt, p, l);
+        vector_init(&s2_ntt, p + l, k);
+        vector_init(&t0_ntt, p + l + k, k);
+    } else {
+        /* These are not modified below */
+        a_ntt = priv->a_ntt;
+        s1_ntt = priv->s1_ntt;
+        s2_ntt = priv->s2_ntt;
+        t0_ntt = priv->t0_ntt;
+    }
     /* End of the allocated blob setup */
 
     /*
@@ -236,9 +483,9 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
     CONSTTIME_SECRET_VECTOR(priv->s1);
     CONSTTIME_SECRET_VECTOR(priv->s2);
     CONSTTIME_SECRET_VECTOR(priv->t0);
-
-    if (!sample_ops->matrix_expand_A(md_ctx, priv->shake128_md, priv->rho, &a_ntt))
-        goto err;
+    CONSTTIME_SECRET_VECTOR(priv->s1_ntt);
+    CONSTTIME_SECRET_VECTOR(priv->s2_ntt);
+    CONSTTIME_SECRET_VECTOR(priv->t0_ntt);
 
     /*
      * rho_prime is derived from the secret K and must remain tainted
@@ -251,106 +498,32 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
             rho_prime, sizeof(rho_prime)))
         goto err;
 
-    vector_copy(&s1_ntt, &priv->s1);
-    vector_ntt(&s1_ntt);
-    vector_copy(&s2_ntt, &priv->s2);
-    vector_ntt(&s2_ntt);
-    vector_copy(&t0_ntt, &priv->t0);
-    vector_ntt(&t0_ntt);
-
-    /*
-     * kappa must not exceed 2^16. But the probability of it
-     * exceeding even 1000 iterations is vanishingly small.
-     */
-    for (kappa = 0;; kappa += l) {
-        VECTOR *y_ntt = &cs1;
-        VECTOR *r0 = &w1;
-        VECTOR *ct0 = &w1;
-        uint32_t z_max, r0_max, ct0_max, h_ones;
-
-        sample_ops->vector_expand_mask(&y, rho_prime,
-            (uint32_t)kappa, gamma1, md_ctx, priv->shake256_md);
-        vector_copy(y_ntt, &y);
-        vector_ntt(y_ntt);
-
-        matrix_mult_vector(&a_ntt, y_ntt, &w);
-        vector_ntt_inverse(&w);
-
-        vector_high_bits(&w, gamma2, &w1);
-        ossl_ml_dsa_w1_encode(&w1, gamma2, w1_encoded, w1_encoded_len);
-
-        if (!shake_xof_2(md_ctx, priv->shake256_md, mu, mu_len,
-                w1_encoded, w1_encoded_len, c_tilde, c_tilde_len))
-            break;
-
-        if (!poly_sample_in_ball_ntt(c_ntt, c_tilde, (int)c_tilde_len,
-                md_ctx, priv->shake256_md, params->tau))
-            break;
-
-        vector_mult_scalar(&s1_ntt, c_ntt, &cs1);
-        vector_ntt_inverse(&cs1);
-        vector_mult_scalar(&s2_ntt, c_ntt, &cs2);
-        vector_ntt_inverse(&cs2);
-
-        vector_add(&y, &cs1, &sig.z);
-
-        /* r0 = lowbits(w - cs2) */
-        vector_sub(&w, &cs2, r0);
-        vector_low_bits(r0, gamma2, r0);
+    if (num_polys_priv != 0
+        && !ossl_ml_dsa_key_expand_private(priv, md_ctx,
+            &a_ntt, &s1_ntt, &s2_ntt, &t0_ntt))
+        goto err;
 
-        /*
-         * Leaking that the signature is rejected is fine: the next attempt
-         * is (indistinguishable from) independent of this one, so an
-         * observer learns nothing about the secret key beyond the number of
-         * iterations, which is itself safe to reveal.
-         * Declassify the bound-check output so that Valgrind does not flag
-         * these intentional leaks.
-         */
-        z_max = vector_max(&sig.z);
-        r0_max = vector_max_signed(r0);
-        if (constant_time_declassify_u32(
-                constant_time_ge(z_max, gamma1 - params->beta)
-                | constant_time_ge(r0_max, gamma2 - params->beta)))
-            continue;
-
-        vector_mult_scalar(&t0_ntt, c_ntt, ct0);
-        vector_ntt_inverse(ct0);
-        vector_make_hint(ct0, &cs2, &w, gamma2, &sig.hint);
-
-        ct0_max = vector_max(ct0);
-        h_ones = (uint32_t)vector_count_ones(&sig.hint);
-        /* Same reasoning applies to the leak as above */
-        if (constant_time_declassify_u32(
-                constant_time_ge(ct0_max, gamma2)
-                | constant_time_lt(params->omega, h_ones)))
-            continue;
+    if (threads > 1) {
+        accepted = sign_attempts(attempts, threads);
+    } else {
+        uint32_t kappa;
 
         /*
-         * The iteration has passed both rejection tests: the signature is
-         * accepted.  Declassify all three public outputs before encoding.
-         *
-         * sig.z and sig.hint were computed from secret key material (s1,
-         * s2, t0) and carry taint, but the rejection checks above have
-         * verified they lie within the ranges required by the security
-         * proof, so they reveal nothing about the key.
-         *
-         * c_tilde = H(mu || w1) carries taint that propagated from the
-         * secret rho_prime through y → w → w1.  It is the Fiat-Shamir
-         * challenge commitment and is published as part of the signature.
-         * We defer its declassification to here (rather than immediately
-         * after the SHAKE call) so that Valgrind can check that
-         * poly_sample_in_ball_ntt and the NTT challenge arithmetic are
-         * data-oblivious with respect to their tainted inputs.
+         * kappa must not exceed 2^16. But the probability of it
+         * exceeding even 1000 iterations is vanishingly small.
          */
-        CONSTTIME_DECLASSIFY(c_tilde, c_tilde_len);
-        CONSTTIME_DECLASSIFY_VECTOR(sig.z);
-        CONSTTIME_DECLASSIFY_VECTOR(sig.hint);
-
-        ret = ossl_ml_dsa_sig_encode(&sig, params, out_sig);
-        break;
+        for (kappa = 0;; kappa += l)
+            if ((attempts[0].result = sign_attempt(&attempts[0], kappa)) != 0)
+                break;
+        accepted = attempts[0].result == 1 ? &attempts[0] : NULL;
     }
+    if (accepted != NULL)
+        ret = ossl_ml_dsa_sig_encode(&accepted->sig, params, out_sig);
+
 err:
     EVP_MD_CTX_free(md_ctx);
+    for (i = 0; i < num_attempts; i++)
+        EVP_MD_CTX_free(attempts[i].md_ctx);
     if (alloc_freeptr != NULL) {
         /* Clear the actual sensitive buffer */
         if (alloc != NULL)
@@ -358,7 +531,7 @@ err:
         OPENSSL_free(alloc_freeptr);
     }
     if (w1_encoded != NULL)
-        OPENSSL_clear_free(w1_encoded, w1_encoded_len);
+        OPENSSL_clear_free(w1_encoded, threads * w1_encoded_len);
     OPENSSL_cleanse(rho_prime, sizeof(rho_prime));
     /*
      * Declassify the private key material before returning.  The key struct
@@ -371,6 +544,9 @@ err:
     CONSTTIME_DECLASSIFY_VECTOR(priv->s1);
     CONSTTIME_DECLASSIFY_VECTOR(priv->s2);
     CONSTTIME_DECLASSIFY_VECTOR(priv->t0);
+    CONSTTIME_DECLASSIFY_VECTOR(priv->s1_ntt);
+    CONSTTIME_DECLASSIFY_VECTOR(priv->s2_ntt);
+    CONSTTIME_DECLASSIFY_VECTOR(priv->t0_ntt);
     return ret;
 }
 
@@ -500,7 +676,7 @@ err:
 int ossl_ml_dsa_sign(const ML_DSA_KEY *priv,
     int msg_is_mu, const uint8_t *msg, size_t msg_len,
     const uint8_t *context, size_t context_len,
-    const uint8_t *rand, size_t rand_len, int encode,
+    const uint8_t *rand, size_t rand_len, int encode, uint32_t threads,
     unsigned char *sig, size_t *sig_len, size_t sig_size)
 {
     EVP_MD_CTX *md_ctx = NULL;
@@ -536,7 +712,8 @@ int ossl_ml_dsa_sign(const ML_DSA_KEY *priv,
             goto err;
     }
 
-    ret = ml_dsa_sign_internal(priv, mu_ptr, mu_len, rand, rand_len, sig);
+    ret = ml_dsa_sign_internal(priv, mu_ptr, mu_len, rand, rand_len, threads,
+        sig);
 
 err:
     EVP_MD_CTX_free(md_ctx);
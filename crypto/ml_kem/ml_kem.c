@@ -14,6 +14,7 @@
 #include "internal/common.h"
 #include "internal/constant_time.h"
 #include "internal/sha3.h"
+#include "ml_kem_local.h"
 
 #if ML_KEM_SEED_BYTES != ML_KEM_SHARED_SECRET_BYTES + ML_KEM_RANDOM_BYTES
 #error "ML-KEM keygen seed length != shared secret + random bytes length"
@@ -376,54 +377,126 @@ static __owur int kdf(uint8_t out[ML_KEM_SHARED_SECRET_BYTES],
  * uniformly distributed elements in the range [0,q). This is used for matrix
  * expansion and only operates on public inputs.
  */
-static __owur int sample_scalar(scalar *out, EVP_MD_CTX *mdctx)
+static uint16_t *sample_block(uint16_t *curr, const uint16_t *endout,
+    const uint8_t *in, const uint8_t *endin)
 {
-    uint16_t *curr = out->c, *endout = curr + DEGREE;
-    uint8_t buf[SCALAR_SAMPLING_BUFSIZE], *in;
-    uint8_t *endin = buf + sizeof(buf);
     uint16_t d;
     uint8_t b1, b2, b3;
 
     do {
-        if (!EVP_DigestSqueeze(mdctx, in = buf, sizeof(buf)))
+        b1 = *in++;
+        b2 = *in++;
+        b3 = *in++;
+
+        if (curr >= endout)
+            break;
+        if ((d = ((b2 & 0x0f) << 8) + b1) < kPrime)
+            *curr++ = d;
+        if (curr >= endout)
+            break;
+        if ((d = (b3 << 4) + (b2 >> 4)) < kPrime)
+            *curr++ = d;
+    } while (in < endin);
+    return curr;
+}
+
+static __owur int sample_scalar(scalar *out, EVP_MD_CTX *mdctx)
+{
+    uint16_t *curr = out->c, *endout = curr + DEGREE;
+    uint8_t buf[SCALAR_SAMPLING_BUFSIZE];
+
+    do {
+        if (!EVP_DigestSqueeze(mdctx, buf, sizeof(buf)))
             return 0;
-        do {
-            b1 = *in++;
-            b2 = *in++;
-            b3 = *in++;
-
-            if (curr >= endout)
-                break;
-            if ((d = ((b2 & 0x0f) << 8) + b1) < kPrime)
-                *curr++ = d;
-            if (curr >= endout)
-                break;
-            if ((d = (b3 << 4) + (b2 >> 4)) < kPrime)
-                *curr++ = d;
-        } while (in < endin);
+        curr = sample_block(curr, endout, buf, buf + sizeof(buf));
     } while (curr < endout);
     return 1;
 }
 
+/*
+ * As above, for four scalars at once, from the streams of a 4-way SHAKE128
+ * that has absorbed their seeds.  Streams whose scalar is complete, or which
+ * have no scalar at all, are squeezed along with the others and ignored.
+ */
+static void sample_scalar_x4(scalar *out[4], KECCAK1600_X4_CTX *ctx)
+{
+    uint16_t *curr[4], *endout[4];
+    uint8_t buf[4][SHAKE128_BLOCKSIZE];
+    int i, done;
+
+    for (i = 0; i < 4; i++) {
+        curr[i] = endout[i] = NULL;
+        if (out[i] != NULL) {
+            curr[i] = out[i]->c;
+            endout[i] = curr[i] + DEGREE;
+        }
+    }
+
+    do {
+        ossl_sha3_shake_x4_squeeze(ctx, buf[0], buf[1], buf[2], buf[3],
+            sizeof(buf[0]));
+        done = 1;
+        for (i = 0; i < 4; i++) {
+            if (curr[i] < endout[i])
+                curr[i] = sample_block(curr[i], endout[i],
+                    buf[i], buf[i] + sizeof(buf[i]));
+            done &= curr[i] >= endout[i];
+        }
+    } while (!done);
+}
+
 static CRYPTO_ONCE ml_kem_ntt_once = CRYPTO_ONCE_STATIC_INIT;
 
 #if defined(_ARCH_PPC64)
 #include "arch/ppc_arch.h"
 #endif
 
-#if defined(MLKEM_NTT_PPC_ASM) && defined(_ARCH_PPC64)
+#if (defined(MLKEM_NTT_PPC_ASM) && defined(_ARCH_PPC64)) \
+    || ML_KEM_AVX2_ELIGIBLE || ML_KEM_NEON_ELIGIBLE
 /*
- * PPC64LE Platform supports.
+ * Platform specific implementations, selected by ml_kem_ntt_init().
  */
 typedef void (*ml_kem_scalar_ntt_fn)(scalar *p);
 typedef void (*ml_kem_scalar_inverse_ntt_fn)(scalar *p);
+typedef void (*ml_kem_scalar_mult_fn)(scalar *out, const scalar *lhs,
+    const scalar *rhs);
+typedef void (*ml_kem_scalar_compress_fn)(scalar *s, int bits);
+typedef void (*ml_kem_scalar_cbd_fn)(scalar *out, const uint8_t *in);
 
 static void scalar_ntt_generic(scalar *p);
 static void scalar_inverse_ntt_generic(scalar *p);
+static void scalar_mult_generic(scalar *out, const scalar *lhs,
+    const scalar *rhs);
+static void scalar_mult_add_generic(scalar *out, const scalar *lhs,
+    const scalar *rhs);
+static void scalar_compress_generic(scalar *s, int bits);
+static void scalar_decompress_generic(scalar *s, int bits);
+static void scalar_cbd_2_generic(scalar *out, const uint8_t *in);
+static void scalar_cbd_3_generic(scalar *out, const uint8_t *in);
 
 static ml_kem_scalar_ntt_fn scalar_ntt = scalar_ntt_generic;
 static ml_kem_scalar_inverse_ntt_fn scalar_inverse_ntt = scalar_inverse_ntt_generic;
+static ml_kem_scalar_mult_fn scalar_mult = scalar_mult_generic;
+static ml_kem_scalar_mult_fn scalar_mult_add = scalar_mult_add_generic;
+static ml_kem_scalar_compress_fn scalar_compress = scalar_compress_generic;
+static ml_kem_scalar_compress_fn scalar_decompress = scalar_decompress_generic;
+static ml_kem_scalar_cbd_fn scalar_cbd_2 = scalar_cbd_2_generic;
+static ml_kem_scalar_cbd_fn scalar_cbd_3 = scalar_cbd_3_generic;
+#else
+#define scalar_ntt_generic scalar_ntt
+#define scalar_inverse_ntt_generic scalar_inverse_ntt
+#define scalar_mult_generic scalar_mult
+#define scalar_mult_add_generic scalar_mult_add
+#define scalar_compress_generic scalar_compress
+#define scalar_decompress_generic scalar_decompress
+#define scalar_cbd_2_generic scalar_cbd_2
+#define scalar_cbd_3_generic scalar_cbd_3
+#endif
 
+#if defined(MLKEM_NTT_PPC_ASM) && defined(_ARCH_PPC64)
+/*
+ * PPC64LE Platform supports.
+ */
 void mlkem_ntt_ppc(uint16_t *c);
 void mlkem_inverse_ntt_ppc(uint16_t *c);
 
@@ -436,14 +509,71 @@ static void scalar_inverse_ntt_ppc(scalar *s)
 {
     mlkem_inverse_ntt_ppc(s->c);
 }
-#else
-#define scalar_ntt_generic scalar_ntt
-#define scalar_inverse_ntt_generic scalar_inverse_ntt
 #endif
 
 /*
- * Initialize NTT function pointers to PPC64le implementations if available.
- * Scalar implementations are used by default.
+ * The x86_64 AVX2 and AArch64 NEON implementations of ml_kem_avx2.c and
+ * ml_kem_neon.c, which work on the coefficients of a scalar.
+ */
+#define DEFINE_ML_KEM_SCALAR_FUNCTIONS(arch)                               \
+    static void scalar_ntt_##arch(scalar *s)                               \
+    {                                                                      \
+        ossl_ml_kem_ntt_##arch(s->c);                                      \
+    }                                                                      \
+    static void scalar_inverse_ntt_##arch(scalar *s)                       \
+    {                                                                      \
+        ossl_ml_kem_inverse_ntt_##arch(s->c);                              \
+    }                                                                      \
+    static void scalar_mult_##arch(scalar *out, const scalar *lhs,         \
+        const scalar *rhs)                                                 \
+    {                                                                      \
+        ossl_ml_kem_mult_##arch(out->c, lhs->c, rhs->c);                   \
+    }                                                                      \
+    static void scalar_mult_add_##arch(scalar *out, const scalar *lhs,     \
+        const scalar *rhs)                                                 \
+    {                                                                      \
+        ossl_ml_kem_mult_add_##arch(out->c, lhs->c, rhs->c);               \
+    }                                                                      \
+    static void scalar_compress_##arch(scalar *s, int bits)                \
+    {                                                                      \
+        ossl_ml_kem_compress_##arch(s->c, bits);                           \
+    }                                                                      \
+    static void scalar_decompress_##arch(scalar *s, int bits)              \
+    {                                                                      \
+        ossl_ml_kem_decompress_##arch(s->c, bits);                         \
+    }                                                                      \
+    static void scalar_cbd_2_##arch(scalar *out, const uint8_t *in)        \
+    {                                                                      \
+        ossl_ml_kem_cbd_2_##arch(out->c, in);                              \
+    }                                                                      \
+    static void scalar_cbd_3_##arch(scalar *out, const uint8_t *in)        \
+    {                                                                      \
+        ossl_ml_kem_cbd_3_##arch(out->c, in);                              \
+    }
+
+#define USE_ML_KEM_SCALAR_FUNCTIONS(arch)               \
+    do {                                                \
+        scalar_ntt = scalar_ntt_##arch;                 \
+        scalar_inverse_ntt = scalar_inverse_ntt_##arch; \
+        scalar_mult = scalar_mult_##arch;               \
+        scalar_mult_add = scalar_mult_add_##arch;       \
+        scalar_compress = scalar_compress_##arch;       \
+        scalar_decompress = scalar_decompress_##arch;   \
+        scalar_cbd_2 = scalar_cbd_2_##arch;             \
+        scalar_cbd_3 = scalar_cbd_3_##arch;             \
+    } while (0)
+
+#if ML_KEM_AVX2_ELIGIBLE
+DEFINE_ML_KEM_SCALAR_FUNCTIONS(avx2)
+#endif
+#if ML_KEM_NEON_ELIGIBLE
+DEFINE_ML_KEM_SCALAR_FUNCTIONS(neon)
+#endif
+
+/*
+ * Initialize the function pointers to the PPC64le NTT, or the AVX2 or NEON
+ * polynomial arithmetic, if available.  Scalar implementations are used by
+ * default.
  */
 static void ml_kem_ntt_init(void)
 {
@@ -455,6 +585,14 @@ static void ml_kem_ntt_init(void)
     }
 #endif
 #endif
+#if ML_KEM_AVX2_ELIGIBLE
+    if (ossl_ml_kem_avx2_capable())
+        USE_ML_KEM_SCALAR_FUNCTIONS(avx2);
+#endif
+#if ML_KEM_NEON_ELIGIBLE
+    if (ossl_ml_kem_neon_capable())
+        USE_ML_KEM_SCALAR_FUNCTIONS(neon);
+#endif
 }
 
 /*-
@@ -593,7 +731,7 @@ static void scalar_sub(scalar *lhs, const scalar *rhs)
  * two reduced numbers together, so we need some intermediate reduction steps,
  * even if an uint64_t could hold 3 multiplied numbers.
  */
-static void scalar_mult(scalar *out, const scalar *lhs,
+static void scalar_mult_generic(scalar *out, const scalar *lhs,
     const scalar *rhs)
 {
     uint16_t *curr = out->c, *end = curr + DEGREE;
@@ -611,7 +749,7 @@ static void scalar_mult(scalar *out, const scalar *lhs,
 }
 
 /* Above, but add the result to an existing scalar */
-static ossl_inline void scalar_mult_add(scalar *out, const scalar *lhs,
+static void scalar_mult_add_generic(scalar *out, const scalar *lhs,
     const scalar *rhs)
 {
     uint16_t *curr = out->c, *end = curr + DEGREE;
@@ -849,7 +987,7 @@ static __owur uint16_t decompress(uint16_t x, int bits)
  * FIPS 203, Section 4.2.1, Equation (4.7): "Compress_d".
  * In-place lossy rounding of scalars to 2^d bits.
  */
-static void scalar_compress(scalar *s, int bits)
+static void scalar_compress_generic(scalar *s, int bits)
 {
     int i;
 
@@ -861,7 +999,7 @@ static void scalar_compress(scalar *s, int bits)
  * FIPS 203, Section 4.2.1, Equation (4.8): "Decompress_d".
  * In-place approximate recovery of scalars from 2^d bit compression.
  */
-static void scalar_decompress(scalar *s, int bits)
+static void scalar_decompress_generic(scalar *s, int bits)
 {
     int i;
 
@@ -978,6 +1116,37 @@ matrix_mult_transpose_add(scalar *out, const scalar *m, const scalar *a, int ran
  *
  * Where FIPS 203 computes t = A * s + e, we use the transpose of "m".
  */
+/*
+ * matrix_expand() four entries at a time, when there is a 4-way SHAKE128 that
+ * is faster than four separate ones.  The matrix has 4, 9 or 16 entries, so
+ * only ML-KEM-768 has an incomplete batch of one entry at the end.
+ */
+static void matrix_expand_x4(ML_KEM_KEY *key)
+{
+    KECCAK1600_X4_CTX ctx;
+    uint8_t input[4][ML_KEM_RANDOM_BYTES + 2];
+    scalar *out[4];
+    int rank = key->vinfo->rank;
+    int n = rank * rank;
+    int i, k, e;
+
+    for (k = 0; k < 4; k++)
+        memcpy(input[k], key->rho, ML_KEM_RANDOM_BYTES);
+    for (i = 0; i < n; i += 4) {
+        for (k = 0; k < 4; k++) {
+            /* Past the end, hash a copy of the first seed and discard it */
+            e = i + k < n ? i + k : i;
+            out[k] = i + k < n ? &key->m[e] : NULL;
+            input[k][ML_KEM_RANDOM_BYTES] = (uint8_t)(e / rank);
+            input[k][ML_KEM_RANDOM_BYTES + 1] = (uint8_t)(e % rank);
+        }
+        ossl_sha3_shake128_x4_init(&ctx, input[0], input[1], input[2],
+            input[3], sizeof(input[0]));
+        sample_scalar_x4(out, &ctx);
+        ossl_sha3_shake_x4_cleanup(&ctx);
+    }
+}
+
 static __owur int matrix_expand(EVP_MD_CTX *mdctx, ML_KEM_KEY *key)
 {
     scalar *out = key->m;
@@ -985,6 +1154,11 @@ static __owur int matrix_expand(EVP_MD_CTX *mdctx, ML_KEM_KEY *key)
     int rank = key->vinfo->rank;
     int i, j;
 
+    if (ossl_sha3_shake_x4_capable()) {
+        matrix_expand_x4(key);
+        return 1;
+    }
+
     memcpy(input, key->rho, ML_KEM_RANDOM_BYTES);
     for (i = 0; i < rank; i++) {
         for (j = 0; j < rank; j++) {
@@ -1000,24 +1174,18 @@ static __owur int matrix_expand(EVP_MD_CTX *mdctx, ML_KEM_KEY *key)
 }
 
 /*
- * Algorithm 7 from the spec, with eta fixed to two and the PRF call
- * included. Creates binominally distributed elements by sampling 2*|eta| bits,
- * and setting the coefficient to the count of the first bits minus the count of
- * the second bits, resulting in a centered binomial distribution. Since eta is
- * two this gives -2/2 with a probability of 1/16, -1/1 with probability 1/4,
- * and 0 with probability 3/8.
+ * Algorithm 7 from the spec, with eta fixed to two. Creates binominally
+ * distributed elements by sampling 2*|eta| bits, and setting the coefficient
+ * to the count of the first bits minus the count of the second bits, resulting
+ * in a centered binomial distribution. Since eta is two this gives -2/2 with a
+ * probability of 1/16, -1/1 with probability 1/4, and 0 with probability 3/8.
  */
-static __owur int cbd_2(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
-    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key)
+static void scalar_cbd_2_generic(scalar *out, const uint8_t *r)
 {
     uint16_t *curr = out->c, *end = curr + DEGREE;
-    uint8_t randbuf[4 * DEGREE / 8], *r = randbuf; /* 64 * eta slots */
     uint16_t value, mask;
     uint8_t b;
 
-    if (!prf(randbuf, sizeof(randbuf), in, mdctx, key))
-        return 0;
-
     do {
         b = *r++;
 
@@ -1038,26 +1206,20 @@ static __owur int cbd_2(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
         mask = constish_time_true(value >> 15);
         *curr++ = value + (kPrime & mask);
     } while (curr < end);
-    return 1;
 }
 
 /*
- * Algorithm 7 from the spec, with eta fixed to three and the PRF call
- * included. Creates binominally distributed elements by sampling 3*|eta| bits,
- * and setting the coefficient to the count of the first bits minus the count of
- * the second bits, resulting in a centered binomial distribution.
+ * Algorithm 7 from the spec, with eta fixed to three. Creates binominally
+ * distributed elements by sampling 3*|eta| bits, and setting the coefficient
+ * to the count of the first bits minus the count of the second bits, resulting
+ * in a centered binomial distribution.
  */
-static __owur int cbd_3(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
-    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key)
+static void scalar_cbd_3_generic(scalar *out, const uint8_t *r)
 {
     uint16_t *curr = out->c, *end = curr + DEGREE;
-    uint8_t randbuf[6 * DEGREE / 8], *r = randbuf; /* 64 * eta slots */
     uint8_t b1, b2, b3;
     uint16_t value, mask;
 
-    if (!prf(randbuf, sizeof(randbuf), in, mdctx, key))
-        return 0;
-
     do {
         b1 = *r++;
         b2 = *r++;
@@ -1090,6 +1252,29 @@ static __owur int cbd_3(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
         mask = constish_time_true(value >> 15);
         *curr++ = value + (kPrime & mask);
     } while (curr < end);
+}
+
+/* SamplePolyCBD_2(PRF_2(s, b)), the PRF call included */
+static __owur int cbd_2(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
+    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key)
+{
+    uint8_t randbuf[4 * DEGREE / 8]; /* 64 * eta slots */
+
+    if (!prf(randbuf, sizeof(randbuf), in, mdctx, key))
+        return 0;
+    scalar_cbd_2(out, randbuf);
+    return 1;
+}
+
+/* SamplePolyCBD_3(PRF_3(s, b)), the PRF call included */
+static __owur int cbd_3(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
+    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key)
+{
+    uint8_t randbuf[6 * DEGREE / 8]; /* 64 * eta slots */
+
+    if (!prf(randbuf, sizeof(randbuf), in, mdctx, key))
+        return 0;
+    scalar_cbd_3(out, randbuf);
     return 1;
 }
 
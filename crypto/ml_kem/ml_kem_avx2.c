@@ -0,0 +1,400 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * ML-KEM polynomial arithmetic on 16 coefficients at a time with AVX2.
+ *
+ * Coefficients are kept fully reduced, as in ml_kem.c, between butterflies.
+ * Products are computed with signed Montgomery reduction and brought back
+ * into [0, q) with a conditional addition of q, so every function returns
+ * exactly what its portable counterpart returns.  The last three layers of
+ * the (inverse) NTT pair up coefficients within a single vector: both halves
+ * of each pair are duplicated across the vector, so that all 16 lanes compute
+ * the butterfly, and a blend keeps the sum in the lower half and the
+ * difference in the upper half.
+ */
+
+#include <string.h>
+#include "internal/cryptlib.h"
+#include "ml_kem_local.h"
+
+#if ML_KEM_AVX2_ELIGIBLE
+
+#include <immintrin.h>
+#include "ml_kem_zetas.h"
+
+#define STRINGIFY_IMPLEMENTATION_(a) #a
+#define STRINGIFY(a) STRINGIFY_IMPLEMENTATION_(a)
+
+#ifdef __clang__
+#define OPENSSL_TARGET_AVX2                                              \
+    _Pragma(STRINGIFY(clang attribute push(__attribute__((target("avx2"))), \
+        apply_to = function)))
+#define OPENSSL_UNTARGET_AVX2 _Pragma("clang attribute pop")
+#else
+#define OPENSSL_TARGET_AVX2 \
+    _Pragma("GCC push_options") _Pragma(STRINGIFY(GCC target("avx2")))
+#define OPENSSL_UNTARGET_AVX2 _Pragma("GCC pop_options")
+#endif
+
+int ossl_ml_kem_avx2_capable(void)
+{
+    return (OPENSSL_ia32cap_P[2] & (1u << 5)) != 0;
+}
+
+OPENSSL_TARGET_AVX2
+
+#define LOAD(p) _mm256_loadu_si256((const __m256i *)(p))
+#define STORE(p, v) _mm256_storeu_si256((__m256i *)(p), (v))
+
+/* Returns a * b / 2^16 mod q in (-q, q), for |a| < q and 0 <= b < q */
+static ossl_inline __m256i montmul(__m256i a, __m256i b, __m256i bqinv)
+{
+    __m256i hi = _mm256_mulhi_epi16(a, b);
+    __m256i t = _mm256_mullo_epi16(a, bqinv);
+
+    return _mm256_sub_epi16(hi, _mm256_mulhi_epi16(t, _mm256_set1_epi16(ML_KEM_Q)));
+}
+
+/* Reduces 0 <= a < 2q to [0, q) */
+static ossl_inline __m256i reduce_once(__m256i a)
+{
+    return _mm256_min_epu16(a, _mm256_sub_epi16(a, _mm256_set1_epi16(ML_KEM_Q)));
+}
+
+/* Reduces -q < a < q to [0, q) */
+static ossl_inline __m256i reduce_signed(__m256i a)
+{
+    return reduce_once(_mm256_add_epi16(a, _mm256_set1_epi16(ML_KEM_Q)));
+}
+
+static ossl_inline __m256i qinv(__m256i z)
+{
+    return _mm256_mullo_epi16(z, _mm256_set1_epi16(ML_KEM_QINV));
+}
+
+/* The NTT butterfly: (e, o) -> (e + z * o, e - z * o) */
+static ossl_inline void ntt_butterfly(__m256i *e, __m256i *o, __m256i z,
+    __m256i zq)
+{
+    __m256i t = reduce_signed(montmul(*o, z, zq));
+    __m256i q = _mm256_set1_epi16(ML_KEM_Q);
+
+    *o = reduce_once(_mm256_sub_epi16(_mm256_add_epi16(*e, q), t));
+    *e = reduce_once(_mm256_add_epi16(*e, t));
+}
+
+/* The inverse NTT butterfly: (e, o) -> (e + o, z * (e - o)) */
+static ossl_inline void inverse_ntt_butterfly(__m256i *e, __m256i *o,
+    __m256i z, __m256i zq)
+{
+    __m256i d = _mm256_sub_epi16(*e, *o);
+
+    *e = reduce_once(_mm256_add_epi16(*e, *o));
+    *o = reduce_signed(montmul(d, z, zq));
+}
+
+/* Broadcasts the two zetas at |p| to the lower and upper 8 lanes */
+static ossl_inline __m256i zetas_x2(const uint16_t *p)
+{
+    const __m256i idx = _mm256_setr_epi8(0, 1, 0, 1, 0, 1, 0, 1,
+        0, 1, 0, 1, 0, 1, 0, 1,
+        2, 3, 2, 3, 2, 3, 2, 3,
+        2, 3, 2, 3, 2, 3, 2, 3);
+    uint32_t z;
+
+    memcpy(&z, p, sizeof(z));
+    return _mm256_shuffle_epi8(_mm256_set1_epi32((int)z), idx);
+}
+
+/* Broadcasts the four zetas at |p| to groups of 4 lanes */
+static ossl_inline __m256i zetas_x4(const uint16_t *p)
+{
+    const __m256i idx = _mm256_setr_epi8(0, 1, 0, 1, 0, 1, 0, 1,
+        2, 3, 2, 3, 2, 3, 2, 3,
+        4, 5, 4, 5, 4, 5, 4, 5,
+        6, 7, 6, 7, 6, 7, 6, 7);
+    uint64_t z;
+
+    memcpy(&z, p, sizeof(z));
+    return _mm256_shuffle_epi8(_mm256_set1_epi64x((long long)z), idx);
+}
+
+/*
+ * One layer of butterflies on pairs of coefficients |offset| < 16 apart,
+ * within |v|: |e| and |o| have the first and second coefficient of each pair
+ * in both lanes of the pair.
+ */
+#define NTT_LAYER_INTRA(v, e, o, z, blend)                            \
+    do {                                                              \
+        __m256i zq_ = qinv(z), e_ = (e), o_ = (o);                    \
+                                                                      \
+        ntt_butterfly(&e_, &o_, (z), zq_);                            \
+        (v) = blend(e_, o_);                                          \
+    } while (0)
+
+#define INVERSE_NTT_LAYER_INTRA(v, e, o, z, blend)                    \
+    do {                                                              \
+        __m256i zq_ = qinv(z), e_ = (e), o_ = (o);                    \
+                                                                      \
+        inverse_ntt_butterfly(&e_, &o_, (z), zq_);                    \
+        (v) = blend(e_, o_);                                          \
+    } while (0)
+
+#define LO8(v) _mm256_permute4x64_epi64((v), 0x44)
+#define HI8(v) _mm256_permute4x64_epi64((v), 0xee)
+#define BLEND8(a, b) _mm256_blend_epi32((a), (b), 0xf0)
+#define LO4(v) _mm256_unpacklo_epi64((v), (v))
+#define HI4(v) _mm256_unpackhi_epi64((v), (v))
+#define BLEND4(a, b) _mm256_blend_epi32((a), (b), 0xcc)
+#define LO2(v) _mm256_shuffle_epi32((v), 0xa0)
+#define HI2(v) _mm256_shuffle_epi32((v), 0xf5)
+#define BLEND2(a, b) _mm256_blend_epi32((a), (b), 0xaa)
+
+void ossl_ml_kem_ntt_avx2(uint16_t c[256])
+{
+    __m256i v[16], z, zq;
+    int offset, i, j, k;
+
+    for (i = 0; i < 16; i++)
+        v[i] = LOAD(c + 16 * i);
+
+    /* Pairs of coefficients 128 to 16 apart, |offset| vectors apart */
+    for (offset = 8, k = 1; offset >= 1; offset >>= 1) {
+        for (i = 0; i < 16; i += 2 * offset, k++) {
+            z = _mm256_set1_epi16((short)ml_kem_zetas[k]);
+            zq = qinv(z);
+            for (j = i; j < i + offset; j++)
+                ntt_butterfly(&v[j], &v[j + offset], z, zq);
+        }
+    }
+    for (i = 0; i < 16; i++) {
+        z = _mm256_set1_epi16((short)ml_kem_zetas[16 + i]);
+        NTT_LAYER_INTRA(v[i], LO8(v[i]), HI8(v[i]), z, BLEND8);
+        z = zetas_x2(ml_kem_zetas + 32 + 2 * i);
+        NTT_LAYER_INTRA(v[i], LO4(v[i]), HI4(v[i]), z, BLEND4);
+        z = zetas_x4(ml_kem_zetas + 64 + 4 * i);
+        NTT_LAYER_INTRA(v[i], LO2(v[i]), HI2(v[i]), z, BLEND2);
+        STORE(c + 16 * i, v[i]);
+    }
+}
+
+void ossl_ml_kem_inverse_ntt_avx2(uint16_t c[256])
+{
+    const __m256i f = _mm256_set1_epi16(ML_KEM_MONT_F);
+    const __m256i fq = qinv(f);
+    __m256i v[16], z, zq;
+    int offset, i, j, k;
+
+    for (i = 0; i < 16; i++) {
+        v[i] = LOAD(c + 16 * i);
+        z = zetas_x4(ml_kem_inverse_zetas + 1 + 4 * i);
+        INVERSE_NTT_LAYER_INTRA(v[i], LO2(v[i]), HI2(v[i]), z, BLEND2);
+        z = zetas_x2(ml_kem_inverse_zetas + 65 + 2 * i);
+        INVERSE_NTT_LAYER_INTRA(v[i], LO4(v[i]), HI4(v[i]), z, BLEND4);
+        z = _mm256_set1_epi16((short)ml_kem_inverse_zetas[97 + i]);
+        INVERSE_NTT_LAYER_INTRA(v[i], LO8(v[i]), HI8(v[i]), z, BLEND8);
+    }
+
+    for (offset = 1, k = 113; offset <= 8; offset <<= 1) {
+        for (i = 0; i < 16; i += 2 * offset, k++) {
+            z = _mm256_set1_epi16((short)ml_kem_inverse_zetas[k]);
+            zq = qinv(z);
+            for (j = i; j < i + offset; j++)
+                inverse_ntt_butterfly(&v[j], &v[j + offset], z, zq);
+        }
+    }
+
+    /* Multiply by 1/128 */
+    for (i = 0; i < 16; i++)
+        STORE(c + 16 * i, reduce_signed(montmul(v[i], f, fq)));
+}
+
+/*
+ * Multiplies 8 pairs of coefficients of |lhs| and |rhs|, in GF(q)[X]/(X^2 -
+ * zeta), the zetas being those at |roots|:
+ *
+ *   (l0 + l1 X) * (r0 + r1 X) = (l0 * r0 + l1 * r1 * zeta) + (l0 * r1 + l1 * r0) X
+ *
+ * Each sum is computed exactly with _mm256_madd_epi16(), using l * R and
+ * l1 * zeta * R, so that the Montgomery reduction of the sums is exact.
+ */
+static ossl_inline __m256i basemul(const uint16_t *lhs, const uint16_t *rhs,
+    const uint16_t *roots)
+{
+    const __m256i swap = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5,
+        10, 11, 8, 9, 14, 15, 12, 13,
+        2, 3, 0, 1, 6, 7, 4, 5,
+        10, 11, 8, 9, 14, 15, 12, 13);
+    const __m256i r2 = _mm256_set1_epi16(ML_KEM_MONT_R2);
+    __m256i l = LOAD(lhs), r = LOAD(rhs);
+    __m256i z, lr, lz, x0, x1, lo, hi, t;
+
+    /* R^2 in the even lanes, zeta * R^2 in the odd lanes */
+    z = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)roots));
+    z = _mm256_or_si256(_mm256_slli_epi32(z, 16),
+        _mm256_set1_epi32(ML_KEM_MONT_R2));
+
+    lr = montmul(l, r2, qinv(r2));
+    lz = montmul(l, z, qinv(z));
+    x0 = _mm256_madd_epi16(lz, r);
+    x1 = _mm256_madd_epi16(lr, _mm256_shuffle_epi8(r, swap));
+
+    /* Montgomery reduction of x0 and x1, interleaved */
+    lo = _mm256_blend_epi16(x0, _mm256_slli_epi32(x1, 16), 0xaa);
+    hi = _mm256_blend_epi16(_mm256_srli_epi32(x0, 16), x1, 0xaa);
+    t = _mm256_mullo_epi16(lo, _mm256_set1_epi16(ML_KEM_QINV));
+    t = _mm256_sub_epi16(hi, _mm256_mulhi_epi16(t, _mm256_set1_epi16(ML_KEM_Q)));
+    return reduce_signed(t);
+}
+
+void ossl_ml_kem_mult_avx2(uint16_t out[256], const uint16_t lhs[256],
+    const uint16_t rhs[256])
+{
+    int i;
+
+    for (i = 0; i < 256; i += 16)
+        STORE(out + i, basemul(lhs + i, rhs + i, ml_kem_mod_roots + i / 2));
+}
+
+void ossl_ml_kem_mult_add_avx2(uint16_t out[256], const uint16_t lhs[256],
+    const uint16_t rhs[256])
+{
+    __m256i v;
+    int i;
+
+    for (i = 0; i < 256; i += 16) {
+        v = basemul(lhs + i, rhs + i, ml_kem_mod_roots + i / 2);
+        STORE(out + i, reduce_once(_mm256_add_epi16(v, LOAD(out + i))));
+    }
+}
+
+/*
+ * round(2^bits * x / q) = floor((2^(bits + 1) * x + q) / 2q), of 8 32-bit
+ * values, with the division done as a multiplication by
+ * ML_KEM_COMPRESS_M = ceil(2^37 / 2q), exact for numerators below 2^24.
+ */
+static ossl_inline __m256i compress_x8(__m256i x, int bits)
+{
+    const __m256i m = _mm256_set1_epi32(ML_KEM_COMPRESS_M);
+    __m256i even, odd;
+
+    x = _mm256_add_epi32(_mm256_sll_epi32(x, _mm_cvtsi32_si128(bits + 1)),
+        _mm256_set1_epi32(ML_KEM_Q));
+    even = _mm256_srli_epi64(_mm256_mul_epu32(x, m), ML_KEM_COMPRESS_SHIFT);
+    odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), m),
+        ML_KEM_COMPRESS_SHIFT);
+    return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xaa);
+}
+
+void ossl_ml_kem_compress_avx2(uint16_t c[256], int bits)
+{
+    const __m256i mask = _mm256_set1_epi16((short)((1 << bits) - 1));
+    __m256i lo, hi;
+    int i;
+
+    for (i = 0; i < 256; i += 16) {
+        lo = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(c + i)));
+        hi = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(c + i + 8)));
+        lo = _mm256_packus_epi32(compress_x8(lo, bits), compress_x8(hi, bits));
+        lo = _mm256_permute4x64_epi64(lo, 0xd8);
+        STORE(c + i, _mm256_and_si256(lo, mask));
+    }
+}
+
+/* round(q * x / 2^bits) = (x * 2^(15 - bits) * q + 2^14) >> 15 */
+void ossl_ml_kem_decompress_avx2(uint16_t c[256], int bits)
+{
+    const __m128i shift = _mm_cvtsi32_si128(15 - bits);
+    const __m256i q = _mm256_set1_epi16(ML_KEM_Q);
+    int i;
+
+    for (i = 0; i < 256; i += 16)
+        STORE(c + i, _mm256_mulhrs_epi16(_mm256_sll_epi16(LOAD(c + i), shift), q));
+}
+
+/* Maps 16 values in [0, 2 * eta] to value - eta mod q */
+static ossl_inline __m256i cbd_center(__m256i v, int eta)
+{
+    return reduce_once(_mm256_add_epi16(v, _mm256_set1_epi16(ML_KEM_Q - eta)));
+}
+
+/*
+ * Each byte gives two coefficients, the sum of its bits 0 and 1 less that of
+ * its bits 2 and 3, and the same for its bits 4 to 7.
+ */
+void ossl_ml_kem_cbd_2_avx2(uint16_t out[256], const uint8_t in[128])
+{
+    const __m128i m55 = _mm_set1_epi8(0x55), m33 = _mm_set1_epi8(0x33);
+    const __m128i m0f = _mm_set1_epi8(0x0f), m22 = _mm_set1_epi8(0x22);
+    __m128i b, t, d;
+    int i;
+
+    for (i = 0; i < 128; i += 16) {
+        b = _mm_loadu_si128((const __m128i *)(in + i));
+        /* Sums of pairs of bits, then their differences + 2 in each nibble */
+        t = _mm_add_epi8(_mm_and_si128(b, m55),
+            _mm_and_si128(_mm_srli_epi16(b, 1), m55));
+        d = _mm_sub_epi8(_mm_add_epi8(_mm_and_si128(t, m33), m22),
+            _mm_and_si128(_mm_srli_epi16(t, 2), m33));
+        t = _mm_and_si128(_mm_srli_epi16(d, 4), m0f);
+        d = _mm_and_si128(d, m0f);
+        STORE(out + 2 * i,
+            cbd_center(_mm256_cvtepu8_epi16(_mm_unpacklo_epi8(d, t)), 2));
+        STORE(out + 2 * i + 16,
+            cbd_center(_mm256_cvtepu8_epi16(_mm_unpackhi_epi8(d, t)), 2));
+    }
+}
+
+/*
+ * Each 3 bytes give four coefficients, the sums of 6 groups of 3 bits less
+ * those of the next 3 bits.
+ */
+void ossl_ml_kem_cbd_3_avx2(uint16_t out[256], const uint8_t in[192])
+{
+    const __m256i spread = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+        6, 7, 8, -1, 9, 10, 11, -1,
+        4, 5, 6, -1, 7, 8, 9, -1,
+        10, 11, 12, -1, 13, 14, 15, -1);
+    const __m256i m249 = _mm256_set1_epi32(0x249249);
+    const __m256i m1c7 = _mm256_set1_epi32(0x1c71c7);
+    const __m256i m7 = _mm256_set1_epi32(7), m70000 = _mm256_set1_epi32(0x70000);
+    __m256i w, t, d, s01, s23, lo, hi;
+    int i, j;
+
+    for (i = 0, j = 0; i < 192; i += 24, j += 32) {
+        /* Bytes 0-11 in the lower lane and 12-23 in the upper, 3 per dword */
+        w = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(in + i))),
+            _mm_loadl_epi64((const __m128i *)(in + i + 16)), 1);
+        w = _mm256_shuffle_epi8(_mm256_permute4x64_epi64(w, 0x94), spread);
+
+        /* Sums of triplets of bits, then their differences + 3 */
+        t = _mm256_add_epi32(_mm256_and_si256(w, m249),
+            _mm256_add_epi32(_mm256_and_si256(_mm256_srli_epi32(w, 1), m249),
+                _mm256_and_si256(_mm256_srli_epi32(w, 2), m249)));
+        d = _mm256_sub_epi32(
+            _mm256_add_epi32(_mm256_and_si256(t, m1c7), _mm256_set1_epi32(0xc30c3)),
+            _mm256_and_si256(_mm256_srli_epi32(t, 3), m1c7));
+
+        /* The 4 coefficients of each dword as 16-bit values */
+        s01 = _mm256_or_si256(_mm256_and_si256(d, m7),
+            _mm256_and_si256(_mm256_slli_epi32(d, 10), m70000));
+        s23 = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(d, 12), m7),
+            _mm256_and_si256(_mm256_srli_epi32(d, 2), m70000));
+        lo = _mm256_unpacklo_epi32(s01, s23);
+        hi = _mm256_unpackhi_epi32(s01, s23);
+        STORE(out + j, cbd_center(_mm256_permute2x128_si256(lo, hi, 0x20), 3));
+        STORE(out + j + 16, cbd_center(_mm256_permute2x128_si256(lo, hi, 0x31), 3));
+    }
+}
+
+OPENSSL_UNTARGET_AVX2
+
+#endif /* ML_KEM_AVX2_ELIGIBLE */
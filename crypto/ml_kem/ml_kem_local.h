@@ -0,0 +1,72 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#if !defined(OSSL_LIBCRYPTO_ML_KEM_ML_KEM_LOCAL_H)
+#define OSSL_LIBCRYPTO_ML_KEM_ML_KEM_LOCAL_H
+
+#include <stdint.h>
+#include <openssl/opensslconf.h>
+
+/*
+ * Vectorised ML-KEM polynomial arithmetic.
+ *
+ * All functions operate on the ML_KEM_DEGREE (256) coefficients of a scalar,
+ * and produce exactly the same, fully reduced, results as the portable C code
+ * in ml_kem.c, which selects them at run time in ml_kem_ntt_init().
+ *
+ * - ntt, inverse_ntt: in-place (inverse) number theoretic transform
+ * - mult: out = lhs * rhs, in the NTT domain
+ * - mult_add: out += lhs * rhs, in the NTT domain
+ * - compress, decompress: in-place Compress_d and Decompress_d
+ * - cbd_2, cbd_3: SamplePolyCBD_eta of 64 * eta bytes of PRF output
+ */
+#if (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
+    && !defined(OPENSSL_NO_ASM)                                                        \
+    && ((defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 8))                  \
+        || (defined(__clang__) && (__clang_major__ >= 7)))
+#define ML_KEM_AVX2_ELIGIBLE 1
+#else
+#define ML_KEM_AVX2_ELIGIBLE 0
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON) && !defined(OPENSSL_NO_ASM)
+#define ML_KEM_NEON_ELIGIBLE 1
+#else
+#define ML_KEM_NEON_ELIGIBLE 0
+#endif
+
+#if ML_KEM_AVX2_ELIGIBLE
+int ossl_ml_kem_avx2_capable(void);
+void ossl_ml_kem_ntt_avx2(uint16_t c[256]);
+void ossl_ml_kem_inverse_ntt_avx2(uint16_t c[256]);
+void ossl_ml_kem_mult_avx2(uint16_t out[256], const uint16_t lhs[256],
+    const uint16_t rhs[256]);
+void ossl_ml_kem_mult_add_avx2(uint16_t out[256], const uint16_t lhs[256],
+    const uint16_t rhs[256]);
+void ossl_ml_kem_compress_avx2(uint16_t c[256], int bits);
+void ossl_ml_kem_decompress_avx2(uint16_t c[256], int bits);
+void ossl_ml_kem_cbd_2_avx2(uint16_t out[256], const uint8_t in[128]);
+void ossl_ml_kem_cbd_3_avx2(uint16_t out[256], const uint8_t in[192]);
+#endif
+
+#if ML_KEM_NEON_ELIGIBLE
+int ossl_ml_kem_neon_capable(void);
+void ossl_ml_kem_ntt_neon(uint16_t c[256]);
+void ossl_ml_kem_inverse_ntt_neon(uint16_t c[256]);
+void ossl_ml_kem_mult_neon(uint16_t out[256], const uint16_t lhs[256],
+    const uint16_t rhs[256]);
+void ossl_ml_kem_mult_add_neon(uint16_t out[256], const uint16_t lhs[256],
+    const uint16_t rhs[256]);
+void ossl_ml_kem_compress_neon(uint16_t c[256], int bits);
+void ossl_ml_kem_decompress_neon(uint16_t c[256], int bits);
+void ossl_ml_kem_cbd_2_neon(uint16_t out[256], const uint8_t in[128]);
+void ossl_ml_kem_cbd_3_neon(uint16_t out[256], const uint8_t in[192]);
+#endif
+
+#endif /* OSSL_LIBCRYPTO_ML_KEM_ML_KEM_LOCAL_H */
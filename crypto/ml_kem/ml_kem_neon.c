@@ -0,0 +1,371 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * ML-KEM polynomial arithmetic on 8 coefficients at a time with AArch64 NEON.
+ *
+ * This follows ml_kem_avx2.c: fully reduced coefficients between
+ * butterflies, signed Montgomery multiplication, here with the doubling
+ * multiply-high instructions, and the last two layers of the (inverse) NTT
+ * computed on duplicated halves of each vector.
+ */
+
+#include "internal/cryptlib.h"
+#include "ml_kem_local.h"
+
+#if ML_KEM_NEON_ELIGIBLE
+
+#include <arm_neon.h>
+#include "arch/arm_arch.h"
+#include "ml_kem_zetas.h"
+
+int ossl_ml_kem_neon_capable(void)
+{
+    return (OPENSSL_armcap_P & ARMV7_NEON) != 0;
+}
+
+#define LOAD(p) vreinterpretq_s16_u16(vld1q_u16(p))
+#define STORE(p, v) vst1q_u16((p), vreinterpretq_u16_s16(v))
+
+/*
+ * Returns a * b / 2^16 mod q in (-q, q), for |a| < q and 0 <= b < q.  The
+ * low halves of 2 * a * b and 2 * t * q are equal, so the halving
+ * subtraction of their high halves is exact.
+ */
+static ossl_inline int16x8_t montmul(int16x8_t a, int16x8_t b, int16x8_t bqinv)
+{
+    int16x8_t hi = vqdmulhq_s16(a, b);
+    int16x8_t t = vmulq_s16(a, bqinv);
+
+    return vhsubq_s16(hi, vqdmulhq_s16(t, vdupq_n_s16(ML_KEM_Q)));
+}
+
+/* Reduces 0 <= a < 2q to [0, q) */
+static ossl_inline int16x8_t reduce_once(int16x8_t a)
+{
+    uint16x8_t u = vreinterpretq_u16_s16(a);
+
+    return vreinterpretq_s16_u16(vminq_u16(u,
+        vsubq_u16(u, vdupq_n_u16(ML_KEM_Q))));
+}
+
+/* Reduces -q < a < q to [0, q) */
+static ossl_inline int16x8_t reduce_signed(int16x8_t a)
+{
+    return reduce_once(vaddq_s16(a, vdupq_n_s16(ML_KEM_Q)));
+}
+
+static ossl_inline int16x8_t qinv(int16x8_t z)
+{
+    return vmulq_s16(z, vdupq_n_s16(ML_KEM_QINV));
+}
+
+/* The NTT butterfly: (e, o) -> (e + z * o, e - z * o) */
+static ossl_inline void ntt_butterfly(int16x8_t *e, int16x8_t *o, int16x8_t z,
+    int16x8_t zq)
+{
+    int16x8_t t = reduce_signed(montmul(*o, z, zq));
+
+    *o = reduce_once(vsubq_s16(vaddq_s16(*e, vdupq_n_s16(ML_KEM_Q)), t));
+    *e = reduce_once(vaddq_s16(*e, t));
+}
+
+/* The inverse NTT butterfly: (e, o) -> (e + o, z * (e - o)) */
+static ossl_inline void inverse_ntt_butterfly(int16x8_t *e, int16x8_t *o,
+    int16x8_t z, int16x8_t zq)
+{
+    int16x8_t d = vsubq_s16(*e, *o);
+
+    *e = reduce_once(vaddq_s16(*e, *o));
+    *o = reduce_signed(montmul(d, z, zq));
+}
+
+/* Broadcasts the two zetas at |p| to the lower and upper 4 lanes */
+static ossl_inline int16x8_t zetas_x2(const uint16_t *p)
+{
+    return vcombine_s16(vdup_n_s16((int16_t)p[0]), vdup_n_s16((int16_t)p[1]));
+}
+
+#define U32(v) vreinterpretq_u32_s16(v)
+#define S16(v) vreinterpretq_s16_u32(v)
+#define LO4(v) vcombine_s16(vget_low_s16(v), vget_low_s16(v))
+#define HI4(v) vcombine_s16(vget_high_s16(v), vget_high_s16(v))
+#define BLEND4(a, b) vcombine_s16(vget_low_s16(a), vget_high_s16(b))
+#define LO2(v) S16(vtrn1q_u32(U32(v), U32(v)))
+#define HI2(v) S16(vtrn2q_u32(U32(v), U32(v)))
+/* Both lanes of each pair of |b| hold the same value */
+#define BLEND2(a, b) S16(vtrn1q_u32(U32(a), U32(b)))
+
+/*
+ * One layer of butterflies on pairs of coefficients |offset| < 8 apart,
+ * within |v|: |e| and |o| have the first and second coefficient of each pair
+ * in both lanes of the pair.
+ */
+#define NTT_LAYER_INTRA(v, e, o, z, blend)                            \
+    do {                                                              \
+        int16x8_t zq_ = qinv(z), e_ = (e), o_ = (o);                  \
+                                                                      \
+        ntt_butterfly(&e_, &o_, (z), zq_);                            \
+        (v) = blend(e_, o_);                                          \
+    } while (0)
+
+#define INVERSE_NTT_LAYER_INTRA(v, e, o, z, blend)                    \
+    do {                                                              \
+        int16x8_t zq_ = qinv(z), e_ = (e), o_ = (o);                  \
+                                                                      \
+        inverse_ntt_butterfly(&e_, &o_, (z), zq_);                    \
+        (v) = blend(e_, o_);                                          \
+    } while (0)
+
+void ossl_ml_kem_ntt_neon(uint16_t c[256])
+{
+    int16x8_t v[32], z, zq;
+    int offset, i, j, k;
+
+    for (i = 0; i < 32; i++)
+        v[i] = LOAD(c + 8 * i);
+
+    /* Pairs of coefficients 128 to 8 apart, |offset| vectors apart */
+    for (offset = 16, k = 1; offset >= 1; offset >>= 1) {
+        for (i = 0; i < 32; i += 2 * offset, k++) {
+            z = vdupq_n_s16((int16_t)ml_kem_zetas[k]);
+            zq = qinv(z);
+            for (j = i; j < i + offset; j++)
+                ntt_butterfly(&v[j], &v[j + offset], z, zq);
+        }
+    }
+    for (i = 0; i < 32; i++) {
+        z = vdupq_n_s16((int16_t)ml_kem_zetas[32 + i]);
+        NTT_LAYER_INTRA(v[i], LO4(v[i]), HI4(v[i]), z, BLEND4);
+        z = zetas_x2(ml_kem_zetas + 64 + 2 * i);
+        NTT_LAYER_INTRA(v[i], LO2(v[i]), HI2(v[i]), z, BLEND2);
+        STORE(c + 8 * i, v[i]);
+    }
+}
+
+void ossl_ml_kem_inverse_ntt_neon(uint16_t c[256])
+{
+    const int16x8_t f = vdupq_n_s16(ML_KEM_MONT_F);
+    const int16x8_t fq = qinv(f);
+    int16x8_t v[32], z, zq;
+    int offset, i, j, k;
+
+    for (i = 0; i < 32; i++) {
+        v[i] = LOAD(c + 8 * i);
+        z = zetas_x2(ml_kem_inverse_zetas + 1 + 2 * i);
+        INVERSE_NTT_LAYER_INTRA(v[i], LO2(v[i]), HI2(v[i]), z, BLEND2);
+        z = vdupq_n_s16((int16_t)ml_kem_inverse_zetas[65 + i]);
+        INVERSE_NTT_LAYER_INTRA(v[i], LO4(v[i]), HI4(v[i]), z, BLEND4);
+    }
+
+    for (offset = 1, k = 97; offset <= 16; offset <<= 1) {
+        for (i = 0; i < 32; i += 2 * offset, k++) {
+            z = vdupq_n_s16((int16_t)ml_kem_inverse_zetas[k]);
+            zq = qinv(z);
+            for (j = i; j < i + offset; j++)
+                inverse_ntt_butterfly(&v[j], &v[j + offset], z, zq);
+        }
+    }
+
+    /* Multiply by 1/128 */
+    for (i = 0; i < 32; i++)
+        STORE(c + 8 * i, reduce_signed(montmul(v[i], f, fq)));
+}
+
+/*
+ * Returns (a0 * b0 + a1 * b1) / 2^16 mod q in [0, q), for |a| < q and
+ * 0 <= b < q, the sums being exact in 32 bits.
+ */
+static ossl_inline int16x8_t mul_add_reduce(int16x8_t a0, int16x8_t b0,
+    int16x8_t a1, int16x8_t b1)
+{
+    int32x4_t lo = vmlal_s16(vmull_s16(vget_low_s16(a0), vget_low_s16(b0)),
+        vget_low_s16(a1), vget_low_s16(b1));
+    int32x4_t hi = vmlal_high_s16(vmull_high_s16(a0, b0), a1, b1);
+    int16x8_t t = vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+
+    t = vmulq_s16(t, vdupq_n_s16(ML_KEM_QINV));
+    lo = vmlsl_s16(lo, vget_low_s16(t), vdup_n_s16(ML_KEM_Q));
+    hi = vmlsl_high_s16(hi, t, vdupq_n_s16(ML_KEM_Q));
+    return reduce_signed(vcombine_s16(vshrn_n_s32(lo, 16), vshrn_n_s32(hi, 16)));
+}
+
+/*
+ * Multiplies 8 pairs of coefficients of |lhs| and |rhs|, in GF(q)[X]/(X^2 -
+ * zeta), the zetas being those at |roots|, see ml_kem_avx2.c.  The pairs are
+ * split into their even and odd coefficients as they are loaded.
+ */
+static ossl_inline int16x8x2_t basemul(const uint16_t *lhs, const uint16_t *rhs,
+    const uint16_t *roots)
+{
+    const int16x8_t r2 = vdupq_n_s16(ML_KEM_MONT_R2);
+    uint16x8x2_t l = vld2q_u16(lhs), r = vld2q_u16(rhs);
+    int16x8_t z = LOAD(roots);
+    int16x8_t l0 = vreinterpretq_s16_u16(l.val[0]);
+    int16x8_t l1 = vreinterpretq_s16_u16(l.val[1]);
+    int16x8_t r0 = vreinterpretq_s16_u16(r.val[0]);
+    int16x8_t r1 = vreinterpretq_s16_u16(r.val[1]);
+    int16x8_t l1z = montmul(l1, z, qinv(z));
+    int16x8x2_t ret;
+
+    l0 = montmul(l0, r2, qinv(r2));
+    l1 = montmul(l1, r2, qinv(r2));
+    ret.val[0] = mul_add_reduce(l0, r0, l1z, r1);
+    ret.val[1] = mul_add_reduce(l0, r1, l1, r0);
+    return ret;
+}
+
+void ossl_ml_kem_mult_neon(uint16_t out[256], const uint16_t lhs[256],
+    const uint16_t rhs[256])
+{
+    int16x8x2_t v;
+    int i;
+
+    for (i = 0; i < 256; i += 16) {
+        v = basemul(lhs + i, rhs + i, ml_kem_mod_roots + i / 2);
+        vst2q_s16((int16_t *)(out + i), v);
+    }
+}
+
+void ossl_ml_kem_mult_add_neon(uint16_t out[256], const uint16_t lhs[256],
+    const uint16_t rhs[256])
+{
+    int16x8x2_t v, acc;
+    int i;
+
+    for (i = 0; i < 256; i += 16) {
+        v = basemul(lhs + i, rhs + i, ml_kem_mod_roots + i / 2);
+        acc = vld2q_s16((const int16_t *)(out + i));
+        acc.val[0] = reduce_once(vaddq_s16(acc.val[0], v.val[0]));
+        acc.val[1] = reduce_once(vaddq_s16(acc.val[1], v.val[1]));
+        vst2q_s16((int16_t *)(out + i), acc);
+    }
+}
+
+/*
+ * round(2^bits * x / q) = floor((2^(bits + 1) * x + q) / 2q), of 4 32-bit
+ * values, see ml_kem_avx2.c.
+ */
+static ossl_inline uint32x4_t compress_x4(uint32x4_t x, int32x4_t shift)
+{
+    const uint32x4_t m = vdupq_n_u32(ML_KEM_COMPRESS_M);
+    uint64x2_t lo, hi;
+
+    x = vaddq_u32(vshlq_u32(x, shift), vdupq_n_u32(ML_KEM_Q));
+    lo = vmull_u32(vget_low_u32(x), vget_low_u32(m));
+    hi = vmull_high_u32(x, m);
+    return vshrq_n_u32(vcombine_u32(vshrn_n_u64(lo, 32), vshrn_n_u64(hi, 32)),
+        ML_KEM_COMPRESS_SHIFT - 32);
+}
+
+void ossl_ml_kem_compress_neon(uint16_t c[256], int bits)
+{
+    const uint16x8_t mask = vdupq_n_u16((uint16_t)((1 << bits) - 1));
+    const int32x4_t shift = vdupq_n_s32(bits + 1);
+    uint16x8_t x;
+    uint32x4_t lo, hi;
+    int i;
+
+    for (i = 0; i < 256; i += 8) {
+        x = vld1q_u16(c + i);
+        lo = compress_x4(vmovl_u16(vget_low_u16(x)), shift);
+        hi = compress_x4(vmovl_high_u16(x), shift);
+        x = vcombine_u16(vmovn_u32(lo), vmovn_u32(hi));
+        vst1q_u16(c + i, vandq_u16(x, mask));
+    }
+}
+
+/* round(q * x / 2^bits) = (x * 2^(15 - bits) * q * 2 + 2^15) >> 16 */
+void ossl_ml_kem_decompress_neon(uint16_t c[256], int bits)
+{
+    const int16x8_t shift = vdupq_n_s16((int16_t)(15 - bits));
+    const int16x8_t q = vdupq_n_s16(ML_KEM_Q);
+    int i;
+
+    for (i = 0; i < 256; i += 8)
+        STORE(c + i, vqrdmulhq_s16(vshlq_s16(LOAD(c + i), shift), q));
+}
+
+/* Maps 8 values in [0, 2 * eta] to value - eta mod q */
+static ossl_inline uint16x8_t cbd_center(uint16x8_t v, int eta)
+{
+    v = vaddq_u16(v, vdupq_n_u16((uint16_t)(ML_KEM_Q - eta)));
+    return vminq_u16(v, vsubq_u16(v, vdupq_n_u16(ML_KEM_Q)));
+}
+
+/* See ossl_ml_kem_cbd_2_avx2() */
+void ossl_ml_kem_cbd_2_neon(uint16_t out[256], const uint8_t in[128])
+{
+    const uint8x16_t m55 = vdupq_n_u8(0x55), m33 = vdupq_n_u8(0x33);
+    const uint8x16_t m0f = vdupq_n_u8(0x0f), m22 = vdupq_n_u8(0x22);
+    uint8x16_t b, t, d;
+    int i;
+
+    for (i = 0; i < 128; i += 16) {
+        b = vld1q_u8(in + i);
+        t = vaddq_u8(vandq_u8(b, m55), vandq_u8(vshrq_n_u8(b, 1), m55));
+        d = vsubq_u8(vaddq_u8(vandq_u8(t, m33), m22),
+            vandq_u8(vshrq_n_u8(t, 2), m33));
+        t = vshrq_n_u8(d, 4);
+        d = vandq_u8(d, m0f);
+        b = vzip1q_u8(d, t);
+        vst1q_u16(out + 2 * i, cbd_center(vmovl_u8(vget_low_u8(b)), 2));
+        vst1q_u16(out + 2 * i + 8, cbd_center(vmovl_high_u8(b), 2));
+        b = vzip2q_u8(d, t);
+        vst1q_u16(out + 2 * i + 16, cbd_center(vmovl_u8(vget_low_u8(b)), 2));
+        vst1q_u16(out + 2 * i + 24, cbd_center(vmovl_high_u8(b), 2));
+    }
+}
+
+#define CBD_3_SLOT(d, shift)                                                 \
+    vmovn_u32(vminq_u32(vaddq_u32(vandq_u32((d), vdupq_n_u32(7)), (shift)), \
+        vsubq_u32(vaddq_u32(vandq_u32((d), vdupq_n_u32(7)), (shift)),        \
+            vdupq_n_u32(ML_KEM_Q))))
+
+/* The 16 coefficients of the 4 groups of 3 bytes in |w| */
+static ossl_inline void cbd_3_x4(uint16_t *out, uint32x4_t w)
+{
+    const uint32x4_t m249 = vdupq_n_u32(0x249249);
+    const uint32x4_t m1c7 = vdupq_n_u32(0x1c71c7);
+    const uint32x4_t bias = vdupq_n_u32(ML_KEM_Q - 3);
+    uint32x4_t t, d;
+    uint16x4x4_t s;
+
+    t = vaddq_u32(vandq_u32(w, m249),
+        vaddq_u32(vandq_u32(vshrq_n_u32(w, 1), m249),
+            vandq_u32(vshrq_n_u32(w, 2), m249)));
+    d = vsubq_u32(vaddq_u32(vandq_u32(t, m1c7), vdupq_n_u32(0xc30c3)),
+        vandq_u32(vshrq_n_u32(t, 3), m1c7));
+    s.val[0] = CBD_3_SLOT(d, bias);
+    s.val[1] = CBD_3_SLOT(vshrq_n_u32(d, 6), bias);
+    s.val[2] = CBD_3_SLOT(vshrq_n_u32(d, 12), bias);
+    s.val[3] = CBD_3_SLOT(vshrq_n_u32(d, 18), bias);
+    vst4_u16(out, s);
+}
+
+/* See ossl_ml_kem_cbd_3_avx2() */
+void ossl_ml_kem_cbd_3_neon(uint16_t out[256], const uint8_t in[192])
+{
+    uint8x8x3_t b;
+    uint16x8_t w01, w2;
+    int i, j;
+
+    for (i = 0, j = 0; i < 192; i += 24, j += 32) {
+        /* 8 groups of 3 bytes as 24-bit values */
+        b = vld3_u8(in + i);
+        w01 = vorrq_u16(vmovl_u8(b.val[0]), vshll_n_u8(b.val[1], 8));
+        w2 = vmovl_u8(b.val[2]);
+        cbd_3_x4(out + j, vorrq_u32(vmovl_u16(vget_low_u16(w01)),
+                              vshll_n_u16(vget_low_u16(w2), 16)));
+        cbd_3_x4(out + j + 16, vorrq_u32(vmovl_high_u16(w01),
+                                   vshll_high_n_u16(w2, 16)));
+    }
+}
+
+#endif /* ML_KEM_NEON_ELIGIBLE */
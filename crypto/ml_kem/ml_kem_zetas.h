@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Constants of the vectorised ML-KEM kernels, which multiply with Montgomery
+ * reduction: mont(a, b) = a * b / 2^16 mod 3329.  So the constants are those
+ * of ml_kem.c multiplied by R = 2^16 mod 3329, i.e. in Python:
+ *
+ * p = 3329
+ * R = 2**16 % p
+ * zetas = [k * R % p for k in kNTTRoots]
+ * inverse_zetas = [k * R % p for k in kInverseNTTRoots]
+ * mod_roots = [k * R * R % p for k in kModRoots]
+ */
+
+#define ML_KEM_Q 3329
+#define ML_KEM_QINV -3327 /* 3329^-1 mod 2^16 */
+#define ML_KEM_MONT_R2 1353 /* 2^32 mod 3329 */
+#define ML_KEM_MONT_F 512 /* 2^16 / 128 mod 3329 */
+/* ceil(2^37 / (2 * 3329)), see compress() */
+#define ML_KEM_COMPRESS_M 20642679
+#define ML_KEM_COMPRESS_SHIFT 37
+
+static const uint16_t ml_kem_zetas[128] = {
+    0x8ed, 0xa0b, 0xb9a, 0x714, 0x5d5, 0x58e, 0x11f, 0x0ca,
+    0xc56, 0x26e, 0x629, 0x0b6, 0x3c2, 0x84f, 0x73f, 0x5bc,
+    0x23d, 0x7d4, 0x108, 0x17f, 0x9c4, 0x5b2, 0x6bf, 0xc7f,
+    0xa58, 0x3f9, 0x2dc, 0x260, 0x6fb, 0x19b, 0xc34, 0x6de,
+    0x4c7, 0x28c, 0xad9, 0x3f7, 0x7f4, 0x5d3, 0xbe7, 0x6f9,
+    0x204, 0xcf9, 0xbc1, 0xa67, 0x6af, 0x877, 0x07e, 0x5bd,
+    0x9ac, 0xca7, 0xbf2, 0x33e, 0x06b, 0x774, 0xc0a, 0x94a,
+    0xb73, 0x3c1, 0x71d, 0xa2c, 0x1c0, 0x8d8, 0x2a5, 0x806,
+    0x8b2, 0x1ae, 0x22b, 0x34b, 0x81e, 0x367, 0x60e, 0x069,
+    0x1a6, 0x24b, 0x0b1, 0xc16, 0xbde, 0xb35, 0x626, 0x675,
+    0xc0b, 0x30a, 0x487, 0xc6e, 0x9f8, 0x5cb, 0xaa7, 0x45f,
+    0x6cb, 0x284, 0x999, 0x15d, 0x1a2, 0x149, 0xc65, 0xcb6,
+    0x331, 0x449, 0x25b, 0x262, 0x52a, 0x7fc, 0x748, 0x180,
+    0x842, 0xc79, 0x4c2, 0x7ca, 0x997, 0x0dc, 0x85e, 0x686,
+    0x860, 0x707, 0x803, 0x31a, 0x71b, 0x9ab, 0x99b, 0x1de,
+    0xc95, 0xbcd, 0x3e4, 0x3df, 0x3be, 0x74d, 0x5f2, 0x65c
+};
+
+static const uint16_t ml_kem_inverse_zetas[128] = {
+    0x8ed, 0x6a5, 0x70f, 0x5b4, 0x943, 0x922, 0x91d, 0x134,
+    0x06c, 0xb23, 0x366, 0x356, 0x5e6, 0x9e7, 0x4fe, 0x5fa,
+    0x4a1, 0x67b, 0x4a3, 0xc25, 0x36a, 0x537, 0x83f, 0x088,
+    0x4bf, 0xb81, 0x5b9, 0x505, 0x7d7, 0xa9f, 0xaa6, 0x8b8,
+    0x9d0, 0x04b, 0x09c, 0xbb8, 0xb5f, 0xba4, 0x368, 0xa7d,
+    0x636, 0x8a2, 0x25a, 0x736, 0x309, 0x093, 0x87a, 0x9f7,
+    0x0f6, 0x68c, 0x6db, 0x1cc, 0x123, 0x0eb, 0xc50, 0xab6,
+    0xb5b, 0xc98, 0x6f3, 0x99a, 0x4e3, 0x9b6, 0xad6, 0xb53,
+    0x44f, 0x4fb, 0xa5c, 0x429, 0xb41, 0x2d5, 0x5e4, 0x940,
+    0x18e, 0x3b7, 0x0f7, 0x58d, 0xc96, 0x9c3, 0x10f, 0x05a,
+    0x355, 0x744, 0xc83, 0x48a, 0x652, 0x29a, 0x140, 0x008,
+    0xafd, 0x608, 0x11a, 0x72e, 0x50d, 0x90a, 0x228, 0xa75,
+    0x83a, 0x623, 0x0cd, 0xb66, 0x606, 0xaa1, 0xa25, 0x908,
+    0x2a9, 0x082, 0x642, 0x74f, 0x33d, 0xb82, 0xbf9, 0x52d,
+    0xac4, 0x745, 0x5c2, 0x4b2, 0x93f, 0xc4b, 0x6d8, 0xa93,
+    0x0ab, 0xc37, 0xbe2, 0x773, 0x72c, 0x5ed, 0x167, 0x2f6
+};
+
+static const uint16_t ml_kem_mod_roots[128] = {
+    0xbd3, 0x12e, 0x1ef, 0xb12, 0xc53, 0x0ae, 0x82d, 0x4d4,
+    0x434, 0x8cd, 0xb06, 0x1fb, 0xbcf, 0x132, 0x0ed, 0xc14,
+    0x88d, 0x474, 0xbdd, 0x124, 0x664, 0x69d, 0x913, 0x3ee,
+    0x361, 0x9a0, 0x360, 0x9a1, 0x4f6, 0x80b, 0x7e3, 0x51e,
+    0x1eb, 0xb16, 0x02c, 0xcd5, 0x6e0, 0x621, 0x14e, 0xbb3,
+    0x8c1, 0x440, 0xbf6, 0x10b, 0xa4c, 0x2b5, 0x0f3, 0xc0e,
+    0x846, 0x4bb, 0x07a, 0xc87, 0x60f, 0x6f2, 0x72a, 0x5d7,
+    0xbdc, 0x125, 0xab4, 0x24d, 0xc00, 0x101, 0x6c5, 0x63c,
+    0xa2d, 0x2d4, 0xca5, 0x05c, 0xba2, 0x15f, 0x918, 0x3e9,
+    0x557, 0x7aa, 0xcd2, 0x02f, 0x5a9, 0x758, 0x779, 0x588,
+    0x06f, 0xc92, 0x876, 0x48b, 0x056, 0xcab, 0x8aa, 0x457,
+    0x136, 0xbcb, 0x015, 0xcec, 0x348, 0x9b9, 0x394, 0x96d,
+    0x821, 0x4e0, 0xaa9, 0x258, 0xa48, 0x2b9, 0xcf2, 0x00f,
+    0x71f, 0x5e2, 0xaad, 0x254, 0xae8, 0x219, 0x13e, 0xbc3,
+    0xb4f, 0x1b2, 0x7b0, 0x551, 0x869, 0x498, 0x2cb, 0xa36,
+    0x755, 0x5ac, 0xb47, 0x1ba, 0x8f6, 0x40b, 0x5cf, 0x732
+};
@@ -51,6 +51,20 @@ typedef struct rand_global_st {
      */
     EVP_RAND_CTX *primary;
 
+    /*
+     * Optional intermediate DRBGs between <primary> and the per thread
+     * <public> and <private> DRBGs.
+     *
+     * When there are shards, the per thread DRBGs are instantiated and
+     * reseeded from one of the shards rather than from <primary>, so that
+     * a large number of threads do not all contend for the lock of the
+     * <primary> DRBG.  The shards are created along with <primary> and
+     * don't change after that.
+     */
+    unsigned int num_shards;
+    EVP_RAND_CTX **shards;
+    TSAN_QUALIFIER unsigned int next_shard;
+
     /*
      * The provider which we'll use to generate randomness.
      */
@@ -273,6 +287,22 @@ end:
 }
 #endif /* OPENSSL_NO_DEPRECATED_3_0 */
 
+/*
+ * Reseed the shards after the primary DRBG has been reseeded, so that seed
+ * material added with RAND_seed() or RAND_add() reaches the per thread DRBGs
+ * as quickly as it does without shards.
+ */
+static void rand_reseed_shards(OSSL_LIB_CTX *ctx)
+{
+    RAND_GLOBAL *dgbl = rand_get_global(ctx);
+    unsigned int i;
+
+    if (dgbl == NULL || dgbl->shards == NULL)
+        return;
+    for (i = 0; i < dgbl->num_shards; i++)
+        EVP_RAND_reseed(dgbl->shards[i], 0, NULL, 0, NULL, 0);
+}
+
 void RAND_seed(const void *buf, int num)
 {
     EVP_RAND_CTX *drbg;
@@ -286,8 +316,10 @@ void RAND_seed(const void *buf, int num)
 #endif
 
     drbg = RAND_get0_primary(NULL);
-    if (drbg != NULL && num > 0)
+    if (drbg != NULL && num > 0) {
         EVP_RAND_reseed(drbg, 0, NULL, 0, buf, num);
+        rand_reseed_shards(NULL);
+    }
 }
 
 void RAND_add(const void *buf, int num, double randomness)
@@ -302,7 +334,7 @@ void RAND_add(const void *buf, int num, double randomness)
     }
 #endif
     drbg = RAND_get0_primary(NULL);
-    if (drbg != NULL && num > 0)
+    if (drbg != NULL && num > 0) {
 #ifdef OPENSSL_RAND_SEED_NONE
         /* Without an entropy source, we have to rely on the user */
         EVP_RAND_reseed(drbg, 0, buf, num, NULL, 0);
@@ -310,6 +342,8 @@ void RAND_add(const void *buf, int num, double randomness)
         /* With an entropy source, we downgrade this to additional input */
         EVP_RAND_reseed(drbg, 0, NULL, 0, buf, num);
 #endif
+        rand_reseed_shards(NULL);
+    }
 }
 
 #if !defined(OPENSSL_NO_DEPRECATED_1_1_0)
@@ -480,6 +514,17 @@ err0:
     return NULL;
 }
 
+static void rand_free_shards(EVP_RAND_CTX **shards, unsigned int num)
+{
+    unsigned int i;
+
+    if (shards == NULL)
+        return;
+    for (i = 0; i < num; i++)
+        EVP_RAND_CTX_free(shards[i]);
+    OPENSSL_free(shards);
+}
+
 void ossl_rand_ctx_free(void *vdgbl)
 {
     RAND_GLOBAL *dgbl = vdgbl;
@@ -488,6 +533,7 @@ void ossl_rand_ctx_free(void *vdgbl)
         return;
 
     CRYPTO_THREAD_lock_free(dgbl->lock);
+    rand_free_shards(dgbl->shards, dgbl->num_shards);
     EVP_RAND_CTX_free(dgbl->primary);
     EVP_RAND_CTX_free(dgbl->seed);
 #ifndef FIPS_MODULE
@@ -719,7 +765,8 @@ static EVP_RAND_CTX *rand_new_crngt(OSSL_LIB_CTX *libctx, EVP_RAND_CTX *parent)
  */
 static EVP_RAND_CTX *rand_get0_primary(OSSL_LIB_CTX *ctx, RAND_GLOBAL *dgbl)
 {
-    EVP_RAND_CTX *ret, *seed = NULL, *primary;
+    EVP_RAND_CTX *ret, *seed = NULL, *primary, **shards = NULL;
+    unsigned int i;
 
     if (dgbl == NULL)
         return NULL;
@@ -765,21 +812,47 @@ static EVP_RAND_CTX *rand_get0_primary(OSSL_LIB_CTX *ctx, RAND_GLOBAL *dgbl)
         return NULL;
     }
 
-    if (!CRYPTO_THREAD_write_lock(dgbl->lock)) {
-        EVP_RAND_CTX_free(ret);
-        return NULL;
+    /*
+     * The shards are shared between threads just like the primary DRBG.
+     * They are only asked for seed material when a per thread DRBG is
+     * instantiated or reseeded, so they use the primary's reseed intervals.
+     */
+    if (dgbl->num_shards > 0) {
+        shards = OPENSSL_calloc(dgbl->num_shards, sizeof(*shards));
+        if (shards == NULL)
+            goto err;
+        for (i = 0; i < dgbl->num_shards; i++) {
+            shards[i] = rand_new_drbg(ctx, ret, PRIMARY_RESEED_INTERVAL,
+                PRIMARY_RESEED_TIME_INTERVAL);
+            if (shards[i] == NULL)
+                goto err;
+            if (!EVP_RAND_enable_locking(shards[i])) {
+                ERR_raise(ERR_LIB_EVP, EVP_R_UNABLE_TO_ENABLE_LOCKING);
+                goto err;
+            }
+        }
     }
 
+    if (!CRYPTO_THREAD_write_lock(dgbl->lock))
+        goto err;
+
     primary = dgbl->primary;
     if (primary != NULL) {
         CRYPTO_THREAD_unlock(dgbl->lock);
+        rand_free_shards(shards, dgbl->num_shards);
         EVP_RAND_CTX_free(ret);
         return primary;
     }
+    dgbl->shards = shards;
     dgbl->primary = ret;
     CRYPTO_THREAD_unlock(dgbl->lock);
 
     return ret;
+
+err:
+    rand_free_shards(shards, dgbl->num_shards);
+    EVP_RAND_CTX_free(ret);
+    return NULL;
 }
 
 /*
@@ -794,9 +867,27 @@ EVP_RAND_CTX *RAND_get0_primary(OSSL_LIB_CTX *ctx)
     return dgbl == NULL ? NULL : rand_get0_primary(ctx, dgbl);
 }
 
+/*
+ * Get the parent for a new per thread DRBG.  This is the primary DRBG unless
+ * shards are in use, in which case the threads are spread across the shards
+ * in turn.
+ * Returns pointer to its EVP_RAND_CTX on success, NULL on failure.
+ */
+static EVP_RAND_CTX *rand_get0_parent(OSSL_LIB_CTX *ctx, RAND_GLOBAL *dgbl)
+{
+    EVP_RAND_CTX *primary = rand_get0_primary(ctx, dgbl);
+    unsigned int n;
+
+    /* The shards were published together with the primary DRBG */
+    if (primary == NULL || dgbl->shards == NULL)
+        return primary;
+    n = tsan_counter(&dgbl->next_shard);
+    return dgbl->shards[n % dgbl->num_shards];
+}
+
 static EVP_RAND_CTX *rand_get0_public(OSSL_LIB_CTX *ctx, RAND_GLOBAL *dgbl)
 {
-    EVP_RAND_CTX *rand, *primary;
+    EVP_RAND_CTX *rand, *parent;
     OSSL_LIB_CTX *origctx = ctx;
 
     ctx = ossl_lib_ctx_get_concrete(ctx);
@@ -809,8 +900,8 @@ static EVP_RAND_CTX *rand_get0_public(OSSL_LIB_CTX *ctx, RAND_GLOBAL *dgbl)
 
     rand = CRYPTO_THREAD_get_local_ex(CRYPTO_THREAD_LOCAL_DRBG_PUB_KEY, ctx);
     if (rand == NULL) {
-        primary = rand_get0_primary(origctx, dgbl);
-        if (primary == NULL)
+        parent = rand_get0_parent(origctx, dgbl);
+        if (parent == NULL)
             return NULL;
 
         /*
@@ -820,7 +911,7 @@ static EVP_RAND_CTX *rand_get0_public(OSSL_LIB_CTX *ctx, RAND_GLOBAL *dgbl)
         if (CRYPTO_THREAD_get_local_ex(CRYPTO_THREAD_LOCAL_DRBG_PRIV_KEY, ctx) == NULL
             && !ossl_init_thread_start(NULL, ctx, rand_delete_thread_state))
             return NULL;
-        rand = rand_new_drbg(ctx, primary, SECONDARY_RESEED_INTERVAL,
+        rand = rand_new_drbg(ctx, parent, SECONDARY_RESEED_INTERVAL,
             SECONDARY_RESEED_TIME_INTERVAL);
         if (!CRYPTO_THREAD_set_local_ex(CRYPTO_THREAD_LOCAL_DRBG_PUB_KEY, ctx, rand)) {
             EVP_RAND_CTX_free(rand);
@@ -843,7 +934,7 @@ EVP_RAND_CTX *RAND_get0_public(OSSL_LIB_CTX *ctx)
 
 static EVP_RAND_CTX *rand_get0_private(OSSL_LIB_CTX *ctx, RAND_GLOBAL *dgbl)
 {
-    EVP_RAND_CTX *rand, *primary;
+    EVP_RAND_CTX *rand, *parent;
     OSSL_LIB_CTX *origctx = ctx;
 
     ctx = ossl_lib_ctx_get_concrete(ctx);
@@ -852,8 +943,8 @@ static EVP_RAND_CTX *rand_get0_private(OSSL_LIB_CTX *ctx, RAND_GLOBAL *dgbl)
 
     rand = CRYPTO_THREAD_get_local_ex(CRYPTO_THREAD_LOCAL_DRBG_PRIV_KEY, ctx);
     if (rand == NULL) {
-        primary = rand_get0_primary(origctx, dgbl);
-        if (primary == NULL)
+        parent = rand_get0_parent(origctx, dgbl);
+        if (parent == NULL)
             return NULL;
 
         /*
@@ -863,7 +954,7 @@ static EVP_RAND_CTX *rand_get0_private(OSSL_LIB_CTX *ctx, RAND_GLOBAL *dgbl)
         if (CRYPTO_THREAD_get_local_ex(CRYPTO_THREAD_LOCAL_DRBG_PUB_KEY, ctx) == NULL
             && !ossl_init_thread_start(NULL, ctx, rand_delete_thread_state))
             return NULL;
-        rand = rand_new_drbg(ctx, primary, SECONDARY_RESEED_INTERVAL,
+        rand = rand_new_drbg(ctx, parent, SECONDARY_RESEED_INTERVAL,
             SECONDARY_RESEED_TIME_INTERVAL);
         if (!CRYPTO_THREAD_set_local_ex(CRYPTO_THREAD_LOCAL_DRBG_PRIV_KEY, ctx, rand)) {
             EVP_RAND_CTX_free(rand);
@@ -983,6 +1074,18 @@ static int random_conf_init(CONF_IMODULE *md, const CONF *cnf)
         } else if (OPENSSL_strcasecmp(cval->name, "seed_properties") == 0) {
             if (!random_set_string(&dgbl->seed_propq, cval->value))
                 return 0;
+        } else if (OPENSSL_strcasecmp(cval->name, "shards") == 0) {
+            long shards;
+
+            if (!NCONF_get_number_e(cnf, CONF_imodule_get_value(md),
+                    cval->name, &shards)
+                || shards < 0
+                || !RAND_set_DRBG_shards(libctx, (unsigned int)shards)) {
+                ERR_raise_data(ERR_LIB_CRYPTO,
+                    CRYPTO_R_RANDOM_SECTION_ERROR,
+                    "name=%s, value=%s", cval->name, cval->value);
+                return 0;
+            }
         } else if (OPENSSL_strcasecmp(cval->name, "random_provider") == 0) {
 #ifndef FIPS_MODULE
             OSSL_PROVIDER *prov = ossl_provider_find(libctx, cval->value, 0);
@@ -1046,6 +1149,24 @@ int RAND_set_DRBG_type(OSSL_LIB_CTX *ctx, const char *drbg, const char *propq,
         && random_set_string(&dgbl->rng_digest, digest);
 }
 
+int RAND_set_DRBG_shards(OSSL_LIB_CTX *ctx, unsigned int shards)
+{
+    RAND_GLOBAL *dgbl = rand_get_global(ctx);
+
+    if (dgbl == NULL)
+        return 0;
+    if (dgbl->primary != NULL) {
+        ERR_raise(ERR_LIB_RAND, RAND_R_ALREADY_INSTANTIATED);
+        return 0;
+    }
+    if (shards > RAND_DRBG_MAX_SHARDS) {
+        ERR_raise(ERR_LIB_RAND, RAND_R_ARGUMENT_OUT_OF_RANGE);
+        return 0;
+    }
+    dgbl->num_shards = shards;
+    return 1;
+}
+
 int RAND_set_seed_source_type(OSSL_LIB_CTX *ctx, const char *seed,
     const char *propq)
 {
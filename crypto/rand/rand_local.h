@@ -25,6 +25,9 @@
 #define PRIMARY_RESEED_TIME_INTERVAL (60 * 60) /* 1 hour */
 #define SECONDARY_RESEED_TIME_INTERVAL (7 * 60) /* 7 minutes */
 
+/* Upper limit for the number of intermediate DRBG shards */
+#define RAND_DRBG_MAX_SHARDS 1024
+
 #ifndef FIPS_MODULE
 /* The global RAND method, and the global buffer and DRBG instance. */
 extern RAND_METHOD ossl_rand_meth;
@@ -0,0 +1,456 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * SHAKE of four independent messages of the same length at once, either in
+ * one go or absorbing once and then squeezing the four streams in lock step.
+ *
+ * On x86_64 the messages are hashed with the Keccak-f[1600] below, which runs
+ * four permutations side by side in the 64-bit lanes of AVX2 registers. It is
+ * at least as fast as keccak1600x4-avx512vl.pl, which is only used where the
+ * AVX2 code cannot be compiled. Elsewhere they are hashed one after the other.
+ */
+
+#include <string.h>
+#include <openssl/byteorder.h>
+#include <openssl/crypto.h>
+#include "internal/cryptlib.h"
+#include "internal/sha3.h"
+
+#define SHAKE_PAD 0x1f
+
+#if defined(KECCAK1600_ASM)                                                               \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
+    && !defined(OPENSSL_NO_ASM)
+#define SHA3_X4_AVX512VL
+#endif
+
+#if defined(OPENSSL_CPUID_OBJ) \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64))
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 8)
+#define SHA3_X4_AVX2
+#endif
+#endif
+
+void SHA3_squeeze(uint64_t A[5][5], unsigned char *out, size_t len, size_t r,
+    int next);
+
+#define X4_SCALAR 0
+#define X4_AVX2 1
+#define X4_AVX512VL 2
+
+/*
+ * Absorb one message per state and pad it, leaving the last block unpermuted,
+ * where there is nothing better.
+ */
+static void absorb_x1(KECCAK1600_X4_CTX *ctx,
+    const unsigned char *const in[4], size_t inlen)
+{
+    uint64_t A[25], w;
+    unsigned char block[SHA3_BLOCKSIZE(128)];
+    size_t r = ctx->rate, rem, i, j;
+
+    for (j = 0; j < 4; j++) {
+        memset(A, 0, sizeof(A));
+        rem = SHA3_absorb((uint64_t(*)[5])A, in[j], inlen, r);
+        memset(block, 0, r);
+        memcpy(block, in[j] + inlen - rem, rem);
+        block[rem] ^= SHAKE_PAD;
+        block[r - 1] ^= 0x80;
+        for (i = 0; i < 25; i++) {
+            if (8 * i < r) {
+                OPENSSL_load_u64_le(&w, block + 8 * i);
+                A[i] ^= w;
+            }
+            ctx->A[i][j] = A[i];
+        }
+    }
+    OPENSSL_cleanse(block, sizeof(block));
+    OPENSSL_cleanse(A, sizeof(A));
+}
+
+/* Squeeze |n| blocks of each state, one state after the other */
+static void squeeze_x1(KECCAK1600_X4_CTX *ctx, unsigned char *const out[4],
+    size_t n)
+{
+    uint64_t A[25];
+    size_t r = ctx->rate, i, j;
+
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 25; i++)
+            A[i] = ctx->A[i][j];
+        SHA3_squeeze((uint64_t(*)[5])A, out[j], n * r, r, 1);
+        for (i = 0; i < 25; i++)
+            ctx->A[i][j] = A[i];
+    }
+    OPENSSL_cleanse(A, sizeof(A));
+}
+
+#ifdef SHA3_X4_AVX2
+#include <immintrin.h>
+
+#define STRINGIFY_IMPLEMENTATION_(a) #a
+#define STRINGIFY(a) STRINGIFY_IMPLEMENTATION_(a)
+
+#ifdef __clang__
+#define OPENSSL_TARGET_AVX2                                              \
+    _Pragma(STRINGIFY(clang attribute push(__attribute__((target("avx2"))), \
+        apply_to = function)))
+#define OPENSSL_UNTARGET_AVX2 _Pragma("clang attribute pop")
+#else
+#define OPENSSL_TARGET_AVX2 \
+    _Pragma("GCC push_options") _Pragma(STRINGIFY(GCC target("avx2")))
+#define OPENSSL_UNTARGET_AVX2 _Pragma("GCC pop_options")
+#endif
+
+static const uint64_t iotas[24] = {
+    UINT64_C(0x0000000000000001), UINT64_C(0x0000000000008082),
+    UINT64_C(0x800000000000808a), UINT64_C(0x8000000080008000),
+    UINT64_C(0x000000000000808b), UINT64_C(0x0000000080000001),
+    UINT64_C(0x8000000080008081), UINT64_C(0x8000000000008009),
+    UINT64_C(0x000000000000008a), UINT64_C(0x0000000000000088),
+    UINT64_C(0x0000000080008009), UINT64_C(0x000000008000000a),
+    UINT64_C(0x000000008000808b), UINT64_C(0x800000000000008b),
+    UINT64_C(0x8000000000008089), UINT64_C(0x8000000000008003),
+    UINT64_C(0x8000000000008002), UINT64_C(0x8000000000000080),
+    UINT64_C(0x000000000000800a), UINT64_C(0x800000008000000a),
+    UINT64_C(0x8000000080008081), UINT64_C(0x8000000000008080),
+    UINT64_C(0x0000000080000001), UINT64_C(0x8000000080008008)
+};
+
+OPENSSL_TARGET_AVX2
+
+#define ROL64(a, n) \
+    _mm256_or_si256(_mm256_slli_epi64((a), (n)), _mm256_srli_epi64((a), 64 - (n)))
+
+/*
+ * Keccak-f[1600] of four states, A[x + 5 * y] holding lane (x, y) of each
+ * of them.
+ */
+static void keccak_f1600_x4(__m256i A[25])
+{
+    __m256i B[25], C[5], D[5];
+    size_t i, x, y;
+
+    for (i = 0; i < 24; i++) {
+        /* Theta */
+        for (x = 0; x < 5; x++)
+            C[x] = _mm256_xor_si256(_mm256_xor_si256(A[x], A[x + 5]),
+                _mm256_xor_si256(_mm256_xor_si256(A[x + 10], A[x + 15]),
+                    A[x + 20]));
+        for (x = 0; x < 5; x++)
+            D[x] = _mm256_xor_si256(C[(x + 4) % 5], ROL64(C[(x + 1) % 5], 1));
+        for (y = 0; y < 25; y += 5)
+            for (x = 0; x < 5; x++)
+                A[y + x] = _mm256_xor_si256(A[y + x], D[x]);
+
+        /* Rho and Pi */
+        B[0] = A[0];
+        B[1] = ROL64(A[6], 44);
+        B[2] = ROL64(A[12], 43);
+        B[3] = ROL64(A[18], 21);
+        B[4] = ROL64(A[24], 14);
+        B[5] = ROL64(A[3], 28);
+        B[6] = ROL64(A[9], 20);
+        B[7] = ROL64(A[10], 3);
+        B[8] = ROL64(A[16], 45);
+        B[9] = ROL64(A[22], 61);
+        B[10] = ROL64(A[1], 1);
+        B[11] = ROL64(A[7], 6);
+        B[12] = ROL64(A[13], 25);
+        B[13] = ROL64(A[19], 8);
+        B[14] = ROL64(A[20], 18);
+        B[15] = ROL64(A[4], 27);
+        B[16] = ROL64(A[5], 36);
+        B[17] = ROL64(A[11], 10);
+        B[18] = ROL64(A[17], 15);
+        B[19] = ROL64(A[23], 56);
+        B[20] = ROL64(A[2], 62);
+        B[21] = ROL64(A[8], 55);
+        B[22] = ROL64(A[14], 39);
+        B[23] = ROL64(A[15], 41);
+        B[24] = ROL64(A[21], 2);
+
+        /* Chi */
+        for (y = 0; y < 25; y += 5)
+            for (x = 0; x < 5; x++)
+                A[y + x] = _mm256_xor_si256(B[y + x],
+                    _mm256_andnot_si256(B[y + (x + 1) % 5],
+                        B[y + (x + 2) % 5]));
+
+        /* Iota */
+        A[0] = _mm256_xor_si256(A[0], _mm256_set1_epi64x((long long)iotas[i]));
+    }
+}
+
+/* XOR a block of |r| bytes of each message into the states */
+static void absorb_x4(__m256i A[25], const unsigned char *const in[4], size_t r)
+{
+    uint64_t w[4];
+    size_t i, j;
+
+    for (i = 0; i < r / 8; i++) {
+        for (j = 0; j < 4; j++)
+            OPENSSL_load_u64_le(&w[j], in[j] + 8 * i);
+        A[i] = _mm256_xor_si256(A[i],
+            _mm256_set_epi64x((long long)w[3], (long long)w[2],
+                (long long)w[1], (long long)w[0]));
+    }
+}
+
+static void absorb_avx2(KECCAK1600_X4_CTX *ctx,
+    const unsigned char *const in[4], size_t inlen)
+{
+    unsigned char block[4][SHA3_BLOCKSIZE(128)];
+    const unsigned char *p[4];
+    __m256i A[25];
+    size_t r = ctx->rate, i, j, off;
+
+    for (i = 0; i < 25; i++)
+        A[i] = _mm256_setzero_si256();
+
+    for (off = 0; inlen - off >= r; off += r) {
+        for (j = 0; j < 4; j++)
+            p[j] = in[j] + off;
+        absorb_x4(A, p, r);
+        keccak_f1600_x4(A);
+    }
+    for (j = 0; j < 4; j++) {
+        memset(block[j], 0, r);
+        memcpy(block[j], in[j] + off, inlen - off);
+        block[j][inlen - off] ^= SHAKE_PAD;
+        block[j][r - 1] ^= 0x80;
+        p[j] = block[j];
+    }
+    absorb_x4(A, p, r);
+
+    for (i = 0; i < 25; i++)
+        _mm256_storeu_si256((__m256i *)ctx->A[i], A[i]);
+    OPENSSL_cleanse(block, sizeof(block));
+    OPENSSL_cleanse(A, sizeof(A));
+}
+
+/* Squeeze |n| blocks of each state */
+static void squeeze_avx2(KECCAK1600_X4_CTX *ctx, unsigned char *const out[4],
+    size_t n)
+{
+    __m256i A[25];
+    size_t r = ctx->rate, i, j, off;
+
+    for (i = 0; i < 25; i++)
+        A[i] = _mm256_loadu_si256((const __m256i *)ctx->A[i]);
+
+    for (off = 0; n > 0; n--, off += r) {
+        keccak_f1600_x4(A);
+        for (i = 0; 8 * i < r; i++) {
+            _mm256_storeu_si256((__m256i *)ctx->A[i], A[i]);
+            for (j = 0; j < 4; j++)
+                OPENSSL_store_u64_le(out[j] + off + 8 * i, ctx->A[i][j]);
+        }
+    }
+
+    for (i = 0; i < 25; i++)
+        _mm256_storeu_si256((__m256i *)ctx->A[i], A[i]);
+    OPENSSL_cleanse(A, sizeof(A));
+}
+
+OPENSSL_UNTARGET_AVX2
+
+static ossl_inline int avx2_capable(void)
+{
+    return (OPENSSL_ia32cap_P[2] & (1u << 5)) != 0;
+}
+#endif /* SHA3_X4_AVX2 */
+
+int ossl_sha3_shake_x4_capable(void)
+{
+#ifdef SHA3_X4_AVX2
+    if (avx2_capable())
+        return 1;
+#endif
+#ifdef SHA3_X4_AVX512VL
+    if (SHA3_avx512vl_capable())
+        return 1;
+#endif
+    return 0;
+}
+
+#ifdef SHA3_X4_AVX512VL
+/* Whether to use keccak1600x4-avx512vl.pl, rather than the AVX2 code */
+static ossl_inline int use_avx512vl(void)
+{
+#ifdef SHA3_X4_AVX2
+    if (avx2_capable())
+        return 0;
+#endif
+    return SHA3_avx512vl_capable();
+}
+#endif
+
+static void shake_x4_init(KECCAK1600_X4_CTX *ctx, size_t bitlen,
+    const void *in0, const void *in1, const void *in2, const void *in3,
+    size_t inlen)
+{
+    const unsigned char *const in[4] = { in0, in1, in2, in3 };
+
+    ctx->rate = SHA3_BLOCKSIZE(bitlen);
+    ctx->bufsz = 0;
+#ifdef SHA3_X4_AVX2
+    if (avx2_capable()) {
+        ctx->impl = X4_AVX2;
+        absorb_avx2(ctx, in, inlen);
+        return;
+    }
+#endif
+#ifdef SHA3_X4_AVX512VL
+    if (use_avx512vl()) {
+        ctx->impl = X4_AVX512VL;
+        if (bitlen == 128) {
+            ossl_sha3_shake128_x4_inc_init_avx512vl(&ctx->avx512vl);
+            ossl_sha3_shake128_x4_inc_absorb_avx512vl(&ctx->avx512vl,
+                in0, in1, in2, in3, inlen);
+        } else {
+            ossl_sha3_shake256_x4_inc_init_avx512vl(&ctx->avx512vl);
+            ossl_sha3_shake256_x4_inc_absorb_avx512vl(&ctx->avx512vl,
+                in0, in1, in2, in3, inlen);
+        }
+        return;
+    }
+#endif
+    ctx->impl = X4_SCALAR;
+    absorb_x1(ctx, in, inlen);
+}
+
+/*
+ * Start SHAKE128 or SHAKE256 of four messages of |inlen| bytes each, to be
+ * followed by any number of ossl_sha3_shake_x4_squeeze() calls and a final
+ * ossl_sha3_shake_x4_cleanup().
+ */
+void ossl_sha3_shake128_x4_init(KECCAK1600_X4_CTX *ctx,
+    const void *in0, const void *in1, const void *in2, const void *in3,
+    size_t inlen)
+{
+    shake_x4_init(ctx, 128, in0, in1, in2, in3, inlen);
+}
+
+void ossl_sha3_shake256_x4_init(KECCAK1600_X4_CTX *ctx,
+    const void *in0, const void *in1, const void *in2, const void *in3,
+    size_t inlen)
+{
+    shake_x4_init(ctx, 256, in0, in1, in2, in3, inlen);
+}
+
+static void squeeze_blocks(KECCAK1600_X4_CTX *ctx,
+    unsigned char *const out[4], size_t n)
+{
+#ifdef SHA3_X4_AVX2
+    if (ctx->impl == X4_AVX2) {
+        squeeze_avx2(ctx, out, n);
+        return;
+    }
+#endif
+    squeeze_x1(ctx, out, n);
+}
+
+/* Write the next |outlen| bytes of each of the four streams */
+void ossl_sha3_shake_x4_squeeze(KECCAK1600_X4_CTX *ctx,
+    void *out0, void *out1, void *out2, void *out3, size_t outlen)
+{
+    unsigned char *const out[4] = { out0, out1, out2, out3 };
+    unsigned char *p[4];
+    size_t r = ctx->rate, off = 0, len, j;
+
+#ifdef SHA3_X4_AVX512VL
+    if (ctx->impl == X4_AVX512VL) {
+        if (r == SHA3_BLOCKSIZE(128))
+            ossl_sha3_shake128_x4_inc_squeeze_avx512vl(out0, out1, out2, out3,
+                outlen, &ctx->avx512vl);
+        else
+            ossl_sha3_shake256_x4_inc_squeeze_avx512vl(out0, out1, out2, out3,
+                outlen, &ctx->avx512vl);
+        return;
+    }
+#endif
+    while (off < outlen) {
+        if (ctx->bufsz == 0) {
+            /* Whole blocks go straight to the output */
+            if (outlen - off >= r) {
+                len = (outlen - off) / r;
+                for (j = 0; j < 4; j++)
+                    p[j] = out[j] + off;
+                squeeze_blocks(ctx, p, len);
+                off += len * r;
+                continue;
+            }
+            for (j = 0; j < 4; j++)
+                p[j] = ctx->buf[j];
+            squeeze_blocks(ctx, p, 1);
+            ctx->bufsz = r;
+        }
+        len = outlen - off < ctx->bufsz ? outlen - off : ctx->bufsz;
+        for (j = 0; j < 4; j++)
+            memcpy(out[j] + off, ctx->buf[j] + r - ctx->bufsz, len);
+        ctx->bufsz -= len;
+        off += len;
+    }
+}
+
+void ossl_sha3_shake_x4_cleanup(KECCAK1600_X4_CTX *ctx)
+{
+#ifdef SHA3_X4_AVX512VL
+    if (ctx->impl == X4_AVX512VL) {
+        ossl_sha3_shake128_x4_inc_cleanup_avx512vl(&ctx->avx512vl);
+        return;
+    }
+#endif
+    OPENSSL_cleanse(ctx->A, sizeof(ctx->A));
+    OPENSSL_cleanse(ctx->buf, sizeof(ctx->buf));
+}
+
+static void shake_x4(size_t bitlen, void *out0, void *out1, void *out2,
+    void *out3, size_t outlen,
+    const void *in0, const void *in1, const void *in2, const void *in3,
+    size_t inlen)
+{
+    KECCAK1600_X4_CTX ctx;
+
+    shake_x4_init(&ctx, bitlen, in0, in1, in2, in3, inlen);
+    ossl_sha3_shake_x4_squeeze(&ctx, out0, out1, out2, out3, outlen);
+    ossl_sha3_shake_x4_cleanup(&ctx);
+}
+
+void ossl_sha3_shake128_x4(void *out0, void *out1, void *out2, void *out3,
+    size_t outlen,
+    const void *in0, const void *in1, const void *in2, const void *in3,
+    size_t inlen)
+{
+#ifdef SHA3_X4_AVX512VL
+    if (use_avx512vl()) {
+        ossl_sha3_shake128_x4_avx512vl(out0, out1, out2, out3, outlen,
+            in0, in1, in2, in3, inlen);
+        return;
+    }
+#endif
+    shake_x4(128, out0, out1, out2, out3, outlen, in0, in1, in2, in3, inlen);
+}
+
+void ossl_sha3_shake256_x4(void *out0, void *out1, void *out2, void *out3,
+    size_t outlen,
+    const void *in0, const void *in1, const void *in2, const void *in3,
+    size_t inlen)
+{
+#ifdef SHA3_X4_AVX512VL
+    if (use_avx512vl()) {
+        ossl_sha3_shake256_x4_avx512vl(out0, out1, out2, out3, outlen,
+            in0, in1, in2, in3, inlen);
+        return;
+    }
+#endif
+    shake_x4(256, out0, out1, out2, out3, outlen, in0, in1, in2, in3, inlen);
+}
@@ -0,0 +1,453 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * SHA256 and SHA512 low level APIs are deprecated for public use, but still ok
+ * for internal use.
+ */
+#include "internal/deprecated.h"
+
+#include <string.h>
+#include <openssl/byteorder.h>
+#include <openssl/crypto.h>
+#include <openssl/sha.h>
+#include "internal/cryptlib.h"
+#include "crypto/sha.h"
+
+/*
+ * Hashing of many independent messages at once.
+ *
+ * Hashing one message is a chain of dependent rounds that leaves most of the
+ * lanes of the vector units idle. Hashing several messages side by side, one
+ * per lane, does not make any one of them faster, but gets several done in
+ * about the time of one.
+ *
+ * SHA-224 and SHA-256 use sha256_multi_block() from sha256-mb-x86_64.pl,
+ * which hashes 4 messages at once with SSSE3 or AVX, 8 with AVX2, and pairs
+ * of them with the SHA extensions. The SHA extensions make hashing a single
+ * message nearly as fast, so with them short messages are hashed one after
+ * the other. The messages may also continue a common prefix, as SLH-DSA
+ * hashes everything after a block holding PK.seed. SHA-384 and SHA-512 hash
+ * 4 messages at once with AVX2. Everywhere else, and for the last message of
+ * an odd batch, the messages are hashed one after the other.
+ */
+
+#if defined(OPENSSL_CPUID_OBJ) \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64))
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 8)
+#define SHA512_MB_AVX2
+#endif
+#endif
+
+#ifdef SHA256_MB_ASM
+
+/* The state of 8 lanes, h[i][j] being word i of the state of lane j */
+typedef struct {
+    unsigned int h[8][8];
+} SHA256_MB_CTX;
+
+typedef struct {
+    const unsigned char *ptr;
+    int blocks;
+} HASH_DESC;
+
+void sha256_multi_block(SHA256_MB_CTX *, const HASH_DESC *, int);
+
+#define SHA256_MB_LANES 8
+/* The block counts passed to sha256_multi_block() are ints */
+#define SHA256_MB_MAX_BLOCKS (1 << 20)
+/* Shorter messages are hashed one at a time with the SHA extensions */
+#define SHA256_MB_SHAEXT_MIN (4 * SHA256_CBLOCK)
+
+/*
+ * Continue |init|, which has hashed a whole number of blocks, with each of
+ * the n <= 8 messages, and output the first |outlen| bytes of each digest.
+ */
+static void sha256_multi_x8(const SHA256_CTX *init, size_t n,
+    const unsigned char *const in[], const size_t inl[],
+    unsigned char *const out[], size_t outlen)
+{
+    unsigned char storage[sizeof(SHA256_MB_CTX) + 32];
+    SHA256_MB_CTX *mctx = (SHA256_MB_CTX *)(storage + 32 - ((size_t)storage % 32));
+    unsigned char tail[SHA256_MB_LANES][2 * SHA256_CBLOCK];
+    unsigned char md[SHA256_DIGEST_LENGTH];
+    const unsigned char *ptr[SHA256_MB_LANES];
+    size_t left[SHA256_MB_LANES], blocks, more, r;
+    uint64_t prefix = ((uint64_t)init->Nh << 32) | init->Nl;
+    HASH_DESC desc[SHA256_MB_LANES];
+    size_t i, j;
+
+    for (i = 0; i < SHA256_MB_LANES; i++) {
+        ptr[i] = i < n ? in[i] : NULL;
+        left[i] = i < n ? inl[i] / SHA256_CBLOCK : 0;
+        for (j = 0; j < 8; j++)
+            mctx->h[j][i] = init->h[j];
+    }
+
+    /* Whole blocks, which lanes without any more skip */
+    do {
+        more = 0;
+        for (i = 0; i < SHA256_MB_LANES; i++) {
+            blocks = left[i] < SHA256_MB_MAX_BLOCKS ? left[i]
+                                                    : SHA256_MB_MAX_BLOCKS;
+            desc[i].ptr = ptr[i];
+            desc[i].blocks = (int)blocks;
+            if (blocks > 0)
+                ptr[i] += blocks * SHA256_CBLOCK;
+            left[i] -= blocks;
+            more |= blocks;
+        }
+        if (more != 0)
+            sha256_multi_block(mctx, desc, SHA256_MB_LANES / 4);
+    } while (more != 0);
+
+    /* The rest of each message with its padding, in one or two blocks */
+    memset(tail, 0, sizeof(tail));
+    for (i = 0; i < SHA256_MB_LANES; i++) {
+        desc[i].ptr = tail[i];
+        desc[i].blocks = 0;
+        if (i >= n)
+            continue;
+        r = inl[i] % SHA256_CBLOCK;
+        memcpy(tail[i], ptr[i], r);
+        tail[i][r] = 0x80;
+        desc[i].blocks = r < SHA256_CBLOCK - 8 ? 1 : 2;
+        OPENSSL_store_u64_be(tail[i] + desc[i].blocks * SHA256_CBLOCK - 8,
+            prefix + ((uint64_t)inl[i] << 3));
+    }
+    sha256_multi_block(mctx, desc, SHA256_MB_LANES / 4);
+
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < 8; j++)
+            OPENSSL_store_u32_be(md + 4 * j, mctx->h[j][i]);
+        memcpy(out[i], md, outlen);
+    }
+
+    OPENSSL_cleanse(md, sizeof(md));
+    OPENSSL_cleanse(tail, sizeof(tail));
+    OPENSSL_cleanse(storage, sizeof(storage));
+}
+#endif /* SHA256_MB_ASM */
+
+/*
+ * Whether ossl_sha256_multi_from() hashes messages of |inl| bytes that follow
+ * a whole number of blocks side by side, rather than one after the other.
+ */
+int ossl_sha256_multi_capable(size_t inl)
+{
+#ifdef SHA256_MB_ASM
+    /* Needs SSSE3 */
+    return (OPENSSL_ia32cap_P[1] & (1 << (41 - 32))) != 0
+        && ((OPENSSL_ia32cap_P[2] & (1u << 29)) == 0
+            || inl >= SHA256_MB_SHAEXT_MIN);
+#else
+    return 0;
+#endif
+}
+
+int ossl_sha256_multi_from(const SHA256_CTX *init, size_t n,
+    const unsigned char *const in[], const size_t inl[],
+    unsigned char *const out[], size_t outlen)
+{
+    unsigned char md[SHA256_DIGEST_LENGTH];
+    SHA256_CTX c;
+    size_t i = 0;
+
+    if (outlen > SHA256_DIGEST_LENGTH)
+        return 0;
+
+#ifdef SHA256_MB_ASM
+    if (n > 0 && init->num == 0 && ossl_sha256_multi_capable(inl[0])) {
+        while (n - i >= 2) {
+            size_t m = n - i < SHA256_MB_LANES ? n - i : SHA256_MB_LANES;
+
+            sha256_multi_x8(init, m, in + i, inl + i, out + i, outlen);
+            i += m;
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        c = *init;
+        c.md_len = SHA256_DIGEST_LENGTH;
+        if (!SHA256_Update(&c, in[i], inl[i]) || !SHA256_Final(md, &c))
+            return 0;
+        memcpy(out[i], md, outlen);
+    }
+    OPENSSL_cleanse(md, sizeof(md));
+    OPENSSL_cleanse(&c, sizeof(c));
+    return 1;
+}
+
+int ossl_sha256_multi(size_t md_len, size_t n, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[])
+{
+    SHA256_CTX c;
+
+    if (md_len == SHA224_DIGEST_LENGTH)
+        SHA224_Init(&c);
+    else
+        SHA256_Init(&c);
+    return ossl_sha256_multi_from(&c, n, in, inl, out, md_len);
+}
+
+#ifdef SHA512_MB_AVX2
+#include <immintrin.h>
+
+#define STRINGIFY_IMPLEMENTATION_(a) #a
+#define STRINGIFY(a) STRINGIFY_IMPLEMENTATION_(a)
+
+#ifdef __clang__
+#define OPENSSL_TARGET_AVX2                                              \
+    _Pragma(STRINGIFY(clang attribute push(__attribute__((target("avx2"))), \
+        apply_to = function)))
+#define OPENSSL_UNTARGET_AVX2 _Pragma("clang attribute pop")
+#else
+#define OPENSSL_TARGET_AVX2 \
+    _Pragma("GCC push_options") _Pragma(STRINGIFY(GCC target("avx2")))
+#define OPENSSL_UNTARGET_AVX2 _Pragma("GCC pop_options")
+#endif
+
+#define SHA512_MB_LANES 4
+
+static const uint64_t K512[80] = {
+    UINT64_C(0x428a2f98d728ae22), UINT64_C(0x7137449123ef65cd),
+    UINT64_C(0xb5c0fbcfec4d3b2f), UINT64_C(0xe9b5dba58189dbbc),
+    UINT64_C(0x3956c25bf348b538), UINT64_C(0x59f111f1b605d019),
+    UINT64_C(0x923f82a4af194f9b), UINT64_C(0xab1c5ed5da6d8118),
+    UINT64_C(0xd807aa98a3030242), UINT64_C(0x12835b0145706fbe),
+    UINT64_C(0x243185be4ee4b28c), UINT64_C(0x550c7dc3d5ffb4e2),
+    UINT64_C(0x72be5d74f27b896f), UINT64_C(0x80deb1fe3b1696b1),
+    UINT64_C(0x9bdc06a725c71235), UINT64_C(0xc19bf174cf692694),
+    UINT64_C(0xe49b69c19ef14ad2), UINT64_C(0xefbe4786384f25e3),
+    UINT64_C(0x0fc19dc68b8cd5b5), UINT64_C(0x240ca1cc77ac9c65),
+    UINT64_C(0x2de92c6f592b0275), UINT64_C(0x4a7484aa6ea6e483),
+    UINT64_C(0x5cb0a9dcbd41fbd4), UINT64_C(0x76f988da831153b5),
+    UINT64_C(0x983e5152ee66dfab), UINT64_C(0xa831c66d2db43210),
+    UINT64_C(0xb00327c898fb213f), UINT64_C(0xbf597fc7beef0ee4),
+    UINT64_C(0xc6e00bf33da88fc2), UINT64_C(0xd5a79147930aa725),
+    UINT64_C(0x06ca6351e003826f), UINT64_C(0x142929670a0e6e70),
+    UINT64_C(0x27b70a8546d22ffc), UINT64_C(0x2e1b21385c26c926),
+    UINT64_C(0x4d2c6dfc5ac42aed), UINT64_C(0x53380d139d95b3df),
+    UINT64_C(0x650a73548baf63de), UINT64_C(0x766a0abb3c77b2a8),
+    UINT64_C(0x81c2c92e47edaee6), UINT64_C(0x92722c851482353b),
+    UINT64_C(0xa2bfe8a14cf10364), UINT64_C(0xa81a664bbc423001),
+    UINT64_C(0xc24b8b70d0f89791), UINT64_C(0xc76c51a30654be30),
+    UINT64_C(0xd192e819d6ef5218), UINT64_C(0xd69906245565a910),
+    UINT64_C(0xf40e35855771202a), UINT64_C(0x106aa07032bbd1b8),
+    UINT64_C(0x19a4c116b8d2d0c8), UINT64_C(0x1e376c085141ab53),
+    UINT64_C(0x2748774cdf8eeb99), UINT64_C(0x34b0bcb5e19b48a8),
+    UINT64_C(0x391c0cb3c5c95a63), UINT64_C(0x4ed8aa4ae3418acb),
+    UINT64_C(0x5b9cca4f7763e373), UINT64_C(0x682e6ff3d6b2b8a3),
+    UINT64_C(0x748f82ee5defb2fc), UINT64_C(0x78a5636f43172f60),
+    UINT64_C(0x84c87814a1f0ab72), UINT64_C(0x8cc702081a6439ec),
+    UINT64_C(0x90befffa23631e28), UINT64_C(0xa4506cebde82bde9),
+    UINT64_C(0xbef9a3f7b2c67915), UINT64_C(0xc67178f2e372532b),
+    UINT64_C(0xca273eceea26619c), UINT64_C(0xd186b8c721c0c207),
+    UINT64_C(0xeada7dd6cde0eb1e), UINT64_C(0xf57d4f7fee6ed178),
+    UINT64_C(0x06f067aa72176fba), UINT64_C(0x0a637dc5a2c898a6),
+    UINT64_C(0x113f9804bef90dae), UINT64_C(0x1b710b35131c471b),
+    UINT64_C(0x28db77f523047d84), UINT64_C(0x32caab7b40c72493),
+    UINT64_C(0x3c9ebe0a15c9bebc), UINT64_C(0x431d67c49c100d4c),
+    UINT64_C(0x4cc5d4becb3e42b6), UINT64_C(0x597f299cfc657e2a),
+    UINT64_C(0x5fcb6fab3ad6faec), UINT64_C(0x6c44198c4a475817)
+};
+
+OPENSSL_TARGET_AVX2
+
+#define ROTR64(x, n) \
+    _mm256_or_si256(_mm256_srli_epi64((x), (n)), _mm256_slli_epi64((x), 64 - (n)))
+#define Sigma0(x) \
+    _mm256_xor_si256(ROTR64((x), 28), _mm256_xor_si256(ROTR64((x), 34), ROTR64((x), 39)))
+#define Sigma1(x) \
+    _mm256_xor_si256(ROTR64((x), 14), _mm256_xor_si256(ROTR64((x), 18), ROTR64((x), 41)))
+#define sigma0(x) \
+    _mm256_xor_si256(ROTR64((x), 1), _mm256_xor_si256(ROTR64((x), 8), _mm256_srli_epi64((x), 7)))
+#define sigma1(x) \
+    _mm256_xor_si256(ROTR64((x), 19), _mm256_xor_si256(ROTR64((x), 61), _mm256_srli_epi64((x), 6)))
+#define Ch(x, y, z) \
+    _mm256_xor_si256(_mm256_and_si256((x), (y)), _mm256_andnot_si256((x), (z)))
+#define Maj(x, y, z)                                                     \
+    _mm256_xor_si256(_mm256_and_si256((x), (y)),                         \
+        _mm256_xor_si256(_mm256_and_si256((x), (z)), _mm256_and_si256((y), (z))))
+
+#define ROUND_00_15(i, a, b, c, d, e, f, g, h)                          \
+    do {                                                                \
+        T1 = _mm256_add_epi64(_mm256_add_epi64(h, Sigma1(e)),           \
+            _mm256_add_epi64(Ch(e, f, g),                               \
+                _mm256_add_epi64(_mm256_set1_epi64x((long long)K512[i]), \
+                    X[(i) & 15])));                                     \
+        h = _mm256_add_epi64(Sigma0(a), Maj(a, b, c));                  \
+        d = _mm256_add_epi64(d, T1);                                    \
+        h = _mm256_add_epi64(h, T1);                                    \
+    } while (0)
+
+#define ROUND_16_80(i, j, a, b, c, d, e, f, g, h)                    \
+    do {                                                             \
+        X[(j) & 15] = _mm256_add_epi64(X[(j) & 15],                  \
+            _mm256_add_epi64(                                        \
+                _mm256_add_epi64(sigma1(X[((j) + 14) & 15]),         \
+                    X[((j) + 9) & 15]),                              \
+                sigma0(X[((j) + 1) & 15])));                         \
+        ROUND_00_15((i) + (j), a, b, c, d, e, f, g, h);              \
+    } while (0)
+
+/* Hash a block of each lane, keeping the state of the lanes not in |active| */
+static void sha512_block_x4(__m256i s[8], const unsigned char *const p[4],
+    __m256i active)
+{
+    __m256i X[16], a, b, c, d, e, f, g, h, T1;
+    uint64_t w[SHA512_MB_LANES];
+    int i, j;
+
+    for (i = 0; i < 16; i++) {
+        for (j = 0; j < SHA512_MB_LANES; j++)
+            OPENSSL_load_u64_be(&w[j], p[j] + 8 * i);
+        X[i] = _mm256_set_epi64x((long long)w[3], (long long)w[2],
+            (long long)w[1], (long long)w[0]);
+    }
+    a = s[0];
+    b = s[1];
+    c = s[2];
+    d = s[3];
+    e = s[4];
+    f = s[5];
+    g = s[6];
+    h = s[7];
+
+    for (i = 0; i < 16; i += 8) {
+        ROUND_00_15(i + 0, a, b, c, d, e, f, g, h);
+        ROUND_00_15(i + 1, h, a, b, c, d, e, f, g);
+        ROUND_00_15(i + 2, g, h, a, b, c, d, e, f);
+        ROUND_00_15(i + 3, f, g, h, a, b, c, d, e);
+        ROUND_00_15(i + 4, e, f, g, h, a, b, c, d);
+        ROUND_00_15(i + 5, d, e, f, g, h, a, b, c);
+        ROUND_00_15(i + 6, c, d, e, f, g, h, a, b);
+        ROUND_00_15(i + 7, b, c, d, e, f, g, h, a);
+    }
+    for (i = 16; i < 80; i += 16) {
+        ROUND_16_80(i, 0, a, b, c, d, e, f, g, h);
+        ROUND_16_80(i, 1, h, a, b, c, d, e, f, g);
+        ROUND_16_80(i, 2, g, h, a, b, c, d, e, f);
+        ROUND_16_80(i, 3, f, g, h, a, b, c, d, e);
+        ROUND_16_80(i, 4, e, f, g, h, a, b, c, d);
+        ROUND_16_80(i, 5, d, e, f, g, h, a, b, c);
+        ROUND_16_80(i, 6, c, d, e, f, g, h, a, b);
+        ROUND_16_80(i, 7, b, c, d, e, f, g, h, a);
+        ROUND_16_80(i, 8, a, b, c, d, e, f, g, h);
+        ROUND_16_80(i, 9, h, a, b, c, d, e, f, g);
+        ROUND_16_80(i, 10, g, h, a, b, c, d, e, f);
+        ROUND_16_80(i, 11, f, g, h, a, b, c, d, e);
+        ROUND_16_80(i, 12, e, f, g, h, a, b, c, d);
+        ROUND_16_80(i, 13, d, e, f, g, h, a, b, c);
+        ROUND_16_80(i, 14, c, d, e, f, g, h, a, b);
+        ROUND_16_80(i, 15, b, c, d, e, f, g, h, a);
+    }
+
+    s[0] = _mm256_blendv_epi8(s[0], _mm256_add_epi64(s[0], a), active);
+    s[1] = _mm256_blendv_epi8(s[1], _mm256_add_epi64(s[1], b), active);
+    s[2] = _mm256_blendv_epi8(s[2], _mm256_add_epi64(s[2], c), active);
+    s[3] = _mm256_blendv_epi8(s[3], _mm256_add_epi64(s[3], d), active);
+    s[4] = _mm256_blendv_epi8(s[4], _mm256_add_epi64(s[4], e), active);
+    s[5] = _mm256_blendv_epi8(s[5], _mm256_add_epi64(s[5], f), active);
+    s[6] = _mm256_blendv_epi8(s[6], _mm256_add_epi64(s[6], g), active);
+    s[7] = _mm256_blendv_epi8(s[7], _mm256_add_epi64(s[7], h), active);
+}
+
+static void sha512_multi_x4(size_t md_len, size_t n,
+    const unsigned char *const in[], const size_t inl[],
+    unsigned char *const out[])
+{
+    static const unsigned char idle[SHA512_CBLOCK] = { 0 };
+    unsigned char tail[SHA512_MB_LANES][2 * SHA512_CBLOCK];
+    const unsigned char *p[SHA512_MB_LANES];
+    size_t full[SHA512_MB_LANES], total[SHA512_MB_LANES], r, k, last = 0;
+    uint64_t h[SHA512_MB_LANES];
+    long long act[SHA512_MB_LANES];
+    __m256i s[8];
+    SHA512_CTX c;
+    size_t i, j;
+
+    if (md_len == SHA384_DIGEST_LENGTH)
+        SHA384_Init(&c);
+    else
+        SHA512_Init(&c);
+    for (i = 0; i < 8; i++)
+        s[i] = _mm256_set1_epi64x((long long)c.h[i]);
+
+    /* Each message is followed by its padding in one or two blocks */
+    memset(tail, 0, sizeof(tail));
+    for (i = 0; i < n; i++) {
+        full[i] = inl[i] / SHA512_CBLOCK;
+        r = inl[i] % SHA512_CBLOCK;
+        memcpy(tail[i], in[i] + full[i] * SHA512_CBLOCK, r);
+        tail[i][r] = 0x80;
+        total[i] = full[i] + (r < SHA512_CBLOCK - 16 ? 1 : 2);
+        OPENSSL_store_u64_be(tail[i] + (total[i] - full[i]) * SHA512_CBLOCK - 16,
+            (uint64_t)inl[i] >> 61);
+        OPENSSL_store_u64_be(tail[i] + (total[i] - full[i]) * SHA512_CBLOCK - 8,
+            (uint64_t)inl[i] << 3);
+        if (total[i] > last)
+            last = total[i];
+    }
+
+    for (k = 0; k < last; k++) {
+        for (j = 0; j < SHA512_MB_LANES; j++) {
+            act[j] = j < n && k < total[j] ? -1 : 0;
+            if (act[j] == 0)
+                p[j] = idle;
+            else if (k < full[j])
+                p[j] = in[j] + k * SHA512_CBLOCK;
+            else
+                p[j] = tail[j] + (k - full[j]) * SHA512_CBLOCK;
+        }
+        sha512_block_x4(s, p, _mm256_set_epi64x(act[3], act[2], act[1], act[0]));
+    }
+
+    for (i = 0; i < md_len / 8; i++) {
+        _mm256_storeu_si256((__m256i *)h, s[i]);
+        for (j = 0; j < n; j++)
+            OPENSSL_store_u64_be(out[j] + 8 * i, h[j]);
+    }
+
+    OPENSSL_cleanse(tail, sizeof(tail));
+    OPENSSL_cleanse(s, sizeof(s));
+}
+
+OPENSSL_UNTARGET_AVX2
+
+#endif /* SHA512_MB_AVX2 */
+
+int ossl_sha512_multi(size_t md_len, size_t n, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[])
+{
+    SHA512_CTX c;
+    size_t i = 0;
+
+#ifdef SHA512_MB_AVX2
+    if ((OPENSSL_ia32cap_P[2] & (1u << 5)) != 0) {
+        while (n - i >= 2) {
+            size_t m = n - i < SHA512_MB_LANES ? n - i : SHA512_MB_LANES;
+
+            sha512_multi_x4(md_len, m, in + i, inl + i, out + i);
+            i += m;
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        if (md_len == SHA384_DIGEST_LENGTH)
+            SHA384_Init(&c);
+        else
+            SHA512_Init(&c);
+        if (!SHA512_Update(&c, in[i], inl[i]) || !SHA512_Final(out[i], &c))
+            return 0;
+    }
+    return 1;
+}
@@ -62,6 +62,7 @@ SLH_DSA_HASH_CTX *ossl_slh_dsa_hash_ctx_dup(const SLH_DSA_HASH_CTX *src)
         return NULL;
 
     ret->hmac_digest_used = src->hmac_digest_used;
+    ret->threads = src->threads;
     /* Note that the key is not ref counted, since it does not own the key */
     ret->key = src->key;
 
@@ -89,6 +90,19 @@ int ossl_slh_dsa_hash_ctx_prehash_pk_seed(SLH_DSA_HASH_CTX *ctx,
     return ctx->key->hash_func->prehash_pk_seed(ctx, pkseed, n);
 }
 
+/**
+ * @brief Set the maximum number of threads that signing may use.
+ * See slh_threads.c
+ *
+ * @param ctx The SLH_DSA_HASH_CTX object.
+ * @param threads The maximum number of threads, 0 or 1 to sign on the
+ *                calling thread only.
+ */
+void ossl_slh_dsa_hash_ctx_set_threads(SLH_DSA_HASH_CTX *ctx, uint32_t threads)
+{
+    ctx->threads = threads;
+}
+
 /**
  * @brief Destroy a SLH_DSA_HASH_CTX
  *
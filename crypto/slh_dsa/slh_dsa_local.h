@@ -54,8 +54,16 @@ struct slh_dsa_hash_ctx_st {
     void *shactx_pkseed; /* A low level SHAKE or SHA256 object with PK.seed hashed in it */
     EVP_MAC_CTX *hmac_ctx; /* required by SHA algorithms for PRFmsg() */
     int hmac_digest_used; /* Used for lazy init of hmac_ctx digest */
+    uint32_t threads; /* The maximum number of threads to sign with */
 };
 
+/* Computes part |i| of a signature, see slh_threads.c */
+typedef int(OSSL_SLH_TASK_FN)(SLH_DSA_HASH_CTX *ctx, void *arg, uint32_t i);
+
+uint32_t ossl_slh_threads(const SLH_DSA_HASH_CTX *ctx, uint32_t n);
+__owur int ossl_slh_run_tasks(SLH_DSA_HASH_CTX *ctx, uint32_t n,
+    OSSL_SLH_TASK_FN *fn, void *arg);
+
 __owur int ossl_slh_wots_pk_gen(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
     const uint8_t *pk_seed, uint8_t *adrs,
     uint8_t *pk_out, size_t pk_out_len);
@@ -71,6 +79,10 @@ __owur int ossl_slh_xmss_node(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
     const uint8_t *pk_seed, uint8_t *adrs,
     uint8_t *pk_out, size_t pk_out_len);
 
+__owur int ossl_slh_xmss_auth_path(SLH_DSA_HASH_CTX *ctx,
+    const uint8_t *sk_seed, uint32_t node_id,
+    const uint8_t *pk_seed, uint8_t *adrs,
+    uint8_t *auth_path, uint8_t *root);
 __owur int ossl_slh_xmss_sign(SLH_DSA_HASH_CTX *ctx, const uint8_t *msg,
     const uint8_t *sk_seed, uint32_t node_id,
     const uint8_t *pk_seed, uint8_t *adrs,
@@ -20,6 +20,13 @@
 #define SLH_MAX_K_TIMES_A (SLH_MAX_A * SLH_MAX_K)
 #define SLH_MAX_ROOTS (SLH_MAX_K_TIMES_A * SLH_MAX_N)
 
+/*
+ * Subtrees with up to 2^SLH_FORS_BATCH_HEIGHT leaves are computed one level
+ * at a time, so that the hashes of each level are computed at once.
+ */
+#define SLH_FORS_BATCH_HEIGHT 4
+#define SLH_FORS_BATCH (1 << SLH_FORS_BATCH_HEIGHT)
+
 static void slh_base_2b(const uint8_t *in, uint32_t b, uint32_t *out, size_t out_len);
 
 /**
@@ -53,13 +60,101 @@ static int slh_fors_sk_gen(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
     return key->hash_func->PRF(ctx, pk_seed, sk_seed, sk_adrs, pk_out, pk_out_len);
 }
 
+/**
+ * @brief Computes a node of a Merkle tree of height at most
+ * SLH_FORS_BATCH_HEIGHT, a level at a time.
+ * See FIPS 205 Section 8.2 Algorithm 18
+ *
+ * The leaf nodes are hashes of FORS secret values.
+ * Each parent node is a hash of its 2 children.
+ * All the FORS secret values, all the leaves, and then all the nodes of each
+ * level are computed at once.
+ *
+ * @param ctx Contains SLH_DSA algorithm functions and constants.
+ * @param sk_seed A SLH_DSA private key seed of size |n|
+ * @param pk_seed A SLH_DSA public key seed of size |n|
+ * @param adrs The ADRS object, as for slh_fors_node()
+ * @param node_id The target node index
+ * @param height The target node height
+ * @param node The returned hash for a node of size|n|
+ * @returns 1 on success, or 0 on error.
+ */
+static int slh_fors_subtree(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
+    const uint8_t *pk_seed, uint8_t *adrs, uint32_t node_id,
+    uint32_t height, uint8_t *node)
+{
+    int ret = 0;
+    const SLH_DSA_KEY *key = ctx->key;
+    uint8_t nodes[2][SLH_FORS_BATCH * SLH_MAX_N];
+    uint8_t node_adrs[SLH_FORS_BATCH][SLH_ADRS_SIZE_MAX];
+    const uint8_t *lane_adrs[SLH_FORS_BATCH] = { NULL };
+    const uint8_t *in[SLH_FORS_BATCH] = { NULL };
+    uint8_t *out[SLH_FORS_BATCH] = { NULL };
+    uint32_t n = key->params->n;
+    uint32_t first = node_id << height, count = 1 << height;
+    uint32_t i, h;
+
+    SLH_ADRS_FUNC_DECLARE(key, adrsf);
+    SLH_ADRS_FN_DECLARE(adrsf, set_tree_index);
+    SLH_ADRS_FN_DECLARE(adrsf, set_tree_height);
+    SLH_HASH_FUNC_DECLARE(key, hashf);
+    SLH_HASH_FN_DECLARE(hashf, F_multi);
+    SLH_HASH_FN_DECLARE(hashf, H_multi);
+
+    /* The FORS secret values, as in slh_fors_sk_gen() */
+    for (i = 0; i < count; ++i) {
+        adrsf->copy(node_adrs[i], adrs);
+        adrsf->set_type_and_clear(node_adrs[i], SLH_ADRS_TYPE_FORS_PRF);
+        adrsf->copy_keypair_address(node_adrs[i], adrs);
+        set_tree_index(node_adrs[i], first + i);
+        lane_adrs[i] = node_adrs[i];
+        in[i] = sk_seed;
+        out[i] = nodes[0] + i * n;
+    }
+    if (!F_multi(ctx, pk_seed, count, lane_adrs, in, out))
+        goto err;
+
+    /* The leaves */
+    for (i = 0; i < count; ++i) {
+        adrsf->copy(node_adrs[i], adrs);
+        set_tree_height(node_adrs[i], 0);
+        set_tree_index(node_adrs[i], first + i);
+        in[i] = nodes[0] + i * n;
+        out[i] = nodes[1] + i * n;
+    }
+    if (!F_multi(ctx, pk_seed, count, lane_adrs, in, out))
+        goto err;
+
+    /* Each level hashes pairs of nodes of the level below */
+    for (h = 1; h <= height; ++h) {
+        count >>= 1;
+        for (i = 0; i < count; ++i) {
+            set_tree_height(node_adrs[i], h);
+            set_tree_index(node_adrs[i], (first >> h) + i);
+            in[i] = nodes[h & 1] + 2 * i * n;
+            out[i] = nodes[(h + 1) & 1] + i * n;
+        }
+        if (!H_multi(ctx, pk_seed, count, lane_adrs, in, out))
+            goto err;
+    }
+    memcpy(node, nodes[(height + 1) & 1], n);
+    /* Leave |adrs| as computing the node one hash at a time would */
+    set_tree_height(adrs, height);
+    set_tree_index(adrs, node_id);
+    ret = 1;
+err:
+    OPENSSL_cleanse(nodes, sizeof(nodes));
+    return ret;
+}
+
 /**
  * @brief Computes the nodes of a Merkle tree.
  * See FIPS 205 Section 8.2 Algorithm 18
  *
  * The leaf nodes are hashes of FORS secret values.
  * Each parent node is a hash of its 2 children.
- * Note this is a recursive function.
+ * Note this is a recursive function, down to subtrees of height
+ * SLH_FORS_BATCH_HEIGHT.
  *
  * @param ctx Contains SLH_DSA algorithm functions and constants.
  * @param sk_seed A SLH_DSA private key seed of size |n|
@@ -78,32 +173,88 @@ static int slh_fors_node(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
     const uint8_t *pk_seed, uint8_t *adrs, uint32_t node_id,
     uint32_t height, uint8_t *node, size_t node_len)
 {
-    int ret = 0;
     const SLH_DSA_KEY *key = ctx->key;
-    uint8_t sk[SLH_MAX_N], lnode[SLH_MAX_N], rnode[SLH_MAX_N];
+    uint8_t lnode[SLH_MAX_N], rnode[SLH_MAX_N];
+
+    SLH_ADRS_FUNC_DECLARE(key, adrsf);
+
+    if (height <= SLH_FORS_BATCH_HEIGHT)
+        return slh_fors_subtree(ctx, sk_seed, pk_seed, adrs, node_id, height,
+            node);
+
+    if (!slh_fors_node(ctx, sk_seed, pk_seed, adrs, 2 * node_id, height - 1,
+            lnode, sizeof(lnode))
+        || !slh_fors_node(ctx, sk_seed, pk_seed, adrs, 2 * node_id + 1,
+            height - 1, rnode, sizeof(rnode)))
+        return 0;
+    adrsf->set_tree_height(adrs, height);
+    adrsf->set_tree_index(adrs, node_id);
+    return key->hash_func->H(ctx, pk_seed, adrs, lnode, rnode, node, node_len);
+}
+
+typedef struct {
+    const uint8_t *sk_seed;
+    const uint8_t *pk_seed;
+    const uint8_t *adrs;
+    const uint32_t *ids;
+    uint8_t *sig;
+} SLH_FORS_SIGN_ARGS;
+
+/**
+ * @brief Generate the part of a FORS signature for one of the k trees.
+ *
+ * This is the private key value selected by the message digest, followed by
+ * its authentication path. The trees are independent of each other, so
+ * they may be signed concurrently, see slh_threads.c.
+ *
+ * @param ctx Contains SLH_DSA algorithm functions and constants.
+ * @param varg The SLH_FORS_SIGN_ARGS shared by all the trees.
+ * @param tree_id The index of the tree, in the range 0..k-1
+ * @returns 1 on success, or 0 on error.
+ */
+static int slh_fors_sign_tree(SLH_DSA_HASH_CTX *ctx, void *varg,
+    uint32_t tree_id)
+{
+    const SLH_FORS_SIGN_ARGS *args = varg;
+    const SLH_DSA_KEY *key = ctx->key;
     uint32_t n = key->params->n;
+    uint32_t a = key->params->a;
+    uint32_t layer, s;
+    /* Get the tree[i] leaf id */
+    uint32_t node_id = args->ids[tree_id]; /* |id| = |a| bits */
+    /*
+     * Give each of the k trees a unique range at each level.
+     * e.g. If we have 4096 leaf nodes (2^a = 2^12) for each tree
+     * i will use indexes from 4096 * i + (0..4095) for its bottom level.
+     * For the next level up from the bottom there would be 2048 nodes
+     * (so tree i uses indexes 2048 * i + (0...2047) for this level)
+     */
+    uint32_t tree_offset = tree_id << a;
+    uint8_t *sig = args->sig + tree_id * (a + 1) * n;
 
+    SLH_ADRS_DECLARE(adrs);
     SLH_ADRS_FUNC_DECLARE(key, adrsf);
 
-    if (height == 0) {
-        /* Gets here for leaf nodes */
-        if (!slh_fors_sk_gen(ctx, sk_seed, pk_seed, adrs, node_id, sk, sizeof(sk)))
-            return 0;
-        adrsf->set_tree_height(adrs, 0);
-        adrsf->set_tree_index(adrs, node_id);
-        ret = key->hash_func->F(ctx, pk_seed, adrs, sk, n, node, node_len);
-        OPENSSL_cleanse(sk, n);
-        return ret;
-    } else {
-        if (!slh_fors_node(ctx, sk_seed, pk_seed, adrs, 2 * node_id, height - 1,
-                lnode, sizeof(rnode))
-            || !slh_fors_node(ctx, sk_seed, pk_seed, adrs, 2 * node_id + 1,
-                height - 1, rnode, sizeof(rnode)))
-            return 0;
-        adrsf->set_tree_height(adrs, height);
-        adrsf->set_tree_index(adrs, node_id);
-        if (!key->hash_func->H(ctx, pk_seed, adrs, lnode, rnode, node, node_len))
+    adrsf->copy(adrs, args->adrs);
+    if (!slh_fors_sk_gen(ctx, args->sk_seed, args->pk_seed, adrs,
+            node_id + tree_offset, sig, n))
+        return 0;
+
+    /*
+     * Traverse from the bottom of the tree (layer = 0)
+     * up to the root (layer = a - 1).
+     * NOTE: This is a really inefficient way of doing this, since at
+     * layer a - 1 it calculates most of the hashes of the entire tree as
+     * well as all the leaf nodes. So it is calculating nodes multiple times.
+     */
+    for (layer = 0; layer < a; ++layer) {
+        sig += n;
+        s = node_id ^ 1; /* XOR gets the index of the other child in a binary tree */
+        if (!slh_fors_node(ctx, args->sk_seed, args->pk_seed, adrs,
+                s + tree_offset, layer, sig, n))
             return 0;
+        node_id >>= 1; /* Get the parent node id */
+        tree_offset >>= 1; /* Each layer up has half as many nodes */
     }
     return 1;
 }
@@ -125,23 +276,17 @@ static int slh_fors_node(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
  *             the type set to FORS_TREE, and the keypair address set to the
  *             index of the WOTS+ key that signs the FORS key.
  * @param sig_wpkt A WPACKET object to write the generated XMSS signature to
- * @param sig_len  The size of |sig| which is (2 * n + 3) * n + tree_height * n.
  * @returns 1 on success, or 0 on error.
  */
 int ossl_slh_fors_sign(SLH_DSA_HASH_CTX *ctx, const uint8_t *md,
     const uint8_t *sk_seed, const uint8_t *pk_seed,
     uint8_t *adrs, WPACKET *sig_wpkt)
 {
-    const SLH_DSA_KEY *key = ctx->key;
-    uint32_t tree_id, layer, s, tree_offset;
-    uint32_t ids[SLH_MAX_K];
-    const SLH_DSA_PARAMS *params = key->params;
-    uint32_t n = params->n;
+    const SLH_DSA_PARAMS *params = ctx->key->params;
     uint32_t k = params->k; /* number of trees */
     uint32_t a = params->a;
-    uint32_t two_power_a = (1 << a); /* this is t in FIPS 205 */
-    uint32_t tree_id_times_two_power_a = 0;
-    uint8_t out[SLH_MAX_N];
+    uint32_t ids[SLH_MAX_K];
+    SLH_FORS_SIGN_ARGS args;
 
     /*
      * Split md into k a-bit values e.g with k = 14, a = 12
@@ -149,44 +294,12 @@ int ossl_slh_fors_sign(SLH_DSA_HASH_CTX *ctx, const uint8_t *md,
      */
     slh_base_2b(md, a, ids, k);
 
-    for (tree_id = 0; tree_id < k; ++tree_id) {
-        /* Get the tree[i] leaf id */
-        uint32_t node_id = ids[tree_id]; /* |id| = |a| bits */
-
-        /*
-         * Give each of the k trees a unique range at each level.
-         * e.g. If we have 4096 leaf nodes (2^a = 2^12) for each tree
-         * i will use indexes from 4096 * i + (0..4095) for its bottom level.
-         * For the next level up from the bottom there would be 2048 nodes
-         * (so tree i uses indexes 2048 * i + (0...2047) for this level)
-         */
-        tree_offset = tree_id_times_two_power_a;
-
-        if (!slh_fors_sk_gen(ctx, sk_seed, pk_seed, adrs,
-                node_id + tree_id_times_two_power_a, out, sizeof(out))
-            || !WPACKET_memcpy(sig_wpkt, out, n))
-            return 0;
-
-        /*
-         * Traverse from the bottom of the tree (layer = 0)
-         * up to the root (layer = a - 1).
-         * NOTE: This is a really inefficient way of doing this, since at
-         * layer a - 1 it calculates most of the hashes of the entire tree as
-         * well as all the leaf nodes. So it is calculating nodes multiple times.
-         */
-        for (layer = 0; layer < a; ++layer) {
-            s = node_id ^ 1; /* XOR gets the index of the other child in a binary tree */
-            if (!slh_fors_node(ctx, sk_seed, pk_seed, adrs,
-                    s + tree_offset, layer, out, sizeof(out)))
-                return 0;
-            node_id >>= 1; /* Get the parent node id */
-            tree_offset >>= 1; /* Each layer up has half as many nodes */
-            if (!WPACKET_memcpy(sig_wpkt, out, n))
-                return 0;
-        }
-        tree_id_times_two_power_a += two_power_a;
-    }
-    return 1;
+    args.sk_seed = sk_seed;
+    args.pk_seed = pk_seed;
+    args.adrs = adrs;
+    args.ids = ids;
+    return WPACKET_allocate_bytes(sig_wpkt, k * (a + 1) * params->n, &args.sig)
+        && ossl_slh_run_tasks(ctx, k, slh_fors_sign_tree, &args);
 }
 
 /**
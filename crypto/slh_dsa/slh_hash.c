@@ -22,7 +22,9 @@
 #include "crypto/sha.h"
 
 #define MAX_DIGEST_SIZE 64 /* SHA-512 is used for security category 3 & 5 */
-#define NIBBLE_MASK 15
+/* The number of inputs of the multi-lane hash functions hashed at once */
+#define SHA256_LANES 8
+#define SHAKE_LANES 4
 
 /* Most hash functions in SLH-DSA truncate the output */
 #define sha256_final(ctx, out, outlen)    \
@@ -51,8 +53,11 @@ static OSSL_SLH_HASHFUNC_H slh_h_sha512;
 static OSSL_SLH_HASHFUNC_H slh_h_shake;
 static OSSL_SLH_HASHFUNC_T slh_t_sha256;
 static OSSL_SLH_HASHFUNC_T slh_t_sha512;
-static OSSL_SLH_HASHFUNC_wots_pk_gen slh_wots_pk_gen_sha2;
-static OSSL_SLH_HASHFUNC_wots_pk_gen slh_wots_pk_gen_shake;
+static OSSL_SLH_HASHFUNC_F_multi slh_f_multi_sha256;
+static OSSL_SLH_HASHFUNC_F_multi slh_f_multi_shake;
+static OSSL_SLH_HASHFUNC_H_multi slh_h_multi_sha256;
+static OSSL_SLH_HASHFUNC_H_multi slh_h_multi_sha512;
+static OSSL_SLH_HASHFUNC_H_multi slh_h_multi_shake;
 
 static const uint8_t zeros[128] = { 0 };
 
@@ -244,95 +249,6 @@ slh_prf_sha256(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed,
     return 1;
 }
 
-static int
-slh_wots_pk_gen_sha2(SLH_DSA_HASH_CTX *hctx,
-    const uint8_t *sk_seed, const uint8_t *pk_seed,
-    uint8_t *adrs, uint8_t *pk_out, size_t pk_out_len)
-{
-    int ret = 0;
-    size_t n = hctx->key->params->n;
-    size_t i, j = 0, len = SLH_WOTS_LEN(n);
-    uint8_t sk[SLH_MAX_N];
-    SHA256_CTX *sctx = (SHA256_CTX *)(hctx->shactx_pkseed);
-    SHA256_CTX ctx;
-    const SLH_ADRS_FUNC *adrsf = hctx->key->adrs_func;
-    SLH_ADRS_DECLARE(sk_adrs);
-    SLH_ADRS_FN_DECLARE(adrsf, set_chain_address);
-    SLH_ADRS_FN_DECLARE(adrsf, set_hash_address);
-
-    adrsf->copy(sk_adrs, adrs);
-    adrsf->set_type_and_clear(sk_adrs, SLH_ADRS_TYPE_WOTS_PRF);
-    adrsf->copy_keypair_address(sk_adrs, adrs);
-
-    for (i = 0; i < len; ++i) { /* len = 2n + 3 */
-        set_chain_address(sk_adrs, (uint32_t)i);
-
-        /* PRF */
-        ctx = *sctx;
-        SHA256_Update(&ctx, sk_adrs, SLH_ADRSC_SIZE);
-        SHA256_Update(&ctx, sk_seed, n);
-        sha256_final(&ctx, sk, n);
-
-        set_chain_address(adrs, (uint32_t)i);
-        for (j = 0; j < NIBBLE_MASK; ++j) {
-            set_hash_address(adrs, (uint32_t)j);
-            /* F */
-            ctx = *sctx;
-            SHA256_Update(&ctx, adrs, SLH_ADRSC_SIZE);
-            SHA256_Update(&ctx, sk, n);
-            sha256_final(&ctx, sk, n);
-        }
-        memcpy(pk_out, sk, n);
-        pk_out += n;
-    }
-    ret = 1;
-    return ret;
-}
-
-int slh_wots_pk_gen_shake(SLH_DSA_HASH_CTX *hctx,
-    const uint8_t *sk_seed, const uint8_t *pk_seed,
-    uint8_t *adrs, uint8_t *pk_out, size_t pk_out_len)
-{
-    int ret = 0;
-    size_t n = hctx->key->params->n;
-    size_t i, j = 0, len = SLH_WOTS_LEN(n);
-    uint8_t sk[SLH_MAX_N];
-    const SLH_ADRS_FUNC *adrsf = hctx->key->adrs_func;
-    SLH_ADRS_DECLARE(sk_adrs);
-    SLH_ADRS_FN_DECLARE(adrsf, set_chain_address);
-    SLH_ADRS_FN_DECLARE(adrsf, set_hash_address);
-    KECCAK1600_CTX *sctx = (KECCAK1600_CTX *)(hctx->shactx_pkseed);
-    KECCAK1600_CTX ctx;
-
-    adrsf->copy(sk_adrs, adrs);
-    adrsf->set_type_and_clear(sk_adrs, SLH_ADRS_TYPE_WOTS_PRF);
-    adrsf->copy_keypair_address(sk_adrs, adrs);
-
-    for (i = 0; i < len; ++i) { /* len = 2n + 3 */
-        set_chain_address(sk_adrs, (uint32_t)i);
-
-        /* PRF */
-        ctx = *sctx;
-        ossl_sha3_absorb(&ctx, sk_adrs, SLH_ADRS_SIZE);
-        ossl_sha3_absorb(&ctx, sk_seed, n);
-        ossl_sha3_squeeze(&ctx, sk, n);
-
-        set_chain_address(adrs, (uint32_t)i);
-        for (j = 0; j < NIBBLE_MASK; ++j) {
-            set_hash_address(adrs, (uint32_t)j);
-            /* F */
-            ctx = *sctx;
-            ossl_sha3_absorb(&ctx, adrs, SLH_ADRS_SIZE);
-            ossl_sha3_absorb(&ctx, sk, n);
-            ossl_sha3_squeeze(&ctx, sk, n);
-        }
-        memcpy(pk_out, sk, n);
-        pk_out += n;
-    }
-    ret = 1;
-    return ret;
-}
-
 static int
 slh_f_sha256(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, const uint8_t *adrs,
     const uint8_t *m1, size_t m1_len, uint8_t *out, size_t out_len)
@@ -407,6 +323,143 @@ slh_t_sha512(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, const uint8_t *adrs
     return 1;
 }
 
+/*
+ * Multi-lane F() and H() for SHAKE, which hash 4 inputs at once where
+ * possible. Each input PK.seed || ADRS || M fits in a single block.
+ */
+static int
+slh_multi_shake(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, size_t lanes,
+    const uint8_t *const adrs[], const uint8_t *const m[], size_t m_len,
+    uint8_t *const out[])
+{
+    size_t n = hctx->key->params->n;
+    size_t i, j, k, l, in_len = n + SLH_ADRS_SIZE + m_len;
+    uint8_t in[SHAKE_LANES][SLH_ADRS_SIZE + 3 * SLH_MAX_N];
+    uint8_t md[SHAKE_LANES][SLH_MAX_N];
+    KECCAK1600_CTX sctx;
+
+    if (!ossl_sha3_shake_x4_capable()) {
+        for (i = 0; i < lanes; ++i) {
+            sctx = *((KECCAK1600_CTX *)(hctx->shactx_pkseed));
+            ossl_sha3_absorb(&sctx, adrs[i], SLH_ADRS_SIZE);
+            ossl_sha3_absorb(&sctx, m[i], m_len);
+            ossl_sha3_squeeze(&sctx, out[i], n);
+        }
+        return 1;
+    }
+
+    for (i = 0; i < lanes; i += k) {
+        k = lanes - i < SHAKE_LANES ? lanes - i : SHAKE_LANES;
+        for (j = 0; j < SHAKE_LANES; ++j) {
+            /* Unused lanes repeat the last input */
+            l = i + (j < k ? j : k - 1);
+            memcpy(in[j], pk_seed, n);
+            memcpy(in[j] + n, adrs[l], SLH_ADRS_SIZE);
+            memcpy(in[j] + n + SLH_ADRS_SIZE, m[l], m_len);
+        }
+        ossl_sha3_shake256_x4(md[0], md[1], md[2], md[3], n,
+            in[0], in[1], in[2], in[3], in_len);
+        for (j = 0; j < k; ++j)
+            memcpy(out[i + j], md[j], n);
+    }
+    OPENSSL_cleanse(in, sizeof(in));
+    OPENSSL_cleanse(md, sizeof(md));
+    return 1;
+}
+
+static int
+slh_f_multi_shake(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, size_t lanes,
+    const uint8_t *const adrs[], const uint8_t *const m[], uint8_t *const out[])
+{
+    return slh_multi_shake(hctx, pk_seed, lanes, adrs, m, hctx->key->params->n,
+        out);
+}
+
+static int
+slh_h_multi_shake(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, size_t lanes,
+    const uint8_t *const adrs[], const uint8_t *const m[], uint8_t *const out[])
+{
+    return slh_multi_shake(hctx, pk_seed, lanes, adrs, m,
+        2 * hctx->key->params->n, out);
+}
+
+/*
+ * Multi-lane F() and H() for SHA2, which hash up to 8 inputs at once from
+ * the state after the block holding PK.seed. Each ADRSc || M fits in the
+ * block that follows. Where that would be no faster, as with the SHA
+ * extensions, the inputs are hashed one by one without being copied.
+ */
+static int
+slh_multi_sha256(SLH_DSA_HASH_CTX *hctx, size_t lanes,
+    const uint8_t *const adrs[], const uint8_t *const m[], size_t m_len,
+    uint8_t *const out[])
+{
+    size_t n = hctx->key->params->n;
+    size_t i, j, k;
+    uint8_t buf[SHA256_LANES][SLH_ADRSC_SIZE + 2 * SLH_MAX_N];
+    const uint8_t *in[SHA256_LANES];
+    size_t in_len[SHA256_LANES];
+    int ret = 1;
+
+    for (i = 0; ret && i < lanes; i += k) {
+        k = lanes - i < SHA256_LANES ? lanes - i : SHA256_LANES;
+        for (j = 0; j < k; ++j) {
+            memcpy(buf[j], adrs[i + j], SLH_ADRSC_SIZE);
+            memcpy(buf[j] + SLH_ADRSC_SIZE, m[i + j], m_len);
+            in[j] = buf[j];
+            in_len[j] = SLH_ADRSC_SIZE + m_len;
+        }
+        ret = ossl_sha256_multi_from(hctx->shactx_pkseed, k, in, in_len,
+            out + i, n);
+    }
+    OPENSSL_cleanse(buf, sizeof(buf));
+    return ret;
+}
+
+static int
+slh_f_multi_sha256(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, size_t lanes,
+    const uint8_t *const adrs[], const uint8_t *const m[], uint8_t *const out[])
+{
+    size_t n = hctx->key->params->n;
+    size_t i;
+
+    if (ossl_sha256_multi_capable(SLH_ADRSC_SIZE + n))
+        return slh_multi_sha256(hctx, lanes, adrs, m, n, out);
+    for (i = 0; i < lanes; ++i)
+        if (!slh_f_sha256(hctx, pk_seed, adrs[i], m[i], n, out[i], n))
+            return 0;
+    return 1;
+}
+
+static int
+slh_h_multi_sha256(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, size_t lanes,
+    const uint8_t *const adrs[], const uint8_t *const m[], uint8_t *const out[])
+{
+    size_t n = hctx->key->params->n;
+    size_t i;
+
+    if (ossl_sha256_multi_capable(SLH_ADRSC_SIZE + 2 * n))
+        return slh_multi_sha256(hctx, lanes, adrs, m, 2 * n, out);
+    for (i = 0; i < lanes; ++i)
+        if (!slh_h_sha256(hctx, pk_seed, adrs[i], m[i], m[i] + n, out[i], n))
+            return 0;
+    return 1;
+}
+
+/* There is no multi-lane SHA-512 from a common state, so hash one by one */
+static int
+slh_h_multi_sha512(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, size_t lanes,
+    const uint8_t *const adrs[], const uint8_t *const m[], uint8_t *const out[])
+{
+    size_t n = hctx->key->params->n;
+    size_t i;
+
+    for (i = 0; i < lanes; ++i)
+        if (!slh_h_sha512(hctx, pk_seed, adrs[i], m[i], m[i] + n, out[i], n))
+            return 0;
+    return 1;
+}
+
 static int slh_hash_shake_precache(SLH_DSA_HASH_CTX *hctx, const uint8_t *pkseed, size_t n)
 {
     KECCAK1600_CTX *ctx = NULL, *seedctx = NULL;
@@ -477,7 +530,8 @@ const SLH_HASH_FUNC *ossl_slh_get_hash_fn(int is_shake, int security_category)
             slh_f_shake,
             slh_h_shake,
             slh_f_shake,
-            slh_wots_pk_gen_shake },
+            slh_f_multi_shake,
+            slh_h_multi_shake },
         { slh_hash_sha256_precache,
             slh_hash_sha256_dup,
             slh_hmsg_sha256,
@@ -486,7 +540,8 @@ const SLH_HASH_FUNC *ossl_slh_get_hash_fn(int is_shake, int security_category)
             slh_f_sha256,
             slh_h_sha256,
             slh_t_sha256,
-            slh_wots_pk_gen_sha2 },
+            slh_f_multi_sha256,
+            slh_h_multi_sha256 },
         { slh_hash_sha256_precache,
             slh_hash_sha256_dup,
             slh_hmsg_sha512,
@@ -495,7 +550,8 @@ const SLH_HASH_FUNC *ossl_slh_get_hash_fn(int is_shake, int security_category)
             slh_f_sha256,
             slh_h_sha512,
             slh_t_sha512,
-            slh_wots_pk_gen_sha2 }
+            slh_f_multi_sha256,
+            slh_h_multi_sha512 }
     };
     return &methods[is_shake ? 0 : (security_category == 1 ? 1 : 2)];
 }
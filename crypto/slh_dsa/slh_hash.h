@@ -52,9 +52,19 @@ typedef int(OSSL_SLH_HASHFUNC_H)(SLH_DSA_HASH_CTX *ctx, const uint8_t *pk_seed,
 
 #define OSSL_SLH_HASHFUNC_T OSSL_SLH_HASHFUNC_F
 
-typedef int(OSSL_SLH_HASHFUNC_wots_pk_gen)(SLH_DSA_HASH_CTX *hctx,
-    const uint8_t *sk_seed, const uint8_t *pk_seed,
-    uint8_t *adrs, uint8_t *pk_out, size_t pk_out_len);
+/*
+ * Computes F() of |lanes| independent inputs at once, each with its own
+ * |adrs| and a message |m| of size |n|, into the |n| byte outputs |out|.
+ * |out[i]| may be |m[i]|. As PRF() is F() with SK.seed as the message,
+ * this also computes several PRF() values at once.
+ */
+typedef int(OSSL_SLH_HASHFUNC_F_multi)(SLH_DSA_HASH_CTX *ctx,
+    const uint8_t *pk_seed, size_t lanes,
+    const uint8_t *const adrs[], const uint8_t *const m[],
+    uint8_t *const out[]);
+
+/* The same for H(), with each |m[i]| being the two |n| byte children */
+#define OSSL_SLH_HASHFUNC_H_multi OSSL_SLH_HASHFUNC_F_multi
 
 typedef int(OSSL_SLH_HASHFUNC_prehash_pk_seed)(SLH_DSA_HASH_CTX *hctx,
     const uint8_t *pk_seed, size_t n);
@@ -70,7 +80,8 @@ typedef struct slh_hash_func_st {
     OSSL_SLH_HASHFUNC_F *F;
     OSSL_SLH_HASHFUNC_H *H;
     OSSL_SLH_HASHFUNC_T *T;
-    OSSL_SLH_HASHFUNC_wots_pk_gen *wots_pk_gen;
+    OSSL_SLH_HASHFUNC_F_multi *F_multi;
+    OSSL_SLH_HASHFUNC_H_multi *H_multi;
 } SLH_HASH_FUNC;
 
 const SLH_HASH_FUNC *ossl_slh_get_hash_fn(int is_shake, int security_category);
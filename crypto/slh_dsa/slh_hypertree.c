@@ -1,5 +1,5 @@
 /*
- * Copyright 2024-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2024-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -11,6 +11,102 @@
 #include "slh_dsa_local.h"
 #include "slh_dsa_key.h"
 
+#define SLH_MAX_D 22
+
+typedef struct {
+    const uint8_t *sk_seed;
+    const uint8_t *pk_seed;
+    uint64_t tree_ids[SLH_MAX_D];
+    uint32_t leaf_ids[SLH_MAX_D];
+    uint8_t *sig; /* The |d| XMSS signatures */
+    uint8_t roots[SLH_MAX_D][SLH_MAX_N];
+} SLH_HT_SIGN_ARGS;
+
+/*
+ * Compute the authentication path of the XMSS signature at |layer|, and the
+ * root of its tree, which the next layer signs.
+ */
+static int slh_ht_sign_layer(SLH_DSA_HASH_CTX *ctx, void *varg, uint32_t layer)
+{
+    SLH_HT_SIGN_ARGS *args = varg;
+    const SLH_DSA_KEY *key = ctx->key;
+    const SLH_DSA_PARAMS *params = key->params;
+    size_t xmss_len = (SLH_WOTS_LEN(params->n) + params->hm) * params->n;
+
+    SLH_ADRS_FUNC_DECLARE(key, adrsf);
+    SLH_ADRS_DECLARE(adrs);
+
+    adrsf->zero(adrs);
+    adrsf->set_layer_address(adrs, layer);
+    adrsf->set_tree_address(adrs, args->tree_ids[layer]);
+    return ossl_slh_xmss_auth_path(ctx, args->sk_seed, args->leaf_ids[layer],
+        args->pk_seed, adrs,
+        args->sig + layer * xmss_len + SLH_WOTS_LEN(params->n) * params->n,
+        layer + 1 < params->d ? args->roots[layer] : NULL);
+}
+
+/*
+ * Generate a Hypertree Signature with the layers computed concurrently.
+ *
+ * The signature of each layer is the WOTS+ signature of the root of the tree
+ * below, so computing one after the other, as ossl_slh_ht_sign() does, needs
+ * the signature of a layer to get the root that the next layer signs.
+ * Here, the authentication paths of all the layers, which are most of the
+ * work, are computed concurrently, along with the root of each tree from its
+ * leaf. The WOTS+ signatures of these roots are then added one by one.
+ * The signature is the same.
+ */
+static int slh_ht_sign_threads(SLH_DSA_HASH_CTX *ctx, const uint8_t *msg,
+    const uint8_t *sk_seed, const uint8_t *pk_seed,
+    uint64_t tree_id, uint32_t leaf_id, WPACKET *sig_wpkt)
+{
+    const SLH_DSA_KEY *key = ctx->key;
+    const SLH_DSA_PARAMS *params = key->params;
+    uint32_t n = params->n;
+    uint32_t d = params->d;
+    uint32_t hm = params->hm;
+    uint32_t mask = (1 << hm) - 1;
+    size_t wots_len = SLH_WOTS_LEN(n) * n;
+    uint32_t layer;
+    WPACKET wots_pkt;
+    SLH_HT_SIGN_ARGS args;
+
+    SLH_ADRS_FUNC_DECLARE(key, adrsf);
+    SLH_ADRS_DECLARE(adrs);
+
+    if (d > SLH_MAX_D)
+        return 0;
+    args.sk_seed = sk_seed;
+    args.pk_seed = pk_seed;
+    for (layer = 0; layer < d; ++layer) {
+        args.tree_ids[layer] = tree_id;
+        args.leaf_ids[layer] = leaf_id;
+        leaf_id = tree_id & mask;
+        tree_id >>= hm;
+    }
+    if (!WPACKET_allocate_bytes(sig_wpkt, d * (wots_len + hm * n), &args.sig)
+        || !ossl_slh_run_tasks(ctx, d, slh_ht_sign_layer, &args))
+        return 0;
+
+    for (layer = 0; layer < d; ++layer) {
+        adrsf->zero(adrs);
+        adrsf->set_layer_address(adrs, layer);
+        adrsf->set_tree_address(adrs, args.tree_ids[layer]);
+        adrsf->set_type_and_clear(adrs, SLH_ADRS_TYPE_WOTS_HASH);
+        adrsf->set_keypair_address(adrs, args.leaf_ids[layer]);
+        if (!WPACKET_init_static_len(&wots_pkt,
+                args.sig + layer * (wots_len + hm * n), wots_len, 0))
+            return 0;
+        if (!ossl_slh_wots_sign(ctx, layer == 0 ? msg : args.roots[layer - 1],
+                sk_seed, pk_seed, adrs, &wots_pkt)
+            || !WPACKET_finish(&wots_pkt)) {
+            WPACKET_cleanup(&wots_pkt);
+            return 0;
+        }
+    }
+    return 1;
+}
+
 /**
  * @brief Generate a Hypertree Signature
  * See FIPS 205 Section 7.1 Algorithm 12
@@ -45,6 +141,10 @@ int ossl_slh_ht_sign(SLH_DSA_HASH_CTX *ctx,
     uint8_t *psig;
     PACKET rpkt, *xmss_sig_rpkt = &rpkt;
 
+    if (ossl_slh_threads(ctx, d) > 1)
+        return slh_ht_sign_threads(ctx, msg, sk_seed, pk_seed, tree_id,
+            leaf_id, sig_wpkt);
+
     mask = (1 << hm) - 1; /* A mod 2^h = A & ((2^h - 1))) */
 
     adrsf->zero(adrs);
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include "internal/thread.h"
+#include "slh_dsa_local.h"
+#include "slh_dsa_key.h"
+
+/*
+ * Computing independent parts of a signature on the thread pool of the
+ * library context, see OSSL_set_max_threads().
+ *
+ * The parts are dealt out in turn to as many threads as the "threads"
+ * signature parameter asks for and the pool has available, the calling thread
+ * being one of them. Each part is written to its own place in the signature,
+ * so the signature does not depend on which thread computed what. The threads
+ * share the SLH_DSA_HASH_CTX, which F, H, T and PRF only read.
+ */
+
+#define SLH_MAX_THREADS 16
+
+typedef struct {
+    SLH_DSA_HASH_CTX *ctx;
+    OSSL_SLH_TASK_FN *fn;
+    void *arg;
+    uint32_t n;
+    uint32_t first;
+    uint32_t stride;
+    int ok;
+} SLH_LANE;
+
+static void run_lane(SLH_LANE *lane)
+{
+    uint32_t i;
+
+    lane->ok = 1;
+    for (i = lane->first; lane->ok && i < lane->n; i += lane->stride)
+        lane->ok = lane->fn(lane->ctx, lane->arg, i);
+}
+
+static CRYPTO_THREAD_RETVAL run_lane_thread(void *arg)
+{
+    run_lane(arg);
+    return 0;
+}
+
+/* Returns the number of threads, including the caller, to do |n| parts on */
+uint32_t ossl_slh_threads(const SLH_DSA_HASH_CTX *ctx, uint32_t n)
+{
+    uint32_t threads = ctx->threads;
+    uint64_t avail;
+
+    if (threads > n)
+        threads = n;
+    if (threads > SLH_MAX_THREADS)
+        threads = SLH_MAX_THREADS;
+    if (threads <= 1)
+        return 1;
+    avail = ossl_get_avail_threads(ossl_slh_dsa_key_get0_libctx(ctx->key));
+    if (avail < threads - 1)
+        threads = (uint32_t)avail + 1;
+    return threads;
+}
+
+/* Calls |fn| for each part 0..n-1, returns 1 if every call succeeded */
+int ossl_slh_run_tasks(SLH_DSA_HASH_CTX *ctx, uint32_t n,
+    OSSL_SLH_TASK_FN *fn, void *arg)
+{
+    SLH_LANE lanes[SLH_MAX_THREADS];
+    void *threads[SLH_MAX_THREADS] = { NULL };
+    OSSL_LIB_CTX *libctx = ossl_slh_dsa_key_get0_libctx(ctx->key);
+    uint32_t i, nlanes = ossl_slh_threads(ctx, n);
+    int ret;
+
+    for (i = 0; i < nlanes; i++) {
+        lanes[i].ctx = ctx;
+        lanes[i].fn = fn;
+        lanes[i].arg = arg;
+        lanes[i].n = n;
+        lanes[i].first = i;
+        lanes[i].stride = nlanes;
+    }
+    for (i = 1; i < nlanes; i++)
+        threads[i] = ossl_crypto_thread_start(libctx, run_lane_thread,
+            &lanes[i]);
+
+    run_lane(&lanes[0]);
+    ret = lanes[0].ok;
+
+    for (i = 1; i < nlanes; i++) {
+        /* Do the parts of a thread that could not be started here instead */
+        if (threads[i] == NULL) {
+            run_lane(&lanes[i]);
+        } else {
+            if (!ossl_crypto_thread_join(threads[i], NULL))
+                ret = 0;
+            ossl_crypto_thread_clean(threads[i]);
+        }
+        ret = ret && lanes[i].ok;
+    }
+    return ret;
+}
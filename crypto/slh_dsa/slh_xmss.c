@@ -64,6 +64,62 @@ int ossl_slh_xmss_node(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
     return 1;
 }
 
+/**
+ * @brief Compute the authentication path of an XMSS leaf node, and optionally
+ * the root of the XMSS tree.
+ * See FIPS 205 Section 6.2 Algorithm 10 (and Section 6.3 Algorithm 11)
+ *
+ * The root is computed from the leaf node and its authentication path, the
+ * same way as ossl_slh_xmss_pk_from_sig() does from an XMSS signature. This
+ * allows the root to be known without the WOTS+ signature of the tree.
+ *
+ * @param ctx Contains SLH_DSA algorithm functions and constants.
+ * @param sk_seed A private key seed of size |n|
+ * @param node_id The index of a WOTS+ key within the XMSS tree.
+ * @param pk_seed A public key seed of size |n|
+ * @param adrs An ADRS object containing the layer address and tree address set
+ *             to the XMSS tree.
+ * @param auth_path The returned authentication path of size (tree_height * n)
+ * @param root If not NULL, the returned root of size |n|
+ * @returns 1 on success, or 0 on error.
+ */
+int ossl_slh_xmss_auth_path(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
+    uint32_t node_id, const uint8_t *pk_seed, uint8_t *adrs,
+    uint8_t *auth_path, uint8_t *root)
+{
+    const SLH_DSA_KEY *key = ctx->key;
+    SLH_ADRS_FUNC_DECLARE(key, adrsf);
+    SLH_HASH_FUNC_DECLARE(key, hashf);
+    SLH_HASH_FN_DECLARE(hashf, H);
+    size_t n = key->params->n;
+    uint32_t h, hm = key->params->hm;
+    const uint8_t *auth;
+
+    for (h = 0; h < hm; ++h)
+        if (!ossl_slh_xmss_node(ctx, sk_seed, (node_id >> h) ^ 1, h, pk_seed,
+                adrs, auth_path + h * n, n))
+            return 0;
+    if (root == NULL)
+        return 1;
+
+    if (!ossl_slh_xmss_node(ctx, sk_seed, node_id, 0, pk_seed, adrs, root, n))
+        return 0;
+    adrsf->set_type_and_clear(adrs, SLH_ADRS_TYPE_TREE);
+    for (h = 0; h < hm; ++h) {
+        auth = auth_path + h * n;
+        adrsf->set_tree_height(adrs, h + 1);
+        adrsf->set_tree_index(adrs, node_id >> (h + 1));
+        if (((node_id >> h) & 1) == 0) {
+            if (!H(ctx, pk_seed, adrs, root, auth, root, n))
+                return 0;
+        } else {
+            if (!H(ctx, pk_seed, adrs, auth, root, root, n))
+                return 0;
+        }
+    }
+    return 1;
+}
+
 /**
  * @brief Generate an XMSS signature using a message and key.
  * See FIPS 205 Section 6.2 Algorithm 10
@@ -89,11 +145,8 @@ int ossl_slh_xmss_sign(SLH_DSA_HASH_CTX *ctx, const uint8_t *msg,
     const SLH_DSA_KEY *key = ctx->key;
     SLH_ADRS_FUNC_DECLARE(key, adrsf);
     SLH_ADRS_DECLARE(tmp_adrs);
-    size_t n = key->params->n;
-    uint32_t h, hm = key->params->hm;
-    uint32_t id = node_id;
+    const SLH_DSA_PARAMS *params = key->params;
     uint8_t *auth_path; /* Pointer to a buffer offset inside |sig_wpkt| */
-    size_t auth_path_len = n;
 
     /*
      * This code reverses the order of the FIPS 205 code so that it does the
@@ -106,14 +159,9 @@ int ossl_slh_xmss_sign(SLH_DSA_HASH_CTX *ctx, const uint8_t *msg,
         return 0;
 
     adrsf->copy(adrs, tmp_adrs);
-    for (h = 0; h < hm; ++h) {
-        if (!WPACKET_allocate_bytes(sig_wpkt, auth_path_len, &auth_path)
-            || !ossl_slh_xmss_node(ctx, sk_seed, id ^ 1, h, pk_seed, adrs,
-                auth_path, auth_path_len))
-            return 0;
-        id >>= 1;
-    }
-    return 1;
+    return WPACKET_allocate_bytes(sig_wpkt, params->hm * params->n, &auth_path)
+        && ossl_slh_xmss_auth_path(ctx, sk_seed, node_id, pk_seed, adrs,
+            auth_path, NULL);
 }
 
 /**
@@ -0,0 +1,585 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include "internal/e_os.h"
+#include "internal/cryptlib.h"
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#if defined(OPENSSL_SYS_UNIX) && !defined(OPENSSL_NO_POSIX_IO)
+#define CERT_INDEX_MMAP
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <openssl/buffer.h>
+#include <openssl/evp.h>
+#include <openssl/safestack.h>
+#include <openssl/x509.h>
+#include "crypto/x509.h"
+#include "x509_local.h"
+
+/*
+ * A certificate index file holds the DER encodings of a set of certificates
+ * together with sorted tables that find them by subject name hash and by
+ * SHA-256 fingerprint, so that a large trust store can be mapped into memory
+ * as is and certificates decoded only when a lookup asks for them.
+ *
+ * All numbers are 32 bit big endian. The file starts with a header:
+ *
+ *      magic "OSSLCIX1", version, count,
+ *      cert table offset, name table offset, fingerprint table offset, 0
+ *
+ * The cert table has |count| entries of the offset and the length of the
+ * encoding of each certificate. The name table has |count| entries of a
+ * subject name hash as computed by X509_NAME_hash_ex() and a certificate
+ * number, sorted by hash. The fingerprint table has |count| entries of a
+ * SHA-256 fingerprint and a certificate number, sorted by fingerprint.
+ */
+
+#define CERT_INDEX_MAGIC "OSSLCIX1"
+#define CERT_INDEX_MAGIC_LEN 8
+#define CERT_INDEX_VERSION 1
+#define CERT_INDEX_HEADER_LEN 32
+#define CERT_INDEX_CERT_ENTRY_LEN 8
+#define CERT_INDEX_NAME_ENTRY_LEN 8
+#define CERT_INDEX_FP_ENTRY_LEN (SHA256_DIGEST_LENGTH + 4)
+
+typedef struct cert_index_st {
+    unsigned char *data;
+    size_t len;
+    int mapped;
+    uint32_t count;
+    const unsigned char *certs;
+    const unsigned char *names;
+    const unsigned char *fps;
+    OSSL_LIB_CTX *libctx;
+    char *propq;
+} CERT_INDEX;
+
+DEFINE_STACK_OF(CERT_INDEX)
+
+static int new_index(X509_LOOKUP *lu);
+static void free_index(X509_LOOKUP *lu);
+static int index_ctrl_ex(X509_LOOKUP *lu, int cmd, const char *argp,
+    long argl, char **retp, OSSL_LIB_CTX *libctx,
+    const char *propq);
+static int get_cert_by_subject(X509_LOOKUP *lu, X509_LOOKUP_TYPE type,
+    const X509_NAME *name, X509_OBJECT *ret);
+static int get_cert_by_subject_ex(X509_LOOKUP *lu, X509_LOOKUP_TYPE type,
+    const X509_NAME *name, X509_OBJECT *ret,
+    OSSL_LIB_CTX *libctx, const char *propq);
+static int get_cert_by_fingerprint(X509_LOOKUP *lu, X509_LOOKUP_TYPE type,
+    const unsigned char *bytes, int len,
+    X509_OBJECT *ret);
+
+static X509_LOOKUP_METHOD x509_index_lookup = {
+    "Load certs from a certificate index",
+    new_index, /* new_item */
+    free_index, /* free */
+    NULL, /* init */
+    NULL, /* shutdown */
+    NULL, /* ctrl */
+    get_cert_by_subject, /* get_by_subject */
+    NULL, /* get_by_issuer_serial */
+    get_cert_by_fingerprint, /* get_by_fingerprint */
+    NULL, /* get_by_alias */
+    get_cert_by_subject_ex, /* get_by_subject_ex */
+    index_ctrl_ex, /* ctrl_ex */
+};
+
+X509_LOOKUP_METHOD *X509_LOOKUP_cert_index(void)
+{
+    return &x509_index_lookup;
+}
+
+static uint32_t get_u32(const unsigned char *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16)
+        | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static unsigned char *put_u32(unsigned char *p, uint32_t v)
+{
+    *p++ = (unsigned char)(v >> 24);
+    *p++ = (unsigned char)(v >> 16);
+    *p++ = (unsigned char)(v >> 8);
+    *p++ = (unsigned char)v;
+    return p;
+}
+
+static void cert_index_free(CERT_INDEX *idx)
+{
+    if (idx == NULL)
+        return;
+#ifdef CERT_INDEX_MMAP
+    if (idx->mapped)
+        munmap(idx->data, idx->len);
+    else
+#endif
+        OPENSSL_free(idx->data);
+    OPENSSL_free(idx->propq);
+    OPENSSL_free(idx);
+}
+
+static int new_index(X509_LOOKUP *lu)
+{
+    STACK_OF(CERT_INDEX) *indexes = sk_CERT_INDEX_new_null();
+
+    if (indexes == NULL) {
+        ERR_raise(ERR_LIB_X509, ERR_R_CRYPTO_LIB);
+        return 0;
+    }
+    lu->method_data = indexes;
+    return 1;
+}
+
+static void free_index(X509_LOOKUP *lu)
+{
+    sk_CERT_INDEX_pop_free(lu->method_data, cert_index_free);
+    lu->method_data = NULL;
+}
+
+static int cert_index_read(CERT_INDEX *idx, const char *file)
+{
+#ifdef CERT_INDEX_MMAP
+    struct stat st;
+    void *p;
+    int fd;
+
+    if ((fd = open(file, O_RDONLY)) < 0) {
+        ERR_raise_data(ERR_LIB_SYS, errno, "calling open(%s)", file);
+        return 0;
+    }
+    if (fstat(fd, &st) < 0 || st.st_size < CERT_INDEX_HEADER_LEN
+        || (uint64_t)st.st_size > SIZE_MAX) {
+        close(fd);
+        ERR_raise(ERR_LIB_X509, X509_R_INVALID_CERT_INDEX);
+        return 0;
+    }
+    /*
+     * The pages are never written, so a private mapping still shares them
+     * with other processes.  Writers must replace the file with rename()
+     * rather than rewrite it, see X509_LOOKUP_cert_index(3).
+     */
+    p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        ERR_raise_data(ERR_LIB_SYS, errno, "calling mmap(%s)", file);
+        return 0;
+    }
+    idx->data = p;
+    idx->len = (size_t)st.st_size;
+    idx->mapped = 1;
+    return 1;
+#else
+    BIO *in;
+    BUF_MEM *b;
+    int n, ok = 0;
+
+    if ((in = BIO_new_file(file, "rb")) == NULL) {
+        ERR_raise(ERR_LIB_X509, ERR_R_BIO_LIB);
+        return 0;
+    }
+    if ((b = BUF_MEM_new()) == NULL) {
+        BIO_free(in);
+        return 0;
+    }
+    for (;;) {
+        if (!BUF_MEM_grow(b, b->length + 4096))
+            goto err;
+        if ((n = BIO_read(in, b->data + b->length - 4096, 4096)) < 0)
+            goto err;
+        b->length -= 4096 - n;
+        if (n == 0)
+            break;
+    }
+    idx->len = b->length;
+    idx->data = (unsigned char *)b->data;
+    b->data = NULL;
+    ok = 1;
+err:
+    BUF_MEM_free(b);
+    BIO_free(in);
+    return ok;
+#endif
+}
+
+/* Check that every table and every certificate lies within the file */
+static int cert_index_check(CERT_INDEX *idx)
+{
+    const unsigned char *p = idx->data;
+    uint32_t i, off_certs, off_names, off_fps;
+
+    if (idx->len < CERT_INDEX_HEADER_LEN
+        || memcmp(p, CERT_INDEX_MAGIC, CERT_INDEX_MAGIC_LEN) != 0
+        || get_u32(p + 8) != CERT_INDEX_VERSION)
+        return 0;
+    idx->count = get_u32(p + 12);
+    off_certs = get_u32(p + 16);
+    off_names = get_u32(p + 20);
+    off_fps = get_u32(p + 24);
+
+    if (idx->count > idx->len / CERT_INDEX_FP_ENTRY_LEN
+        || off_certs > idx->len
+        || idx->len - off_certs < (size_t)idx->count * CERT_INDEX_CERT_ENTRY_LEN
+        || off_names > idx->len
+        || idx->len - off_names < (size_t)idx->count * CERT_INDEX_NAME_ENTRY_LEN
+        || off_fps > idx->len
+        || idx->len - off_fps < (size_t)idx->count * CERT_INDEX_FP_ENTRY_LEN)
+        return 0;
+    idx->certs = p + off_certs;
+    idx->names = p + off_names;
+    idx->fps = p + off_fps;
+
+    for (i = 0; i < idx->count; i++) {
+        const unsigned char *c = idx->certs + (size_t)i * CERT_INDEX_CERT_ENTRY_LEN;
+        uint32_t off = get_u32(c), len = get_u32(c + 4);
+
+        if (off > idx->len || idx->len - off < len || len > INT_MAX
+            || get_u32(idx->names + (size_t)i * CERT_INDEX_NAME_ENTRY_LEN + 4)
+                >= idx->count
+            || get_u32(idx->fps + (size_t)i * CERT_INDEX_FP_ENTRY_LEN
+                   + SHA256_DIGEST_LENGTH)
+                >= idx->count)
+            return 0;
+    }
+    return 1;
+}
+
+static int add_cert_index(X509_LOOKUP *lu, const char *file,
+    OSSL_LIB_CTX *libctx, const char *propq)
+{
+    CERT_INDEX *idx;
+
+    if (file == NULL) {
+        ERR_raise(ERR_LIB_X509, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+    if ((idx = OPENSSL_zalloc(sizeof(*idx))) == NULL)
+        return 0;
+    idx->libctx = libctx;
+    if (propq != NULL && (idx->propq = OPENSSL_strdup(propq)) == NULL)
+        goto err;
+    if (!cert_index_read(idx, file))
+        goto err;
+    if (!cert_index_check(idx)) {
+        ERR_raise_data(ERR_LIB_X509, X509_R_INVALID_CERT_INDEX, "%s", file);
+        goto err;
+    }
+    if (!sk_CERT_INDEX_push(lu->method_data, idx)) {
+        ERR_raise(ERR_LIB_X509, ERR_R_CRYPTO_LIB);
+        goto err;
+    }
+    return 1;
+err:
+    cert_index_free(idx);
+    return 0;
+}
+
+static int index_ctrl_ex(X509_LOOKUP *lu, int cmd, const char *argp,
+    long argl, char **retp, OSSL_LIB_CTX *libctx,
+    const char *propq)
+{
+    switch (cmd) {
+    case X509_L_LOAD_CERT_INDEX:
+        return add_cert_index(lu, argp, libctx, propq);
+    }
+    return 0;
+}
+
+static X509 *cert_index_decode(const CERT_INDEX *idx, uint32_t n,
+    OSSL_LIB_CTX *libctx, const char *propq)
+{
+    const unsigned char *c = idx->certs + (size_t)n * CERT_INDEX_CERT_ENTRY_LEN;
+    const unsigned char *der = idx->data + get_u32(c);
+    X509 *x = X509_new_ex(libctx, propq);
+
+    if (x == NULL)
+        return NULL;
+    if (d2i_X509(&x, &der, (long)get_u32(c + 4)) == NULL) {
+        X509_free(x);
+        return NULL;
+    }
+    return x;
+}
+
+/* Find the first entry of the name table of |idx| with hash |h| */
+static uint32_t cert_index_find_name(const CERT_INDEX *idx, uint32_t h)
+{
+    uint32_t lo = 0, hi = idx->count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (get_u32(idx->names + (size_t)mid * CERT_INDEX_NAME_ENTRY_LEN) < h)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/*
+ * Copy the object in the store of |lu| that matches |stmp| into |ret|. If
+ * |exact| is set the certificate itself must match, not only its subject.
+ */
+static int get_from_store(X509_LOOKUP *lu, const X509_NAME *name,
+    X509_OBJECT *stmp, int exact, X509_OBJECT *ret)
+{
+    STACK_OF(X509_OBJECT) *objs;
+    X509_OBJECT *tmp = NULL;
+
+    if (ossl_x509_store_read_lock(lu->store_ctx) == 0)
+        return 0;
+    if (lu->store_ctx->objs_ht)
+        objs = ossl_x509_store_ht_get_by_name(lu->store_ctx, name);
+    else
+        objs = lu->store_ctx->objs;
+    if (objs != NULL)
+        tmp = exact ? X509_OBJECT_retrieve_match(objs, stmp)
+                    : sk_X509_OBJECT_value(objs, sk_X509_OBJECT_find(objs, stmp));
+    X509_STORE_unlock(lu->store_ctx);
+
+    if (tmp == NULL)
+        return 0;
+    ret->type = tmp->type;
+    memcpy(&ret->data, &tmp->data, sizeof(ret->data));
+    return 1;
+}
+
+static int get_cert_by_subject(X509_LOOKUP *lu, X509_LOOKUP_TYPE type,
+    const X509_NAME *name, X509_OBJECT *ret)
+{
+    return get_cert_by_subject_ex(lu, type, name, ret, NULL, NULL);
+}
+
+static int get_cert_by_subject_ex(X509_LOOKUP *lu, X509_LOOKUP_TYPE type,
+    const X509_NAME *name, X509_OBJECT *ret,
+    OSSL_LIB_CTX *libctx, const char *propq)
+{
+    STACK_OF(CERT_INDEX) *indexes = lu->method_data;
+    X509 st_x509;
+    X509_OBJECT stmp;
+    uint32_t h, n;
+    int i, ok, found = 0;
+
+    /* Only certificates are indexed */
+    if (name == NULL || type != X509_LU_X509)
+        return 0;
+
+    h = (uint32_t)X509_NAME_hash_ex(name, libctx, propq, &ok);
+    if (!ok)
+        return 0;
+
+    for (i = 0; i < sk_CERT_INDEX_num(indexes); i++) {
+        const CERT_INDEX *idx = sk_CERT_INDEX_value(indexes, i);
+
+        for (n = cert_index_find_name(idx, h); n < idx->count; n++) {
+            const unsigned char *e = idx->names + (size_t)n * CERT_INDEX_NAME_ENTRY_LEN;
+            X509 *x;
+
+            if (get_u32(e) != h)
+                break;
+            if ((x = cert_index_decode(idx, get_u32(e + 4), libctx, propq)) == NULL)
+                continue;
+            if (X509_NAME_cmp(X509_get_subject_name(x), name) == 0
+                && X509_STORE_add_cert(lu->store_ctx, x))
+                found = 1;
+            X509_free(x);
+        }
+    }
+    if (!found)
+        return 0;
+
+    st_x509.cert_info.subject = (X509_NAME *)name; /* won't modify it */
+    stmp.type = X509_LU_X509;
+    stmp.data.x509 = &st_x509;
+    return get_from_store(lu, name, &stmp, 0, ret);
+}
+
+static int cert_index_fp_cmp(const void *fp, const void *e)
+{
+    return memcmp(fp, e, SHA256_DIGEST_LENGTH);
+}
+
+static int get_cert_by_fingerprint(X509_LOOKUP *lu, X509_LOOKUP_TYPE type,
+    const unsigned char *bytes, int len,
+    X509_OBJECT *ret)
+{
+    STACK_OF(CERT_INDEX) *indexes = lu->method_data;
+    X509_OBJECT stmp;
+    X509 *x = NULL;
+    int i, ok;
+
+    if (type != X509_LU_X509 || bytes == NULL || len != SHA256_DIGEST_LENGTH)
+        return 0;
+
+    for (i = 0; x == NULL && i < sk_CERT_INDEX_num(indexes); i++) {
+        const CERT_INDEX *idx = sk_CERT_INDEX_value(indexes, i);
+        const unsigned char *e;
+
+        e = bsearch(bytes, idx->fps, idx->count, CERT_INDEX_FP_ENTRY_LEN,
+            cert_index_fp_cmp);
+        if (e != NULL)
+            x = cert_index_decode(idx, get_u32(e + SHA256_DIGEST_LENGTH),
+                idx->libctx, idx->propq);
+    }
+    if (x == NULL || !X509_STORE_add_cert(lu->store_ctx, x)) {
+        X509_free(x);
+        return 0;
+    }
+
+    stmp.type = X509_LU_X509;
+    stmp.data.x509 = x;
+    ok = get_from_store(lu, X509_get_subject_name(x), &stmp, 1, ret);
+    X509_free(x);
+    return ok;
+}
+
+typedef struct {
+    unsigned char fp[SHA256_DIGEST_LENGTH];
+    uint32_t hash;
+    uint32_t cert;
+    X509 *x;
+    int derlen;
+} CERT_INDEX_ENTRY;
+
+static int cert_index_entry_fp_cmp(const void *a, const void *b)
+{
+    return memcmp(((const CERT_INDEX_ENTRY *)a)->fp,
+        ((const CERT_INDEX_ENTRY *)b)->fp, SHA256_DIGEST_LENGTH);
+}
+
+static int cert_index_entry_name_cmp(const void *a, const void *b)
+{
+    const CERT_INDEX_ENTRY *ea = a, *eb = b;
+
+    if (ea->hash != eb->hash)
+        return ea->hash < eb->hash ? -1 : 1;
+    return ea->cert < eb->cert ? -1 : ea->cert > eb->cert;
+}
+
+int X509_cert_index_write(BIO *out, const STACK_OF(X509) *certs,
+    OSSL_LIB_CTX *libctx, const char *propq)
+{
+    CERT_INDEX_ENTRY *ents = NULL;
+    EVP_MD *md = NULL;
+    unsigned char *buf = NULL, *p, *der;
+    uint32_t off_certs, off_names, off_fps;
+    size_t total;
+    int i, j, n, num = sk_X509_num(certs), ok = 0, hok;
+
+    if (out == NULL) {
+        ERR_raise(ERR_LIB_X509, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+    if ((md = EVP_MD_fetch(libctx, "SHA256", propq)) == NULL) {
+        ERR_raise(ERR_LIB_X509, ERR_R_EVP_LIB);
+        return 0;
+    }
+    if (num > (int)((UINT32_MAX - CERT_INDEX_HEADER_LEN)
+                    / (CERT_INDEX_CERT_ENTRY_LEN + CERT_INDEX_NAME_ENTRY_LEN
+                        + CERT_INDEX_FP_ENTRY_LEN))) {
+        ERR_raise(ERR_LIB_X509, X509_R_INVALID_CERT_INDEX);
+        goto err;
+    }
+    if (num > 0 && (ents = OPENSSL_calloc(num, sizeof(*ents))) == NULL)
+        goto err;
+
+    for (i = 0; i < num; i++) {
+        X509 *x = sk_X509_value(certs, i);
+        unsigned long h;
+
+        ents[i].x = x;
+        h = X509_NAME_hash_ex(X509_get_subject_name(x), libctx, propq, &hok);
+        if (!hok || (ents[i].derlen = i2d_X509(x, NULL)) <= 0
+            || !X509_digest(x, md, ents[i].fp, NULL)) {
+            ERR_raise(ERR_LIB_X509, ERR_R_X509_LIB);
+            goto err;
+        }
+        ents[i].hash = (uint32_t)h;
+    }
+
+    /*
+     * Certificates are numbered in fingerprint order, which makes the
+     * fingerprint table the identity mapping and drops duplicates.
+     */
+    if (num > 0)
+        qsort(ents, num, sizeof(*ents), cert_index_entry_fp_cmp);
+    for (i = n = 0; i < num; i++) {
+        if (n > 0 && cert_index_entry_fp_cmp(&ents[n - 1], &ents[i]) == 0)
+            continue;
+        ents[n] = ents[i];
+        ents[n].cert = n;
+        n++;
+    }
+
+    off_certs = CERT_INDEX_HEADER_LEN;
+    off_names = off_certs + n * CERT_INDEX_CERT_ENTRY_LEN;
+    off_fps = off_names + n * CERT_INDEX_NAME_ENTRY_LEN;
+    total = off_fps + (size_t)n * CERT_INDEX_FP_ENTRY_LEN;
+    for (i = 0; i < n; i++) {
+        if ((size_t)ents[i].derlen > UINT32_MAX - total) {
+            ERR_raise(ERR_LIB_X509, X509_R_INVALID_CERT_INDEX);
+            goto err;
+        }
+        total += ents[i].derlen;
+    }
+    if ((buf = OPENSSL_malloc(total)) == NULL)
+        goto err;
+
+    p = buf;
+    memcpy(p, CERT_INDEX_MAGIC, CERT_INDEX_MAGIC_LEN);
+    p = put_u32(p + CERT_INDEX_MAGIC_LEN, CERT_INDEX_VERSION);
+    p = put_u32(p, (uint32_t)n);
+    p = put_u32(p, off_certs);
+    p = put_u32(p, off_names);
+    p = put_u32(p, off_fps);
+    p = put_u32(p, 0);
+
+    der = buf + off_fps + (size_t)n * CERT_INDEX_FP_ENTRY_LEN;
+    for (i = 0; i < n; i++) {
+        p = put_u32(p, (uint32_t)(der - buf));
+        p = put_u32(p, (uint32_t)ents[i].derlen);
+        if (i2d_X509(ents[i].x, &der) != ents[i].derlen) {
+            ERR_raise(ERR_LIB_X509, ERR_R_X509_LIB);
+            goto err;
+        }
+    }
+    p = buf + off_fps;
+    for (i = 0; i < n; i++) {
+        memcpy(p, ents[i].fp, SHA256_DIGEST_LENGTH);
+        p = put_u32(p + SHA256_DIGEST_LENGTH, ents[i].cert);
+    }
+    if (n > 0)
+        qsort(ents, n, sizeof(*ents), cert_index_entry_name_cmp);
+    p = buf + off_names;
+    for (i = 0; i < n; i++) {
+        p = put_u32(p, ents[i].hash);
+        p = put_u32(p, ents[i].cert);
+    }
+
+    for (p = buf; total > 0; p += j, total -= j) {
+        if ((j = BIO_write(out, p, total > INT_MAX ? INT_MAX : (int)total)) <= 0) {
+            ERR_raise(ERR_LIB_X509, ERR_R_BIO_LIB);
+            goto err;
+        }
+    }
+    ok = 1;
+err:
+    OPENSSL_free(buf);
+    OPENSSL_free(ents);
+    EVP_MD_free(md);
+    return ok;
+}
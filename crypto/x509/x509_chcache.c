@@ -0,0 +1,272 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include <openssl/x509v3.h>
+#include "internal/hashtable.h"
+#include "crypto/x509.h"
+#include "x509_local.h"
+
+/*
+ * A cache of chains that an X509_STORE verified successfully.
+ *
+ * Entries are keyed by the fingerprints of the target certificate and of all
+ * untrusted certificates that were offered with it, together with those
+ * verification parameters that can change the outcome other than the time
+ * and the peer identity. The time is checked against the validity window of
+ * the cached chain, the peer identity is checked again on every hit.
+ *
+ * The table is emptied whenever a certificate or CRL is added to the store
+ * and when it would grow beyond its configured size.
+ */
+
+#define CHAIN_CACHE_MAX_CERTS 16
+#define CHAIN_CACHE_BUCKETS 64
+
+typedef struct {
+    STACK_OF(X509) *chain;
+    int num_untrusted;
+    int64_t not_before;
+    int64_t not_after;
+} CHAIN_CACHE_ENTRY;
+
+typedef struct {
+    const OSSL_LIB_CTX *libctx;
+    unsigned long flags;
+    uint32_t inh_flags;
+    int purpose;
+    int trust;
+    int depth;
+    int auth_level;
+    int ncerts;
+} CHAIN_CACHE_PARAMS;
+
+HT_START_KEY_DEFN(chain_cache_key)
+HT_DEF_KEY_FIELD_UINT8T_ARRAY(buf, sizeof(CHAIN_CACHE_PARAMS) + CHAIN_CACHE_MAX_CERTS * SHA_DIGEST_LENGTH)
+HT_END_KEY_DEFN(CHAIN_CACHE_KEY)
+
+IMPLEMENT_HT_VALUE_TYPE_FNS(CHAIN_CACHE_ENTRY, chcache, static)
+
+static void chain_cache_entry_free(CHAIN_CACHE_ENTRY *e)
+{
+    if (e == NULL)
+        return;
+    OSSL_STACK_OF_X509_free(e->chain);
+    OPENSSL_free(e);
+}
+
+static void chain_cache_free(HT_VALUE *v)
+{
+    chain_cache_entry_free(ossl_ht_chcache_CHAIN_CACHE_ENTRY_from_value(v));
+}
+
+static int chain_cache_add_fingerprint(HT_KEY *key, X509 *x)
+{
+    if (!ossl_x509v3_cache_extensions(x)
+        || (x->ex_flags & EXFLAG_NO_FINGERPRINT) != 0)
+        return 0;
+    return HT_COPY_RAW_KEY(key, x->sha1_hash, SHA_DIGEST_LENGTH);
+}
+
+/* Returns 0 if the verification |ctx| is about cannot be cached */
+static int chain_cache_key(CHAIN_CACHE_KEY *key, X509_STORE_CTX *ctx)
+{
+    const X509_VERIFY_PARAM *vpm = ctx->param;
+    CHAIN_CACHE_PARAMS p;
+    int i, n = sk_X509_num(ctx->untrusted);
+
+    if (n >= CHAIN_CACHE_MAX_CERTS)
+        return 0;
+
+    /* Zeroed so that padding does not end up in the key */
+    memset(&p, 0, sizeof(p));
+    p.libctx = ctx->libctx;
+    p.flags = vpm->flags;
+    p.inh_flags = vpm->inh_flags;
+    p.purpose = vpm->purpose;
+    p.trust = vpm->trust;
+    p.depth = vpm->depth;
+    p.auth_level = vpm->auth_level;
+    p.ncerts = n;
+
+    HT_INIT_RAW_KEY(key);
+    if (!HT_COPY_RAW_KEY(TO_HT_KEY(key), (const uint8_t *)&p, sizeof(p))
+        || !chain_cache_add_fingerprint(TO_HT_KEY(key), ctx->cert))
+        return 0;
+    for (i = 0; i < n; i++)
+        if (!chain_cache_add_fingerprint(TO_HT_KEY(key),
+                sk_X509_value(ctx->untrusted, i)))
+            return 0;
+    return 1;
+}
+
+/*
+ * The key only holds fingerprints, make sure that the untrusted part of the
+ * cached chain really consists of the certificates we were given.
+ */
+static int chain_cache_match(X509_STORE_CTX *ctx, STACK_OF(X509) *chain,
+    int num_untrusted)
+{
+    int i, j, n = sk_X509_num(ctx->untrusted);
+
+    if (X509_cmp(sk_X509_value(chain, 0), ctx->cert) != 0)
+        return 0;
+    for (i = 1; i < num_untrusted; i++) {
+        X509 *x = sk_X509_value(chain, i);
+
+        for (j = 0; j < n; j++)
+            if (X509_cmp(sk_X509_value(ctx->untrusted, j), x) == 0)
+                break;
+        if (j == n)
+            return 0;
+    }
+    return 1;
+}
+
+int ossl_x509_chain_cache_get(X509_STORE_CTX *ctx, int64_t verification_time,
+    int check_time)
+{
+    X509_STORE *store = ctx->store;
+    CHAIN_CACHE_KEY key;
+    CHAIN_CACHE_ENTRY *e;
+    HT_VALUE *v;
+    STACK_OF(X509) *chain = NULL;
+    int num_untrusted = 0;
+    uint64_t tmp;
+
+    if (!chain_cache_key(&key, ctx))
+        return 0;
+
+    if (!ossl_ht_read_lock(store->chain_cache))
+        return 0;
+    e = ossl_ht_chcache_CHAIN_CACHE_ENTRY_get(store->chain_cache,
+        TO_HT_KEY(&key), &v);
+    if (e != NULL
+        && (!check_time
+            || (verification_time >= e->not_before
+                && verification_time <= e->not_after))) {
+        chain = X509_chain_up_ref(e->chain);
+        num_untrusted = e->num_untrusted;
+    }
+    ossl_ht_read_unlock(store->chain_cache);
+
+    if (chain != NULL && !chain_cache_match(ctx, chain, num_untrusted)) {
+        OSSL_STACK_OF_X509_free(chain);
+        chain = NULL;
+    }
+    CRYPTO_atomic_add64(chain != NULL ? &store->chain_cache_hits
+                                      : &store->chain_cache_misses,
+        1, &tmp, store->lock);
+    if (chain == NULL)
+        return 0;
+
+    OSSL_STACK_OF_X509_free(ctx->chain);
+    ctx->chain = chain;
+    ctx->num_untrusted = num_untrusted;
+    return 1;
+}
+
+/*
+ * Remember the chain of |ctx|, which has just been verified successfully and
+ * whose certificates are all valid from |not_before| until |not_after|.
+ */
+void ossl_x509_chain_cache_add(X509_STORE_CTX *ctx, int64_t not_before,
+    int64_t not_after)
+{
+    X509_STORE *store = ctx->store;
+    CHAIN_CACHE_KEY key;
+    CHAIN_CACHE_ENTRY *e;
+    int rv;
+
+    if (!chain_cache_key(&key, ctx))
+        return;
+    if ((e = OPENSSL_zalloc(sizeof(*e))) == NULL)
+        return;
+    if ((e->chain = X509_chain_up_ref(ctx->chain)) == NULL) {
+        OPENSSL_free(e);
+        return;
+    }
+    e->num_untrusted = ctx->num_untrusted;
+    e->not_before = not_before;
+    e->not_after = not_after;
+
+    ossl_ht_write_lock(store->chain_cache);
+    if (ossl_ht_count(store->chain_cache) >= store->chain_cache_size)
+        ossl_ht_flush(store->chain_cache);
+    /* Another thread may have got here first, which is fine */
+    rv = ossl_ht_chcache_CHAIN_CACHE_ENTRY_insert(store->chain_cache,
+        TO_HT_KEY(&key), e, NULL);
+    ossl_ht_write_unlock(store->chain_cache);
+    if (rv != 1)
+        chain_cache_entry_free(e);
+}
+
+void ossl_x509_chain_cache_flush(X509_STORE *xs)
+{
+    if (xs->chain_cache == NULL)
+        return;
+    ossl_ht_write_lock(xs->chain_cache);
+    ossl_ht_flush(xs->chain_cache);
+    ossl_ht_write_unlock(xs->chain_cache);
+}
+
+int X509_STORE_set_chain_cache_size(X509_STORE *xs, size_t size)
+{
+    HT_CONFIG htconf = {
+        .ht_free_fn = chain_cache_free,
+        .init_neighborhoods = CHAIN_CACHE_BUCKETS,
+        .collision_check = 1,
+    };
+
+    if (xs == NULL) {
+        ERR_raise(ERR_LIB_X509, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    if (size == 0) {
+        ossl_ht_free(xs->chain_cache);
+        xs->chain_cache = NULL;
+    } else if (xs->chain_cache == NULL) {
+        if ((xs->chain_cache = ossl_ht_new(&htconf)) == NULL) {
+            ERR_raise(ERR_LIB_X509, ERR_R_CRYPTO_LIB);
+            return 0;
+        }
+    } else {
+        ossl_x509_chain_cache_flush(xs);
+    }
+    xs->chain_cache_size = size;
+    return 1;
+}
+
+size_t X509_STORE_get_chain_cache_size(const X509_STORE *xs)
+{
+    return xs->chain_cache_size;
+}
+
+int X509_STORE_get_chain_cache_stats(X509_STORE *xs, uint64_t *hits,
+    uint64_t *misses)
+{
+    if (xs == NULL) {
+        ERR_raise(ERR_LIB_X509, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+    if (hits != NULL && !CRYPTO_atomic_load(&xs->chain_cache_hits, hits,
+            xs->lock))
+        return 0;
+    if (misses != NULL && !CRYPTO_atomic_load(&xs->chain_cache_misses, misses,
+            xs->lock))
+        return 0;
+    return 1;
+}
+
+void X509_STORE_flush_chain_cache(X509_STORE *xs)
+{
+    if (xs != NULL)
+        ossl_x509_chain_cache_flush(xs);
+}
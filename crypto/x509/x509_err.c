@@ -39,6 +39,8 @@ static const ERR_STRING_DATA X509_str_reasons[] = {
     { ERR_PACK(ERR_LIB_X509, 0, X509_R_IDP_MISMATCH), "idp mismatch" },
     { ERR_PACK(ERR_LIB_X509, 0, X509_R_INVALID_ATTRIBUTES),
         "invalid attributes" },
+    { ERR_PACK(ERR_LIB_X509, 0, X509_R_INVALID_CERT_INDEX),
+        "invalid cert index" },
     { ERR_PACK(ERR_LIB_X509, 0, X509_R_INVALID_DIRECTORY), "invalid directory" },
     { ERR_PACK(ERR_LIB_X509, 0, X509_R_INVALID_DISTPOINT), "invalid distpoint" },
     { ERR_PACK(ERR_LIB_X509, 0, X509_R_INVALID_EXTENSION), "invalid extension" },
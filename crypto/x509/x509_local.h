@@ -177,8 +177,43 @@ struct x509_store_st {
     CRYPTO_EX_DATA ex_data;
     CRYPTO_REF_COUNT references;
     CRYPTO_RWLOCK *lock;
+    /* Chains verified earlier, see x509_chcache.c */
+    HT *chain_cache;
+    size_t chain_cache_size;
+    uint64_t chain_cache_hits;
+    uint64_t chain_cache_misses;
+    /* Revocation statuses established earlier, see x509_rvcache.c */
+    HT *rv_cache;
+    size_t rv_cache_size;
+    uint64_t rv_cache_hits;
+    uint64_t rv_cache_misses;
 };
 
+/* A check of the signature of |cert| or |crl| with |pkey|, see x509_par.c */
+typedef struct x509_sig_check_st {
+    X509 *cert;
+    X509_CRL *crl;
+    EVP_PKEY *pkey;
+    int ok;
+} X509_SIG_CHECK;
+
+#define X509_RV_CACHE_OCSP 1
+#define X509_RV_CACHE_CRL 2
+
+/* A revocation status of a certificate, see x509_rvcache.c */
+typedef struct x509_rv_cache_result_st {
+    /* X509_RV_CACHE_OCSP or X509_RV_CACHE_CRL */
+    int source;
+    /* V_OCSP_CERTSTATUS_GOOD or V_OCSP_CERTSTATUS_REVOKED */
+    int status;
+    /* The result of the OCSP check, if the status is revoked */
+    int reason;
+    /* The SHA-256 digest of the response or CRL it was taken from */
+    unsigned char evidence[SHA256_DIGEST_LENGTH];
+    /* The status must be established again after this time */
+    int64_t not_after;
+} X509_RV_CACHE_RESULT;
+
 typedef struct lookup_dir_hashes_st BY_DIR_HASH;
 typedef struct lookup_dir_entry_st BY_DIR_ENTRY;
 DEFINE_STACK_OF(BY_DIR_HASH)
@@ -194,6 +229,18 @@ int ossl_x509_store_ctx_get_by_subject(const X509_STORE_CTX *ctx, X509_LOOKUP_TY
 __owur int ossl_x509_store_read_lock(X509_STORE *xs);
 STACK_OF(X509_OBJECT) *ossl_x509_store_ht_get_by_name(const X509_STORE *store,
     const X509_NAME *xn);
+int ossl_x509_chain_cache_get(X509_STORE_CTX *ctx, int64_t verification_time,
+    int check_time);
+void ossl_x509_chain_cache_add(X509_STORE_CTX *ctx, int64_t not_before,
+    int64_t not_after);
+void ossl_x509_chain_cache_flush(X509_STORE *xs);
+void ossl_x509_check_sigs(OSSL_LIB_CTX *libctx, X509_SIG_CHECK *checks, int n);
+int ossl_x509_rv_cache_get(X509_STORE *store, const X509 *x, X509 *issuer,
+    X509_RV_CACHE_RESULT *res);
+void ossl_x509_rv_cache_count(X509_STORE *store, int hit);
+void ossl_x509_rv_cache_add(X509_STORE *store, const X509 *x, X509 *issuer,
+    const X509_RV_CACHE_RESULT *res);
+void ossl_x509_rv_cache_flush(X509_STORE *xs);
 int ossl_x509_check_rfc822(X509 *x, const char *chk, size_t chklen,
     unsigned int flags);
 int ossl_x509_check_smtputf8(X509 *x, const char *chk, size_t chklen,
@@ -280,6 +280,8 @@ void X509_STORE_free(X509_STORE *xs)
     CRYPTO_THREAD_lock_free(xs->lock);
     CRYPTO_FREE_REF(&xs->references);
     ossl_ht_free(xs->objs_ht);
+    ossl_ht_free(xs->chain_cache);
+    ossl_ht_free(xs->rv_cache);
     OPENSSL_free(xs);
 }
 
@@ -542,6 +544,10 @@ static int x509_store_add_obj(X509_STORE *store, X509_OBJECT *obj)
 
     if (added == 0) /* obj not pushed */
         X509_OBJECT_free(obj);
+    else {
+        ossl_x509_chain_cache_flush(store);
+        ossl_x509_rv_cache_flush(store);
+    }
 
     return ret;
 }
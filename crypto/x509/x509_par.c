@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include "internal/thread.h"
+#include "crypto/x509.h"
+#include "x509_local.h"
+
+/*
+ * Signature checks for X509_V_FLAG_PARALLEL_CHECKS.
+ *
+ * The checks are spread over as many threads of the library context's thread
+ * pool as are available, up to X509_SIG_CHECK_MAX_THREADS, with the calling
+ * thread taking its share. Each check only writes its own result, and the
+ * certificates and CRLs remember the keys their signatures are good with, so
+ * the verification that follows finds the results without doing the work
+ * again, on whatever thread it runs.
+ */
+
+#define X509_SIG_CHECK_MAX_THREADS 8
+
+typedef struct {
+    X509_SIG_CHECK *checks;
+    int n;
+    int first;
+    int stride;
+} SIG_CHECK_LANE;
+
+static void run_lane(SIG_CHECK_LANE *lane)
+{
+    int i;
+
+    for (i = lane->first; i < lane->n; i += lane->stride) {
+        X509_SIG_CHECK *c = &lane->checks[i];
+
+        if (c->pkey == NULL)
+            continue;
+        if (c->cert != NULL)
+            c->ok = ossl_x509_verify_cached(c->cert, c->pkey) > 0;
+        else
+            c->ok = ossl_x509_crl_verify_cached(c->crl, c->pkey) > 0;
+    }
+}
+
+static CRYPTO_THREAD_RETVAL run_lane_thread(void *arg)
+{
+    run_lane(arg);
+    return 0;
+}
+
+void ossl_x509_check_sigs(OSSL_LIB_CTX *libctx, X509_SIG_CHECK *checks, int n)
+{
+    SIG_CHECK_LANE lanes[X509_SIG_CHECK_MAX_THREADS + 1];
+    void *threads[X509_SIG_CHECK_MAX_THREADS];
+    uint64_t avail = n > 1 ? ossl_get_avail_threads(libctx) : 0;
+    int i, nthreads = n - 1;
+
+    if ((uint64_t)nthreads > avail)
+        nthreads = (int)avail;
+    if (nthreads > X509_SIG_CHECK_MAX_THREADS)
+        nthreads = X509_SIG_CHECK_MAX_THREADS;
+
+    for (i = 0; i <= nthreads; i++) {
+        lanes[i].checks = checks;
+        lanes[i].n = n;
+        lanes[i].first = i;
+        lanes[i].stride = nthreads + 1;
+    }
+    for (i = 0; i < nthreads; i++)
+        threads[i] = ossl_crypto_thread_start(libctx, run_lane_thread,
+            &lanes[i + 1]);
+
+    run_lane(&lanes[0]);
+
+    for (i = 0; i < nthreads; i++) {
+        /* Do the work of a thread that could not be started here instead */
+        if (threads[i] == NULL) {
+            run_lane(&lanes[i + 1]);
+            continue;
+        }
+        ossl_crypto_thread_join(threads[i], NULL);
+        ossl_crypto_thread_clean(threads[i]);
+    }
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include <openssl/x509v3.h>
+#include "internal/hashtable.h"
+#include "crypto/x509.h"
+#include "x509_local.h"
+
+/*
+ * A cache of revocation statuses that an X509_STORE established from OCSP
+ * responses and CRLs.
+ *
+ * Entries are keyed by the fingerprint of the issuer certificate, which
+ * binds the issuer key, and the serial number of the certificate. Each one
+ * records the digest of the response or CRL the status came from, so that it
+ * is only used when the same evidence is presented again, and how long it is
+ * valid.
+ *
+ * When the cache is full, entries that are no longer valid or that were not
+ * used since the previous time it was full are evicted, which approximates
+ * evicting the least recently used ones without making lookups take the
+ * write lock. If every entry was used, the cache is emptied.
+ */
+
+#define RV_CACHE_MAX_SERIAL 32
+#define RV_CACHE_BUCKETS 64
+
+typedef struct {
+    unsigned char issuer[SHA_DIGEST_LENGTH];
+    unsigned char serial_type;
+    unsigned char serial_len;
+    unsigned char serial[RV_CACHE_MAX_SERIAL];
+} RV_CACHE_ID;
+
+HT_START_KEY_DEFN(rv_cache_key)
+HT_DEF_KEY_FIELD_UINT8T_ARRAY(buf, sizeof(RV_CACHE_ID))
+HT_END_KEY_DEFN(RV_CACHE_KEY)
+
+typedef struct {
+    RV_CACHE_KEY key;
+    X509_RV_CACHE_RESULT res;
+    uint64_t used;
+} RV_CACHE_ENTRY;
+
+IMPLEMENT_HT_VALUE_TYPE_FNS(RV_CACHE_ENTRY, rvcache, static)
+
+static void rv_cache_free(HT_VALUE *v)
+{
+    OPENSSL_free(ossl_ht_rvcache_RV_CACHE_ENTRY_from_value(v));
+}
+
+/* Returns 0 if the status of |x| cannot be cached */
+static int rv_cache_key(RV_CACHE_KEY *key, const X509 *x, X509 *issuer)
+{
+    const ASN1_INTEGER *serial = X509_get0_serialNumber(x);
+    RV_CACHE_ID id;
+
+    if (serial->length > RV_CACHE_MAX_SERIAL
+        || !ossl_x509v3_cache_extensions(issuer)
+        || (issuer->ex_flags & EXFLAG_NO_FINGERPRINT) != 0)
+        return 0;
+
+    /* Zeroed so that unused bytes do not end up in the key */
+    memset(&id, 0, sizeof(id));
+    memcpy(id.issuer, issuer->sha1_hash, sizeof(id.issuer));
+    id.serial_type = (unsigned char)serial->type;
+    id.serial_len = (unsigned char)serial->length;
+    memcpy(id.serial, serial->data, serial->length);
+
+    HT_INIT_RAW_KEY(key);
+    return HT_COPY_RAW_KEY(TO_HT_KEY(key), (const uint8_t *)&id, sizeof(id));
+}
+
+int ossl_x509_rv_cache_get(X509_STORE *store, const X509 *x, X509 *issuer,
+    X509_RV_CACHE_RESULT *res)
+{
+    RV_CACHE_KEY key;
+    RV_CACHE_ENTRY *e;
+    HT_VALUE *v;
+    int found = 0;
+
+    if (!rv_cache_key(&key, x, issuer))
+        return 0;
+
+    if (!ossl_ht_read_lock(store->rv_cache))
+        return 0;
+    e = ossl_ht_rvcache_RV_CACHE_ENTRY_get(store->rv_cache, TO_HT_KEY(&key),
+        &v);
+    if (e != NULL) {
+        *res = e->res;
+        CRYPTO_atomic_store(&e->used, 1, store->lock);
+        found = 1;
+    }
+    ossl_ht_read_unlock(store->rv_cache);
+    return found;
+}
+
+/*
+ * Count a lookup, which is a hit if ossl_x509_rv_cache_get() found an entry
+ * and the caller could use it.
+ */
+void ossl_x509_rv_cache_count(X509_STORE *store, int hit)
+{
+    uint64_t tmp;
+
+    CRYPTO_atomic_add64(hit ? &store->rv_cache_hits : &store->rv_cache_misses,
+        1, &tmp, store->lock);
+}
+
+typedef struct {
+    CRYPTO_RWLOCK *lock;
+    int64_t now;
+    size_t kept;
+} RV_CACHE_SWEEP;
+
+/* Selects the entries to evict, called with the write lock held */
+static int rv_cache_stale(HT_VALUE *v, void *arg)
+{
+    RV_CACHE_ENTRY *e = ossl_ht_rvcache_RV_CACHE_ENTRY_from_value(v);
+    RV_CACHE_SWEEP *sweep = arg;
+    uint64_t used = 0;
+
+    CRYPTO_atomic_load(&e->used, &used, sweep->lock);
+    if (used == 0 || e->res.not_after < sweep->now)
+        return 1;
+    CRYPTO_atomic_store(&e->used, 0, sweep->lock);
+    sweep->kept++;
+    return 0;
+}
+
+/* Makes room for one more entry, called with the write lock held */
+static void rv_cache_evict(X509_STORE *store)
+{
+    RV_CACHE_SWEEP sweep;
+    HT_VALUE_LIST *stale;
+    RV_CACHE_KEY key;
+    size_t i;
+
+    sweep.lock = store->lock;
+    sweep.now = (int64_t)time(NULL);
+    sweep.kept = 0;
+    stale = ossl_ht_filter(store->rv_cache, ossl_ht_count(store->rv_cache),
+        rv_cache_stale, &sweep);
+    if (stale == NULL || sweep.kept >= store->rv_cache_size) {
+        ossl_ht_flush(store->rv_cache);
+    } else {
+        for (i = 0; i < stale->list_len; i++) {
+            key = ossl_ht_rvcache_RV_CACHE_ENTRY_from_value(stale->list[i])->key;
+            ossl_ht_delete(store->rv_cache, TO_HT_KEY(&key));
+        }
+    }
+    ossl_ht_value_list_free(stale);
+}
+
+void ossl_x509_rv_cache_add(X509_STORE *store, const X509 *x, X509 *issuer,
+    const X509_RV_CACHE_RESULT *res)
+{
+    RV_CACHE_ENTRY *e;
+    int rv;
+
+    if ((e = OPENSSL_zalloc(sizeof(*e))) == NULL)
+        return;
+    if (!rv_cache_key(&e->key, x, issuer)) {
+        OPENSSL_free(e);
+        return;
+    }
+    e->res = *res;
+
+    ossl_ht_write_lock(store->rv_cache);
+    if (ossl_ht_count(store->rv_cache) >= store->rv_cache_size)
+        rv_cache_evict(store);
+    /* Newer evidence replaces older */
+    ossl_ht_delete(store->rv_cache, TO_HT_KEY(&e->key));
+    rv = ossl_ht_rvcache_RV_CACHE_ENTRY_insert(store->rv_cache,
+        TO_HT_KEY(&e->key), e, NULL);
+    ossl_ht_write_unlock(store->rv_cache);
+    if (rv != 1)
+        OPENSSL_free(e);
+}
+
+void ossl_x509_rv_cache_flush(X509_STORE *xs)
+{
+    if (xs->rv_cache == NULL)
+        return;
+    ossl_ht_write_lock(xs->rv_cache);
+    ossl_ht_flush(xs->rv_cache);
+    ossl_ht_write_unlock(xs->rv_cache);
+}
+
+int X509_STORE_set_revocation_cache_size(X509_STORE *xs, size_t size)
+{
+    HT_CONFIG htconf = {
+        .ht_free_fn = rv_cache_free,
+        .init_neighborhoods = RV_CACHE_BUCKETS,
+        .collision_check = 1,
+    };
+
+    if (xs == NULL) {
+        ERR_raise(ERR_LIB_X509, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    if (size == 0) {
+        ossl_ht_free(xs->rv_cache);
+        xs->rv_cache = NULL;
+    } else if (xs->rv_cache == NULL) {
+        if ((xs->rv_cache = ossl_ht_new(&htconf)) == NULL) {
+            ERR_raise(ERR_LIB_X509, ERR_R_CRYPTO_LIB);
+            return 0;
+        }
+    } else {
+        ossl_x509_rv_cache_flush(xs);
+    }
+    xs->rv_cache_size = size;
+    return 1;
+}
+
+size_t X509_STORE_get_revocation_cache_size(const X509_STORE *xs)
+{
+    return xs->rv_cache_size;
+}
+
+int X509_STORE_get_revocation_cache_stats(X509_STORE *xs, uint64_t *hits,
+    uint64_t *misses)
+{
+    if (xs == NULL) {
+        ERR_raise(ERR_LIB_X509, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+    if (hits != NULL && !CRYPTO_atomic_load(&xs->rv_cache_hits, hits,
+            xs->lock))
+        return 0;
+    if (misses != NULL && !CRYPTO_atomic_load(&xs->rv_cache_misses, misses,
+            xs->lock))
+        return 0;
+    return 1;
+}
+
+void X509_STORE_flush_revocation_cache(X509_STORE *xs)
+{
+    if (xs != NULL)
+        ossl_x509_rv_cache_flush(xs);
+}
@@ -48,6 +48,7 @@ static int x509_verify_x509(X509_STORE_CTX *ctx);
 static int x509_verify_rpk(X509_STORE_CTX *ctx);
 static int build_chain(X509_STORE_CTX *ctx);
 static int verify_chain(X509_STORE_CTX *ctx);
+static int verify_chain_cached(X509_STORE_CTX *ctx);
 static int verify_rpk(X509_STORE_CTX *ctx);
 static int dane_verify(X509_STORE_CTX *ctx);
 static int dane_verify_rpk(X509_STORE_CTX *ctx);
@@ -62,6 +63,9 @@ static int check_revocation(X509_STORE_CTX *ctx);
 static int check_cert_ocsp_resp(X509_STORE_CTX *ctx);
 #endif
 static int check_cert_crl(X509_STORE_CTX *ctx);
+static void check_crl_sigs(X509_STORE_CTX *ctx, int first, int last);
+static int check_crl(X509_STORE_CTX *ctx, X509_CRL *crl);
+static int cert_crl(X509_STORE_CTX *ctx, X509_CRL *crl, X509 *x);
 static int check_policy(X509_STORE_CTX *ctx);
 static int check_dane_issuer(X509_STORE_CTX *ctx, int depth);
 static int check_cert_key_level(X509_STORE_CTX *ctx, X509 *cert);
@@ -113,7 +117,7 @@ int X509_self_signed(const X509 *cert, int verify_signature)
         return 0;
     if (!verify_signature)
         return 1;
-    return X509_verify(cert, pkey);
+    return ossl_x509_verify_cached((X509 *)cert, pkey);
 }
 
 /*
@@ -375,7 +379,12 @@ static int x509_verify_x509(X509_STORE_CTX *ctx)
     CB_FAIL_IF(!check_cert_key_level(ctx, ctx->cert),
         ctx, ctx->cert, 0, X509_V_ERR_EE_KEY_TOO_SMALL);
 
-    ret = DANETLS_ENABLED(ctx->dane) ? dane_verify(ctx) : verify_chain(ctx);
+    if (DANETLS_ENABLED(ctx->dane))
+        ret = dane_verify(ctx);
+    else if (ctx->store != NULL && ctx->store->chain_cache != NULL)
+        ret = verify_chain_cached(ctx);
+    else
+        ret = verify_chain(ctx);
 
     /*
      * Safety-net.  If we are returning an error, we must also set ctx->error,
@@ -397,11 +406,77 @@ static int sk_X509_contains(STACK_OF(X509) *sk, X509 *cert)
     return 0;
 }
 
+/* Whether |candidate| in |sk| qualifies as issuer of |x|, see below */
+static int is_issuer_candidate(X509_STORE_CTX *ctx, int check_signing_allowed,
+    int no_dup, X509 *candidate, const X509 *x)
+{
+    if (no_dup
+        && !((x->ex_flags & EXFLAG_SI) != 0 && sk_X509_num(ctx->chain) == 1)
+        && sk_X509_contains(ctx->chain, candidate))
+        return 0;
+    if (!ctx->check_issued(ctx, x, candidate))
+        return 0;
+    /* yet better not check key usage for trust anchors */
+    return !check_signing_allowed
+        || ossl_x509_signing_allowed(candidate, x) == X509_V_OK;
+}
+
+/*
+ * Consider |candidate| after |*issuer|. Returns 1 if it is good enough to
+ * stop looking, otherwise leaves in |*issuer| the first match that has the
+ * latest expiration date so we return nearest match if no certificate time
+ * is OK.
+ */
+static int better_issuer(X509_STORE_CTX *ctx, X509 **issuer, X509 *candidate)
+{
+    if (ossl_x509_check_cert_time(ctx, candidate, -1)) {
+        *issuer = candidate;
+        return 1;
+    }
+    if (*issuer == NULL
+        || ASN1_TIME_compare(X509_get0_notAfter(candidate),
+               X509_get0_notAfter(*issuer))
+            > 0)
+        *issuer = candidate;
+    return 0;
+}
+
+/*
+ * With X509_V_FLAG_PARALLEL_CHECKS, check the signature of |x| with the keys
+ * of all |n| candidates at once, and prefer those that it is good with, in
+ * the order of |sk|. Returns 0 if the checks could not be done.
+ */
+static int get0_best_signing_issuer(X509_STORE_CTX *ctx, X509 **issuer,
+    X509 **candidates, int n, const X509 *x)
+{
+    X509_SIG_CHECK *checks;
+    int i, found = 0;
+
+    if ((checks = OPENSSL_calloc(n, sizeof(*checks))) == NULL)
+        return 0;
+    for (i = 0; i < n; i++) {
+        checks[i].cert = (X509 *)x;
+        checks[i].pkey = X509_get0_pubkey(candidates[i]);
+    }
+    ossl_x509_check_sigs(ctx->libctx, checks, n);
+
+    for (i = 0; i < n; i++) {
+        if (!checks[i].ok)
+            continue;
+        found = 1;
+        if (better_issuer(ctx, issuer, candidates[i]))
+            break;
+    }
+    OPENSSL_free(checks);
+    return found;
+}
+
 /*-
  * Find in |sk| an issuer cert of cert |x| accepted by |ctx->check_issued|.
  * If no_dup, the issuer must not yet be in |ctx->chain|, yet allowing the
  *     exception that |x| is self-issued and |ctx->chain| has just one element.
- * Prefer the first match with suitable validity period or latest expiration.
+ * Prefer the first match with suitable validity period or latest expiration,
+ * with X509_V_FLAG_PARALLEL_CHECKS among those that signed |x| if any did.
  */
 /*
  * Note: so far, we do not check during chain building
@@ -414,33 +489,36 @@ static int sk_X509_contains(STACK_OF(X509) *sk, X509 *cert)
 static X509 *get0_best_issuer_sk(X509_STORE_CTX *ctx, int check_signing_allowed,
     int no_dup, STACK_OF(X509) *sk, const X509 *x)
 {
-    int i;
-    X509 *candidate, *issuer = NULL;
+    int i, n = 0;
+    X509 *candidate, *issuer = NULL, **candidates = NULL;
+
+    if ((ctx->param->flags & X509_V_FLAG_PARALLEL_CHECKS) != 0
+        && sk_X509_num(sk) > 1)
+        candidates = OPENSSL_malloc(sk_X509_num(sk) * sizeof(*candidates));
 
     for (i = 0; i < sk_X509_num(sk); i++) {
         candidate = sk_X509_value(sk, i);
-        if (no_dup
-            && !((x->ex_flags & EXFLAG_SI) != 0 && sk_X509_num(ctx->chain) == 1)
-            && sk_X509_contains(ctx->chain, candidate))
+        if (!is_issuer_candidate(ctx, check_signing_allowed, no_dup,
+                candidate, x))
             continue;
-        if (ctx->check_issued(ctx, x, candidate)) {
-            if (check_signing_allowed
-                /* yet better not check key usage for trust anchors */
-                && ossl_x509_signing_allowed(candidate, x) != X509_V_OK)
-                continue;
-            if (ossl_x509_check_cert_time(ctx, candidate, -1))
-                return candidate;
-            /*
-             * Leave in *issuer the first match that has the latest expiration
-             * date so we return nearest match if no certificate time is OK.
-             */
-            if (issuer == NULL
-                || ASN1_TIME_compare(X509_get0_notAfter(candidate),
-                       X509_get0_notAfter(issuer))
-                    > 0)
-                issuer = candidate;
-        }
+        if (candidates != NULL)
+            candidates[n++] = candidate;
+        else if (better_issuer(ctx, &issuer, candidate))
+            break;
+    }
+
+    /*
+     * Rather than finding out later that the signature of |x| is not good
+     * with the key of the chosen issuer, check all of them now. Should none
+     * of them fit, choose as usual, and let verification report the error.
+     */
+    if (candidates != NULL
+        && (n < 2 || !get0_best_signing_issuer(ctx, &issuer, candidates, n, x))) {
+        for (i = 0; i < n; i++)
+            if (better_issuer(ctx, &issuer, candidates[i]))
+                break;
     }
+    OPENSSL_free(candidates);
     return issuer;
 }
 
@@ -467,8 +545,15 @@ int X509_STORE_CTX_get1_issuer(X509 **issuer, X509_STORE_CTX *ctx, const X509 *x
     if (ret != 1)
         goto end;
 
-    /* quick happy path: certificate matches and is currently valid */
-    if (ctx->check_issued(ctx, x, obj->data.x509)) {
+    /*
+     * quick happy path: certificate matches and is currently valid, and with
+     * X509_V_FLAG_PARALLEL_CHECKS the signature of |x| is good with its key
+     */
+    if (ctx->check_issued(ctx, x, obj->data.x509)
+        && ((ctx->param->flags & X509_V_FLAG_PARALLEL_CHECKS) == 0
+            || ossl_x509_verify_cached((X509 *)x,
+                   X509_get0_pubkey(obj->data.x509))
+                > 0)) {
         if (ossl_x509_check_cert_time(ctx, obj->data.x509, -1)) {
             *issuer = obj->data.x509;
             /* |*issuer| has taken over the cert reference from |obj| */
@@ -1274,6 +1359,8 @@ static int check_revocation(X509_STORE_CTX *ctx)
             i = 1;
         else
             i = 0;
+        if ((ctx->param->flags & X509_V_FLAG_PARALLEL_CHECKS) != 0)
+            check_crl_sigs(ctx, i, last);
         for (; i <= last; i++) {
             ctx->error_depth = i;
             ok = check_cert_crl(ctx);
@@ -1285,7 +1372,135 @@ static int check_revocation(X509_STORE_CTX *ctx)
     return 1;
 }
 
+/*
+ * Add to |crls| those of |sk| that are issued by the subject of |issuer|, and
+ * |issuer| to |issuers| for each.
+ */
+static int add_crl_sigs(STACK_OF(X509_CRL) *crls, STACK_OF(X509) *issuers,
+    STACK_OF(X509_CRL) *sk, X509 *issuer)
+{
+    int i;
+
+    for (i = 0; i < sk_X509_CRL_num(sk); i++) {
+        X509_CRL *crl = sk_X509_CRL_value(sk, i);
+
+        if (X509_NAME_cmp(X509_CRL_get_issuer(crl),
+                X509_get_subject_name(issuer))
+            != 0)
+            continue;
+        if (!X509_CRL_up_ref(crl))
+            return 0;
+        if (!sk_X509_CRL_push(crls, crl)) {
+            X509_CRL_free(crl);
+            return 0;
+        }
+        if (!sk_X509_push(issuers, issuer))
+            return 0;
+    }
+    return 1;
+}
+
+/*
+ * With X509_V_FLAG_PARALLEL_CHECKS, check the signatures of the CRLs issued
+ * by the issuers of the certificates from depth |first| to |last| with their
+ * keys at once, so that check_crl() finds them done. CRLs with other issuers
+ * are left to check_crl(), and so is any CRL if the callbacks that select and
+ * check them are not the default ones.
+ */
+static void check_crl_sigs(X509_STORE_CTX *ctx, int first, int last)
+{
+    STACK_OF(X509_CRL) *crls = sk_X509_CRL_new_null(), *found;
+    STACK_OF(X509) *issuers = sk_X509_new_null();
+    X509_SIG_CHECK *checks = NULL;
+    int i, n, ok = 1;
+
+    if (crls == NULL || issuers == NULL
+        || ctx->get_crl != NULL || ctx->check_crl != check_crl)
+        goto end;
+
+    for (i = first; ok && i <= last && i + 1 < sk_X509_num(ctx->chain); i++) {
+        X509 *x = sk_X509_value(ctx->chain, i);
+        X509 *issuer = sk_X509_value(ctx->chain, i + 1);
+
+        if ((x->ex_flags & (EXFLAG_SS | EXFLAG_PROXY)) != 0
+            || X509_get0_pubkey(issuer) == NULL)
+            continue;
+        ok = add_crl_sigs(crls, issuers, ctx->crls, issuer);
+        found = ctx->lookup_crls(ctx, X509_get_issuer_name(x));
+        if (ok)
+            ok = add_crl_sigs(crls, issuers, found, issuer);
+        sk_X509_CRL_pop_free(found, X509_CRL_free);
+    }
+
+    if (!ok || (n = sk_X509_CRL_num(crls)) < 2
+        || (checks = OPENSSL_calloc(n, sizeof(*checks))) == NULL)
+        goto end;
+    for (i = 0; i < n; i++) {
+        checks[i].crl = sk_X509_CRL_value(crls, i);
+        checks[i].pkey = X509_get0_pubkey(sk_X509_value(issuers, i));
+    }
+    ossl_x509_check_sigs(ctx->libctx, checks, n);
+
+end:
+    OPENSSL_free(checks);
+    sk_X509_CRL_pop_free(crls, X509_CRL_free);
+    sk_X509_free(issuers);
+}
+
+/*
+ * Revocation statuses are cached with the SHA-256 digest of the DER encoding
+ * of the OCSP response or CRL they were established from, so that they are
+ * only used when exactly the same response or CRL is presented again.
+ * Returns 0 if |obj| cannot be digested, in which case the cache is not used.
+ */
+static int rv_cache_evidence(X509_STORE_CTX *ctx, const ASN1_ITEM *it,
+    void *obj, unsigned char *evidence)
+{
+    unsigned int len;
+
+    return ossl_asn1_item_digest_ex(it, EVP_sha256(), obj, evidence, &len,
+               ctx->libctx, ctx->propq)
+        && len == SHA256_DIGEST_LENGTH;
+}
+
 #ifndef OPENSSL_NO_OCSP
+/*
+ * Look up the status of the current certificate in the revocation cache of
+ * the store, which is used if it was established from the same response |bs|
+ * and is still valid.
+ */
+static int ocsp_cache_get(X509_STORE_CTX *ctx, const unsigned char *evidence)
+{
+    X509_RV_CACHE_RESULT res;
+    int hit;
+
+    hit = ossl_x509_rv_cache_get(ctx->store, ctx->current_cert,
+              ctx->current_issuer, &res)
+        && res.source == X509_RV_CACHE_OCSP
+        /* Allow the same 5 minutes as OCSP_check_validity() below */
+        && res.not_after + 300 >= (int64_t)time(NULL)
+        && memcmp(res.evidence, evidence, sizeof(res.evidence)) == 0;
+    ossl_x509_rv_cache_count(ctx->store, hit);
+    return hit ? res.status : -1;
+}
+
+static void ocsp_cache_add(X509_STORE_CTX *ctx, const unsigned char *evidence,
+    int status, const ASN1_GENERALIZEDTIME *nextupd)
+{
+    X509_RV_CACHE_RESULT res;
+
+    /* Without a nextUpdate time newer information is always available */
+    if (nextupd == NULL
+        || !certificate_time_to_posix(nextupd, &res.not_after))
+        return;
+    res.source = X509_RV_CACHE_OCSP;
+    res.status = status;
+    res.reason = 0;
+    memcpy(res.evidence, evidence, sizeof(res.evidence));
+    ossl_x509_rv_cache_add(ctx->store, ctx->current_cert, ctx->current_issuer,
+        &res);
+}
+
 static int check_cert_ocsp_resp(X509_STORE_CTX *ctx)
 {
     int cert_status, crl_reason;
@@ -1298,8 +1513,9 @@ static int check_cert_ocsp_resp(X509_STORE_CTX *ctx)
     ASN1_OBJECT *cert_id_md_oid;
     EVP_MD *cert_id_md = NULL;
     OCSP_CERTID *cert_id = NULL;
+    unsigned char evidence[SHA256_DIGEST_LENGTH];
     int ret = V_OCSP_CERTSTATUS_UNKNOWN;
-    int num;
+    int num, use_cache;
 
     num = sk_OCSP_RESPONSE_num(ctx->ocsp_resp);
 
@@ -1318,6 +1534,13 @@ static int check_cert_ocsp_resp(X509_STORE_CTX *ctx)
         goto end;
     }
 
+    use_cache = ctx->store != NULL && ctx->store->rv_cache != NULL
+        && rv_cache_evidence(ctx, ASN1_ITEM_rptr(OCSP_RESPONSE), resp,
+            evidence);
+    if (use_cache && (ret = ocsp_cache_get(ctx, evidence)) >= 0)
+        goto end;
+    ret = V_OCSP_CERTSTATUS_UNKNOWN;
+
     if (OCSP_basic_verify(bs, ctx->chain, ctx->store, 0) <= 0) {
         ret = X509_V_ERR_OCSP_SIGNATURE_FAILURE;
         goto end;
@@ -1379,6 +1602,10 @@ static int check_cert_ocsp_resp(X509_STORE_CTX *ctx)
         ret = cert_status;
     }
 
+    if (use_cache
+        && (ret == V_OCSP_CERTSTATUS_GOOD || ret == V_OCSP_CERTSTATUS_REVOKED))
+        ocsp_cache_add(ctx, evidence, ret, nextupd);
+
 end:
     OCSP_CERTID_free(cert_id);
     OCSP_BASICRESP_free(bs);
@@ -1386,13 +1613,88 @@ end:
 }
 #endif
 
+/*
+ * The revocation cache is only used for CRLs when they are selected and
+ * checked the default way, and when no error can be overridden by the verify
+ * callback, so that a cached status is one any other verification would find.
+ */
+static int crl_cache_usable(const X509_STORE_CTX *ctx)
+{
+    return ctx->store != NULL
+        && ctx->store->rv_cache != NULL
+        && ctx->verify_cb == null_callback
+        && ctx->get_crl == NULL
+        && ctx->check_crl == check_crl
+        && ctx->cert_crl == cert_crl
+        && (ctx->param->flags
+               & (X509_V_FLAG_USE_DELTAS | X509_V_FLAG_EXTENDED_CRL_SUPPORT))
+            == 0;
+}
+
+/*
+ * Set |*match| to the CRL of |crls| that |res| was established from, if any.
+ * Returns 0 if any other CRL of |crls| could be used to check |x| instead.
+ */
+static int crl_cache_match(X509_STORE_CTX *ctx, const X509_RV_CACHE_RESULT *res,
+    X509 *x, STACK_OF(X509_CRL) *crls, X509_CRL **match)
+{
+    unsigned char evidence[SHA256_DIGEST_LENGTH];
+    int i;
+
+    for (i = 0; i < sk_X509_CRL_num(crls); i++) {
+        X509_CRL *crl = sk_X509_CRL_value(crls, i);
+
+        if ((crl->idp_flags & IDP_INDIRECT) == 0
+            && X509_NAME_cmp(X509_CRL_get_issuer(crl),
+                   X509_get_issuer_name(x))
+                != 0)
+            continue;
+        if (!rv_cache_evidence(ctx, ASN1_ITEM_rptr(X509_CRL), crl, evidence)
+            || memcmp(res->evidence, evidence, sizeof(evidence)) != 0)
+            return 0;
+        *match = crl;
+    }
+    return 1;
+}
+
+/*
+ * Look up the status of |x| in the revocation cache of the store, which is
+ * used if the CRL it was established from is the only one there is for |x|
+ * and is still valid.
+ */
+static int crl_cache_get(X509_STORE_CTX *ctx, X509 *x, X509 *issuer)
+{
+    X509_RV_CACHE_RESULT res;
+    STACK_OF(X509_CRL) *found = NULL;
+    X509_CRL *crl = NULL;
+    int ok;
+
+    if (!ossl_x509_rv_cache_get(ctx->store, x, issuer, &res)
+        || res.source != X509_RV_CACHE_CRL
+        || res.status != V_OCSP_CERTSTATUS_GOOD
+        || res.not_after < (int64_t)time(NULL)
+        || !crl_cache_match(ctx, &res, x, ctx->crls, &crl))
+        return 0;
+    /* As in get_crl_delta(), the store is only searched if need be */
+    if (crl == NULL) {
+        found = ctx->lookup_crls(ctx, X509_get_issuer_name(x));
+        if (!crl_cache_match(ctx, &res, x, found, &crl))
+            crl = NULL;
+    }
+    ok = crl != NULL && ossl_x509_check_crl_time(ctx, crl, 0);
+    sk_X509_CRL_pop_free(found, X509_CRL_free);
+    return ok;
+}
+
 /* Sadly, returns 0 also on internal error. */
 static int check_cert_crl(X509_STORE_CTX *ctx)
 {
     X509_CRL *crl = NULL, *dcrl = NULL;
-    int ok = 0;
+    X509_RV_CACHE_RESULT res;
+    int ok = 0, use_cache, cacheable = 0;
     int cnum = ctx->error_depth;
     X509 *x = sk_X509_value(ctx->chain, cnum);
+    X509 *issuer = sk_X509_value(ctx->chain, cnum + 1);
 
     ctx->current_cert = x;
     ctx->current_issuer = NULL;
@@ -1405,6 +1707,14 @@ static int check_cert_crl(X509_STORE_CTX *ctx)
     if ((x->ex_flags & EXFLAG_PROXY) != 0)
         return 1;
 
+    use_cache = issuer != NULL && crl_cache_usable(ctx);
+    if (use_cache) {
+        ok = crl_cache_get(ctx, x, issuer);
+        ossl_x509_rv_cache_count(ctx->store, ok);
+        if (ok)
+            return 1;
+    }
+
     while (ctx->current_reasons != CRLDP_ALL_REASONS) {
         unsigned int last_reasons = ctx->current_reasons;
 
@@ -1451,6 +1761,20 @@ static int check_cert_crl(X509_STORE_CTX *ctx)
                 goto done;
         }
 
+        /* Only a status established from a single complete CRL is cached */
+        cacheable = use_cache && last_reasons == 0 && dcrl == NULL
+            && ctx->current_reasons == CRLDP_ALL_REASONS
+            && X509_CRL_get0_nextUpdate(crl) != NULL
+            && certificate_time_to_posix(X509_CRL_get0_nextUpdate(crl),
+                &res.not_after)
+            && rv_cache_evidence(ctx, ASN1_ITEM_rptr(X509_CRL), crl,
+                res.evidence);
+        if (cacheable) {
+            res.source = X509_RV_CACHE_CRL;
+            res.status = V_OCSP_CERTSTATUS_GOOD;
+            res.reason = 0;
+        }
+
         ctx->current_crl = NULL;
         X509_CRL_free(crl);
         X509_CRL_free(dcrl);
@@ -1465,6 +1789,8 @@ static int check_cert_crl(X509_STORE_CTX *ctx)
             goto done;
         }
     }
+    if (cacheable && ok == 1)
+        ossl_x509_rv_cache_add(ctx->store, x, issuer, &res);
 done:
     X509_CRL_free(crl);
     X509_CRL_free(dcrl);
@@ -2069,7 +2395,7 @@ static int check_crl(X509_STORE_CTX *ctx, X509_CRL *crl)
         if (rv != X509_V_OK && !verify_cb_crl(ctx, rv))
             return 0;
         /* Verify CRL signature */
-        if (X509_CRL_verify(crl, ikey) <= 0 && !verify_cb_crl(ctx, X509_V_ERR_CRL_SIGNATURE_FAILURE))
+        if (ossl_x509_crl_verify_cached(crl, ikey) <= 0 && !verify_cb_crl(ctx, X509_V_ERR_CRL_SIGNATURE_FAILURE))
             return 0;
     }
     return 1;
@@ -2079,6 +2405,7 @@ static int check_crl(X509_STORE_CTX *ctx, X509_CRL *crl)
 static int cert_crl(X509_STORE_CTX *ctx, X509_CRL *crl, X509 *x)
 {
     X509_REVOKED *rev;
+    int i;
 
     /*
      * The rules changed for this... previously if a CRL contained unhandled
@@ -2093,7 +2420,11 @@ static int cert_crl(X509_STORE_CTX *ctx, X509_CRL *crl, X509 *x)
      * Look for serial number of certificate in CRL.  If found, make sure
      * reason is not removeFromCRL.
      */
-    if (X509_CRL_get0_by_cert(crl, &rev, x)) {
+    i = X509_CRL_get0_by_cert(crl, &rev, x);
+    /* A lazy CRL whose entry cannot be decoded is as unusable as any other */
+    if (i < 0)
+        return verify_cb_crl(ctx, X509_V_ERR_UNABLE_TO_GET_CRL);
+    if (i > 0) {
         if (rev->reason == CRL_REASON_REMOVE_FROM_CRL)
             return 2;
         if (!verify_cb_crl(ctx, X509_V_ERR_CERT_REVOKED))
@@ -2294,6 +2625,79 @@ int ossl_x509_check_cert_time(X509_STORE_CTX *ctx, X509 *x, int depth)
     return 1;
 }
 
+/*
+ * The chain cache only records whether a chain verified, so only those
+ * verifications whose outcome is fully determined by the certificates, the
+ * store and the parameters that make up the cache key can use it: no
+ * callbacks that could accept errors or change how the chain is built, and
+ * no revocation or policy checks, whose results depend on more than that.
+ */
+static int chain_cache_usable(const X509_STORE_CTX *ctx)
+{
+    const X509_VERIFY_PARAM *vpm = ctx->param;
+
+    return ctx->parent == NULL
+        && ctx->crls == NULL
+        && ctx->ocsp_resp == NULL
+        && ctx->propq == NULL
+        && vpm->policies == NULL
+        && (vpm->flags & (X509_V_FLAG_CRL_CHECK | X509_V_FLAG_OCSP_RESP_CHECK
+                | X509_V_FLAG_POLICY_MASK))
+            == 0
+        && ctx->verify_cb == null_callback
+        && ctx->verify == internal_verify
+        && ctx->get_issuer == X509_STORE_CTX_get1_issuer
+        && ctx->check_issued == check_issued
+        && ctx->check_revocation == check_revocation
+        && ctx->check_policy == check_policy
+        && ctx->lookup_certs == X509_STORE_CTX_get1_certs
+        && ctx->cleanup == NULL;
+}
+
+/*
+ * Like verify_chain(), but first try the chain cache of the store, and add
+ * the chain to it if it verifies. The peer identity is not part of the cache
+ * key, it is checked again on every hit.
+ */
+static int verify_chain_cached(X509_STORE_CTX *ctx)
+{
+    int64_t verification_time, t;
+    int64_t not_before = INT64_MIN, not_after = INT64_MAX;
+    int check_time, i, ok;
+    X509 *x;
+
+    if (!chain_cache_usable(ctx))
+        return verify_chain(ctx);
+
+    check_time = get_verification_time(ctx->param, &verification_time);
+    if (ossl_x509_chain_cache_get(ctx, verification_time, check_time)) {
+        ctx->error_depth = 0;
+        ctx->current_cert = ctx->cert;
+        ctx->current_issuer = sk_X509_value(ctx->chain,
+            sk_X509_num(ctx->chain) > 1 ? 1 : 0);
+        return check_id(ctx);
+    }
+
+    if ((ok = verify_chain(ctx)) <= 0 || ctx->error != X509_V_OK)
+        return ok;
+
+    /* The chain is good for as long as all of its certificates are */
+    for (i = 0; i < sk_X509_num(ctx->chain); i++) {
+        x = sk_X509_value(ctx->chain, i);
+        if (!certificate_time_to_posix(X509_get0_notBefore(x), &t))
+            return ok;
+        if (t > not_before)
+            not_before = t;
+        if (!certificate_time_to_posix(X509_get0_notAfter(x), &t))
+            return ok;
+        /* 99991231235959Z means the certificate does not expire */
+        if (t != INT64_C(253402300799) && t < not_after)
+            not_after = t;
+    }
+    ossl_x509_chain_cache_add(ctx, not_before, not_after);
+    return ok;
+}
+
 /*
  * Verify the issuer signatures and cert times of ctx->chain.
  * Sadly, returns 0 also on internal error in ctx->verify_cb().
@@ -2389,7 +2793,7 @@ static int internal_verify(X509_STORE_CTX *ctx)
                 CB_FAIL_IF(1, ctx, xi, issuer_depth,
                     X509_V_ERR_UNABLE_TO_DECODE_ISSUER_PUBLIC_KEY);
             } else {
-                CB_FAIL_IF(X509_verify(xs, pkey) <= 0,
+                CB_FAIL_IF(ossl_x509_verify_cached(xs, pkey) <= 0,
                     ctx, xs, n, X509_V_ERR_CERT_SIGNATURE_FAILURE);
             }
         }
@@ -2562,7 +2966,7 @@ X509_CRL *X509_CRL_diff(X509_CRL *base, X509_CRL *newer,
     EVP_PKEY *skey, const EVP_MD *md, unsigned int flags)
 {
     X509_CRL *crl = NULL;
-    int i;
+    int i, j;
     STACK_OF(X509_REVOKED) *revs = NULL;
 
     /* CRLs can't be delta already */
@@ -2652,7 +3056,12 @@ X509_CRL *X509_CRL_diff(X509_CRL *base, X509_CRL *newer,
          * Need something cleverer here for some more complex CRLs covering
          * multiple CAs.
          */
-        if (!X509_CRL_get0_by_serial(base, &rvtmp, &rvn->serialNumber)) {
+        j = X509_CRL_get0_by_serial(base, &rvtmp, &rvn->serialNumber);
+        if (j < 0) {
+            ERR_raise(ERR_LIB_X509, ERR_R_X509_LIB);
+            goto err;
+        }
+        if (j == 0) {
             rvtmp = X509_REVOKED_dup(rvn);
             if (rvtmp == NULL) {
                 ERR_raise(ERR_LIB_X509, ERR_R_ASN1_LIB);
@@ -59,6 +59,8 @@ int X509_CRL_sort(X509_CRL *c)
     int i;
     X509_REVOKED *r;
 
+    if (!ossl_x509_crl_decode_revoked(c))
+        return 0;
     /*
      * sort the data so it will be written in serial number order
      */
@@ -122,6 +124,9 @@ const STACK_OF(X509_EXTENSION) *X509_CRL_get0_extensions(const X509_CRL *crl)
 
 STACK_OF(X509_REVOKED) *X509_CRL_get_REVOKED(const X509_CRL *crl)
 {
+    /* The entries of a lazy CRL are decoded the first time they are asked for */
+    if (!ossl_x509_crl_decode_revoked((X509_CRL *)crl))
+        return NULL;
     return crl->crl.revoked;
 }
 
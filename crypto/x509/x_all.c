@@ -25,6 +25,7 @@
 #include <openssl/dsa.h>
 #include <openssl/x509v3.h>
 #include "internal/asn1.h"
+#include "internal/tsan_assist.h"
 #include "crypto/asn1.h"
 #include "crypto/pkcs7.h"
 #include "crypto/x509.h"
@@ -139,6 +140,67 @@ int X509_verify(const X509 *a, EVP_PKEY *r)
         a->distinguishing_id, r, a->libctx, a->propq);
 }
 
+/*
+ * Check the signature of |obj| with |verify|, but remember the first key that
+ * it is found to be good with in |*sig_pkey|, so that checking it with that
+ * key again, as happens whenever a chain through a shared intermediate is
+ * verified, is a pointer comparison. The key is up-ref'd so that its address
+ * cannot be taken by another key while it is remembered. It is published like
+ * the extensions cache of ossl_x509v3_cache_extensions() and never changes
+ * afterwards.
+ */
+int ossl_x509_verify_memo(void *obj, int (*verify)(void *, EVP_PKEY *),
+    CRYPTO_RWLOCK *lock, EVP_PKEY **sig_pkey,
+    volatile int *sig_cached, EVP_PKEY *r)
+{
+    int ret, match;
+
+#ifdef tsan_ld_acq
+    if (tsan_ld_acq((TSAN_QUALIFIER int *)sig_cached))
+        return *sig_pkey == r ? 1 : verify(obj, r);
+#endif
+
+    if (!CRYPTO_THREAD_read_lock(lock))
+        return verify(obj, r);
+    match = *sig_pkey != NULL && *sig_pkey == r;
+    CRYPTO_THREAD_unlock(lock);
+    if (match)
+        return 1;
+
+    if ((ret = verify(obj, r)) <= 0 || !EVP_PKEY_up_ref(r))
+        return ret;
+    if (!CRYPTO_THREAD_write_lock(lock)) {
+        EVP_PKEY_free(r);
+        return ret;
+    }
+    if (*sig_pkey == NULL) {
+        *sig_pkey = r;
+        r = NULL;
+#ifdef tsan_st_rel
+        tsan_st_rel((TSAN_QUALIFIER int *)sig_cached, 1);
+#endif
+    }
+    CRYPTO_THREAD_unlock(lock);
+    EVP_PKEY_free(r);
+    return ret;
+}
+
+static int x509_verify_thunk(void *a, EVP_PKEY *r)
+{
+    return X509_verify(a, r);
+}
+
+/* Like X509_verify(), but see ossl_x509_verify_memo() */
+int ossl_x509_verify_cached(X509 *a, EVP_PKEY *r)
+{
+    /* A modified certificate is not what was verified */
+    if (a->cert_info.enc.modified || a->distinguishing_id != NULL)
+        return X509_verify(a, r);
+
+    return ossl_x509_verify_memo(a, x509_verify_thunk, a->lock, &a->sig_pkey,
+        &a->sig_cached, r);
+}
+
 int X509_REQ_verify_ex(X509_REQ *a, EVP_PKEY *r, OSSL_LIB_CTX *libctx,
     const char *propq)
 {
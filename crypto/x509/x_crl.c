@@ -8,6 +8,8 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <openssl/asn1t.h>
 #include <openssl/x509.h>
 #include "crypto/x509.h"
@@ -17,6 +19,7 @@
 static int X509_REVOKED_cmp(const X509_REVOKED *const *a,
     const X509_REVOKED *const *b);
 static int setup_idp(X509_CRL *crl, ISSUING_DIST_POINT *idp);
+static int crl_info_decode_revoked(X509_CRL_INFO *inf);
 
 ASN1_SEQUENCE(X509_REVOKED) = {
     ASN1_EMBED(X509_REVOKED, serialNumber, ASN1_INTEGER),
@@ -48,7 +51,7 @@ static int crl_inf_cb(int operation, ASN1_VALUE **pval, const ASN1_ITEM *it,
 {
     X509_CRL_INFO *a = (X509_CRL_INFO *)*pval;
 
-    if (!a || !a->revoked)
+    if (!a)
         return 1;
     switch (operation) {
         /*
@@ -56,7 +59,14 @@ static int crl_inf_cb(int operation, ASN1_VALUE **pval, const ASN1_ITEM *it,
          * affect the output of X509_CRL_print().
          */
     case ASN1_OP_D2I_POST:
-        (void)sk_X509_REVOKED_set_cmp_func(a->revoked, X509_REVOKED_cmp);
+        if (a->revoked != NULL)
+            (void)sk_X509_REVOKED_set_cmp_func(a->revoked, X509_REVOKED_cmp);
+        break;
+        /* A modified lazy CRL has to be encoded with all its entries */
+    case ASN1_OP_I2D_PRE:
+        if (a->revoked == NULL && a->revoked_der != NULL
+            && !crl_info_decode_revoked(a))
+            return 0;
         break;
     }
     return 1;
@@ -72,6 +82,360 @@ ASN1_SEQUENCE_enc(X509_CRL_INFO, enc, crl_inf_cb) = {
     ASN1_EXP_SEQUENCE_OF_OPT(X509_CRL_INFO, extensions, X509_EXTENSION, 0)
 } ASN1_SEQUENCE_END_enc(X509_CRL_INFO, X509_CRL_INFO)
 
+/*
+ * A lazy CRL, see d2i_X509_CRL_lazy(), is decoded with this instead, which
+ * leaves the revoked entries encoded in |revoked_der|.
+ */
+static const ASN1_AUX X509_CRL_INFO_LAZY_aux = {
+    NULL, ASN1_AFLG_ENCODING, 0, 0, crl_inf_cb, offsetof(X509_CRL_INFO, enc), NULL
+};
+ASN1_SEQUENCE(X509_CRL_INFO_LAZY) = {
+    ASN1_OPT(X509_CRL_INFO, version, ASN1_INTEGER),
+    ASN1_EMBED(X509_CRL_INFO, sig_alg, X509_ALGOR),
+    ASN1_SIMPLE(X509_CRL_INFO, issuer, X509_NAME),
+    ASN1_SIMPLE(X509_CRL_INFO, lastUpdate, ASN1_TIME),
+    ASN1_OPT(X509_CRL_INFO, nextUpdate, ASN1_TIME),
+    ASN1_OPT(X509_CRL_INFO, revoked_der, ASN1_SEQUENCE),
+    ASN1_EXP_SEQUENCE_OF_OPT(X509_CRL_INFO, extensions, X509_EXTENSION, 0)
+} static_ASN1_SEQUENCE_END_ref(X509_CRL_INFO, X509_CRL_INFO_LAZY)
+
+ASN1_ITEM_TEMPLATE(X509_REVOKED_SEQ) = ASN1_EX_TEMPLATE_TYPE(ASN1_TFLG_SEQUENCE_OF, 0, revoked, X509_REVOKED)
+static_ASN1_ITEM_TEMPLATE_END(X509_REVOKED_SEQ)
+
+/*
+ * The revoked entries of a lazy CRL stay in their DER encoding. They are
+ * indexed by pointers to their encodings sorted by serial number, and an
+ * entry is only decoded when a lookup finds it.
+ */
+struct x509_crl_lazy_st {
+    const unsigned char **index;
+    int num;
+    X509_REVOKED **decoded; /* decoded entries, in the order of |index| */
+};
+
+static void crl_lazy_free(struct x509_crl_lazy_st *lazy)
+{
+    int i;
+
+    if (lazy == NULL)
+        return;
+    for (i = 0; i < lazy->num; i++)
+        X509_REVOKED_free(lazy->decoded[i]);
+    OPENSSL_free(lazy->decoded);
+    OPENSSL_free(lazy->index);
+    OPENSSL_free(lazy);
+}
+
+/*
+ * If |*pp| starts with a definite length TLV with universal tag |tag| that is
+ * constructed if |cons|, and that fits in |max| bytes, point |*pp| to its
+ * contents and set |*plen| to their length.
+ */
+static int der_get_header(const unsigned char **pp, long *plen, long max,
+    int tag, int cons)
+{
+    const unsigned char *p = *pp;
+    int ret, ptag, pclass;
+
+    if (max <= 0)
+        return 0;
+    ret = ASN1_get_object(&p, plen, &ptag, &pclass, max);
+    if ((ret & 0x81) != 0 || ptag != tag || pclass != V_ASN1_UNIVERSAL
+        || (ret & V_ASN1_CONSTRUCTED) != (cons ? V_ASN1_CONSTRUCTED : 0))
+        return 0;
+    *pp = p;
+    return 1;
+}
+
+/* Like der_get_header(), for a TLV that der_get_header() accepted before */
+static const unsigned char *der_skip_header(const unsigned char *p,
+    size_t *plen)
+{
+    size_t n, len;
+
+    if (*++p < 0x80) {
+        *plen = *p;
+        return p + 1;
+    }
+    for (n = *p++ & 0x7f, len = 0; n > 0; n--)
+        len = (len << 8) | *p++;
+    *plen = len;
+    return p;
+}
+
+#define CRL_LAZY_ENTRY_CRITICAL 1
+
+/*
+ * Check the structure of the revoked entry at |*pp| and move past it. Returns
+ * -1 if the entry cannot be left encoded, because it is not in the form we
+ * expect or because it names a certificate issuer, which only makes sense in
+ * the order of all entries, or CRL_LAZY_ENTRY_CRITICAL if it has a critical
+ * extension.
+ */
+static int crl_lazy_check_entry(const unsigned char **pp, long max)
+{
+    const unsigned char *p = *pp, *end, *ext_end;
+    static const unsigned char cert_issuer_oid[] = { 0x55, 0x1d, 0x1d };
+    long len;
+    int ret = 0;
+
+    if (!der_get_header(&p, &len, max, V_ASN1_SEQUENCE, 1))
+        return -1;
+    end = p + len;
+
+    /* The serial number must be minimally encoded, like c2i_ASN1_INTEGER() wants */
+    if (!der_get_header(&p, &len, end - p, V_ASN1_INTEGER, 0) || len == 0
+        || (len > 1
+            && ((p[0] == 0 && (p[1] & 0x80) == 0)
+                || (p[0] == 0xff && (p[1] & 0x80) != 0))))
+        return -1;
+    p += len;
+
+    if (!der_get_header(&p, &len, end - p, V_ASN1_UTCTIME, 0)
+        && !der_get_header(&p, &len, end - p, V_ASN1_GENERALIZEDTIME, 0))
+        return -1;
+    p += len;
+
+    if (p < end
+        && (!der_get_header(&p, &len, end - p, V_ASN1_SEQUENCE, 1)
+            || p + len != end))
+        return -1;
+    while (p < end) {
+        if (!der_get_header(&p, &len, end - p, V_ASN1_SEQUENCE, 1))
+            return -1;
+        ext_end = p + len;
+        if (!der_get_header(&p, &len, ext_end - p, V_ASN1_OBJECT, 0))
+            return -1;
+        if (len == sizeof(cert_issuer_oid)
+            && memcmp(p, cert_issuer_oid, sizeof(cert_issuer_oid)) == 0)
+            return -1;
+        p += len;
+        if (der_get_header(&p, &len, ext_end - p, V_ASN1_BOOLEAN, 0)) {
+            if (len != 1)
+                return -1;
+            if (p[0] != 0)
+                ret = CRL_LAZY_ENTRY_CRITICAL;
+            p += len;
+        }
+        if (!der_get_header(&p, &len, ext_end - p, V_ASN1_OCTET_STRING, 0)
+            || p + len != ext_end)
+            return -1;
+        p = ext_end;
+    }
+    *pp = end;
+    return ret;
+}
+
+/* The contents of the serial number of the revoked entry encoded at |p| */
+static const unsigned char *crl_lazy_serial(const unsigned char *p,
+    size_t *plen)
+{
+    size_t len;
+
+    return der_skip_header(der_skip_header(p, &len), plen);
+}
+
+static int crl_lazy_serial_cmp(const unsigned char *p,
+    const unsigned char *serial, size_t len)
+{
+    size_t plen;
+
+    p = crl_lazy_serial(p, &plen);
+    if (plen != len)
+        return plen < len ? -1 : 1;
+    return memcmp(p, serial, len);
+}
+
+static int crl_lazy_index_cmp(const void *a, const void *b)
+{
+    const unsigned char *pa = *(const unsigned char *const *)a;
+    const unsigned char *pb = *(const unsigned char *const *)b;
+    const unsigned char *serial;
+    size_t len;
+    int ret;
+
+    serial = crl_lazy_serial(pb, &len);
+    if ((ret = crl_lazy_serial_cmp(pa, serial, len)) != 0)
+        return ret;
+    /* Keep entries with the same serial number in the order of the CRL */
+    return pa < pb ? -1 : pa > pb;
+}
+
+/*
+ * Index the revoked entries of the lazy CRL |crl|. Returns -1 if they need to
+ * be decoded after all.
+ */
+static int crl_lazy_init(X509_CRL *crl)
+{
+    struct x509_crl_lazy_st *lazy;
+    const unsigned char *p = crl->crl.revoked_der->data, *end;
+    const unsigned char **index = NULL, **tmp;
+    long len;
+    int num = 0, max = 0, r, critical = 0;
+
+    ERR_set_mark();
+    if (!der_get_header(&p, &len, crl->crl.revoked_der->length,
+            V_ASN1_SEQUENCE, 1)) {
+        ERR_pop_to_mark();
+        return -1;
+    }
+    for (end = p + len; p < end; num++) {
+        if (num == max) {
+            max = max == 0 ? 64 : max * 2;
+            if ((tmp = OPENSSL_realloc_array(index, max, sizeof(*index))) == NULL) {
+                ERR_clear_last_mark();
+                OPENSSL_free(index);
+                return 0;
+            }
+            index = tmp;
+        }
+        index[num] = p;
+        if ((r = crl_lazy_check_entry(&p, (long)(end - p))) < 0) {
+            ERR_pop_to_mark();
+            OPENSSL_free(index);
+            return -1;
+        }
+        critical |= r;
+    }
+    ERR_clear_last_mark();
+
+    if ((lazy = OPENSSL_zalloc(sizeof(*lazy))) == NULL
+        || (num > 0
+            && (lazy->decoded = OPENSSL_calloc(num, sizeof(*lazy->decoded))) == NULL)) {
+        OPENSSL_free(lazy);
+        OPENSSL_free(index);
+        return 0;
+    }
+    if (num > 1)
+        qsort(index, num, sizeof(*index), crl_lazy_index_cmp);
+    lazy->index = index;
+    lazy->num = num;
+    crl->lazy = lazy;
+    if (critical)
+        crl->flags |= EXFLAG_CRITICAL;
+    return 1;
+}
+
+/*
+ * Set the reason of a revoked entry of a lazy CRL, and check what would have
+ * been checked when decoding the CRL.
+ */
+static int crl_lazy_setup_entry(X509_REVOKED *rev)
+{
+    ASN1_ENUMERATED *reason;
+    ASN1_GENERALIZEDTIME *inv_date;
+    int j;
+
+    if (X509_REVOKED_get0_revocationDate(rev) == NULL)
+        return 0;
+    reason = X509_REVOKED_get_ext_d2i(rev, NID_crl_reason, &j, NULL);
+    if (reason == NULL && j != -1)
+        return 0;
+    if (reason != NULL) {
+        rev->reason = ASN1_ENUMERATED_get(reason);
+        ASN1_ENUMERATED_free(reason);
+    } else {
+        rev->reason = CRL_REASON_NONE;
+    }
+    inv_date = X509_REVOKED_get_ext_d2i(rev, NID_invalidity_date, &j, NULL);
+    if (inv_date == NULL && j != -1)
+        return 0;
+    ASN1_GENERALIZEDTIME_free(inv_date);
+    return 1;
+}
+
+/*
+ * Decode the revoked entry of a lazy CRL encoded at |p|. An entry that turns
+ * out to be malformed only now is an error, just as it would have been when
+ * decoding the whole CRL.
+ */
+static X509_REVOKED *crl_lazy_decode_entry(const unsigned char *p)
+{
+    X509_REVOKED *rev;
+    size_t len;
+    long total = (long)(der_skip_header(p, &len) - p) + (long)len;
+
+    rev = d2i_X509_REVOKED(NULL, &p, total);
+    if (rev != NULL && crl_lazy_setup_entry(rev))
+        return rev;
+
+    X509_REVOKED_free(rev);
+    ERR_raise_data(ERR_LIB_ASN1, ASN1_R_INVALID_VALUE,
+        "CRL: malformed revoked entry");
+    return NULL;
+}
+
+static X509_REVOKED *crl_lazy_get_entry(X509_CRL *crl, int i)
+{
+    struct x509_crl_lazy_st *lazy = crl->lazy;
+    X509_REVOKED *rev, *ret;
+
+    if (!CRYPTO_THREAD_read_lock(crl->lock))
+        return NULL;
+    ret = lazy->decoded[i];
+    CRYPTO_THREAD_unlock(crl->lock);
+    if (ret != NULL)
+        return ret;
+
+    if ((rev = crl_lazy_decode_entry(lazy->index[i])) == NULL)
+        return NULL;
+    if (!CRYPTO_THREAD_write_lock(crl->lock)) {
+        X509_REVOKED_free(rev);
+        return NULL;
+    }
+    /* Another thread may have got here first */
+    if (lazy->decoded[i] == NULL) {
+        lazy->decoded[i] = rev;
+        rev = NULL;
+    }
+    ret = lazy->decoded[i];
+    CRYPTO_THREAD_unlock(crl->lock);
+    X509_REVOKED_free(rev);
+    return ret;
+}
+
+/* Decode all revoked entries of a lazy CRL */
+static int crl_info_decode_revoked(X509_CRL_INFO *inf)
+{
+    const unsigned char *p = inf->revoked_der->data;
+    STACK_OF(X509_REVOKED) *revoked;
+    int i;
+
+    revoked = (STACK_OF(X509_REVOKED) *)ASN1_item_d2i(NULL, &p,
+        inf->revoked_der->length, ASN1_ITEM_rptr(X509_REVOKED_SEQ));
+    if (revoked == NULL)
+        return 0;
+    for (i = 0; i < sk_X509_REVOKED_num(revoked); i++) {
+        if (!crl_lazy_setup_entry(sk_X509_REVOKED_value(revoked, i))) {
+            ERR_raise_data(ERR_LIB_ASN1, ASN1_R_INVALID_VALUE,
+                "CRL: malformed revoked entry");
+            sk_X509_REVOKED_pop_free(revoked, X509_REVOKED_free);
+            return 0;
+        }
+    }
+    (void)sk_X509_REVOKED_set_cmp_func(revoked, X509_REVOKED_cmp);
+    inf->revoked = revoked;
+    return 1;
+}
+
+/*
+ * Decode all revoked entries of |crl| if it is a lazy CRL and this was not
+ * done yet. Lookups in a lazy CRL do not need this unless it was modified.
+ */
+int ossl_x509_crl_decode_revoked(X509_CRL *crl)
+{
+    int ret = 1;
+
+    if (crl->crl.revoked_der == NULL)
+        return 1;
+    if (!CRYPTO_THREAD_write_lock(crl->lock))
+        return 0;
+    if (crl->crl.revoked == NULL)
+        ret = crl_info_decode_revoked(&crl->crl);
+    CRYPTO_THREAD_unlock(crl->lock);
+    return ret;
+}
+
 /*
  * Set CRL entry issuer according to CRL certificate issuer extension. Check
  * for unhandled critical CRL entry extensions.
@@ -94,7 +458,7 @@ static int crl_set_issuers(X509_CRL *crl)
         return 0;
     }
 
-    revoked = X509_CRL_get_REVOKED(crl);
+    revoked = crl->crl.revoked;
 
     /*
      * If this extension is not present on the first entry in an indirect CRL,
@@ -229,6 +593,10 @@ static int crl_cb(int operation, ASN1_VALUE **pval, const ASN1_ITEM *it,
         ASN1_INTEGER_free(crl->crl_number);
         ASN1_INTEGER_free(crl->base_crl_number);
         sk_GENERAL_NAMES_pop_free(crl->issuers, GENERAL_NAMES_free);
+        EVP_PKEY_free(crl->sig_pkey);
+        crl_lazy_free(crl->lazy);
+        ASN1_STRING_free(crl->crl.revoked_der);
+        crl->crl.revoked_der = NULL;
         /* fall through */
 
     case ASN1_OP_NEW_POST:
@@ -242,6 +610,9 @@ static int crl_cb(int operation, ASN1_VALUE **pval, const ASN1_ITEM *it,
         crl->issuers = NULL;
         crl->crl_number = NULL;
         crl->base_crl_number = NULL;
+        crl->sig_pkey = NULL;
+        crl->sig_cached = 0;
+        crl->lazy = NULL;
         break;
 
     case ASN1_OP_D2I_POST:
@@ -307,6 +678,21 @@ static int crl_cb(int operation, ASN1_VALUE **pval, const ASN1_ITEM *it,
             }
         }
 
+        /*
+         * Index the entries of a lazy CRL, unless they need to be decoded
+         * after all, in which case the CRL is no different from others.
+         */
+        if (crl->crl.revoked_der != NULL) {
+            if ((i = crl_lazy_init(crl)) == 0)
+                return 0;
+            if (i < 0) {
+                if (!crl_info_decode_revoked(&crl->crl))
+                    return 0;
+                ASN1_STRING_free(crl->crl.revoked_der);
+                crl->crl.revoked_der = NULL;
+            }
+        }
+
         if (!crl_set_issuers(crl))
             return 0;
 
@@ -328,6 +714,9 @@ static int crl_cb(int operation, ASN1_VALUE **pval, const ASN1_ITEM *it,
         ASN1_INTEGER_free(crl->crl_number);
         ASN1_INTEGER_free(crl->base_crl_number);
         sk_GENERAL_NAMES_pop_free(crl->issuers, GENERAL_NAMES_free);
+        EVP_PKEY_free(crl->sig_pkey);
+        crl_lazy_free(crl->lazy);
+        ASN1_STRING_free(crl->crl.revoked_der);
         OPENSSL_free(crl->propq);
         break;
     case ASN1_OP_DUP_POST: {
@@ -396,6 +785,16 @@ ASN1_SEQUENCE_ref(X509_CRL, crl_cb) = {
     ASN1_EMBED(X509_CRL, signature, ASN1_BIT_STRING)
 } ASN1_SEQUENCE_END_ref(X509_CRL, X509_CRL)
 
+static const ASN1_AUX X509_CRL_LAZY_aux = {
+    NULL, ASN1_AFLG_REFCOUNT, offsetof(X509_CRL, references),
+    offsetof(X509_CRL, lock), crl_cb, 0, NULL
+};
+ASN1_SEQUENCE(X509_CRL_LAZY) = {
+    ASN1_EMBED(X509_CRL, crl, X509_CRL_INFO_LAZY),
+    ASN1_EMBED(X509_CRL, sig_alg, X509_ALGOR),
+    ASN1_EMBED(X509_CRL, signature, ASN1_BIT_STRING)
+} static_ASN1_SEQUENCE_END_ref(X509_CRL, X509_CRL_LAZY)
+
 IMPLEMENT_ASN1_FUNCTIONS(X509_REVOKED)
 
 IMPLEMENT_ASN1_DUP_FUNCTION(X509_REVOKED)
@@ -406,6 +805,17 @@ IMPLEMENT_ASN1_FUNCTIONS(X509_CRL)
 
 IMPLEMENT_ASN1_DUP_FUNCTION(X509_CRL)
 
+X509_CRL *d2i_X509_CRL_lazy(X509_CRL **a, const unsigned char **in, long len)
+{
+    return (X509_CRL *)ASN1_item_d2i((ASN1_VALUE **)a, in, len,
+        ASN1_ITEM_rptr(X509_CRL_LAZY));
+}
+
+X509_CRL *d2i_X509_CRL_lazy_bio(BIO *bp, X509_CRL **crl)
+{
+    return ASN1_item_d2i_bio(ASN1_ITEM_rptr(X509_CRL_LAZY), bp, crl);
+}
+
 static int X509_REVOKED_cmp(const X509_REVOKED *const *a,
     const X509_REVOKED *const *b)
 {
@@ -430,6 +840,8 @@ int X509_CRL_add0_revoked(X509_CRL *crl, X509_REVOKED *rev)
     X509_CRL_INFO *inf;
 
     inf = &crl->crl;
+    if (!ossl_x509_crl_decode_revoked(crl))
+        return 0;
     if (inf->revoked == NULL)
         inf->revoked = sk_X509_REVOKED_new(X509_REVOKED_cmp);
     if (inf->revoked == NULL || !sk_X509_REVOKED_push(inf->revoked, rev)) {
@@ -447,6 +859,22 @@ int X509_CRL_verify(X509_CRL *crl, EVP_PKEY *r)
     return 0;
 }
 
+static int crl_verify_thunk(void *crl, EVP_PKEY *r)
+{
+    return def_crl_verify(crl, r);
+}
+
+/* Like X509_CRL_verify(), but see ossl_x509_verify_memo() */
+int ossl_x509_crl_verify_cached(X509_CRL *crl, EVP_PKEY *r)
+{
+    /* A modified CRL is not what was verified */
+    if (crl->meth->crl_verify != def_crl_verify || crl->crl.enc.modified)
+        return X509_CRL_verify(crl, r);
+
+    return ossl_x509_verify_memo(crl, crl_verify_thunk, crl->lock,
+        &crl->sig_pkey, &crl->sig_cached, r);
+}
+
 int X509_CRL_get0_by_serial(X509_CRL *crl,
     X509_REVOKED **ret, const ASN1_INTEGER *serial)
 {
@@ -501,6 +929,57 @@ static int crl_revoked_issuer_match(X509_CRL *crl, const X509_NAME *nm,
     return 0;
 }
 
+/*
+ * Binary search in the index of a lazy CRL. Returns -1 if an entry with the
+ * serial number could not be decoded.
+ */
+static int crl_lazy_lookup(X509_CRL *crl,
+    X509_REVOKED **ret, const ASN1_INTEGER *serial,
+    const X509_NAME *issuer)
+{
+    struct x509_crl_lazy_st *lazy = crl->lazy;
+    unsigned char buf[64], *der = buf, *p;
+    const unsigned char *content;
+    X509_REVOKED *rev;
+    size_t len;
+    int derlen, lo = 0, hi = lazy->num, mid, rv = 0;
+
+    if ((derlen = i2d_ASN1_INTEGER(serial, NULL)) <= 0)
+        return 0;
+    if ((size_t)derlen > sizeof(buf)
+        && (der = OPENSSL_malloc(derlen)) == NULL)
+        return 0;
+    p = der;
+    i2d_ASN1_INTEGER(serial, &p);
+    content = der_skip_header(der, &len);
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (crl_lazy_serial_cmp(lazy->index[mid], content, len) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    /* Need to look for matching name */
+    for (; lo < lazy->num
+         && crl_lazy_serial_cmp(lazy->index[lo], content, len) == 0;
+         lo++) {
+        if ((rev = crl_lazy_get_entry(crl, lo)) == NULL) {
+            rv = -1;
+            break;
+        }
+        if (crl_revoked_issuer_match(crl, issuer, rev)) {
+            if (ret)
+                *ret = rev;
+            rv = rev->reason == CRL_REASON_REMOVE_FROM_CRL ? 2 : 1;
+            break;
+        }
+    }
+    if (der != buf)
+        OPENSSL_free(der);
+    return rv;
+}
+
 static int def_crl_lookup(X509_CRL *crl,
     X509_REVOKED **ret, const ASN1_INTEGER *serial,
     const X509_NAME *issuer)
@@ -508,6 +987,11 @@ static int def_crl_lookup(X509_CRL *crl,
     X509_REVOKED rtmp, *rev;
     int idx, num;
 
+    /* The index only covers the entries of a lazy CRL as decoded */
+    if (crl->lazy != NULL && !crl->crl.enc.modified)
+        return crl_lazy_lookup(crl, ret, serial, issuer);
+    if (!ossl_x509_crl_decode_revoked(crl))
+        return 0;
     if (crl->crl.revoked == NULL)
         return 0;
 
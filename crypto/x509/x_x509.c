@@ -54,11 +54,14 @@ static int x509_cb(int operation, ASN1_VALUE **pval, const ASN1_ITEM *it,
         ASIdentifiers_free(ret->rfc3779_asid);
 #endif
         ASN1_OCTET_STRING_free(ret->distinguishing_id);
+        EVP_PKEY_free(ret->sig_pkey);
 
         /* fall through */
 
     case ASN1_OP_NEW_POST:
         ret->ex_cached = 0;
+        ret->sig_pkey = NULL;
+        ret->sig_cached = 0;
         ret->ex_kusage = 0;
         ret->ex_xkusage = 0;
         ret->ex_nscert = 0;
@@ -95,6 +98,7 @@ static int x509_cb(int operation, ASN1_VALUE **pval, const ASN1_ITEM *it,
         ASIdentifiers_free(ret->rfc3779_asid);
 #endif
         ASN1_OCTET_STRING_free(ret->distinguishing_id);
+        EVP_PKEY_free(ret->sig_pkey);
         OPENSSL_free(ret->propq);
         break;
 
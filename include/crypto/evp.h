@@ -220,6 +220,7 @@ struct evp_md_st {
     OSSL_FUNC_digest_gettable_ctx_params_fn *gettable_ctx_params;
     OSSL_FUNC_digest_serialize_fn *serialize;
     OSSL_FUNC_digest_deserialize_fn *deserialize;
+    OSSL_FUNC_digest_digest_multi_fn *digest_multi;
 } /* EVP_MD */;
 
 struct evp_cipher_st {
@@ -46,6 +46,7 @@
 
 #define ML_DSA_KEY_PREFER_SEED (1 << 0)
 #define ML_DSA_KEY_RETAIN_SEED (1 << 1)
+#define ML_DSA_KEY_PRECOMPUTE (1 << 2)
 /* Default provider flags */
 #define ML_DSA_KEY_PROV_FLAGS_DEFAULT \
     (ML_DSA_KEY_PREFER_SEED | ML_DSA_KEY_RETAIN_SEED)
@@ -96,6 +97,7 @@ __owur const uint8_t *ossl_ml_dsa_key_get_priv(const ML_DSA_KEY *key);
 __owur size_t ossl_ml_dsa_key_get_priv_len(const ML_DSA_KEY *key);
 __owur const uint8_t *ossl_ml_dsa_key_get_seed(const ML_DSA_KEY *key);
 __owur int ossl_ml_dsa_key_get_prov_flags(const ML_DSA_KEY *key);
+__owur int ossl_ml_dsa_key_set_precompute(ML_DSA_KEY *key, int precompute);
 int ossl_ml_dsa_set_prekey(ML_DSA_KEY *key, int flags_set, int flags_clr,
     const uint8_t *seed, size_t seed_len,
     const uint8_t *sk, size_t sk_len);
@@ -122,7 +124,7 @@ __owur int ossl_ml_dsa_mu_finalize(EVP_MD_CTX *md_ctx, uint8_t *mu, size_t mu_le
 __owur int ossl_ml_dsa_sign(const ML_DSA_KEY *priv, int msg_is_mu,
     const uint8_t *msg, size_t msg_len,
     const uint8_t *context, size_t context_len,
-    const uint8_t *rand, size_t rand_len, int encode,
+    const uint8_t *rand, size_t rand_len, int encode, uint32_t threads,
     unsigned char *sig, size_t *siglen, size_t sigsize);
 __owur int ossl_ml_dsa_verify(const ML_DSA_KEY *pub, int msg_is_mu,
     const uint8_t *msg, size_t msg_len,
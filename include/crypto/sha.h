@@ -20,10 +20,20 @@ int ossl_sha256_192_init(SHA256_CTX *c);
 int sha512_224_init(SHA512_CTX *);
 int sha512_256_init(SHA512_CTX *);
 int ossl_sha1_ctrl(SHA_CTX *ctx, int cmd, int mslen, void *ms);
+int ossl_sha256_multi_from(const SHA256_CTX *init, size_t n,
+    const unsigned char *const in[], const size_t inl[],
+    unsigned char *const out[], size_t outlen);
 #endif
 
 unsigned char *ossl_sha1(const unsigned char *d, size_t n, unsigned char *md);
 
+/* Hash |n| independent messages, see sha_mb.c */
+int ossl_sha256_multi_capable(size_t inl);
+int ossl_sha256_multi(size_t md_len, size_t n, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[]);
+int ossl_sha512_multi(size_t md_len, size_t n, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[]);
+
 int ossl_sp800_185_right_encode(unsigned char *out,
     size_t out_max_len, size_t *out_len,
     size_t bits);
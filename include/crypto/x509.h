@@ -98,6 +98,7 @@ struct X509_crl_info_st {
     STACK_OF(X509_REVOKED) *revoked; /* revoked entries: optional */
     STACK_OF(X509_EXTENSION) *extensions; /* extensions: optional */
     ASN1_ENCODING enc; /* encoding of signed portion of CRL */
+    ASN1_STRING *revoked_der; /* undecoded revoked entries of a lazy CRL */
 };
 
 struct X509_crl_st {
@@ -125,6 +126,11 @@ struct X509_crl_st {
     const X509_CRL_METHOD *meth;
     void *meth_data;
     CRYPTO_RWLOCK *lock;
+    /* Issuer key that the signature was found to be good with, see x_all.c */
+    EVP_PKEY *sig_pkey;
+    volatile int sig_cached;
+    /* Index of the revoked entries of a lazy CRL, see x_crl.c */
+    struct x509_crl_lazy_st *lazy;
 
     OSSL_LIB_CTX *libctx;
     char *propq;
@@ -202,6 +208,9 @@ struct x509_st {
     X509_CERT_AUX *aux;
     CRYPTO_RWLOCK *lock;
     volatile int ex_cached;
+    /* Issuer key that the signature was found to be good with, see x_all.c */
+    EVP_PKEY *sig_pkey;
+    volatile int sig_cached;
 
     /* Set on live certificates for authentication purposes */
     ASN1_OCTET_STRING *distinguishing_id;
@@ -317,6 +326,12 @@ int ossl_a2i_ipadd(unsigned char *ipout, const char *ipasc);
 int ossl_x509_set1_time(int *modified, ASN1_TIME **ptm, const ASN1_TIME *tm);
 int ossl_x509_print_ex_brief(BIO *bio, const X509 *cert, unsigned long neg_cflags);
 int ossl_x509v3_cache_extensions(const X509 *x);
+int ossl_x509_verify_memo(void *obj, int (*verify)(void *, EVP_PKEY *),
+    CRYPTO_RWLOCK *lock, EVP_PKEY **sig_pkey,
+    volatile int *sig_cached, EVP_PKEY *r);
+int ossl_x509_verify_cached(X509 *a, EVP_PKEY *r);
+int ossl_x509_crl_verify_cached(X509_CRL *crl, EVP_PKEY *r);
+int ossl_x509_crl_decode_revoked(X509_CRL *crl);
 int ossl_x509_init_sig_info(const X509 *x, X509_SIG_INFO *info);
 
 int ossl_x509_set0_libctx(X509 *x, OSSL_LIB_CTX *libctx, const char *propq);
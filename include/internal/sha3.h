@@ -65,6 +65,21 @@ int ossl_shake_squeeze_default(KECCAK1600_CTX *ctx, unsigned char *out, size_t o
 size_t SHA3_absorb(uint64_t A[5][5], const unsigned char *inp, size_t len,
     size_t r);
 
+/*
+ * SHAKE of 4 messages of the same length at once, see sha3_x4.c.
+ * These work everywhere, but are only faster than hashing the messages one
+ * by one if ossl_sha3_shake_x4_capable() returns 1.
+ */
+int ossl_sha3_shake_x4_capable(void);
+void ossl_sha3_shake128_x4(void *out0, void *out1, void *out2, void *out3,
+    size_t outlen,
+    const void *in0, const void *in1, const void *in2, const void *in3,
+    size_t inlen);
+void ossl_sha3_shake256_x4(void *out0, void *out1, void *out2, void *out3,
+    size_t outlen,
+    const void *in0, const void *in1, const void *in2, const void *in3,
+    size_t inlen);
+
 /* Multi-buffer (x4) Keccak-f[1600] context and API */
 #if defined(KECCAK1600_ASM)                                                               \
     && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
@@ -136,4 +151,33 @@ void ossl_sha3_shake256_x4_avx512vl(
 
 #endif /* KECCAK1600_ASM && x86_64 && !OPENSSL_NO_ASM */
 
+/*
+ * Four SHAKE instances that each absorb one message, all of the same length,
+ * and are then squeezed in lock step, e.g. for rejection sampling from
+ * independent streams.  See sha3_x4.c.  As above, this is only faster than
+ * four separate instances if ossl_sha3_shake_x4_capable() returns 1.
+ */
+typedef struct {
+#if defined(KECCAK1600_ASM)                                                               \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
+    && !defined(OPENSSL_NO_ASM)
+    KECCAK1600_X4_AVX512VL_CTX avx512vl;
+#endif
+    uint64_t A[25][4]; /* lane (x, y) of state j is A[x + 5 * y][j] */
+    unsigned char buf[4][SHA3_BLOCKSIZE(128)];
+    size_t rate;
+    size_t bufsz; /* squeezed bytes of buf not yet returned */
+    int impl;
+} KECCAK1600_X4_CTX;
+
+void ossl_sha3_shake128_x4_init(KECCAK1600_X4_CTX *ctx,
+    const void *in0, const void *in1, const void *in2, const void *in3,
+    size_t inlen);
+void ossl_sha3_shake256_x4_init(KECCAK1600_X4_CTX *ctx,
+    const void *in0, const void *in1, const void *in2, const void *in3,
+    size_t inlen);
+void ossl_sha3_shake_x4_squeeze(KECCAK1600_X4_CTX *ctx,
+    void *out0, void *out1, void *out2, void *out3, size_t outlen);
+void ossl_sha3_shake_x4_cleanup(KECCAK1600_X4_CTX *ctx);
+
 #endif /* OSSL_INTERNAL_SHA3_H */
@@ -317,6 +317,7 @@ OSSL_CORE_MAKE_FUNC(int, SSL_QUIC_TLS_alert,
 #define OSSL_FUNC_DIGEST_COPYCTX 15
 #define OSSL_FUNC_DIGEST_SERIALIZE 16
 #define OSSL_FUNC_DIGEST_DESERIALIZE 17
+#define OSSL_FUNC_DIGEST_DIGEST_MULTI 18
 
 OSSL_CORE_MAKE_FUNC(void *, digest_newctx, (void *provctx))
 OSSL_CORE_MAKE_FUNC(int, digest_init, (void *dctx, const OSSL_PARAM params[]))
@@ -331,6 +332,9 @@ OSSL_CORE_MAKE_FUNC(int, digest_squeeze,
 OSSL_CORE_MAKE_FUNC(int, digest_digest,
     (void *provctx, const unsigned char *in, size_t inl,
         unsigned char *out, size_t *outl, size_t outsz))
+OSSL_CORE_MAKE_FUNC(int, digest_digest_multi,
+    (void *provctx, size_t n, const unsigned char *const in[],
+        const size_t inl[], unsigned char *const out[], size_t outsz))
 
 OSSL_CORE_MAKE_FUNC(void, digest_freectx, (void *dctx))
 OSSL_CORE_MAKE_FUNC(void *, digest_dupctx, (void *dctx))
@@ -826,6 +830,8 @@ OSSL_CORE_MAKE_FUNC(void *, keyexch_derive_skey, (void *ctx, const char *key_typ
 #define OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_INIT 30
 #define OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_UPDATE 31
 #define OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_FINAL 32
+#define OSSL_FUNC_SIGNATURE_SIGN_BATCH 33
+#define OSSL_FUNC_SIGNATURE_VERIFY_BATCH 34
 
 OSSL_CORE_MAKE_FUNC(void *, signature_newctx, (void *provctx, const char *propq))
 OSSL_CORE_MAKE_FUNC(int, signature_sign_init, (void *ctx, void *provkey, const OSSL_PARAM params[]))
@@ -848,6 +854,13 @@ OSSL_CORE_MAKE_FUNC(int, signature_verify_message_update,
  * is specified via an OSSL_PARAM.
  */
 OSSL_CORE_MAKE_FUNC(int, signature_verify_message_final, (void *ctx))
+OSSL_CORE_MAKE_FUNC(int, signature_sign_batch,
+    (void *ctx, size_t num, unsigned char **sigs, size_t *siglens,
+        const unsigned char **tbs, const size_t *tbslens))
+OSSL_CORE_MAKE_FUNC(int, signature_verify_batch,
+    (void *ctx, size_t num, const unsigned char **sigs,
+        const size_t *siglens, const unsigned char **tbs,
+        const size_t *tbslens, int *results))
 OSSL_CORE_MAKE_FUNC(int, signature_verify_recover_init,
     (void *ctx, void *provkey, const OSSL_PARAM params[]))
 OSSL_CORE_MAKE_FUNC(int, signature_verify_recover,
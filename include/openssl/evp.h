@@ -646,6 +646,9 @@ __owur int EVP_DigestFinal_ex(EVP_MD_CTX *ctx, unsigned char *md,
 __owur int EVP_Digest(const void *data, size_t count,
     unsigned char *md, unsigned int *size,
     const EVP_MD *type, ENGINE *impl);
+__owur int EVP_Digest_multi(const EVP_MD *type, size_t n,
+    const unsigned char *const in[], const size_t inlen[],
+    unsigned char *const out[]);
 __owur int EVP_Q_digest(OSSL_LIB_CTX *libctx, const char *name,
     const char *propq, const void *data, size_t datalen,
     unsigned char *md, size_t *mdlen);
@@ -1777,6 +1780,9 @@ int EVP_PKEY_sign_init_ex2(EVP_PKEY_CTX *ctx,
 int EVP_PKEY_sign(EVP_PKEY_CTX *ctx,
     unsigned char *sig, size_t *siglen,
     const unsigned char *tbs, size_t tbslen);
+int EVP_PKEY_sign_batch(EVP_PKEY_CTX *ctx, size_t num,
+    unsigned char **sigs, size_t *siglens,
+    const unsigned char **tbs, const size_t *tbslens);
 int EVP_PKEY_sign_message_init(EVP_PKEY_CTX *ctx,
     EVP_SIGNATURE *algo, const OSSL_PARAM params[]);
 int EVP_PKEY_sign_message_update(EVP_PKEY_CTX *ctx,
@@ -1790,6 +1796,10 @@ int EVP_PKEY_verify_init_ex2(EVP_PKEY_CTX *ctx,
 int EVP_PKEY_verify(EVP_PKEY_CTX *ctx,
     const unsigned char *sig, size_t siglen,
     const unsigned char *tbs, size_t tbslen);
+int EVP_PKEY_verify_batch(EVP_PKEY_CTX *ctx, size_t num,
+    const unsigned char **sigs, const size_t *siglens,
+    const unsigned char **tbs, const size_t *tbslens,
+    int *results);
 int EVP_PKEY_verify_message_init(EVP_PKEY_CTX *ctx,
     EVP_SIGNATURE *algo, const OSSL_PARAM params[]);
 int EVP_PKEY_verify_message_update(EVP_PKEY_CTX *ctx,
@@ -34,6 +34,7 @@
 #define X509_R_ERROR_USING_SIGINF_SET 142
 #define X509_R_IDP_MISMATCH 128
 #define X509_R_INVALID_ATTRIBUTES 138
+#define X509_R_INVALID_CERT_INDEX 148
 #define X509_R_INVALID_DIRECTORY 113
 #define X509_R_INVALID_DISTPOINT 143
 #define X509_R_INVALID_EXTENSION 146
@@ -44,8 +44,11 @@ static void *aes_gcm_dupctx(void *provctx)
         return NULL;
 
     dctx = OPENSSL_memdup(ctx, sizeof(*ctx));
-    if (dctx != NULL && dctx->base.gcm.key != NULL)
-        dctx->base.gcm.key = &dctx->ks.ks;
+    if (dctx != NULL) {
+        if (dctx->base.gcm.key != NULL)
+            dctx->base.gcm.key = &dctx->ks.ks;
+        dctx->base.pipeline = NULL;
+    }
 
     return dctx;
 }
@@ -55,12 +58,75 @@ static void aes_gcm_freectx(void *vctx)
 {
     PROV_AES_GCM_CTX *ctx = (PROV_AES_GCM_CTX *)vctx;
 
+    if (ctx == NULL)
+        return;
+    ossl_cipher_pipeline_free(ctx->base.pipeline);
     OPENSSL_clear_free(ctx, sizeof(*ctx));
 }
 
+static const PROV_CIPHER_PIPELINE_OPS aes_gcm_pipeline_ops = {
+    aes_gcm_dupctx,
+    aes_gcm_freectx,
+    ossl_gcm_einit,
+    ossl_gcm_dinit,
+    ossl_gcm_stream_update,
+    ossl_gcm_stream_final,
+    ossl_gcm_get_ctx_params,
+    ossl_gcm_set_ctx_params
+};
+
+static OSSL_FUNC_cipher_pipeline_encrypt_init_fn aes_gcm_pipeline_einit;
+static int aes_gcm_pipeline_einit(void *vctx, const unsigned char *key,
+    size_t keylen, size_t numpipes,
+    const unsigned char **iv, size_t ivlen,
+    const OSSL_PARAM params[])
+{
+    PROV_GCM_CTX *ctx = (PROV_GCM_CTX *)vctx;
+
+    return ossl_cipher_pipeline_init(&ctx->pipeline, &aes_gcm_pipeline_ops,
+        vctx, key, keylen, numpipes, iv, ivlen,
+        params, 1);
+}
+
+static OSSL_FUNC_cipher_pipeline_decrypt_init_fn aes_gcm_pipeline_dinit;
+static int aes_gcm_pipeline_dinit(void *vctx, const unsigned char *key,
+    size_t keylen, size_t numpipes,
+    const unsigned char **iv, size_t ivlen,
+    const OSSL_PARAM params[])
+{
+    PROV_GCM_CTX *ctx = (PROV_GCM_CTX *)vctx;
+
+    return ossl_cipher_pipeline_init(&ctx->pipeline, &aes_gcm_pipeline_ops,
+        vctx, key, keylen, numpipes, iv, ivlen,
+        params, 0);
+}
+
+static OSSL_FUNC_cipher_pipeline_update_fn aes_gcm_pipeline_update;
+static int aes_gcm_pipeline_update(void *vctx, size_t numpipes,
+    unsigned char **out, size_t *outl,
+    const size_t *outsize,
+    const unsigned char **in, const size_t *inl)
+{
+    PROV_GCM_CTX *ctx = (PROV_GCM_CTX *)vctx;
+
+    return ossl_cipher_pipeline_update(ctx->pipeline, numpipes, out, outl,
+        outsize, in, inl);
+}
+
+static OSSL_FUNC_cipher_pipeline_final_fn aes_gcm_pipeline_final;
+static int aes_gcm_pipeline_final(void *vctx, size_t numpipes,
+    unsigned char **out, size_t *outl,
+    const size_t *outsize)
+{
+    PROV_GCM_CTX *ctx = (PROV_GCM_CTX *)vctx;
+
+    return ossl_cipher_pipeline_final(ctx->pipeline, numpipes, out, outl,
+        outsize);
+}
+
 /* ossl_aes128gcm_functions */
-IMPLEMENT_aead_cipher(aes, gcm, GCM, AEAD_FLAGS, 128, 8, 96);
+IMPLEMENT_aead_pipeline_cipher(aes, gcm, GCM, AEAD_FLAGS, 128, 8, 96);
 /* ossl_aes192gcm_functions */
-IMPLEMENT_aead_cipher(aes, gcm, GCM, AEAD_FLAGS, 192, 8, 96);
+IMPLEMENT_aead_pipeline_cipher(aes, gcm, GCM, AEAD_FLAGS, 192, 8, 96);
 /* ossl_aes256gcm_functions */
-IMPLEMENT_aead_cipher(aes, gcm, GCM, AEAD_FLAGS, 256, 8, 96);
+IMPLEMENT_aead_pipeline_cipher(aes, gcm, GCM, AEAD_FLAGS, 256, 8, 96);
@@ -35,6 +35,11 @@ static OSSL_FUNC_cipher_cipher_fn chacha20_poly1305_cipher;
 static OSSL_FUNC_cipher_final_fn chacha20_poly1305_final;
 static OSSL_FUNC_cipher_gettable_ctx_params_fn chacha20_poly1305_gettable_ctx_params;
 static OSSL_FUNC_cipher_settable_ctx_params_fn chacha20_poly1305_settable_ctx_params;
+static OSSL_FUNC_cipher_update_fn chacha20_poly1305_update;
+static OSSL_FUNC_cipher_pipeline_encrypt_init_fn chacha20_poly1305_pipeline_einit;
+static OSSL_FUNC_cipher_pipeline_decrypt_init_fn chacha20_poly1305_pipeline_dinit;
+static OSSL_FUNC_cipher_pipeline_update_fn chacha20_poly1305_pipeline_update;
+static OSSL_FUNC_cipher_pipeline_final_fn chacha20_poly1305_pipeline_final;
 #define chacha20_poly1305_gettable_params ossl_cipher_generic_gettable_params
 
 static void *chacha20_poly1305_newctx(void *provctx)
@@ -68,7 +73,10 @@ static void *chacha20_poly1305_dupctx(void *provctx)
     if (ctx == NULL)
         return NULL;
     dctx = OPENSSL_memdup(ctx, sizeof(*ctx));
-    if (dctx != NULL && dctx->base.tlsmac != NULL && dctx->base.alloced) {
+    if (dctx == NULL)
+        return NULL;
+    dctx->pipeline = NULL;
+    if (dctx->base.tlsmac != NULL && dctx->base.alloced) {
         dctx->base.tlsmac = OPENSSL_memdup(dctx->base.tlsmac,
             dctx->base.tlsmacsize);
         if (dctx->base.tlsmac == NULL) {
@@ -84,6 +92,7 @@ static void chacha20_poly1305_freectx(void *vctx)
     PROV_CHACHA20_POLY1305_CTX *ctx = (PROV_CHACHA20_POLY1305_CTX *)vctx;
 
     if (ctx != NULL) {
+        ossl_cipher_pipeline_free(ctx->pipeline);
         ossl_cipher_generic_reset_ctx((PROV_CIPHER_CTX *)vctx);
         OPENSSL_clear_free(ctx, sizeof(*ctx));
     }
@@ -144,6 +153,9 @@ static int chacha20_poly1305_get_ctx_params(void *vctx, OSSL_PARAM params[])
         }
         memcpy(p.tag->data, ctx->tag, p.tag->data_size);
     }
+
+    if (p.ptag != NULL && !ossl_cipher_pipeline_get_tags(ctx->pipeline, p.ptag))
+        return 0;
     return 1;
 }
 
@@ -236,6 +248,9 @@ static int chacha20_poly1305_set_ctx_params(void *vctx,
             return 0;
         }
     }
+
+    if (p.ptag != NULL && !ossl_cipher_pipeline_set_tags(ctx->pipeline, p.ptag))
+        return 0;
     return 1;
 }
 
@@ -247,6 +262,11 @@ static int chacha20_poly1305_einit(void *vctx, const unsigned char *key,
 
     /* The generic function checks for ossl_prov_is_running() */
     ret = ossl_cipher_generic_einit(vctx, key, keylen, iv, ivlen, NULL);
+    if (ret && key != NULL) {
+        PROV_CHACHA20_POLY1305_CTX *cctx = (PROV_CHACHA20_POLY1305_CTX *)vctx;
+
+        ossl_cipher_pipeline_reset(cctx->pipeline);
+    }
     if (ret && iv != NULL) {
         PROV_CIPHER_CTX *ctx = (PROV_CIPHER_CTX *)vctx;
         PROV_CHACHA20_POLY1305_CTX *cctx = (PROV_CHACHA20_POLY1305_CTX *)vctx;
@@ -268,6 +288,11 @@ static int chacha20_poly1305_dinit(void *vctx, const unsigned char *key,
 
     /* The generic function checks for ossl_prov_is_running() */
     ret = ossl_cipher_generic_dinit(vctx, key, keylen, iv, ivlen, NULL);
+    if (ret && key != NULL) {
+        PROV_CHACHA20_POLY1305_CTX *cctx = (PROV_CHACHA20_POLY1305_CTX *)vctx;
+
+        ossl_cipher_pipeline_reset(cctx->pipeline);
+    }
     if (ret && iv != NULL) {
         PROV_CIPHER_CTX *ctx = (PROV_CIPHER_CTX *)vctx;
         PROV_CHACHA20_POLY1305_CTX *cctx = (PROV_CHACHA20_POLY1305_CTX *)vctx;
@@ -344,6 +369,69 @@ static int chacha20_poly1305_final(void *vctx, unsigned char *out, size_t *outl,
     return 1;
 }
 
+static const PROV_CIPHER_PIPELINE_OPS chacha20_poly1305_pipeline_ops = {
+    chacha20_poly1305_dupctx,
+    chacha20_poly1305_freectx,
+    chacha20_poly1305_einit,
+    chacha20_poly1305_dinit,
+    chacha20_poly1305_update,
+    chacha20_poly1305_final,
+    chacha20_poly1305_get_ctx_params,
+    chacha20_poly1305_set_ctx_params
+};
+
+static int chacha20_poly1305_pipeline_einit(void *vctx,
+    const unsigned char *key,
+    size_t keylen, size_t numpipes,
+    const unsigned char **iv,
+    size_t ivlen,
+    const OSSL_PARAM params[])
+{
+    PROV_CHACHA20_POLY1305_CTX *ctx = (PROV_CHACHA20_POLY1305_CTX *)vctx;
+
+    return ossl_cipher_pipeline_init(&ctx->pipeline,
+        &chacha20_poly1305_pipeline_ops,
+        vctx, key, keylen, numpipes, iv, ivlen,
+        params, 1);
+}
+
+static int chacha20_poly1305_pipeline_dinit(void *vctx,
+    const unsigned char *key,
+    size_t keylen, size_t numpipes,
+    const unsigned char **iv,
+    size_t ivlen,
+    const OSSL_PARAM params[])
+{
+    PROV_CHACHA20_POLY1305_CTX *ctx = (PROV_CHACHA20_POLY1305_CTX *)vctx;
+
+    return ossl_cipher_pipeline_init(&ctx->pipeline,
+        &chacha20_poly1305_pipeline_ops,
+        vctx, key, keylen, numpipes, iv, ivlen,
+        params, 0);
+}
+
+static int chacha20_poly1305_pipeline_update(void *vctx, size_t numpipes,
+    unsigned char **out, size_t *outl,
+    const size_t *outsize,
+    const unsigned char **in,
+    const size_t *inl)
+{
+    PROV_CHACHA20_POLY1305_CTX *ctx = (PROV_CHACHA20_POLY1305_CTX *)vctx;
+
+    return ossl_cipher_pipeline_update(ctx->pipeline, numpipes, out, outl,
+        outsize, in, inl);
+}
+
+static int chacha20_poly1305_pipeline_final(void *vctx, size_t numpipes,
+    unsigned char **out, size_t *outl,
+    const size_t *outsize)
+{
+    PROV_CHACHA20_POLY1305_CTX *ctx = (PROV_CHACHA20_POLY1305_CTX *)vctx;
+
+    return ossl_cipher_pipeline_final(ctx->pipeline, numpipes, out, outl,
+        outsize);
+}
+
 /* ossl_chacha20_ossl_poly1305_functions */
 const OSSL_DISPATCH ossl_chacha20_ossl_poly1305_functions[] = {
     { OSSL_FUNC_CIPHER_NEWCTX, (void (*)(void))chacha20_poly1305_newctx },
@@ -354,6 +442,14 @@ const OSSL_DISPATCH ossl_chacha20_ossl_poly1305_functions[] = {
     { OSSL_FUNC_CIPHER_UPDATE, (void (*)(void))chacha20_poly1305_update },
     { OSSL_FUNC_CIPHER_FINAL, (void (*)(void))chacha20_poly1305_final },
     { OSSL_FUNC_CIPHER_CIPHER, (void (*)(void))chacha20_poly1305_cipher },
+    { OSSL_FUNC_CIPHER_PIPELINE_ENCRYPT_INIT,
+        (void (*)(void))chacha20_poly1305_pipeline_einit },
+    { OSSL_FUNC_CIPHER_PIPELINE_DECRYPT_INIT,
+        (void (*)(void))chacha20_poly1305_pipeline_dinit },
+    { OSSL_FUNC_CIPHER_PIPELINE_UPDATE,
+        (void (*)(void))chacha20_poly1305_pipeline_update },
+    { OSSL_FUNC_CIPHER_PIPELINE_FINAL,
+        (void (*)(void))chacha20_poly1305_pipeline_final },
     { OSSL_FUNC_CIPHER_GET_PARAMS,
         (void (*)(void))chacha20_poly1305_get_params },
     { OSSL_FUNC_CIPHER_GETTABLE_PARAMS,
@@ -78,6 +78,7 @@ static int gcm_init(void *vctx, const unsigned char *key, size_t keylen,
         if (!ctx->hw->setkey(ctx, key, ctx->keylen))
             return 0;
         ctx->tls_enc_records = 0;
+        ossl_cipher_pipeline_reset(ctx->pipeline);
     }
     return ossl_gcm_set_ctx_params(ctx, params);
 }
@@ -238,6 +239,9 @@ int ossl_gcm_get_ctx_params(void *vctx, OSSL_PARAM params[])
     if (p.gen != NULL && !OSSL_PARAM_set_uint(p.gen, ctx->iv_gen_rand))
         return 0;
 
+    if (p.ptag != NULL && !ossl_cipher_pipeline_get_tags(ctx->pipeline, p.ptag))
+        return 0;
+
     return 1;
 }
 
@@ -321,6 +325,9 @@ int ossl_gcm_set_ctx_params(void *vctx, const OSSL_PARAM params[])
             || !setivinv(ctx, p.inviv->data, p.inviv->data_size))
             return 0;
 
+    if (p.ptag != NULL && !ossl_cipher_pipeline_set_tags(ctx->pipeline, p.ptag))
+        return 0;
+
     return 1;
 }
 
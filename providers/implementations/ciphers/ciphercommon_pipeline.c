@@ -0,0 +1,190 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/* Generic pipeline functions for AEAD ciphers */
+
+#include <openssl/proverr.h>
+#include "prov/ciphercommon.h"
+#include "prov/providercommon.h"
+
+/*
+ * The pipes are copies of the keyed cipher context. They are kept from one
+ * operation to the next, which then only sets new IVs on them, until the key
+ * changes.
+ */
+struct prov_cipher_pipeline_st {
+    const PROV_CIPHER_PIPELINE_OPS *ops;
+    /* The number of pipes in the current operation */
+    size_t numpipes;
+    /* The number of pipes allocated, at least |numpipes| */
+    size_t npipes;
+    void *pipes[EVP_MAX_PIPES];
+};
+
+void ossl_cipher_pipeline_reset(PROV_CIPHER_PIPELINE *pipeline)
+{
+    size_t i;
+
+    if (pipeline == NULL)
+        return;
+    for (i = 0; i < pipeline->npipes; i++) {
+        pipeline->ops->freectx(pipeline->pipes[i]);
+        pipeline->pipes[i] = NULL;
+    }
+    pipeline->npipes = pipeline->numpipes = 0;
+}
+
+/*
+ * Set up |numpipes| independent operations. If |key| is not NULL the key is
+ * set on the cipher context |vctx| first, otherwise the key |vctx| already
+ * has is used. Pipes are copied from |vctx| the first time they are needed
+ * after a key change, so the key schedule is only computed once however many
+ * pipes and operations there are.
+ */
+int ossl_cipher_pipeline_init(PROV_CIPHER_PIPELINE **pipeline,
+    const PROV_CIPHER_PIPELINE_OPS *ops, void *vctx,
+    const unsigned char *key, size_t keylen,
+    size_t numpipes, const unsigned char **iv,
+    size_t ivlen, const OSSL_PARAM params[], int enc)
+{
+    OSSL_FUNC_cipher_encrypt_init_fn *init = enc ? ops->einit : ops->dinit;
+    PROV_CIPHER_PIPELINE *pl = *pipeline;
+    size_t i;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if (numpipes == 0 || numpipes > EVP_MAX_PIPES) {
+        ERR_raise(ERR_LIB_PROV, ERR_R_PASSED_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    if (pl == NULL) {
+        pl = OPENSSL_zalloc(sizeof(*pl));
+        if (pl == NULL)
+            return 0;
+        pl->ops = ops;
+        *pipeline = pl;
+    }
+    pl->numpipes = 0;
+
+    if (key != NULL) {
+        ossl_cipher_pipeline_reset(pl);
+        if (!init(vctx, key, keylen, NULL, 0, NULL))
+            return 0;
+    }
+
+    for (i = 0; i < numpipes; i++) {
+        if (i == pl->npipes) {
+            if ((pl->pipes[i] = ops->dupctx(vctx)) == NULL)
+                return 0;
+            pl->npipes++;
+        }
+        if (!init(pl->pipes[i], NULL, 0, iv != NULL ? iv[i] : NULL, ivlen,
+                params))
+            return 0;
+    }
+    pl->numpipes = numpipes;
+    return 1;
+}
+
+int ossl_cipher_pipeline_update(PROV_CIPHER_PIPELINE *pipeline,
+    size_t numpipes, unsigned char **out,
+    size_t *outl, const size_t *outsize,
+    const unsigned char **in, const size_t *inl)
+{
+    size_t i;
+
+    if (pipeline == NULL || numpipes != pipeline->numpipes) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_CIPHER_OPERATION_FAILED);
+        return 0;
+    }
+    if (in == NULL || (out != NULL && outsize == NULL)) {
+        ERR_raise(ERR_LIB_PROV, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    /* A NULL |out| means that |in| holds the AAD of each pipe */
+    for (i = 0; i < numpipes; i++)
+        if (!pipeline->ops->update(pipeline->pipes[i],
+                out != NULL ? out[i] : NULL, &outl[i],
+                out != NULL ? outsize[i] : inl[i], in[i], inl[i]))
+            return 0;
+    return 1;
+}
+
+int ossl_cipher_pipeline_final(PROV_CIPHER_PIPELINE *pipeline,
+    size_t numpipes, unsigned char **out,
+    size_t *outl, const size_t *outsize)
+{
+    size_t i;
+
+    if (pipeline == NULL || numpipes != pipeline->numpipes) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_CIPHER_OPERATION_FAILED);
+        return 0;
+    }
+
+    for (i = 0; i < numpipes; i++)
+        if (!pipeline->ops->final(pipeline->pipes[i],
+                out != NULL ? out[i] : NULL, &outl[i],
+                outsize != NULL ? outsize[i] : 0))
+            return 0;
+    return 1;
+}
+
+/*
+ * |p| is an OSSL_CIPHER_PARAM_PIPELINE_AEAD_TAG parameter pointing to an array
+ * of one tag buffer per pipe, each of the size of the parameter.
+ */
+static int pipeline_tags(PROV_CIPHER_PIPELINE *pipeline, const OSSL_PARAM *p,
+    int set)
+{
+    OSSL_PARAM tag[2] = { OSSL_PARAM_END, OSSL_PARAM_END };
+    unsigned char **tags = NULL;
+    size_t taglen, i;
+
+    if (pipeline == NULL || pipeline->numpipes == 0) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_NOT_SUPPORTED);
+        return 0;
+    }
+    if (!OSSL_PARAM_get_octet_ptr(p, (const void **)&tags, &taglen)
+        || tags == NULL) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+        return 0;
+    }
+
+    for (i = 0; i < pipeline->numpipes; i++) {
+        tag[0] = OSSL_PARAM_construct_octet_string(OSSL_CIPHER_PARAM_AEAD_TAG,
+            tags[i], taglen);
+        if (set ? !pipeline->ops->set_ctx_params(pipeline->pipes[i], tag)
+                : !pipeline->ops->get_ctx_params(pipeline->pipes[i], tag))
+            return 0;
+    }
+    return 1;
+}
+
+int ossl_cipher_pipeline_get_tags(PROV_CIPHER_PIPELINE *pipeline,
+    const OSSL_PARAM *p)
+{
+    return pipeline_tags(pipeline, p, 0);
+}
+
+int ossl_cipher_pipeline_set_tags(PROV_CIPHER_PIPELINE *pipeline,
+    const OSSL_PARAM *p)
+{
+    return pipeline_tags(pipeline, p, 1);
+}
+
+void ossl_cipher_pipeline_free(PROV_CIPHER_PIPELINE *pipeline)
+{
+    if (pipeline == NULL)
+        return;
+    ossl_cipher_pipeline_reset(pipeline);
+    OPENSSL_free(pipeline);
+}
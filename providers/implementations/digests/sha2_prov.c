@@ -287,18 +287,18 @@ IMPLEMENT_digest_functions_with_settable_ctx(
     sha1_settable_ctx_params, sha1_set_ctx_params)
 
 /* ossl_sha224_functions */
-IMPLEMENT_digest_functions_with_serialize(sha224, SHA256_CTX,
+IMPLEMENT_digest_functions_with_serialize_multi(sha224, SHA256_CTX,
     SHA256_CBLOCK, SHA224_DIGEST_LENGTH,
     SHA2_FLAGS, SHA224_Init,
     SHA256_Update_thunk, SHA224_Final,
-    SHA256_Serialize, SHA256_Deserialize)
+    SHA256_Serialize, SHA256_Deserialize, ossl_sha256_multi)
 
 /* ossl_sha256_functions */
-IMPLEMENT_digest_functions_with_serialize(sha256, SHA256_CTX,
+IMPLEMENT_digest_functions_with_serialize_multi(sha256, SHA256_CTX,
     SHA256_CBLOCK, SHA256_DIGEST_LENGTH,
     SHA2_FLAGS, SHA256_Init,
     SHA256_Update_thunk, SHA256_Final,
-    SHA256_Serialize, SHA256_Deserialize)
+    SHA256_Serialize, SHA256_Deserialize, ossl_sha256_multi)
 /* ossl_sha256_192_internal_functions */
 IMPLEMENT_digest_functions_with_serialize(sha256_192_internal, SHA256_CTX,
     SHA256_CBLOCK, SHA256_192_DIGEST_LENGTH,
@@ -306,18 +306,18 @@ IMPLEMENT_digest_functions_with_serialize(sha256_192_internal, SHA256_CTX,
     SHA256_Update_thunk, SHA256_Final,
     SHA256_Serialize, SHA256_Deserialize)
 /* ossl_sha384_functions */
-IMPLEMENT_digest_functions_with_serialize(sha384, SHA512_CTX,
+IMPLEMENT_digest_functions_with_serialize_multi(sha384, SHA512_CTX,
     SHA512_CBLOCK, SHA384_DIGEST_LENGTH,
     SHA2_FLAGS, SHA384_Init,
     SHA512_Update_thunk, SHA384_Final,
-    SHA512_Serialize, SHA512_Deserialize)
+    SHA512_Serialize, SHA512_Deserialize, ossl_sha512_multi)
 
 /* ossl_sha512_functions */
-IMPLEMENT_digest_functions_with_serialize(sha512, SHA512_CTX,
+IMPLEMENT_digest_functions_with_serialize_multi(sha512, SHA512_CTX,
     SHA512_CBLOCK, SHA512_DIGEST_LENGTH,
     SHA2_FLAGS, SHA512_Init,
     SHA512_Update_thunk, SHA512_Final,
-    SHA512_Serialize, SHA512_Deserialize)
+    SHA512_Serialize, SHA512_Deserialize, ossl_sha512_multi)
 
 /* ossl_sha512_224_functions */
 IMPLEMENT_digest_functions_with_serialize(sha512_224, SHA512_CTX,
@@ -411,4 +411,43 @@ int ossl_cipher_trailingdata(unsigned char *buf, size_t *buflen,
     size_t blocksize,
     const unsigned char **in, size_t *inlen);
 
+/*
+ * Generic support for the pipeline functions of AEAD ciphers. Each pipe is
+ * run as an independent operation on a copy of the keyed cipher context,
+ * using the functions of the cipher given in the PROV_CIPHER_PIPELINE_OPS.
+ * The copies are reused until ossl_cipher_pipeline_reset() is called, which
+ * ciphers do whenever their key is set.
+ */
+typedef struct prov_cipher_pipeline_st PROV_CIPHER_PIPELINE;
+
+typedef struct prov_cipher_pipeline_ops_st {
+    OSSL_FUNC_cipher_dupctx_fn *dupctx;
+    OSSL_FUNC_cipher_freectx_fn *freectx;
+    OSSL_FUNC_cipher_encrypt_init_fn *einit;
+    OSSL_FUNC_cipher_decrypt_init_fn *dinit;
+    OSSL_FUNC_cipher_update_fn *update;
+    OSSL_FUNC_cipher_final_fn *final;
+    OSSL_FUNC_cipher_get_ctx_params_fn *get_ctx_params;
+    OSSL_FUNC_cipher_set_ctx_params_fn *set_ctx_params;
+} PROV_CIPHER_PIPELINE_OPS;
+
+int ossl_cipher_pipeline_init(PROV_CIPHER_PIPELINE **pipeline,
+    const PROV_CIPHER_PIPELINE_OPS *ops, void *vctx,
+    const unsigned char *key, size_t keylen,
+    size_t numpipes, const unsigned char **iv,
+    size_t ivlen, const OSSL_PARAM params[], int enc);
+int ossl_cipher_pipeline_update(PROV_CIPHER_PIPELINE *pipeline,
+    size_t numpipes, unsigned char **out,
+    size_t *outl, const size_t *outsize,
+    const unsigned char **in, const size_t *inl);
+int ossl_cipher_pipeline_final(PROV_CIPHER_PIPELINE *pipeline,
+    size_t numpipes, unsigned char **out,
+    size_t *outl, const size_t *outsize);
+int ossl_cipher_pipeline_get_tags(PROV_CIPHER_PIPELINE *pipeline,
+    const OSSL_PARAM *p);
+int ossl_cipher_pipeline_set_tags(PROV_CIPHER_PIPELINE *pipeline,
+    const OSSL_PARAM *p);
+void ossl_cipher_pipeline_reset(PROV_CIPHER_PIPELINE *pipeline);
+void ossl_cipher_pipeline_free(PROV_CIPHER_PIPELINE *pipeline);
+
 #endif
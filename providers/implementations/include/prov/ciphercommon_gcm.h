@@ -83,6 +83,7 @@ typedef struct prov_gcm_ctx_st {
     const PROV_GCM_HW *hw; /* hardware specific methods */
     GCM128_CONTEXT gcm;
     ctr128_f ctr;
+    PROV_CIPHER_PIPELINE *pipeline; /* Set by the pipeline init functions */
 } PROV_GCM_CTX;
 
 PROV_CIPHER_FUNC(int, GCM_setkey, (PROV_GCM_CTX *ctx, const unsigned char *key, size_t keylen));
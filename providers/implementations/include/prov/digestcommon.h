@@ -58,10 +58,14 @@ extern "C" {
     if (!ossl_deferred_self_test(PROV_LIBCTX_OF(provctx), \
             ST_ID_DIGEST_##name))                         \
     return NULL
+#define DIGEST_PROV_RUNNING(provctx, name) \
+    (ossl_prov_is_running()                \
+        && ossl_deferred_self_test(PROV_LIBCTX_OF(provctx), ST_ID_DIGEST_##name))
 #else
 #define DIGEST_PROV_CHECK(_provctx, _name) \
     if (!ossl_prov_is_running())           \
     return NULL
+#define DIGEST_PROV_RUNNING(_provctx, _name) ossl_prov_is_running()
 #endif /* FIPS_MODULE && DIGEST_IS_FIPS */
 
 #define PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_START(                               \
@@ -156,6 +160,35 @@ extern "C" {
         { OSSL_FUNC_DIGEST_DESERIALIZE, (void (*)(void))deserialize },             \
         PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_END
 
+/*
+ * As above, with |multi| hashing many independent messages at once, see
+ * EVP_Digest_multi(3)
+ */
+#define IMPLEMENT_digest_functions_with_serialize_multi(                           \
+    name, CTX, blksize, dgstsize, flags, init, upd, fin,                           \
+    serialize, deserialize, multi)                                                 \
+    static OSSL_FUNC_digest_init_fn name##_internal_init;                          \
+    static int name##_internal_init(void *ctx, const OSSL_PARAM params[])          \
+    {                                                                              \
+        return ossl_prov_is_running() && init(ctx);                                \
+    }                                                                              \
+    static OSSL_FUNC_digest_digest_multi_fn name##_digest_multi;                   \
+    static int name##_digest_multi(void *provctx, size_t n,                        \
+        const unsigned char *const in[], const size_t inl[],                       \
+        unsigned char *const out[], size_t outsz)                                  \
+    {                                                                              \
+        return DIGEST_PROV_RUNNING(provctx, name)                                  \
+            && outsz >= dgstsize                                                   \
+            && multi(dgstsize, n, in, inl, out);                                   \
+    }                                                                              \
+    PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_START(name, CTX, blksize, dgstsize, flags, \
+        upd, fin),                                                                 \
+        { OSSL_FUNC_DIGEST_INIT, (void (*)(void))name##_internal_init },           \
+        { OSSL_FUNC_DIGEST_SERIALIZE, (void (*)(void))serialize },                 \
+        { OSSL_FUNC_DIGEST_DESERIALIZE, (void (*)(void))deserialize },             \
+        { OSSL_FUNC_DIGEST_DIGEST_MULTI, (void (*)(void))name##_digest_multi },    \
+        PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_END
+
 const OSSL_PARAM *ossl_digest_default_gettable_params(void *provctx);
 int ossl_digest_default_get_params(OSSL_PARAM params[], size_t blksz,
     size_t paramsz, unsigned long flags);
@@ -69,6 +69,11 @@ struct prov_drbg_st {
     OSSL_FUNC_rand_nonce_fn *parent_nonce;
     OSSL_FUNC_rand_get_seed_fn *parent_get_seed;
     OSSL_FUNC_rand_clear_seed_fn *parent_clear_seed;
+    /*
+     * Set when the parent is a DRBG of this provider, its reseed counter can
+     * then be read directly without taking the parent's lock.
+     */
+    PROV_DRBG *parent_drbg;
 
     /*
      * Stores the return value of openssl_get_fork_id() as of when we last
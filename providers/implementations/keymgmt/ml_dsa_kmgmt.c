@@ -34,6 +34,8 @@ static OSSL_FUNC_keymgmt_import_types_fn ml_dsa_import_types;
 static OSSL_FUNC_keymgmt_export_types_fn ml_dsa_export_types;
 static OSSL_FUNC_keymgmt_dup_fn ml_dsa_dup_key;
 static OSSL_FUNC_keymgmt_gettable_params_fn ml_dsa_gettable_params;
+static OSSL_FUNC_keymgmt_set_params_fn ml_dsa_set_params;
+static OSSL_FUNC_keymgmt_settable_params_fn ml_dsa_settable_params;
 static OSSL_FUNC_keymgmt_validate_fn ml_dsa_validate;
 static OSSL_FUNC_keymgmt_gen_init_fn ml_dsa_gen_init;
 static OSSL_FUNC_keymgmt_gen_cleanup_fn ml_dsa_gen_cleanup;
@@ -48,6 +50,7 @@ struct ml_dsa_gen_ctx {
     char *propq;
     uint8_t entropy[32];
     size_t entropy_len;
+    int precompute; /* -1 for the provider default */
 };
 
 #ifdef FIPS_MODULE
@@ -84,7 +87,7 @@ static int ml_dsa_pairwise_test(const ML_DSA_KEY *key)
     memset(rnd, 0, sizeof(rnd));
     memset(sig, 0, sizeof(sig));
 
-    if (ossl_ml_dsa_sign(key, 0, msg, sizeof(msg), NULL, 0, rnd, sizeof(rnd), 0,
+    if (ossl_ml_dsa_sign(key, 0, msg, sizeof(msg), NULL, 0, rnd, sizeof(rnd), 0, 0,
             sig, &sig_len, sizeof(sig))
         <= 0)
         goto err;
@@ -139,6 +142,12 @@ ML_DSA_KEY *ossl_prov_ml_dsa_new(PROV_CTX *ctx, const char *propq, int evp_type)
         else
             flags_clr |= ML_DSA_KEY_PREFER_SEED;
 
+        if (ossl_prov_ctx_get_bool_param(
+                ctx, OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE, 0))
+            flags_set |= ML_DSA_KEY_PRECOMPUTE;
+        else
+            flags_clr |= ML_DSA_KEY_PRECOMPUTE;
+
         ossl_ml_dsa_set_prekey(key, flags_set, flags_clr, NULL, 0, NULL, 0);
     }
     return key;
@@ -396,6 +405,32 @@ static int ml_dsa_get_params(void *keydata, OSSL_PARAM params[])
      */
     if (p.dgstp != NULL && !OSSL_PARAM_set_utf8_string(p.dgstp, ""))
         return 0;
+
+    if (p.precompute != NULL
+        && !OSSL_PARAM_set_int(p.precompute,
+            (ossl_ml_dsa_key_get_prov_flags(key) & ML_DSA_KEY_PRECOMPUTE) != 0))
+        return 0;
+    return 1;
+}
+
+static const OSSL_PARAM *ml_dsa_settable_params(void *provctx)
+{
+    return ml_dsa_set_params_list;
+}
+
+static int ml_dsa_set_params(void *keydata, const OSSL_PARAM params[])
+{
+    ML_DSA_KEY *key = keydata;
+    struct ml_dsa_set_params_st p;
+    int precompute;
+
+    if (key == NULL || !ml_dsa_set_params_decoder(params, &p))
+        return 0;
+
+    if (p.precompute != NULL
+        && (!OSSL_PARAM_get_int(p.precompute, &precompute)
+            || !ossl_ml_dsa_key_set_precompute(key, precompute != 0)))
+        return 0;
     return 1;
 }
 
@@ -489,6 +524,7 @@ static void *ml_dsa_gen_init(void *provctx, int selection,
 
     if ((gctx = OPENSSL_zalloc(sizeof(*gctx))) != NULL) {
         gctx->provctx = provctx;
+        gctx->precompute = -1;
         if (!ml_dsa_gen_set_params(gctx, params)) {
             OPENSSL_free(gctx);
             gctx = NULL;
@@ -511,6 +547,9 @@ static void *ml_dsa_gen(void *genctx, int evp_type)
         && !ossl_ml_dsa_set_prekey(key, 0, 0,
             gctx->entropy, gctx->entropy_len, NULL, 0))
         goto err;
+    if (gctx->precompute >= 0
+        && !ossl_ml_dsa_key_set_precompute(key, gctx->precompute))
+        goto err;
     if (!ossl_ml_dsa_generate_key(key)) {
         ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GENERATE_KEY);
         goto err;
@@ -549,6 +588,12 @@ static int ml_dsa_gen_set_params(void *genctx, const OSSL_PARAM params[])
         if (!OSSL_PARAM_get_utf8_string(p.propq, &gctx->propq, 0))
             return 0;
     }
+
+    if (p.precompute != NULL) {
+        if (!OSSL_PARAM_get_int(p.precompute, &gctx->precompute))
+            return 0;
+        gctx->precompute = gctx->precompute != 0;
+    }
     return 1;
 }
 
@@ -599,6 +644,8 @@ static void ml_dsa_gen_cleanup(void *genctx)
         { OSSL_FUNC_KEYMGMT_EXPORT_TYPES, (void (*)(void))ml_dsa_export_types },              \
         DISPATCH_LOAD_FN { OSSL_FUNC_KEYMGMT_GET_PARAMS, (void (*)(void))ml_dsa_get_params }, \
         { OSSL_FUNC_KEYMGMT_GETTABLE_PARAMS, (void (*)(void))ml_dsa_gettable_params },        \
+        { OSSL_FUNC_KEYMGMT_SET_PARAMS, (void (*)(void))ml_dsa_set_params },                  \
+        { OSSL_FUNC_KEYMGMT_SETTABLE_PARAMS, (void (*)(void))ml_dsa_settable_params },        \
         { OSSL_FUNC_KEYMGMT_VALIDATE, (void (*)(void))ml_dsa_validate },                      \
         { OSSL_FUNC_KEYMGMT_GEN_INIT, (void (*)(void))ml_dsa_gen_init },                      \
         { OSSL_FUNC_KEYMGMT_GEN, (void (*)(void))ml_dsa_##alg##_gen },                        \
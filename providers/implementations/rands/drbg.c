@@ -112,6 +112,17 @@ static unsigned int get_parent_reseed_count(PROV_DRBG *drbg)
     void *parent = drbg->parent;
     unsigned int r = 0;
 
+#ifndef TSAN_REQUIRES_LOCKING
+    /*
+     * The reseed counter acts as a generation number, it is only ever stored
+     * atomically once a reseed has completed.  Reading a stale value only
+     * delays the propagation of a reseed, so there is no need to serialise
+     * all children on the parent's lock for every generate call.
+     */
+    if (drbg->parent_drbg != NULL)
+        return tsan_load(&drbg->parent_drbg->reseed_counter);
+#endif
+
     *params = OSSL_PARAM_construct_uint(OSSL_DRBG_PARAM_RESEED_COUNTER, &r);
     if (!ossl_drbg_lock_parent(drbg)) {
         ERR_raise(ERR_LIB_PROV, PROV_R_UNABLE_TO_LOCK_PARENT);
@@ -829,6 +840,8 @@ PROV_DRBG *ossl_rand_drbg_new(void *provctx, void *parent, const OSSL_DISPATCH *
         drbg->parent_get_seed = OSSL_FUNC_rand_get_seed(pfunc);
     if ((pfunc = find_call(p_dispatch, OSSL_FUNC_RAND_CLEAR_SEED)) != NULL)
         drbg->parent_clear_seed = OSSL_FUNC_rand_clear_seed(pfunc);
+    if (parent != NULL && drbg->parent_get_seed == ossl_drbg_get_seed)
+        drbg->parent_drbg = parent;
 
     /* Set some default maximums up */
     drbg->max_entropylen = DRBG_MAX_LENGTH;
@@ -60,6 +60,7 @@ typedef struct {
     size_t test_entropy_len;
     int msg_encode;
     int deterministic;
+    uint32_t threads;
     int evp_type;
     /* The Algorithm Identifier of the signature algorithm */
     uint8_t aid_buf[OSSL_MAX_ALGORITHM_ID_SIZE];
@@ -285,7 +286,7 @@ static int ml_dsa_sign_msg_final(void *vctx, unsigned char *sig,
     }
 
     ret = ossl_ml_dsa_sign(ctx->key, 1, mu, sizeof(mu), NULL, 0, rnd,
-        sizeof(rand_tmp), 0, sig, siglen, sigsize);
+        sizeof(rand_tmp), 0, ctx->threads, sig, siglen, sigsize);
     if (rnd != ctx->test_entropy)
         OPENSSL_cleanse(rand_tmp, sizeof(rand_tmp));
     return ret;
@@ -315,7 +316,7 @@ static int ml_dsa_sign(void *vctx, uint8_t *sig, size_t *siglen, size_t sigsize,
     }
     ret = ossl_ml_dsa_sign(ctx->key, ctx->mu, msg, msg_len,
         ctx->context_string, ctx->context_string_len,
-        rnd, sizeof(rand_tmp), ctx->msg_encode,
+        rnd, sizeof(rand_tmp), ctx->msg_encode, ctx->threads,
         sig, siglen, sigsize);
     if (rnd != ctx->test_entropy)
         OPENSSL_cleanse(rand_tmp, sizeof(rand_tmp));
@@ -416,6 +417,9 @@ static int ml_dsa_set_ctx_params(void *vctx, const OSSL_PARAM params[])
     if (p.mu != NULL && !OSSL_PARAM_get_int(p.mu, &pctx->mu))
         return 0;
 
+    if (p.threads != NULL && !OSSL_PARAM_get_uint32(p.threads, &pctx->threads))
+        return 0;
+
     if (p.sig != NULL && pctx->operation == EVP_PKEY_OP_VERIFYMSG) {
         OPENSSL_free(pctx->sig);
         pctx->sig = NULL;
@@ -66,6 +66,7 @@ typedef struct {
     size_t add_random_len;
     int msg_encode;
     int deterministic;
+    uint32_t threads;
     OSSL_LIB_CTX *libctx;
     char *propq;
     const char *alg;
@@ -237,6 +238,7 @@ static int slh_dsa_sign(void *vctx, unsigned char *sig, size_t *siglen,
             opt_rand = add_rand;
         }
     }
+    ossl_slh_dsa_hash_ctx_set_threads(ctx->hash_ctx, ctx->threads);
     ret = ossl_slh_dsa_sign(ctx->hash_ctx, msg, msg_len,
         ctx->context_string, ctx->context_string_len,
         opt_rand, ctx->msg_encode,
@@ -311,6 +313,9 @@ static int slh_dsa_set_ctx_params(void *vctx, const OSSL_PARAM params[])
 
     if (p.msgenc != NULL && !OSSL_PARAM_get_int(p.msgenc, &pctx->msg_encode))
         return 0;
+
+    if (p.threads != NULL && !OSSL_PARAM_get_uint32(p.threads, &pctx->threads))
+        return 0;
     return 1;
 }
 
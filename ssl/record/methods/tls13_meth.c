@@ -84,6 +84,149 @@ end:
     return OSSL_RECORD_RETURN_SUCCESS;
 }
 
+/*
+ * Set up the nonce for the next record: the static IV XORed with the
+ * sequence number, which is then incremented. Calls RLAYERfatal on error.
+ */
+static int tls13_set_nonce(OSSL_RECORD_LAYER *rl, unsigned char *nonce,
+    size_t nonce_len)
+{
+    unsigned char *staticiv = rl->iv;
+    unsigned char *seq = rl->sequence;
+    size_t offset, loop;
+
+    if (nonce_len < SEQ_NUM_SIZE) {
+        /* Should not happen */
+        RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+        return 0;
+    }
+    offset = nonce_len - SEQ_NUM_SIZE;
+    memcpy(nonce, staticiv, offset);
+    for (loop = 0; loop < SEQ_NUM_SIZE; loop++)
+        nonce[offset + loop] = staticiv[offset + loop] ^ seq[loop];
+
+    /* RLAYERfatal already called on failure */
+    return tls_increment_sequence_ctr(rl);
+}
+
+/* Write the AAD for |rec| into |recheader|. Calls RLAYERfatal on error. */
+static int tls13_set_aad(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *rec,
+    unsigned char *recheader)
+{
+    WPACKET wpkt;
+    size_t hdrlen;
+
+    if (!WPACKET_init_static_len(&wpkt, recheader, SSL3_RT_HEADER_LENGTH, 0)
+        || !WPACKET_put_bytes_u8(&wpkt, rec->type)
+        || !WPACKET_put_bytes_u16(&wpkt, rec->rec_version)
+        || !WPACKET_put_bytes_u16(&wpkt, rec->length + rl->taglen)
+        || !WPACKET_get_total_written(&wpkt, &hdrlen)
+        || hdrlen != SSL3_RT_HEADER_LENGTH
+        || !WPACKET_finish(&wpkt)) {
+        RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+        WPACKET_cleanup(&wpkt);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Encrypt |n_recs| records with one set of calls to the pipeline functions of
+ * the cipher. Every record has its own nonce, so the provider is free to
+ * process them in parallel. Records are only ever decrypted one at a time,
+ * see tls13_get_max_records(). Calls RLAYERfatal on error.
+ */
+static int tls13_encrypt_pipeline(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *recs,
+    size_t n_recs, size_t nonce_len)
+{
+    EVP_CIPHER_CTX *enc_ctx = rl->enc_ctx;
+    unsigned char nonces[SSL_MAX_PIPELINES][EVP_MAX_IV_LENGTH];
+    unsigned char recheaders[SSL_MAX_PIPELINES][SSL3_RT_HEADER_LENGTH];
+    const unsigned char *ivs[SSL_MAX_PIPELINES], *aad[SSL_MAX_PIPELINES];
+    const unsigned char *in[SSL_MAX_PIPELINES];
+    unsigned char *out[SSL_MAX_PIPELINES], *tags[SSL_MAX_PIPELINES];
+    unsigned char **tagp = tags;
+    size_t aadlen[SSL_MAX_PIPELINES], inl[SSL_MAX_PIPELINES];
+    size_t outl[SSL_MAX_PIPELINES], outsize[SSL_MAX_PIPELINES];
+    size_t finall[SSL_MAX_PIPELINES];
+    OSSL_PARAM params[2] = { OSSL_PARAM_END, OSSL_PARAM_END };
+    TLS_RL_RECORD *rec;
+    size_t i;
+
+    if (n_recs > SSL_MAX_PIPELINES || nonce_len > EVP_MAX_IV_LENGTH) {
+        /* Should not happen */
+        RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+        return 0;
+    }
+
+    for (i = 0; i < n_recs; i++) {
+        rec = &recs[i];
+
+        /* Plaintext alerts are never pipelined */
+        if (rec->type == SSL3_RT_ALERT) {
+            RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+            return 0;
+        }
+
+        if (!tls13_set_nonce(rl, nonces[i], nonce_len)
+            || !tls13_set_aad(rl, rec, recheaders[i])) {
+            /* RLAYERfatal already called */
+            return 0;
+        }
+
+        ivs[i] = nonces[i];
+        aad[i] = recheaders[i];
+        aadlen[i] = SSL3_RT_HEADER_LENGTH;
+        in[i] = rec->input;
+        inl[i] = rec->length;
+        out[i] = rec->data;
+        outsize[i] = rec->length;
+        tags[i] = rec->data + rec->length;
+    }
+
+    if (EVP_CipherPipelineEncryptInit(enc_ctx, NULL, NULL, 0, n_recs, ivs,
+            nonce_len)
+            <= 0
+        || EVP_CipherPipelineUpdate(enc_ctx, NULL, outl, NULL, aad, aadlen) <= 0
+        || EVP_CipherPipelineUpdate(enc_ctx, out, outl, outsize, in, inl) <= 0) {
+        RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+        return 0;
+    }
+
+    for (i = 0; i < n_recs; i++) {
+        if (outl[i] > recs[i].length) {
+            RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+            return 0;
+        }
+        out[i] += outl[i];
+        outsize[i] -= outl[i];
+    }
+
+    if (EVP_CipherPipelineFinal(enc_ctx, out, finall, outsize) <= 0) {
+        RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+        return 0;
+    }
+
+    for (i = 0; i < n_recs; i++) {
+        if (outl[i] + finall[i] != recs[i].length) {
+            RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+            return 0;
+        }
+    }
+
+    /* Add the tags */
+    params[0] = OSSL_PARAM_construct_octet_ptr(OSSL_CIPHER_PARAM_PIPELINE_AEAD_TAG,
+        (void **)&tagp, rl->taglen);
+    if (EVP_CIPHER_CTX_get_params(enc_ctx, params) <= 0) {
+        RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+        return 0;
+    }
+    for (i = 0; i < n_recs; i++)
+        recs[i].length += rl->taglen;
+
+    return 1;
+}
+
 static int tls13_cipher(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *recs,
     size_t n_recs, int sending, SSL_MAC_BUF *mac,
     size_t macsize)
@@ -91,27 +234,25 @@ static int tls13_cipher(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *recs,
     EVP_CIPHER_CTX *enc_ctx;
     unsigned char recheader[SSL3_RT_HEADER_LENGTH];
     unsigned char tag[EVP_MAX_MD_SIZE];
-    size_t nonce_len, offset, loop, hdrlen, taglen;
-    unsigned char *staticiv;
+    size_t nonce_len, taglen;
     unsigned char *nonce;
-    unsigned char *seq = rl->sequence;
     int lenu, lenf;
     TLS_RL_RECORD *rec = &recs[0];
-    WPACKET wpkt;
     const EVP_CIPHER *cipher;
     EVP_MAC_CTX *mac_ctx = NULL;
     int mode;
 
-    if (n_recs != 1) {
+    enc_ctx = rl->enc_ctx; /* enc_ctx is ignored when rl->mac_ctx != NULL */
+    nonce = rl->nonce;
+
+    /* Only writes with a pipeline capable cipher pass several records */
+    if (n_recs == 0
+        || (n_recs > 1 && (!sending || enc_ctx == NULL || rl->mac_ctx != NULL))) {
         /* Should not happen */
         RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
         return 0;
     }
 
-    enc_ctx = rl->enc_ctx; /* enc_ctx is ignored when rl->mac_ctx != NULL */
-    staticiv = rl->iv;
-    nonce = rl->nonce;
-
     if (enc_ctx == NULL && rl->mac_ctx == NULL) {
         RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
         return 0;
@@ -143,6 +284,9 @@ static int tls13_cipher(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *recs,
         nonce_len = (size_t)ivlen;
     }
 
+    if (n_recs > 1)
+        return tls13_encrypt_pipeline(rl, recs, n_recs, nonce_len);
+
     if (!sending) {
         /*
          * Take off tag. There must be at least one byte of content type as
@@ -154,31 +298,14 @@ static int tls13_cipher(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *recs,
     }
 
     /* Set up nonce: part of static IV followed by sequence number */
-    if (nonce_len < SEQ_NUM_SIZE) {
-        /* Should not happen */
-        RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
-        return 0;
-    }
-    offset = nonce_len - SEQ_NUM_SIZE;
-    memcpy(nonce, staticiv, offset);
-    for (loop = 0; loop < SEQ_NUM_SIZE; loop++)
-        nonce[offset + loop] = staticiv[offset + loop] ^ seq[loop];
-
-    if (!tls_increment_sequence_ctr(rl)) {
+    if (!tls13_set_nonce(rl, nonce, nonce_len)) {
         /* RLAYERfatal already called */
         return 0;
     }
 
     /* Set up the AAD */
-    if (!WPACKET_init_static_len(&wpkt, recheader, sizeof(recheader), 0)
-        || !WPACKET_put_bytes_u8(&wpkt, rec->type)
-        || !WPACKET_put_bytes_u16(&wpkt, rec->rec_version)
-        || !WPACKET_put_bytes_u16(&wpkt, rec->length + rl->taglen)
-        || !WPACKET_get_total_written(&wpkt, &hdrlen)
-        || hdrlen != SSL3_RT_HEADER_LENGTH
-        || !WPACKET_finish(&wpkt)) {
-        RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
-        WPACKET_cleanup(&wpkt);
+    if (!tls13_set_aad(rl, rec, recheader)) {
+        /* RLAYERfatal already called */
         return 0;
     }
 
@@ -253,6 +380,33 @@ static int tls13_cipher(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *recs,
     return 1;
 }
 
+/*
+ * Application data can be split over several records which are encrypted
+ * together if the cipher supports pipelining. Reading is always done one
+ * record at a time: the real content type of a record is only known after
+ * decrypting it, and a KeyUpdate changes the key for the records after it.
+ */
+static size_t tls13_get_max_records(OSSL_RECORD_LAYER *rl, uint8_t type,
+    size_t len, size_t maxfrag,
+    size_t *preffrag)
+{
+    const EVP_CIPHER *cipher;
+    size_t pipes;
+
+    if (rl->max_pipelines <= 1
+        || type != SSL3_RT_APPLICATION_DATA
+        || len == 0
+        || rl->enc_ctx == NULL
+        || rl->mac_ctx != NULL
+        || (cipher = EVP_CIPHER_CTX_get0_cipher(rl->enc_ctx)) == NULL
+        || !EVP_CIPHER_can_pipeline(cipher, 1))
+        return 1;
+
+    pipes = ((len - 1) / *preffrag) + 1;
+
+    return (pipes < rl->max_pipelines) ? pipes : rl->max_pipelines;
+}
+
 static int tls13_validate_record_header(OSSL_RECORD_LAYER *rl,
     TLS_RL_RECORD *rec)
 {
@@ -419,7 +573,7 @@ const struct record_functions_st tls_1_3_funcs = {
     tls_get_more_records,
     tls13_validate_record_header,
     tls13_post_process_record,
-    tls_get_max_records_default,
+    tls13_get_max_records,
     tls_write_records_default,
     tls_allocate_write_buffers_default,
     tls_initialise_write_packets_default,
@@ -48,6 +48,7 @@ int RECORD_LAYER_clear(RECORD_LAYER *rl)
     rl->alert_count = 0;
     rl->num_recs = 0;
     rl->curr_rec = 0;
+    rl->borrowed = 0;
 
     BIO_free(rl->rrlnext);
     rl->rrlnext = NULL;
@@ -594,6 +595,48 @@ int ssl_release_record(SSL_CONNECTION *s, TLS_RECORD *rr, size_t length)
     return 1;
 }
 
+/*
+ * Hand out the unread plaintext of the current record without copying it.
+ * The caller must have made sure that this is application data, for example
+ * by peeking at it with ssl3_read_bytes().
+ */
+int ssl3_read_borrow(SSL_CONNECTION *s, const unsigned char **data,
+    size_t *len)
+{
+    TLS_RECORD *rr;
+
+    if (s->rlayer.curr_rec >= s->rlayer.num_recs) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_INTERNAL_ERROR);
+        return 0;
+    }
+    rr = &s->rlayer.tlsrecs[s->rlayer.curr_rec];
+    if (rr->type != SSL3_RT_APPLICATION_DATA || rr->length == 0) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_INTERNAL_ERROR);
+        return 0;
+    }
+
+    *data = &rr->data[rr->off];
+    *len = s->rlayer.borrowed = rr->length;
+    return 1;
+}
+
+/*
+ * Consume |len| bytes of the plaintext handed out by ssl3_read_borrow(). Once
+ * all of it has been consumed the record is given back to the record layer.
+ */
+int ssl3_read_release(SSL_CONNECTION *s, size_t len)
+{
+    if (len > s->rlayer.borrowed) {
+        ERR_raise(ERR_LIB_SSL, SSL_R_BAD_LENGTH);
+        return 0;
+    }
+    if (len == 0)
+        return 1;
+
+    s->rlayer.borrowed -= len;
+    return ssl_release_record(s, &s->rlayer.tlsrecs[s->rlayer.curr_rec], len);
+}
+
 /*-
  * Return up to 'len' payload bytes received in 'type' records.
  * 'type' is one of the following:
@@ -636,6 +679,8 @@ int ssl3_read_bytes(SSL *ssl, uint8_t type, uint8_t *recvd_type,
     SSL_CONNECTION *s = SSL_CONNECTION_FROM_SSL_ONLY(ssl);
 
     is_tls13 = SSL_CONNECTION_IS_TLS13(s);
+    /* Any read invalidates plaintext handed out by SSL_read_borrow() */
+    s->rlayer.borrowed = 0;
 
     if ((type != 0
             && (type != SSL3_RT_APPLICATION_DATA)
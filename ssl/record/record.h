@@ -126,6 +126,8 @@ typedef struct record_layer_st {
     size_t curr_rec;
     /* Record layer data to be processed */
     TLS_RECORD tlsrecs[SSL_MAX_PIPELINES];
+    /* Bytes of tlsrecs[curr_rec] handed out by SSL_read_borrow() */
+    size_t borrowed;
 
 } RECORD_LAYER;
 
@@ -146,6 +148,9 @@ int RECORD_LAYER_read_pending(const RECORD_LAYER *rl);
 int RECORD_LAYER_processed_read_pending(const RECORD_LAYER *rl);
 int RECORD_LAYER_write_pending(const RECORD_LAYER *rl);
 __owur size_t ssl3_pending(const SSL *s);
+__owur int ssl3_read_borrow(SSL_CONNECTION *s, const unsigned char **data,
+    size_t *len);
+__owur int ssl3_read_release(SSL_CONNECTION *s, size_t len);
 __owur int ssl3_write_bytes(SSL *s, uint8_t type, const void *buf, size_t len,
     size_t *written);
 __owur int ssl3_read_bytes(SSL *s, uint8_t type, uint8_t *recvd_type,
@@ -1,5 +1,5 @@
 /*
- * Copyright 1995-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 1995-2026 The OpenSSL Project Authors. All Rights Reserved.
  * Copyright 2005 Nokia. All rights reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
@@ -45,7 +45,7 @@ void ssl3_free_digest_list(SSL_CONNECTION *s)
 {
     BIO_free(s->s3.handshake_buffer);
     s->s3.handshake_buffer = NULL;
-    EVP_MD_CTX_free(s->s3.handshake_dgst);
+    ssl_ctx_pool_put_md(s->session_ctx, s->s3.handshake_dgst);
     s->s3.handshake_dgst = NULL;
 }
 
@@ -87,18 +87,18 @@ int ssl3_digest_cached_records(SSL_CONNECTION *s, int keep)
             return 0;
         }
 
-        s->s3.handshake_dgst = EVP_MD_CTX_new();
-        if (s->s3.handshake_dgst == NULL) {
-            SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_EVP_LIB);
-            return 0;
-        }
-
         md = ssl_handshake_md(s);
         if (md == NULL) {
             SSLfatal(s, SSL_AD_INTERNAL_ERROR,
                 SSL_R_NO_SUITABLE_DIGEST_ALGORITHM);
             return 0;
         }
+
+        s->s3.handshake_dgst = ssl_ctx_pool_get_md(s->session_ctx, md);
+        if (s->s3.handshake_dgst == NULL) {
+            SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_EVP_LIB);
+            return 0;
+        }
         if (!EVP_DigestInit_ex(s->s3.handshake_dgst, md, NULL)
             || !EVP_DigestUpdate(s->s3.handshake_dgst, hdata, hdatalen)) {
             SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
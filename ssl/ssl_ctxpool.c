@@ -0,0 +1,217 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include "ssl_local.h"
+
+/*
+ * Pools of keyless EVP_MD_CTX and EVP_CIPHER_CTX objects owned by an SSL_CTX.
+ *
+ * Every handshake creates and frees a handful of digest contexts for the
+ * transcript hash and a few cipher contexts for session tickets. With a pool
+ * configured those contexts are handed back to the SSL_CTX when a connection
+ * is done with them instead of being freed, and the next connection picks
+ * them up again.
+ *
+ * Contexts keep their algorithm and provider context, so that initialising
+ * them again for the same algorithm does not allocate anything. Whoever takes
+ * one from the pool initialises it before use, which also wipes what was left
+ * in it. Digest contexts with an EVP_PKEY_CTX attached are never pooled.
+ *
+ * The pool only exists while its size is non-zero. Each pool is a fixed
+ * array of slots that are claimed and filled with atomic compare and
+ * exchange, so connections running on different threads never wait for each
+ * other. Digest contexts start their search at a slot derived from the
+ * digest, which keeps contexts for the same digest together.
+ */
+
+struct ssl_ctx_pool_st {
+    size_t max;
+    void **md;
+    void **cipher;
+    /* Only used where the platform lacks atomic pointer operations */
+    CRYPTO_RWLOCK *lock;
+};
+
+static SSL_CTX_POOL *pool_new(size_t max)
+{
+    SSL_CTX_POOL *pool = OPENSSL_zalloc(sizeof(*pool));
+
+    if (pool == NULL)
+        return NULL;
+    pool->max = max;
+    if ((pool->md = OPENSSL_calloc(max, sizeof(*pool->md))) == NULL
+        || (pool->cipher = OPENSSL_calloc(max, sizeof(*pool->cipher))) == NULL
+        || (pool->lock = CRYPTO_THREAD_lock_new()) == NULL) {
+        OPENSSL_free(pool->md);
+        OPENSSL_free(pool->cipher);
+        OPENSSL_free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void ssl_ctx_pool_free(SSL_CTX_POOL *pool)
+{
+    size_t i;
+
+    if (pool == NULL)
+        return;
+    for (i = 0; i < pool->max; i++) {
+        EVP_MD_CTX_free(pool->md[i]);
+        EVP_CIPHER_CTX_free(pool->cipher[i]);
+    }
+    OPENSSL_free(pool->md);
+    OPENSSL_free(pool->cipher);
+    CRYPTO_THREAD_lock_free(pool->lock);
+    OPENSSL_free(pool);
+}
+
+/* Take an object out of |slots|, searching from |start| on */
+static void *pool_take(SSL_CTX_POOL *pool, void **slots, size_t start)
+{
+    size_t i, n;
+    void *obj;
+
+    for (n = 0, i = start; n < pool->max; n++, i = i + 1 < pool->max ? i + 1 : 0)
+        if (CRYPTO_atomic_load_ptr(&slots[i], &obj, pool->lock)
+            && obj != NULL
+            && CRYPTO_atomic_cmp_exch_ptr(&slots[i], &obj, NULL, pool->lock,
+                NULL))
+            return obj;
+    return NULL;
+}
+
+/* Put |obj| into a free slot of |slots|, searching from |start| on */
+static int pool_give(SSL_CTX_POOL *pool, void **slots, size_t start, void *obj)
+{
+    size_t i, n;
+    void *cur;
+
+    for (n = 0, i = start; n < pool->max; n++, i = i + 1 < pool->max ? i + 1 : 0)
+        if (CRYPTO_atomic_load_ptr(&slots[i], &cur, pool->lock)
+            && cur == NULL
+            && CRYPTO_atomic_cmp_exch_ptr(&slots[i], &cur, obj, pool->lock,
+                NULL))
+            return 1;
+    return 0;
+}
+
+static size_t pool_md_start(const SSL_CTX_POOL *pool, const EVP_MD *md)
+{
+    return (size_t)(((uintptr_t)md >> 4) % pool->max);
+}
+
+/*
+ * Set the maximum number of contexts of each kind kept by |ctx|, creating or
+ * freeing its pool as needed. Returns the previous maximum or -1 on error.
+ * The contexts already pooled are kept as far as they fit.
+ */
+long ssl_ctx_pool_set_size(SSL_CTX *ctx, size_t max)
+{
+    SSL_CTX_POOL *old = ctx->ctx_pool, *pool = NULL;
+    size_t i, old_max = old != NULL ? old->max : 0;
+    void *obj;
+
+    if (max == old_max)
+        return (long)old_max;
+    if (max > 0 && (pool = pool_new(max)) == NULL)
+        return -1;
+
+    for (i = 0; i < old_max; i++) {
+        if ((obj = old->md[i]) != NULL && pool != NULL
+            && pool_give(pool, pool->md,
+                pool_md_start(pool, EVP_MD_CTX_get0_md(obj)), obj))
+            old->md[i] = NULL;
+        if ((obj = old->cipher[i]) != NULL && pool != NULL
+            && pool_give(pool, pool->cipher, 0, obj))
+            old->cipher[i] = NULL;
+    }
+    ctx->ctx_pool = pool;
+    ssl_ctx_pool_free(old);
+
+    return (long)old_max;
+}
+
+long ssl_ctx_pool_get_size(const SSL_CTX *ctx)
+{
+    return ctx->ctx_pool != NULL ? (long)ctx->ctx_pool->max : 0;
+}
+
+/*
+ * Get a digest context from the pool of |ctx|, preferring one that was last
+ * used with |md|. The caller still has to initialise it for its digest.
+ */
+EVP_MD_CTX *ssl_ctx_pool_get_md(SSL_CTX *ctx, const EVP_MD *md)
+{
+    SSL_CTX_POOL *pool = ctx->ctx_pool;
+    EVP_MD_CTX *mctx;
+
+    if (pool == NULL)
+        return EVP_MD_CTX_new();
+
+    if ((mctx = pool_take(pool, pool->md, pool_md_start(pool, md))) != NULL) {
+        ssl_tsan_counter(ctx, &ctx->stats.ctx_pool_hit);
+        return mctx;
+    }
+    ssl_tsan_counter(ctx, &ctx->stats.ctx_pool_miss);
+    return EVP_MD_CTX_new();
+}
+
+/* Give a digest context back to |ctx|, or free it if it can't be pooled */
+void ssl_ctx_pool_put_md(SSL_CTX *ctx, EVP_MD_CTX *mctx)
+{
+    SSL_CTX_POOL *pool = ctx != NULL ? ctx->ctx_pool : NULL;
+
+    if (pool == NULL
+        || mctx == NULL
+        || EVP_MD_CTX_get_pkey_ctx(mctx) != NULL
+        || !pool_give(pool, pool->md,
+            pool_md_start(pool, EVP_MD_CTX_get0_md(mctx)), mctx))
+        EVP_MD_CTX_free(mctx);
+}
+
+EVP_CIPHER_CTX *ssl_ctx_pool_get_cipher(SSL_CTX *ctx)
+{
+    SSL_CTX_POOL *pool = ctx->ctx_pool;
+    EVP_CIPHER_CTX *cctx;
+
+    if (pool == NULL)
+        return EVP_CIPHER_CTX_new();
+
+    if ((cctx = pool_take(pool, pool->cipher, 0)) != NULL) {
+        ssl_tsan_counter(ctx, &ctx->stats.ctx_pool_hit);
+        return cctx;
+    }
+    ssl_tsan_counter(ctx, &ctx->stats.ctx_pool_miss);
+    return EVP_CIPHER_CTX_new();
+}
+
+/* Give a cipher context back to |ctx|, or free it if it can't be pooled */
+void ssl_ctx_pool_put_cipher(SSL_CTX *ctx, EVP_CIPHER_CTX *cctx)
+{
+    SSL_CTX_POOL *pool = ctx != NULL ? ctx->ctx_pool : NULL;
+
+    if (pool == NULL
+        || cctx == NULL
+        || !pool_give(pool, pool->cipher, 0, cctx))
+        EVP_CIPHER_CTX_free(cctx);
+}
+
+/*
+ * Initialise the pooled cipher context |cctx| for |cipher|. If it was last
+ * used with |cipher| only the key and IV are set, so that the provider
+ * context is reused rather than freed and created again.
+ */
+int ssl_ctx_pool_cipher_init(EVP_CIPHER_CTX *cctx, const EVP_CIPHER *cipher,
+    const unsigned char *key, const unsigned char *iv, int enc)
+{
+    if (EVP_CIPHER_CTX_get0_cipher(cctx) == cipher)
+        cipher = NULL;
+    return EVP_CipherInit_ex(cctx, cipher, NULL, key, iv, enc);
+}
@@ -750,6 +750,7 @@ SSL *ossl_ssl_connection_new_int(SSL_CTX *ctx, SSL *user_ssl,
 
     s->mode = ctx->mode;
     s->max_cert_list = ctx->max_cert_list;
+    s->hs_arena_size = ctx->hs_arena_size;
     s->max_early_data = ctx->max_early_data;
     s->recv_max_early_data = ctx->recv_max_early_data;
 
@@ -1082,6 +1083,7 @@ int SSL_has_matching_session_id(const SSL *ssl, const unsigned char *id,
      * by this SSL.
      */
     SSL_SESSION r, *p;
+    SSL_SESSION_CACHE *cache;
     const SSL_CONNECTION *sc = SSL_CONNECTION_FROM_CONST_SSL(ssl);
 
     if (sc == NULL || id_len > sizeof(r.session_id))
@@ -1091,10 +1093,11 @@ int SSL_has_matching_session_id(const SSL *ssl, const unsigned char *id,
     r.session_id_length = id_len;
     memcpy(r.session_id, id, id_len);
 
-    if (!CRYPTO_THREAD_read_lock(sc->session_ctx->lock))
+    cache = ssl_session_cache_get(sc->session_ctx, id, id_len);
+    if (!CRYPTO_THREAD_read_lock(cache->lock))
         return 0;
-    p = lh_SSL_SESSION_retrieve(sc->session_ctx->sessions, &r);
-    CRYPTO_THREAD_unlock(sc->session_ctx->lock);
+    p = lh_SSL_SESSION_retrieve(cache->sessions, &r);
+    CRYPTO_THREAD_unlock(cache->lock);
     return (p != NULL);
 }
 
@@ -1517,7 +1520,14 @@ void ossl_ssl_connection_free(SSL *ssl)
     /* Free up if allocated */
 
     OPENSSL_free(s->ext.hostname);
+    /*
+     * The handshake digest goes back to the pool of session_ctx, so give it
+     * back while we still hold our reference: after SSL_set_SSL_CTX() it may
+     * be the last one.
+     */
+    ssl3_free_digest_list(s);
     SSL_CTX_free(s->session_ctx);
+    s->session_ctx = NULL;
     OPENSSL_free(s->ext.peer_ecpointformats);
     OPENSSL_free(s->ext.supportedgroups);
     OPENSSL_free(s->ext.keyshares);
@@ -1541,8 +1551,8 @@ void ossl_ssl_connection_free(SSL *ssl)
     OPENSSL_free(s->ext.alpn);
     OPENSSL_free(s->ext.tls13_cookie);
     if (s->clienthello != NULL)
-        OPENSSL_free(s->clienthello->pre_proc_exts);
-    OPENSSL_free(s->clienthello);
+        ssl_hs_arena_free(s, s->clienthello->pre_proc_exts);
+    ssl_hs_arena_free(s, s->clienthello);
     OPENSSL_free(s->pha_context);
     EVP_MD_CTX_free(s->pha_dgst);
 
@@ -1581,6 +1591,7 @@ void ossl_ssl_connection_free(SSL *ssl)
 #ifndef OPENSSL_NO_ECH
     ossl_ech_conn_clear(&s->ext.ech);
 #endif
+    OPENSSL_free(s->hs_arena.buf);
 }
 
 void SSL_set0_rbio(SSL *s, BIO *rbio)
@@ -2652,6 +2663,44 @@ int SSL_peek_ex(SSL *s, void *buf, size_t num, size_t *readbytes)
     return ret;
 }
 
+int SSL_read_borrow(SSL *s, const unsigned char **data, size_t *len)
+{
+    SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL_ONLY(s);
+    unsigned char peeked;
+    size_t readbytes;
+
+    if (data == NULL || len == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+    if (sc == NULL || SSL_CONNECTION_IS_DTLS(sc)) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_UNSUPPORTED);
+        return 0;
+    }
+
+    /*
+     * Peeking at a single byte drives the handshake and the record layer
+     * exactly like SSL_read_ex() would, and leaves the current record
+     * holding the plaintext we hand out.
+     */
+    if (ssl_peek_internal(s, &peeked, 1, &readbytes) <= 0)
+        return 0;
+
+    return ssl3_read_borrow(sc, data, len);
+}
+
+int SSL_read_release(SSL *s, size_t len)
+{
+    SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL_ONLY(s);
+
+    if (sc == NULL || SSL_CONNECTION_IS_DTLS(sc)) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_UNSUPPORTED);
+        return 0;
+    }
+
+    return ssl3_read_release(sc, len);
+}
+
 int ssl_write_internal(SSL *s, const void *buf, size_t num,
     uint64_t flags, size_t *written)
 {
@@ -3171,6 +3220,14 @@ long ossl_ctrl_internal(SSL *s, int cmd, long larg, void *parg, int no_quic)
         l = (long)sc->max_cert_list;
         sc->max_cert_list = (size_t)larg;
         return l;
+    case SSL_CTRL_GET_HANDSHAKE_ARENA_SIZE:
+        return (long)sc->hs_arena_size;
+    case SSL_CTRL_SET_HANDSHAKE_ARENA_SIZE:
+        if (larg < 0)
+            return 0;
+        l = (long)sc->hs_arena_size;
+        sc->hs_arena_size = (size_t)larg;
+        return l;
     case SSL_CTRL_SET_MAX_SEND_FRAGMENT:
         if (larg < 512 || larg > SSL3_RT_MAX_PLAIN_LENGTH)
             return 0;
@@ -3248,7 +3305,7 @@ long SSL_callback_ctrl(SSL *s, int cmd, void (*fp)(void))
 
 LHASH_OF(SSL_SESSION) *SSL_CTX_sessions(SSL_CTX *ctx)
 {
-    return ctx->sessions;
+    return ctx->session_cache.sessions;
 }
 
 static int ssl_tsan_load(SSL_CTX *ctx, TSAN_QUALIFIER int *stat)
@@ -3299,6 +3356,14 @@ long SSL_CTX_ctrl(SSL_CTX *ctx, int cmd, long larg, void *parg)
         l = (long)ctx->max_cert_list;
         ctx->max_cert_list = (size_t)larg;
         return l;
+    case SSL_CTRL_GET_HANDSHAKE_ARENA_SIZE:
+        return (long)ctx->hs_arena_size;
+    case SSL_CTRL_SET_HANDSHAKE_ARENA_SIZE:
+        if (larg < 0)
+            return 0;
+        l = (long)ctx->hs_arena_size;
+        ctx->hs_arena_size = (size_t)larg;
+        return l;
 
     case SSL_CTRL_SET_SESS_CACHE_SIZE:
         if (larg < 0)
@@ -3310,13 +3375,17 @@ long SSL_CTX_ctrl(SSL_CTX *ctx, int cmd, long larg, void *parg)
         return (long)ctx->session_cache_size;
     case SSL_CTRL_SET_SESS_CACHE_MODE:
         l = ctx->session_cache_mode;
+        if (!ssl_session_cache_set_sharded(ctx,
+                (larg & SSL_SESS_CACHE_SHARDED) != 0))
+            larg = (larg & ~SSL_SESS_CACHE_SHARDED)
+                | (l & SSL_SESS_CACHE_SHARDED);
         ctx->session_cache_mode = larg;
         return l;
     case SSL_CTRL_GET_SESS_CACHE_MODE:
         return ctx->session_cache_mode;
 
     case SSL_CTRL_SESS_NUMBER:
-        return lh_SSL_SESSION_num_items(ctx->sessions);
+        return (long)ssl_session_cache_num_items(ctx);
     case SSL_CTRL_SESS_CONNECT:
         return ssl_tsan_load(ctx, &ctx->stats.sess_connect);
     case SSL_CTRL_SESS_CONNECT_GOOD:
@@ -3339,6 +3408,16 @@ long SSL_CTX_ctrl(SSL_CTX *ctx, int cmd, long larg, void *parg)
         return ssl_tsan_load(ctx, &ctx->stats.sess_timeout);
     case SSL_CTRL_SESS_CACHE_FULL:
         return ssl_tsan_load(ctx, &ctx->stats.sess_cache_full);
+    case SSL_CTRL_SET_CTX_POOL_SIZE:
+        if (larg < 0)
+            return 0;
+        return ssl_ctx_pool_set_size(ctx, (size_t)larg);
+    case SSL_CTRL_GET_CTX_POOL_SIZE:
+        return ssl_ctx_pool_get_size(ctx);
+    case SSL_CTRL_CTX_POOL_HITS:
+        return ssl_tsan_load(ctx, &ctx->stats.ctx_pool_hit);
+    case SSL_CTRL_CTX_POOL_MISSES:
+        return ssl_tsan_load(ctx, &ctx->stats.ctx_pool_miss);
     case SSL_CTRL_MODE:
         return (ctx->mode |= larg);
     case SSL_CTRL_CLEAR_MODE:
@@ -4060,7 +4139,7 @@ int SSL_export_keying_material_early(SSL *s, unsigned char *out, size_t olen,
         context, contextlen);
 }
 
-static unsigned long ssl_session_hash(const SSL_SESSION *a)
+unsigned long ssl_session_hash(const SSL_SESSION *a)
 {
     const unsigned char *session_id = a->session_id;
     unsigned long l;
@@ -4083,7 +4162,7 @@ static unsigned long ssl_session_hash(const SSL_SESSION *a)
  * being able to construct an SSL_SESSION that will collide with any existing
  * session with a matching session ID.
  */
-static int ssl_session_cmp(const SSL_SESSION *a, const SSL_SESSION *b)
+int ssl_session_cmp(const SSL_SESSION *a, const SSL_SESSION *b)
 {
     if (a->ssl_version != b->ssl_version)
         return 1;
@@ -4273,8 +4352,10 @@ SSL_CTX *SSL_CTX_new_ex(OSSL_LIB_CTX *libctx, const char *propq,
     ret->max_cert_list = SSL_MAX_CERT_LIST_DEFAULT;
     ret->verify_mode = SSL_VERIFY_NONE;
 
-    ret->sessions = lh_SSL_SESSION_new(ssl_session_hash, ssl_session_cmp);
-    if (ret->sessions == NULL) {
+    ret->session_cache.lock = ret->lock;
+    ret->session_cache.sessions = lh_SSL_SESSION_new(ssl_session_hash,
+        ssl_session_cmp);
+    if (ret->session_cache.sessions == NULL) {
         ERR_raise(ERR_LIB_SSL, ERR_R_CRYPTO_LIB);
         goto err;
     }
@@ -4577,7 +4658,7 @@ void SSL_CTX_free(SSL_CTX *a)
      * free ex_data, then finally free the cache.
      * (See ticket [openssl.org #212].)
      */
-    if (a->sessions != NULL)
+    if (a->session_cache.sessions != NULL)
         SSL_CTX_flush_sessions_ex(a, 0);
 
     EVP_MAC_free(a->hmac);
@@ -4588,7 +4669,8 @@ void SSL_CTX_free(SSL_CTX *a)
 #endif
 
     CRYPTO_free_ex_data(CRYPTO_EX_INDEX_SSL_CTX, a, &a->ex_data);
-    lh_SSL_SESSION_free(a->sessions);
+    lh_SSL_SESSION_free(a->session_cache.sessions);
+    ssl_session_cache_free_shards(a);
     X509_STORE_free(a->cert_store);
 #ifndef OPENSSL_NO_CT
     CTLOG_STORE_free(a->ctlog_store);
@@ -4613,6 +4695,11 @@ void SSL_CTX_free(SSL_CTX *a)
     OPENSSL_free(a->ext.tuples);
     OPENSSL_free(a->ext.alpn);
     OPENSSL_secure_clear_free(a->ext.secure, sizeof(*a->ext.secure));
+    SSL_TICKET_KEYRING_free(a->ext.ticket_keyring);
+#ifndef OPENSSL_NO_OCSP
+    SSL_OCSP_STAPLER_free(a->ext.ocsp_stapler);
+#endif
+    ssl_ctx_pool_free(a->ctx_pool);
 
     for (j = 0; j < SSL_ENC_NUM_IDX; j++)
         ssl_evp_cipher_free(a->ssl_cipher_methods[j]);
@@ -5404,6 +5491,7 @@ SSL *SSL_dup(SSL *s)
     retsc->max_proto_version = sc->max_proto_version;
     retsc->mode = sc->mode;
     SSL_set_max_cert_list(ret, SSL_get_max_cert_list(s));
+    SSL_set_handshake_arena_size(ret, SSL_get_handshake_arena_size(s));
     SSL_set_read_ahead(ret, SSL_get_read_ahead(s));
     retsc->msg_callback = sc->msg_callback;
     retsc->msg_callback_arg = sc->msg_callback_arg;
@@ -6294,7 +6382,7 @@ int ssl_handshake_hash(SSL_CONNECTION *s,
         goto err;
     }
 
-    ctx = EVP_MD_CTX_new();
+    ctx = ssl_ctx_pool_get_md(s->session_ctx, EVP_MD_CTX_get0_md(hdgst));
     if (ctx == NULL) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
         goto err;
@@ -6310,7 +6398,7 @@ int ssl_handshake_hash(SSL_CONNECTION *s,
 
     ret = 1;
 err:
-    EVP_MD_CTX_free(ctx);
+    ssl_ctx_pool_put_md(s->session_ctx, ctx);
     return ret;
 }
 
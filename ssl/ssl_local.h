@@ -575,11 +575,13 @@ struct ssl_session_st {
     unsigned char *ticket_appdata;
     size_t ticket_appdata_len;
     uint32_t flags;
-    SSL_CTX *owner;
+    /* The internal session cache (or cache shard) holding this session */
+    struct ssl_session_cache_st *owner;
 
     /*
      * These are used to make removal of session-ids more efficient and to
-     * implement a maximum cache size. Access requires protection of ctx->lock.
+     * implement a maximum cache size. Access requires protection of
+     * owner->lock.
      */
     struct ssl_session_st *prev, *next;
     CRYPTO_REF_COUNT references;
@@ -588,6 +590,21 @@ struct ssl_session_st {
 /* Extended master secret support */
 #define SSL_SESS_FLAG_EXTMS 0x1
 
+/* Number of partitions used when SSL_SESS_CACHE_SHARDED is set */
+#define SSL_SESSION_CACHE_SHARDS 16
+
+/*
+ * An internal session cache, or one shard of it. Sessions are held both in
+ * an lhash for lookup and in a doubly linked list ordered by expiry time.
+ * Both are protected by |lock|.
+ */
+typedef struct ssl_session_cache_st {
+    CRYPTO_RWLOCK *lock;
+    LHASH_OF(SSL_SESSION) *sessions;
+    struct ssl_session_st *head;
+    struct ssl_session_st *tail;
+} SSL_SESSION_CACHE;
+
 #ifndef OPENSSL_NO_SRP
 
 typedef struct srp_ctx_st {
@@ -764,6 +781,42 @@ int ssl_hmac_final(SSL_HMAC *ctx, unsigned char *md, size_t *len,
     size_t max_size);
 size_t ssl_hmac_size(const SSL_HMAC *ctx);
 
+int ssl_ticket_keyring_encrypt_init(SSL_TICKET_KEYRING *ring,
+    unsigned char *key_name, unsigned char *iv,
+    int *iv_len, EVP_CIPHER_CTX *ctx,
+    SSL_HMAC *hctx);
+int ssl_ticket_keyring_decrypt_init(SSL_TICKET_KEYRING *ring,
+    const unsigned char *key_name,
+    const unsigned char *iv,
+    EVP_CIPHER_CTX *ctx, SSL_HMAC *hctx);
+
+typedef struct ssl_ctx_pool_st SSL_CTX_POOL;
+
+void ssl_ctx_pool_free(SSL_CTX_POOL *pool);
+long ssl_ctx_pool_set_size(SSL_CTX *ctx, size_t max);
+long ssl_ctx_pool_get_size(const SSL_CTX *ctx);
+EVP_MD_CTX *ssl_ctx_pool_get_md(SSL_CTX *ctx, const EVP_MD *md);
+void ssl_ctx_pool_put_md(SSL_CTX *ctx, EVP_MD_CTX *mctx);
+EVP_CIPHER_CTX *ssl_ctx_pool_get_cipher(SSL_CTX *ctx);
+void ssl_ctx_pool_put_cipher(SSL_CTX *ctx, EVP_CIPHER_CTX *cctx);
+int ssl_ctx_pool_cipher_init(EVP_CIPHER_CTX *cctx, const EVP_CIPHER *cipher,
+    const unsigned char *key, const unsigned char *iv, int enc);
+
+void *ssl_hs_arena_alloc(SSL_CONNECTION *s, size_t num, int zero);
+void *ssl_hs_arena_calloc(SSL_CONNECTION *s, size_t num, size_t size);
+void ssl_hs_arena_free(SSL_CONNECTION *s, void *ptr);
+void ssl_hs_arena_release(SSL_CONNECTION *s);
+
+#ifndef OPENSSL_NO_OCSP
+typedef struct ssl_ocsp_staple_st SSL_OCSP_STAPLE;
+
+int ssl_ocsp_stapler_has(SSL_OCSP_STAPLER *st, X509 *x);
+SSL_OCSP_STAPLE *ssl_ocsp_stapler_get1(SSL_OCSP_STAPLER *st, X509 *x);
+const unsigned char *ssl_ocsp_staple_get0_der(const SSL_OCSP_STAPLE *staple,
+    size_t *len);
+void ssl_ocsp_staple_free(SSL_OCSP_STAPLE *staple);
+#endif
+
 int ssl_get_EC_curve_nid(const EVP_PKEY *pkey);
 __owur int tls13_set_encoded_pub_key(EVP_PKEY *pkey,
     const unsigned char *enckey,
@@ -827,7 +880,14 @@ struct ssl_ctx_st {
     /* TLSv1.3 specific ciphersuites */
     STACK_OF(SSL_CIPHER) *tls13_ciphersuites;
     struct x509_store_st /* X509_STORE */ *cert_store;
-    LHASH_OF(SSL_SESSION) *sessions;
+    /*
+     * The internal session cache, protected by the SSL_CTX |lock|. When
+     * SSL_SESS_CACHE_SHARDED is set, sessions are instead spread over the
+     * SSL_SESSION_CACHE_SHARDS entries of |session_shards|, each of which has
+     * its own lock.
+     */
+    SSL_SESSION_CACHE session_cache;
+    SSL_SESSION_CACHE *session_shards;
     EVP_MAC *hmac;
     EVP_MD *sha256;
     EVP_CIPHER *tktenc;
@@ -839,8 +899,6 @@ struct ssl_ctx_st {
      * SSL_SESSION_CACHE_MAX_SIZE_DEFAULT. 0 is unlimited.
      */
     size_t session_cache_size;
-    struct ssl_session_st *session_cache_head;
-    struct ssl_session_st *session_cache_tail;
     /*
      * This can have one of 2 values, ored together, SSL_SESS_CACHE_CLIENT,
      * SSL_SESS_CACHE_SERVER, Default is SSL_SESSION_CACHE_SERVER, which
@@ -885,11 +943,19 @@ struct ssl_ctx_st {
                                          * supplying session-id's from
                                          * other processes - spooky
                                          * :-) */
+        TSAN_QUALIFIER int ctx_pool_hit; /* context taken from ctx_pool */
+        TSAN_QUALIFIER int ctx_pool_miss; /* ctx_pool was empty */
     } stats;
 #ifdef TSAN_REQUIRES_LOCKING
     CRYPTO_RWLOCK *tsan_lock;
 #endif
 
+    /*
+     * Digest and cipher contexts kept for reuse by later connections, NULL
+     * unless SSL_CTX_set_ctx_pool_size() was given a non-zero size
+     */
+    SSL_CTX_POOL *ctx_pool;
+
     CRYPTO_REF_COUNT references;
 
     /* if defined, these override the X509_verify_cert() calls */
@@ -954,6 +1020,7 @@ struct ssl_ctx_st {
     int min_proto_version;
     int max_proto_version;
     size_t max_cert_list;
+    size_t hs_arena_size;
 
     struct cert_st /* CERT */ *cert;
     SSL_CERT_LOOKUP *ssl_cert_info;
@@ -1029,11 +1096,15 @@ struct ssl_ctx_st {
             unsigned char *name, unsigned char *iv,
             EVP_CIPHER_CTX *ectx, EVP_MAC_CTX *hctx,
             int enc);
+        /* Shared ticket keys, used instead of the ones above if set */
+        SSL_TICKET_KEYRING *ticket_keyring;
 
         /* certificate status request info */
         /* Callback for status request */
         int (*status_cb)(SSL *ssl, void *arg);
         void *status_arg;
+        /* Stapled responses, used if there is no callback */
+        SSL_OCSP_STAPLER *ocsp_stapler;
         /* ext status type used for CSR extension (OCSP Stapling) */
         int status_type;
         /* RFC 4366 Maximum Fragment Length Negotiation */
@@ -1615,6 +1686,19 @@ struct ssl_connection_st {
     int min_proto_version;
     int max_proto_version;
     size_t max_cert_list;
+    /*
+     * Scratch memory for allocations that do not outlive the message or the
+     * handshake they belong to. |live| counts the allocations that were made
+     * from |buf| and have not been freed yet, |buf| is rewound once it drops
+     * to zero.
+     */
+    struct {
+        unsigned char *buf;
+        size_t size;
+        size_t used;
+        size_t live;
+    } hs_arena;
+    size_t hs_arena_size;
     int first_packet;
     /*
      * What was passed in ClientHello.legacy_version. Used for RSA pre-master
@@ -2462,6 +2546,14 @@ __owur SSL_SESSION *lookup_sess_in_cache(SSL_CONNECTION *s,
     const unsigned char *sess_id,
     size_t sess_id_len);
 __owur int ssl_get_prev_session(SSL_CONNECTION *s, CLIENTHELLO_MSG *hello);
+unsigned long ssl_session_hash(const SSL_SESSION *a);
+int ssl_session_cmp(const SSL_SESSION *a, const SSL_SESSION *b);
+SSL_SESSION_CACHE *ssl_session_cache_get(SSL_CTX *ctx,
+    const unsigned char *sess_id,
+    size_t sess_id_len);
+__owur int ssl_session_cache_set_sharded(SSL_CTX *ctx, int sharded);
+void ssl_session_cache_free_shards(SSL_CTX *ctx);
+size_t ssl_session_cache_num_items(SSL_CTX *ctx);
 __owur SSL_SESSION *ssl_session_dup(const SSL_SESSION *src, int ticket);
 __owur int ssl_cipher_id_cmp(const SSL_CIPHER *a, const SSL_CIPHER *b);
 DECLARE_OBJ_BSEARCH_GLOBAL_CMP_FN(SSL_CIPHER, SSL_CIPHER, ssl_cipher_id);
@@ -20,9 +20,10 @@
 #include "ssl_local.h"
 #include "statem/statem_local.h"
 
-static void SSL_SESSION_list_remove(SSL_CTX *ctx, SSL_SESSION *s);
-static void SSL_SESSION_list_add(SSL_CTX *ctx, SSL_SESSION *s);
-static SSL_SESSION *remove_session_locked(SSL_CTX *ctx, SSL_SESSION *c);
+static void SSL_SESSION_list_remove(SSL_SESSION_CACHE *cache, SSL_SESSION *s);
+static void SSL_SESSION_list_add(SSL_SESSION_CACHE *cache, SSL_SESSION *s);
+static SSL_SESSION *remove_session_locked(SSL_SESSION_CACHE *cache,
+    SSL_SESSION *c);
 
 DEFINE_STACK_OF(SSL_SESSION)
 
@@ -504,6 +505,7 @@ SSL_SESSION *lookup_sess_in_cache(SSL_CONNECTION *s,
             & SSL_SESS_CACHE_NO_INTERNAL_LOOKUP)
         == 0) {
         SSL_SESSION data;
+        SSL_SESSION_CACHE *cache;
 
         data.ssl_version = s->version;
         if (!ossl_assert(sess_id_len <= SSL_MAX_SSL_SESSION_ID_LENGTH))
@@ -512,17 +514,18 @@ SSL_SESSION *lookup_sess_in_cache(SSL_CONNECTION *s,
         memcpy(data.session_id, sess_id, sess_id_len);
         data.session_id_length = sess_id_len;
 
-        if (!CRYPTO_THREAD_read_lock(s->session_ctx->lock))
+        cache = ssl_session_cache_get(s->session_ctx, sess_id, sess_id_len);
+        if (!CRYPTO_THREAD_read_lock(cache->lock))
             return NULL;
-        ret = lh_SSL_SESSION_retrieve(s->session_ctx->sessions, &data);
+        ret = lh_SSL_SESSION_retrieve(cache->sessions, &data);
         if (ret != NULL) {
             /* don't allow other threads to steal it: */
             if (!SSL_SESSION_up_ref(ret)) {
-                CRYPTO_THREAD_unlock(s->session_ctx->lock);
+                CRYPTO_THREAD_unlock(cache->lock);
                 return NULL;
             }
         }
-        CRYPTO_THREAD_unlock(s->session_ctx->lock);
+        CRYPTO_THREAD_unlock(cache->lock);
         if (ret == NULL)
             ssl_tsan_counter(s->session_ctx, &s->session_ctx->stats.sess_miss);
     }
@@ -762,6 +765,8 @@ int SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
 {
     int ret = 0;
     SSL_SESSION *s;
+    SSL_SESSION_CACHE *cache;
+    size_t cache_size;
 
     /*
      * add just 1 reference count for the SSL_CTX's session cache even though
@@ -774,20 +779,21 @@ int SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
      * if session c is in already in cache, we take back the increment later
      */
 
-    if (!CRYPTO_THREAD_write_lock(ctx->lock)) {
+    cache = ssl_session_cache_get(ctx, c->session_id, c->session_id_length);
+    if (!CRYPTO_THREAD_write_lock(cache->lock)) {
         SSL_SESSION_free(c);
         return 0;
     }
-    s = lh_SSL_SESSION_insert(ctx->sessions, c);
+    s = lh_SSL_SESSION_insert(cache->sessions, c);
 
     /*
      * s != NULL iff we already had a session with the given PID. In this
      * case, s == c should hold (then we did not really modify
-     * ctx->sessions), or we're in trouble.
+     * cache->sessions), or we're in trouble.
      */
     if (s != NULL && s != c) {
         /* We *are* in trouble ... */
-        SSL_SESSION_list_remove(ctx, s);
+        SSL_SESSION_list_remove(cache, s);
         SSL_SESSION_free(s);
         /*
          * ... so pretend the other session did not exist in cache (we cannot
@@ -796,7 +802,7 @@ int SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
          * obtain the same session from an external cache)
          */
         s = NULL;
-    } else if (s == NULL && lh_SSL_SESSION_retrieve(ctx->sessions, c) == NULL) {
+    } else if (s == NULL && lh_SSL_SESSION_retrieve(cache->sessions, c) == NULL) {
         /* s == NULL can also mean OOM error in lh_SSL_SESSION_insert ... */
 
         /*
@@ -828,9 +834,15 @@ int SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
 
         ret = 1;
 
-        if (SSL_CTX_sess_get_cache_size(ctx) > 0) {
-            while (SSL_CTX_sess_number(ctx) >= SSL_CTX_sess_get_cache_size(ctx)) {
-                SSL_SESSION *r = remove_session_locked(ctx, ctx->session_cache_tail);
+        /* Each shard gets an equal share of the configured cache size */
+        cache_size = (size_t)SSL_CTX_sess_get_cache_size(ctx);
+        if (cache != &ctx->session_cache)
+            cache_size = (cache_size + SSL_SESSION_CACHE_SHARDS - 1)
+                / SSL_SESSION_CACHE_SHARDS;
+
+        if (cache_size > 0) {
+            while (lh_SSL_SESSION_num_items(cache->sessions) >= cache_size) {
+                SSL_SESSION *r = remove_session_locked(cache, cache->tail);
 
                 if (r == NULL)
                     break;
@@ -840,7 +852,7 @@ int SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
             }
         }
 
-        SSL_SESSION_list_add(ctx, c);
+        SSL_SESSION_list_add(cache, c);
     }
 
     if (s != NULL) {
@@ -852,7 +864,7 @@ int SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
         SSL_SESSION_free(s); /* s == c */
         ret = 0;
     }
-    CRYPTO_THREAD_unlock(ctx->lock);
+    CRYPTO_THREAD_unlock(cache->lock);
 
     while (evicted_head != NULL) {
         SSL_SESSION *next = evicted_head->next;
@@ -870,13 +882,15 @@ int SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
 int SSL_CTX_remove_session(SSL_CTX *ctx, SSL_SESSION *c)
 {
     SSL_SESSION *r;
+    SSL_SESSION_CACHE *cache;
 
     if (c == NULL || c->session_id_length == 0)
         return 0;
-    if (!CRYPTO_THREAD_write_lock(ctx->lock))
+    cache = ssl_session_cache_get(ctx, c->session_id, c->session_id_length);
+    if (!CRYPTO_THREAD_write_lock(cache->lock))
         return 0;
-    r = remove_session_locked(ctx, c);
-    CRYPTO_THREAD_unlock(ctx->lock);
+    r = remove_session_locked(cache, c);
+    CRYPTO_THREAD_unlock(cache->lock);
 
     /*
      * The callback is invoked even when the session is not in the internal
@@ -889,19 +903,20 @@ int SSL_CTX_remove_session(SSL_CTX *ctx, SSL_SESSION *c)
 }
 
 /*
- * Removes c from the session cache. Caller must hold ctx->lock.
+ * Removes c from the session cache. Caller must hold cache->lock.
  * Returns the removed session (caller must invoke remove_session_cb and
  * SSL_SESSION_free), or NULL if not found.
  */
-static SSL_SESSION *remove_session_locked(SSL_CTX *ctx, SSL_SESSION *c)
+static SSL_SESSION *remove_session_locked(SSL_SESSION_CACHE *cache,
+    SSL_SESSION *c)
 {
     SSL_SESSION *r = NULL;
 
     if (c != NULL && c->session_id_length != 0) {
-        r = lh_SSL_SESSION_retrieve(ctx->sessions, c);
+        r = lh_SSL_SESSION_retrieve(cache->sessions, c);
         if (r != NULL) {
-            r = lh_SSL_SESSION_delete(ctx->sessions, r);
-            SSL_SESSION_list_remove(ctx, r);
+            r = lh_SSL_SESSION_delete(cache->sessions, r);
+            SSL_SESSION_list_remove(cache, r);
         }
         c->not_resumable = 1;
     }
@@ -1268,33 +1283,36 @@ void SSL_CTX_flush_sessions(SSL_CTX *s, long t)
 }
 #endif
 
-void SSL_CTX_flush_sessions_ex(SSL_CTX *s, time_t t)
+/*
+ * Removes the sessions of |cache| that have timed out at |t| (or all of them
+ * if |t| is 0) and pushes them onto |sk|.
+ */
+static void flush_session_cache(SSL_SESSION_CACHE *cache, time_t t,
+    STACK_OF(SSL_SESSION) *sk)
 {
-    STACK_OF(SSL_SESSION) *sk;
     SSL_SESSION *current;
     unsigned long i;
     const OSSL_TIME timeout = ossl_time_from_time_t(t);
 
-    if (!CRYPTO_THREAD_write_lock(s->lock))
+    if (!CRYPTO_THREAD_write_lock(cache->lock))
         return;
 
-    sk = sk_SSL_SESSION_new_null();
-    i = lh_SSL_SESSION_get_down_load(s->sessions);
-    lh_SSL_SESSION_set_down_load(s->sessions, 0);
+    i = lh_SSL_SESSION_get_down_load(cache->sessions);
+    lh_SSL_SESSION_set_down_load(cache->sessions, 0);
 
     /*
      * Iterate over the list from the back (oldest), and stop
      * when a session can no longer be removed.
      * Collect removed sessions on a stack to be processed outside the lock,
-     * so that remove_session_cb is never invoked while holding ctx->lock.
+     * so that remove_session_cb is never invoked while holding cache->lock.
      * If the stack failed to create, or a push fails, free the session
      * immediately (without invoking the callback).
      */
-    while (s->session_cache_tail != NULL) {
-        current = s->session_cache_tail;
+    while (cache->tail != NULL) {
+        current = cache->tail;
         if (t == 0 || sess_timedout(timeout, current)) {
-            lh_SSL_SESSION_delete(s->sessions, current);
-            SSL_SESSION_list_remove(s, current);
+            lh_SSL_SESSION_delete(cache->sessions, current);
+            SSL_SESSION_list_remove(cache, current);
             current->not_resumable = 1;
             if (sk == NULL || !sk_SSL_SESSION_push(sk, current))
                 SSL_SESSION_free(current);
@@ -1303,8 +1321,21 @@ void SSL_CTX_flush_sessions_ex(SSL_CTX *s, time_t t)
         }
     }
 
-    lh_SSL_SESSION_set_down_load(s->sessions, i);
-    CRYPTO_THREAD_unlock(s->lock);
+    lh_SSL_SESSION_set_down_load(cache->sessions, i);
+    CRYPTO_THREAD_unlock(cache->lock);
+}
+
+void SSL_CTX_flush_sessions_ex(SSL_CTX *s, time_t t)
+{
+    STACK_OF(SSL_SESSION) *sk;
+    SSL_SESSION *current;
+    size_t i;
+
+    sk = sk_SSL_SESSION_new_null();
+    flush_session_cache(&s->session_cache, t, sk);
+    if (s->session_shards != NULL)
+        for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++)
+            flush_session_cache(&s->session_shards[i], t, sk);
 
     while (sk_SSL_SESSION_num(sk) > 0) {
         current = sk_SSL_SESSION_pop(sk);
@@ -1324,27 +1355,27 @@ int ssl_clear_bad_session(SSL_CONNECTION *s)
         return 0;
 }
 
-/* locked by SSL_CTX in the calling function */
-static void SSL_SESSION_list_remove(SSL_CTX *ctx, SSL_SESSION *s)
+/* locked by the session cache in the calling function */
+static void SSL_SESSION_list_remove(SSL_SESSION_CACHE *cache, SSL_SESSION *s)
 {
     if ((s->next == NULL) || (s->prev == NULL))
         return;
 
-    if (s->next == (SSL_SESSION *)&(ctx->session_cache_tail)) {
+    if (s->next == (SSL_SESSION *)&(cache->tail)) {
         /* last element in list */
-        if (s->prev == (SSL_SESSION *)&(ctx->session_cache_head)) {
+        if (s->prev == (SSL_SESSION *)&(cache->head)) {
             /* only one element in list */
-            ctx->session_cache_head = NULL;
-            ctx->session_cache_tail = NULL;
+            cache->head = NULL;
+            cache->tail = NULL;
         } else {
-            ctx->session_cache_tail = s->prev;
-            s->prev->next = (SSL_SESSION *)&(ctx->session_cache_tail);
+            cache->tail = s->prev;
+            s->prev->next = (SSL_SESSION *)&(cache->tail);
         }
     } else {
-        if (s->prev == (SSL_SESSION *)&(ctx->session_cache_head)) {
+        if (s->prev == (SSL_SESSION *)&(cache->head)) {
             /* first element in list */
-            ctx->session_cache_head = s->next;
-            s->next->prev = (SSL_SESSION *)&(ctx->session_cache_head);
+            cache->head = s->next;
+            s->next->prev = (SSL_SESSION *)&(cache->head);
         } else {
             /* middle of list */
             s->next->prev = s->prev;
@@ -1355,41 +1386,41 @@ static void SSL_SESSION_list_remove(SSL_CTX *ctx, SSL_SESSION *s)
     s->owner = NULL;
 }
 
-static void SSL_SESSION_list_add(SSL_CTX *ctx, SSL_SESSION *s)
+static void SSL_SESSION_list_add(SSL_SESSION_CACHE *cache, SSL_SESSION *s)
 {
     SSL_SESSION *next;
 
     if ((s->next != NULL) && (s->prev != NULL))
-        SSL_SESSION_list_remove(ctx, s);
+        SSL_SESSION_list_remove(cache, s);
 
-    if (ctx->session_cache_head == NULL) {
-        ctx->session_cache_head = s;
-        ctx->session_cache_tail = s;
-        s->prev = (SSL_SESSION *)&(ctx->session_cache_head);
-        s->next = (SSL_SESSION *)&(ctx->session_cache_tail);
+    if (cache->head == NULL) {
+        cache->head = s;
+        cache->tail = s;
+        s->prev = (SSL_SESSION *)&(cache->head);
+        s->next = (SSL_SESSION *)&(cache->tail);
     } else {
-        if (timeoutcmp(s, ctx->session_cache_head) >= 0) {
+        if (timeoutcmp(s, cache->head) >= 0) {
             /*
              * if we timeout after (or the same time as) the first
              * session, put us first - usual case
              */
-            s->next = ctx->session_cache_head;
+            s->next = cache->head;
             s->next->prev = s;
-            s->prev = (SSL_SESSION *)&(ctx->session_cache_head);
-            ctx->session_cache_head = s;
-        } else if (timeoutcmp(s, ctx->session_cache_tail) < 0) {
+            s->prev = (SSL_SESSION *)&(cache->head);
+            cache->head = s;
+        } else if (timeoutcmp(s, cache->tail) < 0) {
             /* if we timeout before the last session, put us last */
-            s->prev = ctx->session_cache_tail;
+            s->prev = cache->tail;
             s->prev->next = s;
-            s->next = (SSL_SESSION *)&(ctx->session_cache_tail);
-            ctx->session_cache_tail = s;
+            s->next = (SSL_SESSION *)&(cache->tail);
+            cache->tail = s;
         } else {
             /*
              * we timeout somewhere in-between - if there is only
              * one session in the cache it will be caught above
              */
-            next = ctx->session_cache_head->next;
-            while (next != (SSL_SESSION *)&(ctx->session_cache_tail)) {
+            next = cache->head->next;
+            while (next != (SSL_SESSION *)&(cache->tail)) {
                 if (timeoutcmp(s, next) >= 0) {
                     s->next = next;
                     s->prev = next->prev;
@@ -1401,7 +1432,112 @@ static void SSL_SESSION_list_add(SSL_CTX *ctx, SSL_SESSION *s)
             }
         }
     }
-    s->owner = ctx;
+    s->owner = cache;
+}
+
+SSL_SESSION_CACHE *ssl_session_cache_get(SSL_CTX *ctx,
+    const unsigned char *sess_id,
+    size_t sess_id_len)
+{
+    if (ctx->session_shards == NULL)
+        return &ctx->session_cache;
+    if (sess_id_len == 0)
+        return &ctx->session_shards[0];
+    /*
+     * The lhash within a shard buckets sessions on the leading bytes of the
+     * session id, so the shard is chosen from the trailing byte instead.
+     */
+    return &ctx->session_shards[sess_id[sess_id_len - 1]
+        % SSL_SESSION_CACHE_SHARDS];
+}
+
+static void session_shards_free(SSL_SESSION_CACHE *shards)
+{
+    size_t i;
+
+    if (shards == NULL)
+        return;
+    for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++) {
+        lh_SSL_SESSION_free(shards[i].sessions);
+        CRYPTO_THREAD_lock_free(shards[i].lock);
+    }
+    OPENSSL_free(shards);
+}
+
+/* Moves every session in |from| to the cache of |ctx| that now owns it */
+static void session_cache_move(SSL_CTX *ctx, SSL_SESSION_CACHE *from)
+{
+    SSL_SESSION *s;
+    SSL_SESSION_CACHE *to;
+
+    /* Oldest first, so that SSL_SESSION_list_add() always prepends */
+    while ((s = from->tail) != NULL) {
+        lh_SSL_SESSION_delete(from->sessions, s);
+        SSL_SESSION_list_remove(from, s);
+        to = ssl_session_cache_get(ctx, s->session_id, s->session_id_length);
+        if (lh_SSL_SESSION_insert(to->sessions, s) == NULL
+            && lh_SSL_SESSION_retrieve(to->sessions, s) == NULL) {
+            /* Out of memory: drop the cache's reference */
+            s->not_resumable = 1;
+            SSL_SESSION_free(s);
+            continue;
+        }
+        SSL_SESSION_list_add(to, s);
+    }
+}
+
+/*
+ * Switches the internal session cache of |ctx| between a single cache and
+ * SSL_SESSION_CACHE_SHARDS independently locked shards, moving any sessions
+ * already cached. Must not be called while |ctx| is in use by other threads.
+ */
+int ssl_session_cache_set_sharded(SSL_CTX *ctx, int sharded)
+{
+    SSL_SESSION_CACHE *shards = ctx->session_shards;
+    size_t i;
+
+    if (sharded == (shards != NULL))
+        return 1;
+
+    if (!sharded) {
+        ctx->session_shards = NULL;
+        for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++)
+            session_cache_move(ctx, &shards[i]);
+        session_shards_free(shards);
+        return 1;
+    }
+
+    shards = OPENSSL_calloc(SSL_SESSION_CACHE_SHARDS, sizeof(*shards));
+    if (shards == NULL)
+        return 0;
+    for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++) {
+        shards[i].sessions = lh_SSL_SESSION_new(ssl_session_hash,
+            ssl_session_cmp);
+        shards[i].lock = CRYPTO_THREAD_lock_new();
+        if (shards[i].sessions == NULL || shards[i].lock == NULL) {
+            session_shards_free(shards);
+            return 0;
+        }
+    }
+    ctx->session_shards = shards;
+    session_cache_move(ctx, &ctx->session_cache);
+    return 1;
+}
+
+void ssl_session_cache_free_shards(SSL_CTX *ctx)
+{
+    session_shards_free(ctx->session_shards);
+    ctx->session_shards = NULL;
+}
+
+size_t ssl_session_cache_num_items(SSL_CTX *ctx)
+{
+    size_t i, n = lh_SSL_SESSION_num_items(ctx->session_cache.sessions);
+
+    if (ctx->session_shards != NULL)
+        for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++)
+            n += lh_SSL_SESSION_num_items(ctx->session_shards[i].sessions);
+    return n;
 }
 
 void SSL_CTX_sess_set_new_cb(SSL_CTX *ctx,
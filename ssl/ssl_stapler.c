@@ -0,0 +1,692 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include <time.h>
+#include <openssl/ocsp.h>
+#include <openssl/http.h>
+#include <openssl/posix_time.h>
+#include "internal/refcount.h"
+#include "ssl_local.h"
+
+#ifndef OPENSSL_NO_OCSP
+
+/*
+ * An OCSP stapler holds the DER encoded OCSP responses of a set of server
+ * certificates and can be shared between many SSL_CTXs.
+ *
+ * Responses are parsed and checked once, when they are installed, and are
+ * then served as they are. A handshake only looks up the certificate by its
+ * SHA1 fingerprint under the read lock and takes a reference on the encoded
+ * response, so it neither parses nor copies anything.
+ *
+ * SSL_OCSP_STAPLER_refresh() fetches new responses from the responders for
+ * those certificates whose response is due for renewal, which is halfway
+ * through its validity window. It does not hold the lock while talking to a
+ * responder, so handshakes keep being served the old response meanwhile.
+ */
+
+/* Accepted clock skew between the responder and us, in seconds */
+#define STAPLE_LEEWAY (5 * 60)
+/* When to refresh a response without nextUpdate, in seconds */
+#define STAPLE_NO_NEXT_UPDATE_LIFETIME (60 * 60)
+/* When to try again after a failed refresh, in seconds */
+#define STAPLE_RETRY_INTERVAL 60
+
+struct ssl_ocsp_staple_st {
+    CRYPTO_REF_COUNT references;
+    unsigned char *der;
+    size_t len;
+    int64_t this_update;
+    /* 0 if the response has no nextUpdate */
+    int64_t next_update;
+};
+
+typedef struct staple_entry_st {
+    unsigned char fingerprint[SHA_DIGEST_LENGTH];
+    X509 *cert;
+    X509 *issuer;
+    /* The certificate ID in requests, which uses SHA1 */
+    OCSP_CERTID *cid;
+    char *url;
+    /* These are protected by the lock of the stapler */
+    SSL_OCSP_STAPLE *staple;
+    int64_t refresh_at;
+    int refreshing;
+} STAPLE_ENTRY;
+
+DEFINE_LHASH_OF_EX(STAPLE_ENTRY);
+
+struct ssl_ocsp_stapler_st {
+    CRYPTO_REF_COUNT references;
+    CRYPTO_RWLOCK *lock;
+    OSSL_LIB_CTX *libctx;
+    char *propq;
+    EVP_MD *sha1;
+    LHASH_OF(STAPLE_ENTRY) *entries;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t refreshes;
+    uint64_t failures;
+};
+
+static unsigned long staple_entry_hash(const STAPLE_ENTRY *e)
+{
+    return (unsigned long)e->fingerprint[0]
+        | (unsigned long)e->fingerprint[1] << 8
+        | (unsigned long)e->fingerprint[2] << 16
+        | (unsigned long)e->fingerprint[3] << 24;
+}
+
+static int staple_entry_cmp(const STAPLE_ENTRY *a, const STAPLE_ENTRY *b)
+{
+    return memcmp(a->fingerprint, b->fingerprint, sizeof(a->fingerprint));
+}
+
+static void ssl_ocsp_staple_up_ref(SSL_OCSP_STAPLE *staple)
+{
+    int i;
+
+    CRYPTO_UP_REF(&staple->references, &i);
+}
+
+void ssl_ocsp_staple_free(SSL_OCSP_STAPLE *staple)
+{
+    int i;
+
+    if (staple == NULL)
+        return;
+
+    CRYPTO_DOWN_REF(&staple->references, &i);
+    if (i > 0)
+        return;
+    OPENSSL_free(staple->der);
+    CRYPTO_FREE_REF(&staple->references);
+    OPENSSL_free(staple);
+}
+
+const unsigned char *ssl_ocsp_staple_get0_der(const SSL_OCSP_STAPLE *staple,
+    size_t *len)
+{
+    *len = staple->len;
+    return staple->der;
+}
+
+static void staple_entry_free(STAPLE_ENTRY *e)
+{
+    if (e == NULL)
+        return;
+    ssl_ocsp_staple_free(e->staple);
+    X509_free(e->cert);
+    X509_free(e->issuer);
+    OCSP_CERTID_free(e->cid);
+    OPENSSL_free(e->url);
+    OPENSSL_free(e);
+}
+
+static int staple_fingerprint(SSL_OCSP_STAPLER *st, X509 *x,
+    unsigned char *fingerprint)
+{
+    /* Makes sure that the fingerprint is cached on |x| */
+    if (X509_check_purpose(x, -1, 0) != 1)
+        return 0;
+    return X509_digest(x, st->sha1, fingerprint, NULL);
+}
+
+/* Returns the entry for |x| or NULL, must be called with the lock held */
+static STAPLE_ENTRY *staple_entry_find(SSL_OCSP_STAPLER *st, X509 *x)
+{
+    STAPLE_ENTRY tmpl;
+
+    if (!staple_fingerprint(st, x, tmpl.fingerprint))
+        return NULL;
+    return lh_STAPLE_ENTRY_retrieve(st->entries, &tmpl);
+}
+
+static int asn1_time_to_posix(const ASN1_GENERALIZEDTIME *t, int64_t *out)
+{
+    struct tm tm;
+
+    return ASN1_TIME_to_tm(t, &tm) && OPENSSL_tm_to_posix(&tm, out);
+}
+
+/*
+ * Returns the index of the single response for the certificate of |e| in |bs|
+ * or -1. Responses fetched by other means than SSL_OCSP_STAPLER_refresh() may
+ * identify the certificate with another hash than SHA1.
+ */
+static int staple_find_single(SSL_OCSP_STAPLER *st, STAPLE_ENTRY *e,
+    OCSP_BASICRESP *bs)
+{
+    ASN1_OBJECT *md_oid;
+    OCSP_CERTID *cid;
+    EVP_MD *md;
+    int i, ret = -1;
+
+    if ((ret = OCSP_resp_find(bs, e->cid, -1)) >= 0)
+        return ret;
+
+    for (i = 0; i < OCSP_resp_count(bs) && ret < 0; i++) {
+        const OCSP_CERTID *id = OCSP_SINGLERESP_get0_id(OCSP_resp_get0(bs, i));
+
+        if (!OCSP_id_get0_info(NULL, &md_oid, NULL, NULL, (OCSP_CERTID *)id))
+            continue;
+        ERR_set_mark();
+        md = EVP_MD_fetch(st->libctx, OBJ_nid2sn(OBJ_obj2nid(md_oid)),
+            st->propq);
+        ERR_pop_to_mark();
+        if (md == NULL)
+            continue;
+        cid = OCSP_cert_to_id(md, e->cert, e->issuer);
+        if (cid != NULL && OCSP_id_cmp(cid, id) == 0)
+            ret = i;
+        OCSP_CERTID_free(cid);
+        EVP_MD_free(md);
+    }
+    return ret;
+}
+
+/*
+ * Check that |bs| is signed by the issuer of the certificate of |e| or by a
+ * responder that the issuer delegated to, so that a forged or corrupted
+ * response never replaces a good one.
+ */
+static int staple_verify(STAPLE_ENTRY *e, OCSP_BASICRESP *bs)
+{
+    STACK_OF(X509) *certs = NULL;
+    X509_STORE *store = NULL;
+    int ret = 0;
+
+    if ((certs = sk_X509_new_null()) == NULL
+        || !sk_X509_push(certs, e->issuer)
+        || (store = X509_STORE_new()) == NULL
+        || !X509_STORE_add_cert(store, e->issuer))
+        goto end;
+    ret = OCSP_basic_verify(bs, certs, store,
+              OCSP_TRUSTOTHER | OCSP_PARTIAL_CHAIN | OCSP_NOEXPLICIT)
+        > 0;
+end:
+    sk_X509_free(certs);
+    X509_STORE_free(store);
+    return ret;
+}
+
+/*
+ * Check that |der| is a successful and correctly signed OCSP response for the
+ * certificate of |e| and make a staple of it. The time at which the response should be renewed
+ * is stored in |*refresh_at|.
+ */
+static SSL_OCSP_STAPLE *staple_new(SSL_OCSP_STAPLER *st, STAPLE_ENTRY *e,
+    const unsigned char *der, size_t len,
+    int64_t *refresh_at)
+{
+    const unsigned char *p = der;
+    OCSP_RESPONSE *resp = NULL;
+    OCSP_BASICRESP *bs = NULL;
+    ASN1_GENERALIZEDTIME *thisupd = NULL, *nextupd = NULL;
+    SSL_OCSP_STAPLE *staple = NULL;
+    int64_t this_update;
+    int idx;
+
+    if (len > LONG_MAX
+        || (resp = d2i_OCSP_RESPONSE(NULL, &p, (long)len)) == NULL
+        || p != der + len
+        || OCSP_response_status(resp) != OCSP_RESPONSE_STATUS_SUCCESSFUL
+        || (bs = OCSP_response_get1_basic(resp)) == NULL
+        || !staple_verify(e, bs)
+        || (idx = staple_find_single(st, e, bs)) < 0
+        || OCSP_single_get0_status(OCSP_resp_get0(bs, idx), NULL, NULL,
+               &thisupd, &nextupd)
+            < 0
+        || !OCSP_check_validity(thisupd, nextupd, STAPLE_LEEWAY, -1)
+        || !asn1_time_to_posix(thisupd, &this_update)) {
+        ERR_raise(ERR_LIB_SSL, SSL_R_INVALID_STATUS_RESPONSE);
+        goto end;
+    }
+
+    if ((staple = OPENSSL_zalloc(sizeof(*staple))) == NULL)
+        goto end;
+    if (!CRYPTO_NEW_REF(&staple->references, 1)) {
+        OPENSSL_free(staple);
+        staple = NULL;
+        goto end;
+    }
+    if ((staple->der = OPENSSL_memdup(der, len)) == NULL) {
+        ssl_ocsp_staple_free(staple);
+        staple = NULL;
+        goto end;
+    }
+    staple->len = len;
+    staple->this_update = this_update;
+
+    if (nextupd == NULL) {
+        *refresh_at = this_update + STAPLE_NO_NEXT_UPDATE_LIFETIME;
+    } else if (!asn1_time_to_posix(nextupd, &staple->next_update)) {
+        ERR_raise(ERR_LIB_SSL, SSL_R_INVALID_STATUS_RESPONSE);
+        ssl_ocsp_staple_free(staple);
+        staple = NULL;
+    } else {
+        *refresh_at = this_update + (staple->next_update - this_update) / 2;
+    }
+end:
+    OCSP_BASICRESP_free(bs);
+    OCSP_RESPONSE_free(resp);
+    return staple;
+}
+
+static int staple_install(SSL_OCSP_STAPLER *st, STAPLE_ENTRY *e,
+    const unsigned char *der, size_t len)
+{
+    SSL_OCSP_STAPLE *staple, *old;
+    int64_t refresh_at = 0;
+
+    if ((staple = staple_new(st, e, der, len, &refresh_at)) == NULL)
+        return 0;
+
+    if (!CRYPTO_THREAD_write_lock(st->lock)) {
+        ssl_ocsp_staple_free(staple);
+        return 0;
+    }
+    old = e->staple;
+    /*
+     * A responder or a caller that hands out a cached response must not roll
+     * back a newer one, which may report a revocation the older one does not
+     */
+    if (old != NULL && old->this_update > staple->this_update) {
+        CRYPTO_THREAD_unlock(st->lock);
+        ssl_ocsp_staple_free(staple);
+        ERR_raise_data(ERR_LIB_SSL, SSL_R_INVALID_STATUS_RESPONSE,
+            "response is older than the installed one");
+        return 0;
+    }
+    e->staple = staple;
+    e->refresh_at = refresh_at;
+    CRYPTO_THREAD_unlock(st->lock);
+
+    ssl_ocsp_staple_free(old);
+    return 1;
+}
+
+SSL_OCSP_STAPLER *SSL_OCSP_STAPLER_new(OSSL_LIB_CTX *libctx,
+    const char *propq)
+{
+    SSL_OCSP_STAPLER *st;
+
+    if ((st = OPENSSL_zalloc(sizeof(*st))) == NULL)
+        return NULL;
+
+    if (!CRYPTO_NEW_REF(&st->references, 1)) {
+        OPENSSL_free(st);
+        return NULL;
+    }
+    st->libctx = libctx;
+    if (propq != NULL && (st->propq = OPENSSL_strdup(propq)) == NULL)
+        goto err;
+    if ((st->lock = CRYPTO_THREAD_lock_new()) == NULL
+        || (st->entries = lh_STAPLE_ENTRY_new(staple_entry_hash,
+                staple_entry_cmp))
+            == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_CRYPTO_LIB);
+        goto err;
+    }
+    if ((st->sha1 = EVP_MD_fetch(libctx, "SHA1", propq)) == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_EVP_LIB);
+        goto err;
+    }
+    return st;
+err:
+    SSL_OCSP_STAPLER_free(st);
+    return NULL;
+}
+
+int SSL_OCSP_STAPLER_up_ref(SSL_OCSP_STAPLER *st)
+{
+    int i;
+
+    if (!CRYPTO_UP_REF(&st->references, &i))
+        return 0;
+
+    REF_PRINT_COUNT("SSL_OCSP_STAPLER", i, st);
+    REF_ASSERT_ISNT(i < 2);
+    return i > 1 ? 1 : 0;
+}
+
+void SSL_OCSP_STAPLER_free(SSL_OCSP_STAPLER *st)
+{
+    int i;
+
+    if (st == NULL)
+        return;
+
+    CRYPTO_DOWN_REF(&st->references, &i);
+    REF_PRINT_COUNT("SSL_OCSP_STAPLER", i, st);
+    if (i > 0)
+        return;
+    REF_ASSERT_ISNT(i < 0);
+
+    lh_STAPLE_ENTRY_doall(st->entries, staple_entry_free);
+    lh_STAPLE_ENTRY_free(st->entries);
+    EVP_MD_free(st->sha1);
+    OPENSSL_free(st->propq);
+    CRYPTO_THREAD_lock_free(st->lock);
+    CRYPTO_FREE_REF(&st->references);
+    OPENSSL_free(st);
+}
+
+int SSL_OCSP_STAPLER_add1_cert(SSL_OCSP_STAPLER *st, X509 *cert,
+    X509 *issuer, const char *url)
+{
+    STACK_OF(OPENSSL_STRING) *aia = NULL;
+    STAPLE_ENTRY *e, *old;
+    int ret = 0;
+
+    if (st == NULL || cert == NULL || issuer == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    if ((e = OPENSSL_zalloc(sizeof(*e))) == NULL)
+        return 0;
+    if (!staple_fingerprint(st, cert, e->fingerprint)) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_X509_LIB);
+        goto err;
+    }
+    if ((e->cid = OCSP_cert_to_id(st->sha1, cert, issuer)) == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_X509_LIB);
+        goto err;
+    }
+    if (url == NULL) {
+        aia = X509_get1_ocsp(cert);
+        url = sk_OPENSSL_STRING_value(aia, 0);
+    }
+    if (url != NULL && (e->url = OPENSSL_strdup(url)) == NULL)
+        goto err;
+    if (!X509_up_ref(cert))
+        goto err;
+    e->cert = cert;
+    if (!X509_up_ref(issuer))
+        goto err;
+    e->issuer = issuer;
+
+    if (!CRYPTO_THREAD_write_lock(st->lock))
+        goto err;
+    /* Registering a certificate again is harmless */
+    if ((old = lh_STAPLE_ENTRY_retrieve(st->entries, e)) == NULL) {
+        (void)lh_STAPLE_ENTRY_insert(st->entries, e);
+        if (lh_STAPLE_ENTRY_error(st->entries) == 0) {
+            e = NULL;
+            ret = 1;
+        }
+    } else {
+        ret = 1;
+    }
+    CRYPTO_THREAD_unlock(st->lock);
+err:
+    X509_email_free(aia);
+    staple_entry_free(e);
+    return ret;
+}
+
+int SSL_OCSP_STAPLER_set1_response(SSL_OCSP_STAPLER *st, X509 *cert,
+    const unsigned char *der, size_t len)
+{
+    STAPLE_ENTRY *e;
+
+    if (st == NULL || cert == NULL || der == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    /* Entries are never removed, so |e| stays valid after unlocking */
+    if (!CRYPTO_THREAD_read_lock(st->lock))
+        return 0;
+    e = staple_entry_find(st, cert);
+    CRYPTO_THREAD_unlock(st->lock);
+    if (e == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_PASSED_INVALID_ARGUMENT);
+        return 0;
+    }
+    return staple_install(st, e, der, len);
+}
+
+static int64_t staple_now(void)
+{
+    return (int64_t)time(NULL);
+}
+
+#ifndef OPENSSL_NO_HTTP
+/* Fetch a response for |e| and install it */
+static int staple_fetch(SSL_OCSP_STAPLER *st, STAPLE_ENTRY *e, int timeout)
+{
+    char *host = NULL, *port = NULL, *path = NULL;
+    OCSP_REQUEST *req = NULL;
+    OCSP_CERTID *cid = NULL;
+    BIO *req_mem = NULL, *rsp = NULL;
+    char *der;
+    long len;
+    int use_ssl, ret = 0;
+
+    if (e->url == NULL) {
+        ERR_raise_data(ERR_LIB_SSL, ERR_R_PASSED_INVALID_ARGUMENT,
+            "no OCSP responder URL");
+        return 0;
+    }
+    if (!OSSL_HTTP_parse_url(e->url, &use_ssl, NULL, &host, &port, NULL,
+            &path, NULL, NULL))
+        goto end;
+    /* There would be no way to configure the TLS connection */
+    if (use_ssl) {
+        ERR_raise_data(ERR_LIB_SSL, ERR_R_UNSUPPORTED,
+            "OCSP responder URL uses https: %s", e->url);
+        goto end;
+    }
+
+    if ((req = OCSP_REQUEST_new()) == NULL
+        || (cid = OCSP_CERTID_dup(e->cid)) == NULL
+        || OCSP_request_add0_id(req, cid) == NULL) {
+        OCSP_CERTID_free(cid);
+        goto end;
+    }
+    if ((req_mem = ASN1_item_i2d_mem_bio(ASN1_ITEM_rptr(OCSP_REQUEST),
+             (const ASN1_VALUE *)req))
+        == NULL)
+        goto end;
+
+    rsp = OSSL_HTTP_transfer(NULL, host, port, path, 0, NULL, NULL,
+        NULL, NULL, NULL, NULL, 0, NULL,
+        "application/ocsp-request", req_mem,
+        "application/ocsp-response", 1,
+        OSSL_HTTP_DEFAULT_MAX_RESP_LEN, timeout, 0);
+    /* The response is read into a memory BIO, install it as it came */
+    if (rsp != NULL && (len = BIO_get_mem_data(rsp, &der)) > 0)
+        ret = staple_install(st, e, (unsigned char *)der, (size_t)len);
+
+end:
+    BIO_free(rsp);
+    BIO_free(req_mem);
+    OCSP_REQUEST_free(req);
+    OPENSSL_free(host);
+    OPENSSL_free(port);
+    OPENSSL_free(path);
+    return ret;
+}
+#endif
+
+typedef struct {
+    STAPLE_ENTRY **due;
+    size_t n;
+    int64_t now;
+} STAPLE_DUE;
+
+static void staple_collect_due(STAPLE_ENTRY *e, STAPLE_DUE *d)
+{
+    if (e->refreshing || e->refresh_at > d->now)
+        return;
+    /* Claimed so that concurrent refreshes do not fetch it again */
+    e->refreshing = 1;
+    d->due[d->n++] = e;
+}
+
+IMPLEMENT_LHASH_DOALL_ARG(STAPLE_ENTRY, STAPLE_DUE);
+
+int SSL_OCSP_STAPLER_refresh(SSL_OCSP_STAPLER *st, int timeout)
+{
+    STAPLE_DUE d;
+    size_t i;
+    uint64_t tmp;
+    int ok, ret = 1;
+
+    if (st == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    if (!CRYPTO_THREAD_write_lock(st->lock))
+        return 0;
+    d.n = 0;
+    d.now = staple_now();
+    d.due = OPENSSL_malloc_array(lh_STAPLE_ENTRY_num_items(st->entries) + 1,
+        sizeof(*d.due));
+    if (d.due != NULL)
+        lh_STAPLE_ENTRY_doall_STAPLE_DUE(st->entries, staple_collect_due, &d);
+    CRYPTO_THREAD_unlock(st->lock);
+    if (d.due == NULL)
+        return 0;
+
+    for (i = 0; i < d.n; i++) {
+        STAPLE_ENTRY *e = d.due[i];
+
+#ifndef OPENSSL_NO_HTTP
+        ok = staple_fetch(st, e, timeout);
+#else
+        ERR_raise(ERR_LIB_SSL, ERR_R_UNSUPPORTED);
+        ok = 0;
+#endif
+        CRYPTO_atomic_add64(ok ? &st->refreshes : &st->failures, 1, &tmp,
+            st->lock);
+        if (!CRYPTO_THREAD_write_lock(st->lock)) {
+            ret = 0;
+            continue;
+        }
+        if (!ok) {
+            /* Keep serving the old response, if any, while it is valid */
+            e->refresh_at = staple_now() + STAPLE_RETRY_INTERVAL;
+            ret = 0;
+        }
+        e->refreshing = 0;
+        CRYPTO_THREAD_unlock(st->lock);
+    }
+    OPENSSL_free(d.due);
+    return ret;
+}
+
+static void staple_earliest_refresh(STAPLE_ENTRY *e, int64_t *earliest)
+{
+    if (e->refresh_at < *earliest)
+        *earliest = e->refresh_at;
+}
+
+IMPLEMENT_LHASH_DOALL_ARG(STAPLE_ENTRY, int64_t);
+
+time_t SSL_OCSP_STAPLER_get_next_refresh(SSL_OCSP_STAPLER *st)
+{
+    int64_t earliest = INT64_MAX;
+
+    if (st == NULL || !CRYPTO_THREAD_read_lock(st->lock))
+        return 0;
+    lh_STAPLE_ENTRY_doall_int64_t(st->entries, staple_earliest_refresh,
+        &earliest);
+    CRYPTO_THREAD_unlock(st->lock);
+
+    if (earliest == INT64_MAX)
+        return (time_t)-1;
+    return (time_t)earliest;
+}
+
+int SSL_OCSP_STAPLER_get_stats(SSL_OCSP_STAPLER *st, uint64_t *hits,
+    uint64_t *misses, uint64_t *refreshes,
+    uint64_t *failures)
+{
+    if (st == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+    if ((hits != NULL && !CRYPTO_atomic_load(&st->hits, hits, st->lock))
+        || (misses != NULL
+            && !CRYPTO_atomic_load(&st->misses, misses, st->lock))
+        || (refreshes != NULL
+            && !CRYPTO_atomic_load(&st->refreshes, refreshes, st->lock))
+        || (failures != NULL
+            && !CRYPTO_atomic_load(&st->failures, failures, st->lock)))
+        return 0;
+    return 1;
+}
+
+/* Returns a usable staple for |x| or NULL, must be called with the lock held */
+static SSL_OCSP_STAPLE *staple_get0(SSL_OCSP_STAPLER *st, X509 *x)
+{
+    STAPLE_ENTRY *e = staple_entry_find(st, x);
+
+    if (e == NULL || e->staple == NULL)
+        return NULL;
+    if (e->staple->next_update != 0
+        && e->staple->next_update + STAPLE_LEEWAY < staple_now())
+        return NULL;
+    return e->staple;
+}
+
+/*
+ * Returns 1 if there is a response to staple for |x|, the certificate of a
+ * handshake in which the client asked for one. This is what the statistics
+ * count.
+ */
+int ssl_ocsp_stapler_has(SSL_OCSP_STAPLER *st, X509 *x)
+{
+    uint64_t tmp;
+    int ret = 0;
+
+    if (x != NULL && CRYPTO_THREAD_read_lock(st->lock)) {
+        ret = staple_get0(st, x) != NULL;
+        CRYPTO_THREAD_unlock(st->lock);
+    }
+    CRYPTO_atomic_add64(ret ? &st->hits : &st->misses, 1, &tmp, st->lock);
+    return ret;
+}
+
+/*
+ * Returns a reference to the response for |x| to staple, or NULL if there is
+ * none. The caller frees it with ssl_ocsp_staple_free().
+ */
+SSL_OCSP_STAPLE *ssl_ocsp_stapler_get1(SSL_OCSP_STAPLER *st, X509 *x)
+{
+    SSL_OCSP_STAPLE *staple = NULL;
+
+    if (x != NULL && CRYPTO_THREAD_read_lock(st->lock)) {
+        if ((staple = staple_get0(st, x)) != NULL)
+            ssl_ocsp_staple_up_ref(staple);
+        CRYPTO_THREAD_unlock(st->lock);
+    }
+    return staple;
+}
+
+int SSL_CTX_set1_ocsp_stapler(SSL_CTX *ctx, SSL_OCSP_STAPLER *st)
+{
+    if (st != NULL && !SSL_OCSP_STAPLER_up_ref(st))
+        return 0;
+    SSL_OCSP_STAPLER_free(ctx->ext.ocsp_stapler);
+    ctx->ext.ocsp_stapler = st;
+    return 1;
+}
+
+SSL_OCSP_STAPLER *SSL_CTX_get0_ocsp_stapler(const SSL_CTX *ctx)
+{
+    return ctx->ext.ocsp_stapler;
+}
+
+#endif
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include <openssl/rand.h>
+#include <openssl/core_names.h>
+#include "internal/refcount.h"
+#include "ssl_local.h"
+
+/*
+ * A session ticket key ring that can be shared between many SSL_CTXs.
+ *
+ * It holds up to three keys: the previous one, which is still accepted for
+ * tickets issued before the last rotation, the current one, which is used to
+ * issue new tickets, and the next one, which is accepted already so that a
+ * key distributed to a fleet ahead of time works on every server no matter
+ * in what order they rotate.
+ *
+ * Keys never change once created. Each holds cipher and MAC contexts that
+ * are already keyed and that are only ever copied, so issuing or accepting a
+ * ticket costs no algorithm fetch and no key schedule. Rotation replaces the
+ * three key pointers under the write lock, readers only hold the read lock
+ * while looking up a key and copying its contexts.
+ */
+
+#define TICKET_KEY_PREVIOUS 0
+#define TICKET_KEY_CURRENT 1
+#define TICKET_KEY_NEXT 2
+#define TICKET_KEY_NUM 3
+
+typedef struct ticket_key_st {
+    unsigned char name[TLSEXT_KEYNAME_LENGTH];
+    EVP_CIPHER_CTX *enc;
+    EVP_CIPHER_CTX *dec;
+    EVP_MAC_CTX *mac;
+} TICKET_KEY;
+
+struct ssl_ticket_keyring_st {
+    CRYPTO_REF_COUNT references;
+    CRYPTO_RWLOCK *lock;
+    OSSL_LIB_CTX *libctx;
+    EVP_CIPHER *cipher;
+    EVP_MAC *hmac;
+    TICKET_KEY *keys[TICKET_KEY_NUM];
+};
+
+static void ticket_key_free(TICKET_KEY *key)
+{
+    if (key == NULL)
+        return;
+    EVP_CIPHER_CTX_free(key->enc);
+    EVP_CIPHER_CTX_free(key->dec);
+    EVP_MAC_CTX_free(key->mac);
+    OPENSSL_free(key);
+}
+
+/*
+ * |keydata| has the layout used by SSL_CTX_set_tlsext_ticket_keys(): the key
+ * name followed by the HMAC and the AES key. If it is NULL a random key is
+ * created.
+ */
+static TICKET_KEY *ticket_key_new(SSL_TICKET_KEYRING *ring,
+    const unsigned char *keydata)
+{
+    unsigned char secret[TLSEXT_TICK_KEY_LENGTH * 2];
+    const unsigned char *hmac_key = secret;
+    const unsigned char *aes_key = secret + TLSEXT_TICK_KEY_LENGTH;
+    OSSL_PARAM params[2];
+    TICKET_KEY *key;
+
+    if ((key = OPENSSL_zalloc(sizeof(*key))) == NULL)
+        return NULL;
+
+    if (keydata != NULL) {
+        memcpy(key->name, keydata, sizeof(key->name));
+        hmac_key = keydata + sizeof(key->name);
+        aes_key = hmac_key + TLSEXT_TICK_KEY_LENGTH;
+    } else if (RAND_bytes_ex(ring->libctx, key->name, sizeof(key->name), 0) <= 0
+        || RAND_priv_bytes_ex(ring->libctx, secret, sizeof(secret), 0) <= 0) {
+        goto err;
+    }
+
+    params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+        "SHA256", 0);
+    params[1] = OSSL_PARAM_construct_end();
+    if ((key->enc = EVP_CIPHER_CTX_new()) == NULL
+        || (key->dec = EVP_CIPHER_CTX_new()) == NULL
+        || (key->mac = EVP_MAC_CTX_new(ring->hmac)) == NULL
+        || !EVP_EncryptInit_ex(key->enc, ring->cipher, NULL, aes_key, NULL)
+        || !EVP_DecryptInit_ex(key->dec, ring->cipher, NULL, aes_key, NULL)
+        || !EVP_MAC_init(key->mac, hmac_key, TLSEXT_TICK_KEY_LENGTH, params))
+        goto err;
+
+    OPENSSL_cleanse(secret, sizeof(secret));
+    return key;
+err:
+    OPENSSL_cleanse(secret, sizeof(secret));
+    ticket_key_free(key);
+    return NULL;
+}
+
+SSL_TICKET_KEYRING *SSL_TICKET_KEYRING_new(OSSL_LIB_CTX *libctx,
+    const char *propq)
+{
+    SSL_TICKET_KEYRING *ring;
+
+    if ((ring = OPENSSL_zalloc(sizeof(*ring))) == NULL)
+        return NULL;
+
+    if (!CRYPTO_NEW_REF(&ring->references, 1)) {
+        OPENSSL_free(ring);
+        return NULL;
+    }
+    ring->libctx = libctx;
+    if ((ring->lock = CRYPTO_THREAD_lock_new()) == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_CRYPTO_LIB);
+        goto err;
+    }
+    if ((ring->cipher = EVP_CIPHER_fetch(libctx, "AES-256-CBC", propq)) == NULL
+        || (ring->hmac = EVP_MAC_fetch(libctx, "HMAC", propq)) == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_EVP_LIB);
+        goto err;
+    }
+    if ((ring->keys[TICKET_KEY_CURRENT] = ticket_key_new(ring, NULL)) == NULL
+        || (ring->keys[TICKET_KEY_NEXT] = ticket_key_new(ring, NULL)) == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_EVP_LIB);
+        goto err;
+    }
+    return ring;
+err:
+    SSL_TICKET_KEYRING_free(ring);
+    return NULL;
+}
+
+int SSL_TICKET_KEYRING_up_ref(SSL_TICKET_KEYRING *ring)
+{
+    int i;
+
+    if (!CRYPTO_UP_REF(&ring->references, &i))
+        return 0;
+
+    REF_PRINT_COUNT("SSL_TICKET_KEYRING", i, ring);
+    REF_ASSERT_ISNT(i < 2);
+    return i > 1 ? 1 : 0;
+}
+
+void SSL_TICKET_KEYRING_free(SSL_TICKET_KEYRING *ring)
+{
+    size_t k;
+    int i;
+
+    if (ring == NULL)
+        return;
+
+    CRYPTO_DOWN_REF(&ring->references, &i);
+    REF_PRINT_COUNT("SSL_TICKET_KEYRING", i, ring);
+    if (i > 0)
+        return;
+    REF_ASSERT_ISNT(i < 0);
+
+    for (k = 0; k < TICKET_KEY_NUM; k++)
+        ticket_key_free(ring->keys[k]);
+    EVP_CIPHER_free(ring->cipher);
+    EVP_MAC_free(ring->hmac);
+    CRYPTO_THREAD_lock_free(ring->lock);
+    CRYPTO_FREE_REF(&ring->references);
+    OPENSSL_free(ring);
+}
+
+int SSL_TICKET_KEYRING_rotate(SSL_TICKET_KEYRING *ring,
+    const unsigned char *keydata, size_t keylen)
+{
+    TICKET_KEY *key, *old;
+
+    if (ring == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+    if (keydata != NULL
+        && keylen != TLSEXT_KEYNAME_LENGTH + 2 * TLSEXT_TICK_KEY_LENGTH) {
+        ERR_raise(ERR_LIB_SSL, SSL_R_INVALID_TICKET_KEYS_LENGTH);
+        return 0;
+    }
+
+    /* Do the expensive part before any thread can notice */
+    if ((key = ticket_key_new(ring, keydata)) == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_EVP_LIB);
+        return 0;
+    }
+
+    if (!CRYPTO_THREAD_write_lock(ring->lock)) {
+        ticket_key_free(key);
+        return 0;
+    }
+    old = ring->keys[TICKET_KEY_PREVIOUS];
+    ring->keys[TICKET_KEY_PREVIOUS] = ring->keys[TICKET_KEY_CURRENT];
+    ring->keys[TICKET_KEY_CURRENT] = ring->keys[TICKET_KEY_NEXT];
+    ring->keys[TICKET_KEY_NEXT] = key;
+    CRYPTO_THREAD_unlock(ring->lock);
+
+    ticket_key_free(old);
+    return 1;
+}
+
+/*
+ * Set up |ctx| and |hctx| to encrypt a ticket with the current key of |ring|.
+ * The name of that key is written to |key_name| and a fresh IV to |iv|.
+ */
+int ssl_ticket_keyring_encrypt_init(SSL_TICKET_KEYRING *ring,
+    unsigned char *key_name, unsigned char *iv,
+    int *iv_len, EVP_CIPHER_CTX *ctx,
+    SSL_HMAC *hctx)
+{
+    TICKET_KEY *key;
+    int ret = 0;
+
+    *iv_len = EVP_CIPHER_get_iv_length(ring->cipher);
+    if (*iv_len < 0 || *iv_len > EVP_MAX_IV_LENGTH
+        || RAND_bytes_ex(ring->libctx, iv, *iv_len, 0) <= 0)
+        return 0;
+
+    if (!CRYPTO_THREAD_read_lock(ring->lock))
+        return 0;
+    key = ring->keys[TICKET_KEY_CURRENT];
+    memcpy(key_name, key->name, sizeof(key->name));
+    if (EVP_CIPHER_CTX_copy(ctx, key->enc)
+        && (hctx->ctx = EVP_MAC_CTX_dup(key->mac)) != NULL)
+        ret = 1;
+    CRYPTO_THREAD_unlock(ring->lock);
+
+    return ret && EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv);
+}
+
+/*
+ * Set up |ctx| and |hctx| to decrypt a ticket that names the key |key_name|.
+ * Returns 1 if the ticket was issued with the current key, 2 if it was issued
+ * with one of the others and should be renewed, 0 if the key is unknown and
+ * -1 on error, like the ticket key callback.
+ */
+int ssl_ticket_keyring_decrypt_init(SSL_TICKET_KEYRING *ring,
+    const unsigned char *key_name,
+    const unsigned char *iv,
+    EVP_CIPHER_CTX *ctx, SSL_HMAC *hctx)
+{
+    TICKET_KEY *key = NULL;
+    size_t k;
+    int ret = -1;
+
+    if (!CRYPTO_THREAD_read_lock(ring->lock))
+        return -1;
+    for (k = 0; k < TICKET_KEY_NUM; k++) {
+        if (ring->keys[k] != NULL
+            && memcmp(ring->keys[k]->name, key_name, TLSEXT_KEYNAME_LENGTH) == 0) {
+            key = ring->keys[k];
+            break;
+        }
+    }
+    if (key == NULL)
+        ret = 0;
+    else if (EVP_CIPHER_CTX_copy(ctx, key->dec)
+        && (hctx->ctx = EVP_MAC_CTX_dup(key->mac)) != NULL)
+        ret = k == TICKET_KEY_CURRENT ? 1 : 2;
+    CRYPTO_THREAD_unlock(ring->lock);
+
+    if (ret > 0 && !EVP_DecryptInit_ex(ctx, NULL, NULL, NULL, iv))
+        ret = -1;
+    return ret;
+}
+
+int SSL_CTX_set1_ticket_keyring(SSL_CTX *ctx, SSL_TICKET_KEYRING *ring)
+{
+    if (ring != NULL && !SSL_TICKET_KEYRING_up_ref(ring))
+        return 0;
+    SSL_TICKET_KEYRING_free(ctx->ext.ticket_keyring);
+    ctx->ext.ticket_keyring = ring;
+    return 1;
+}
+
+SSL_TICKET_KEYRING *SSL_CTX_get0_ticket_keyring(const SSL_CTX *ctx)
+{
+    return ctx->ext.ticket_keyring;
+}
@@ -899,7 +899,7 @@ int extension_is_relevant(SSL_CONNECTION *s, unsigned int extctx,
  * extensions yet, except to check their types. This function also runs the
  * initialiser functions for all known extensions if |init| is nonzero (whether
  * we have collected them or not). If successful the caller is responsible for
- * freeing the contents of |*res|.
+ * freeing the contents of |*res| with ssl_hs_arena_free().
  *
  * Per http://tools.ietf.org/html/rfc5246#section-7.4.1.4, there may not be
  * more than one extension of the same type in a ClientHello or ServerHello.
@@ -934,7 +934,8 @@ int tls_collect_extensions(SSL_CONNECTION *s, PACKET *packet,
 #endif
 
     num_exts = OSSL_NELEM(ext_defs) + (exts != NULL ? exts->meths_count : 0);
-    raw_extensions = OPENSSL_calloc(num_exts, sizeof(*raw_extensions));
+    raw_extensions = ssl_hs_arena_calloc(s, num_exts,
+        sizeof(*raw_extensions));
     if (raw_extensions == NULL) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_CRYPTO_LIB);
         return 0;
@@ -1030,7 +1031,7 @@ int tls_collect_extensions(SSL_CONNECTION *s, PACKET *packet,
     return 1;
 
 err:
-    OPENSSL_free(raw_extensions);
+    ssl_hs_arena_free(s, raw_extensions);
     return 0;
 }
 
@@ -326,11 +326,12 @@ int tls_parse_ctos_status_request(SSL_CONNECTION *s, PACKET *pkt,
 
     /*
      * We only care about this extension if the application
-     * registered a callback. Otherwise, there is nothing to
+     * registered a callback or a stapler. Otherwise, there is nothing to
      * tell us that a response is needed.
      */
     SSL_CTX *sctx = SSL_CONNECTION_GET_CTX(s);
-    if (sctx == NULL || sctx->ext.status_cb == NULL)
+    if (sctx == NULL
+        || (sctx->ext.status_cb == NULL && sctx->ext.ocsp_stapler == NULL))
         return 1;
 
     if (!PACKET_get_1(pkt, (unsigned int *)&s->ext.status_type)) {
@@ -1792,7 +1793,10 @@ EXT_RETURN tls_construct_stoc_status_request(SSL_CONNECTION *s, WPACKET *pkt,
     unsigned int context, X509 *x,
     size_t chainidx)
 {
-    OCSP_RESPONSE *resp;
+    SSL_CTX *sctx = SSL_CONNECTION_GET_CTX(s);
+    OCSP_RESPONSE *resp = NULL;
+    SSL_OCSP_STAPLE *staple = NULL;
+    int ok;
 
     /* We don't currently support this extension inside a CertificateRequest */
     if (context == SSL_EXT_TLS1_3_CERTIFICATE_REQUEST)
@@ -1801,16 +1805,25 @@ EXT_RETURN tls_construct_stoc_status_request(SSL_CONNECTION *s, WPACKET *pkt,
     if (!s->ext.status_expected)
         return EXT_RETURN_NOT_SENT;
 
-    /* Try to retrieve OCSP response for the actual certificate */
-    resp = ossl_get_ocsp_response(s, (int)chainidx);
-
-    /* If no OCSP response was found the extension is not sent */
-    if (resp == NULL)
+    /*
+     * Try to retrieve OCSP response for the actual certificate. A stapled
+     * response is only needed here in TLSv1.3, before that its presence was
+     * checked when status_expected was set.
+     */
+    if (sctx->ext.status_cb == NULL && sctx->ext.ocsp_stapler != NULL) {
+        if (SSL_CONNECTION_IS_TLS13(s)
+            && (staple = ssl_ocsp_stapler_get1(sctx->ext.ocsp_stapler, x))
+                == NULL)
+            return EXT_RETURN_NOT_SENT;
+    } else if ((resp = ossl_get_ocsp_response(s, (int)chainidx)) == NULL) {
+        /* If no OCSP response was found the extension is not sent */
         return EXT_RETURN_NOT_SENT;
+    }
 
     if (!WPACKET_put_bytes_u16(pkt, TLSEXT_TYPE_status_request)
         || !WPACKET_start_sub_packet_u16(pkt)) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+        ssl_ocsp_staple_free(staple);
         return EXT_RETURN_FAIL;
     }
 
@@ -1819,11 +1832,18 @@ EXT_RETURN tls_construct_stoc_status_request(SSL_CONNECTION *s, WPACKET *pkt,
      * send back an empty extension, with the certificate status appearing as a
      * separate message
      */
-    if (SSL_CONNECTION_IS_TLS13(s)
-        && !tls_construct_cert_status_body(s, resp, pkt)) {
-        /* SSLfatal() already called */
-        return EXT_RETURN_FAIL;
+    if (SSL_CONNECTION_IS_TLS13(s)) {
+        if (staple != NULL)
+            ok = tls_construct_cert_status_staple(s, staple, pkt);
+        else
+            ok = tls_construct_cert_status_body(s, resp, pkt);
+        if (!ok) {
+            /* SSLfatal() already called */
+            ssl_ocsp_staple_free(staple);
+            return EXT_RETURN_FAIL;
+        }
     }
+    ssl_ocsp_staple_free(staple);
     if (!WPACKET_close(pkt)) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
         return EXT_RETURN_FAIL;
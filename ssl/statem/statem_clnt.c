@@ -1360,8 +1360,8 @@ __owur CON_FUNC_RETURN tls_construct_client_hello(SSL_CONNECTION *s,
     /* Free up raw exts as needed (happens like this on real server) */
     if (s->clienthello != NULL
         && s->clienthello->pre_proc_exts != NULL) {
-        OPENSSL_free(s->clienthello->pre_proc_exts);
-        OPENSSL_free(s->clienthello);
+        ssl_hs_arena_free(s, s->clienthello->pre_proc_exts);
+        ssl_hs_arena_free(s, s->clienthello);
         s->clienthello = NULL;
     }
     return 1;
@@ -1371,8 +1371,8 @@ err:
         BUF_MEM_free(inner_mem);
     }
     if (s->clienthello != NULL) {
-        OPENSSL_free(s->clienthello->pre_proc_exts);
-        OPENSSL_free(s->clienthello);
+        ssl_hs_arena_free(s, s->clienthello->pre_proc_exts);
+        ssl_hs_arena_free(s, s->clienthello);
         s->clienthello = NULL;
     }
     return 0;
@@ -1946,7 +1946,7 @@ MSG_PROCESS_RETURN tls_process_server_hello(SSL_CONNECTION *s, PACKET *pkt)
         }
 
         ret = tls_process_as_hello_retry_request(s, extensions);
-        OPENSSL_free(extensions);
+        ssl_hs_arena_free(s, extensions);
 
         return ret;
     }
@@ -2200,10 +2200,10 @@ MSG_PROCESS_RETURN tls_process_server_hello(SSL_CONNECTION *s, PACKET *pkt)
         }
     }
 
-    OPENSSL_free(extensions);
+    ssl_hs_arena_free(s, extensions);
     return MSG_PROCESS_CONTINUE_READING;
 err:
-    OPENSSL_free(extensions);
+    ssl_hs_arena_free(s, extensions);
     return MSG_PROCESS_ERROR;
 }
 
@@ -2426,11 +2426,11 @@ MSG_PROCESS_RETURN tls_process_server_certificate(SSL_CONNECTION *s,
                 || !tls_parse_all_extensions(s, SSL_EXT_TLS1_3_CERTIFICATE,
                     rawexts, x, chainidx,
                     PACKET_remaining(pkt) == 0)) {
-                OPENSSL_free(rawexts);
+                ssl_hs_arena_free(s, rawexts);
                 /* SSLfatal already called */
                 goto err;
             }
-            OPENSSL_free(rawexts);
+            ssl_hs_arena_free(s, rawexts);
         }
 
         if (!sk_X509_push(s->session->peer_chain, x)) {
@@ -3013,10 +3013,10 @@ MSG_PROCESS_RETURN tls_process_certificate_request(SSL_CONNECTION *s,
             || !tls_parse_all_extensions(s, SSL_EXT_TLS1_3_CERTIFICATE_REQUEST,
                 rawexts, NULL, 0, 1)) {
             /* SSLfatal() already called */
-            OPENSSL_free(rawexts);
+            ssl_hs_arena_free(s, rawexts);
             return MSG_PROCESS_ERROR;
         }
-        OPENSSL_free(rawexts);
+        ssl_hs_arena_free(s, rawexts);
         if (!tls1_process_sigalgs(s)) {
             SSLfatal(s, SSL_AD_INTERNAL_ERROR, SSL_R_BAD_LENGTH);
             return MSG_PROCESS_ERROR;
@@ -3254,14 +3254,14 @@ MSG_PROCESS_RETURN tls_process_new_session_ticket(SSL_CONNECTION *s,
         }
         s->session->master_key_length = hashlen;
 
-        OPENSSL_free(exts);
+        ssl_hs_arena_free(s, exts);
         ssl_update_cache(s, SSL_SESS_CACHE_CLIENT);
         return MSG_PROCESS_FINISHED_READING;
     }
 
     return MSG_PROCESS_CONTINUE_READING;
 err:
-    OPENSSL_free(exts);
+    ssl_hs_arena_free(s, exts);
     return MSG_PROCESS_ERROR;
 }
 
@@ -4495,11 +4495,11 @@ static MSG_PROCESS_RETURN tls_process_encrypted_extensions(SSL_CONNECTION *s,
         goto err;
     }
 
-    OPENSSL_free(rawexts);
+    ssl_hs_arena_free(s, rawexts);
     return MSG_PROCESS_CONTINUE_READING;
 
 err:
-    OPENSSL_free(rawexts);
+    ssl_hs_arena_free(s, rawexts);
     return MSG_PROCESS_ERROR;
 }
 
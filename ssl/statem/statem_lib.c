@@ -14,6 +14,7 @@
 #include "../ssl_local.h"
 #include "statem_local.h"
 #include "internal/cryptlib.h"
+#include "internal/mem_alloc_utils.h"
 #include "internal/ssl_unwrap.h"
 #include <openssl/buffer.h>
 #include <openssl/core_names.h>
@@ -1304,7 +1305,7 @@ int tls_process_rpk(SSL_CONNECTION *sc, PACKET *pkt, EVP_PKEY **peer_rpk)
     }
 
 err:
-    OPENSSL_free(rawexts);
+    ssl_hs_arena_free(sc, rawexts);
     EVP_PKEY_free(pkey);
     return ret;
 }
@@ -1408,6 +1409,71 @@ unsigned long ssl3_output_cert_chain(SSL_CONNECTION *s, WPACKET *pkt,
     return 1;
 }
 
+/*
+ * Allocations whose lifetime is bounded by a handshake, such as the parsed
+ * ClientHello and the tables of received extensions, are taken from a block
+ * of |hs_arena_size| bytes that is allocated once per handshake instead of
+ * calling the allocator for each of them. They must be freed with
+ * ssl_hs_arena_free(). When the block is full, or if no arena size has been
+ * configured, ordinary heap memory is used.
+ */
+#define HS_ARENA_ALIGN 16
+
+void *ssl_hs_arena_alloc(SSL_CONNECTION *s, size_t num, int zero)
+{
+    size_t len = (num + HS_ARENA_ALIGN - 1) & ~(size_t)(HS_ARENA_ALIGN - 1);
+    void *ret;
+
+    if (s->hs_arena.buf == NULL && s->hs_arena_size > 0) {
+        if ((s->hs_arena.buf = OPENSSL_malloc(s->hs_arena_size)) != NULL)
+            s->hs_arena.size = s->hs_arena_size;
+    }
+    if (num == 0 || len < num || len > s->hs_arena.size - s->hs_arena.used)
+        return zero ? OPENSSL_zalloc(num) : OPENSSL_malloc(num);
+
+    ret = s->hs_arena.buf + s->hs_arena.used;
+    s->hs_arena.used += len;
+    s->hs_arena.live++;
+    if (zero)
+        memset(ret, 0, num);
+    return ret;
+}
+
+void *ssl_hs_arena_calloc(SSL_CONNECTION *s, size_t num, size_t size)
+{
+    size_t bytes;
+
+    if (!ossl_size_mul(num, size, &bytes, OPENSSL_FILE, OPENSSL_LINE))
+        return NULL;
+    return ssl_hs_arena_alloc(s, bytes, 1);
+}
+
+void ssl_hs_arena_free(SSL_CONNECTION *s, void *ptr)
+{
+    unsigned char *p = ptr;
+
+    if (p == NULL)
+        return;
+    if (s->hs_arena.buf == NULL || p < s->hs_arena.buf
+        || p >= s->hs_arena.buf + s->hs_arena.size) {
+        OPENSSL_free(ptr);
+        return;
+    }
+    if (--s->hs_arena.live == 0)
+        s->hs_arena.used = 0;
+}
+
+/* Give the arena block back once nothing allocated from it is in use */
+void ssl_hs_arena_release(SSL_CONNECTION *s)
+{
+    if (s->hs_arena.live > 0)
+        return;
+    OPENSSL_free(s->hs_arena.buf);
+    s->hs_arena.buf = NULL;
+    s->hs_arena.size = 0;
+    s->hs_arena.used = 0;
+}
+
 /*
  * Tidy up after the end of a handshake. In the case of SCTP this may result
  * in NBIO events. If |clearbufs| is set then init_buf and the wbio buffer is
@@ -1448,6 +1514,8 @@ WORK_STATE tls_finish_handshake(SSL_CONNECTION *s, ossl_unused WORK_STATE wst,
         s->init_num = 0;
     }
 
+    ssl_hs_arena_release(s);
+
     if (SSL_CONNECTION_IS_TLS13(s) && !s->server
         && s->post_handshake_auth == SSL_PHA_REQUESTED)
         s->post_handshake_auth = SSL_PHA_EXT_SENT;
@@ -181,6 +181,11 @@ __owur CON_FUNC_RETURN tls_construct_client_key_exchange(SSL_CONNECTION *s,
     WPACKET *pkt);
 __owur int tls_client_key_exchange_post_work(SSL_CONNECTION *s);
 __owur int tls_construct_cert_status_body(SSL_CONNECTION *s, OCSP_RESPONSE *resp, WPACKET *pkt);
+#ifndef OPENSSL_NO_OCSP
+__owur int tls_construct_cert_status_staple(SSL_CONNECTION *s,
+    const SSL_OCSP_STAPLE *staple,
+    WPACKET *pkt);
+#endif
 __owur CON_FUNC_RETURN tls_construct_cert_status(SSL_CONNECTION *s,
     WPACKET *pkt);
 __owur MSG_PROCESS_RETURN tls_process_key_exchange(SSL_CONNECTION *s,
@@ -1776,7 +1776,7 @@ MSG_PROCESS_RETURN tls_process_client_hello(SSL_CONNECTION *s, PACKET *pkt)
         s->new_session = 1;
     }
 
-    clienthello = OPENSSL_zalloc(sizeof(*clienthello));
+    clienthello = ssl_hs_arena_alloc(s, sizeof(*clienthello), 1);
     if (clienthello == NULL) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
         goto err;
@@ -1819,7 +1819,7 @@ MSG_PROCESS_RETURN tls_process_client_hello(SSL_CONNECTION *s, PACKET *pkt)
          */
         if (SSL_get_options(SSL_CONNECTION_GET_SSL(s)) & SSL_OP_COOKIE_EXCHANGE) {
             if (clienthello->dtls_cookie_len == 0) {
-                OPENSSL_free(clienthello);
+                ssl_hs_arena_free(s, clienthello);
                 return MSG_PROCESS_FINISHED_READING;
             }
         }
@@ -1867,8 +1867,8 @@ MSG_PROCESS_RETURN tls_process_client_hello(SSL_CONNECTION *s, PACKET *pkt)
 
 err:
     if (clienthello != NULL)
-        OPENSSL_free(clienthello->pre_proc_exts);
-    OPENSSL_free(clienthello);
+        ssl_hs_arena_free(s, clienthello->pre_proc_exts);
+    ssl_hs_arena_free(s, clienthello);
 #ifndef OPENSSL_NO_ECH
     s->clienthello = NULL;
     OPENSSL_free(s->ext.ech.innerch);
@@ -2335,23 +2335,24 @@ static int tls_early_post_process_client_hello(SSL_CONNECTION *s)
 
     sk_SSL_CIPHER_free(ciphers);
     sk_SSL_CIPHER_free(scsvs);
-    OPENSSL_free(clienthello->pre_proc_exts);
-    OPENSSL_free(s->clienthello);
+    ssl_hs_arena_free(s, clienthello->pre_proc_exts);
+    ssl_hs_arena_free(s, s->clienthello);
     s->clienthello = NULL;
     return 1;
 err:
     sk_SSL_CIPHER_free(ciphers);
     sk_SSL_CIPHER_free(scsvs);
     if (clienthello != NULL)
-        OPENSSL_free(clienthello->pre_proc_exts);
-    OPENSSL_free(s->clienthello);
+        ssl_hs_arena_free(s, clienthello->pre_proc_exts);
+    ssl_hs_arena_free(s, s->clienthello);
     s->clienthello = NULL;
 
     return 0;
 }
 
 /*
- * Call the status request callback if needed. Upon success, returns 1.
+ * Call the status request callback if needed, or check whether the OCSP
+ * stapler has a response if there is no callback. Upon success, returns 1.
  * Upon failure, returns 0.
  */
 static int tls_handle_status_request(SSL_CONNECTION *s)
@@ -2360,6 +2361,18 @@ static int tls_handle_status_request(SSL_CONNECTION *s)
 
     s->ext.status_expected = 0;
 
+#ifndef OPENSSL_NO_OCSP
+    if (s->ext.status_type != TLSEXT_STATUSTYPE_nothing && sctx != NULL
+        && sctx->ext.status_cb == NULL && sctx->ext.ocsp_stapler != NULL) {
+        if (s->s3.tmp.cert != NULL) {
+            s->cert->key = s->s3.tmp.cert;
+            s->ext.status_expected = ssl_ocsp_stapler_has(sctx->ext.ocsp_stapler,
+                s->s3.tmp.cert->x509);
+        }
+        return 1;
+    }
+#endif
+
     /*
      * If status request then ask callback what to do. Note: this must be
      * called after servername callbacks in case the certificate has changed,
@@ -4051,10 +4064,10 @@ MSG_PROCESS_RETURN tls_process_client_certificate(SSL_CONNECTION *s,
                 || !tls_parse_all_extensions(s, SSL_EXT_TLS1_3_CERTIFICATE,
                     rawexts, x, chainidx,
                     PACKET_remaining(&spkt) == 0)) {
-                OPENSSL_free(rawexts);
+                ssl_hs_arena_free(s, rawexts);
                 goto err;
             }
-            OPENSSL_free(rawexts);
+            ssl_hs_arena_free(s, rawexts);
         }
 
         if (!sk_X509_push(sk, x)) {
@@ -4317,7 +4330,7 @@ static CON_FUNC_RETURN construct_stateless_ticket(SSL_CONNECTION *s,
         goto err;
     }
 
-    ctx = EVP_CIPHER_CTX_new();
+    ctx = ssl_ctx_pool_get_cipher(tctx);
     if (ctx == NULL) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_EVP_LIB);
         goto err;
@@ -4399,7 +4412,7 @@ static CON_FUNC_RETURN construct_stateless_ticket(SSL_CONNECTION *s,
                 goto err;
             }
             OPENSSL_free(senc);
-            EVP_CIPHER_CTX_free(ctx);
+            ssl_ctx_pool_put_cipher(tctx, ctx);
             ssl_hmac_destruct(constructed_hctx);
             return CON_FUNC_SUCCESS;
         }
@@ -4412,12 +4425,18 @@ static CON_FUNC_RETURN construct_stateless_ticket(SSL_CONNECTION *s,
             SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
             goto err;
         }
+    } else if (tctx->ext.ticket_keyring != NULL) {
+        if (!ssl_ticket_keyring_encrypt_init(tctx->ext.ticket_keyring,
+                key_name, iv, &iv_len, ctx, &hctx)) {
+            SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+            goto err;
+        }
     } else {
         iv_len = EVP_CIPHER_get_iv_length(sctx->tktenc);
         if (iv_len < 0
             || RAND_bytes_ex(sctx->libctx, iv, iv_len, 0) <= 0
-            || !EVP_EncryptInit_ex(ctx, sctx->tktenc, NULL,
-                tctx->ext.secure->tick_aes_key, iv)
+            || !ssl_ctx_pool_cipher_init(ctx, sctx->tktenc,
+                tctx->ext.secure->tick_aes_key, iv, 1)
             || !ssl_hmac_init(&hctx, tctx->ext.secure->tick_hmac_key,
                 sizeof(tctx->ext.secure->tick_hmac_key),
                 "SHA256")) {
@@ -4470,7 +4489,7 @@ static CON_FUNC_RETURN construct_stateless_ticket(SSL_CONNECTION *s,
     ok = CON_FUNC_SUCCESS;
 err:
     OPENSSL_free(senc);
-    EVP_CIPHER_CTX_free(ctx);
+    ssl_ctx_pool_put_cipher(tctx, ctx);
     ssl_hmac_destruct(constructed_hctx);
     return ok;
 }
@@ -4676,9 +4695,48 @@ int tls_construct_cert_status_body(SSL_CONNECTION *s, OCSP_RESPONSE *resp, WPACK
     return 1;
 }
 
+#ifndef OPENSSL_NO_OCSP
+/*
+ * As tls_construct_cert_status_body() but for a response from the OCSP
+ * stapler, which is sent as it is.
+ */
+int tls_construct_cert_status_staple(SSL_CONNECTION *s,
+    const SSL_OCSP_STAPLE *staple,
+    WPACKET *pkt)
+{
+    const unsigned char *der;
+    size_t len;
+
+    der = ssl_ocsp_staple_get0_der(staple, &len);
+    if (!WPACKET_put_bytes_u8(pkt, s->ext.status_type)
+        || !WPACKET_sub_memcpy_u24(pkt, der, len)) {
+        SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+        return 0;
+    }
+    return 1;
+}
+#endif
+
 CON_FUNC_RETURN tls_construct_cert_status(SSL_CONNECTION *s, WPACKET *pkt)
 {
     OCSP_RESPONSE *resp;
+#ifndef OPENSSL_NO_OCSP
+    SSL_CTX *sctx = SSL_CONNECTION_GET_CTX(s);
+
+    if (sctx->ext.status_cb == NULL && sctx->ext.ocsp_stapler != NULL) {
+        SSL_OCSP_STAPLE *staple;
+        int ok;
+
+        staple = ssl_ocsp_stapler_get1(sctx->ext.ocsp_stapler,
+            SSL_get_certificate(SSL_CONNECTION_GET_SSL(s)));
+        if (staple == NULL)
+            return CON_FUNC_DONT_SEND;
+        ok = tls_construct_cert_status_staple(s, staple, pkt);
+        ssl_ocsp_staple_free(staple);
+        /* SSLfatal() already called on error */
+        return ok ? CON_FUNC_SUCCESS : CON_FUNC_ERROR;
+    }
+#endif
 
     resp = ossl_get_ocsp_response(s, 0);
 
@@ -3224,15 +3224,17 @@ SSL_TICKET_STATUS tls_decrypt_ticket(SSL_CONNECTION *s,
         ret = SSL_TICKET_FATAL_ERR_MALLOC;
         goto end;
     }
-    ctx = EVP_CIPHER_CTX_new();
+    ctx = ssl_ctx_pool_get_cipher(tctx);
     if (ctx == NULL) {
         ret = SSL_TICKET_FATAL_ERR_MALLOC;
         goto end;
     }
 #ifndef OPENSSL_NO_DEPRECATED_3_0
-    if (tctx->ext.ticket_key_evp_cb != NULL || tctx->ext.ticket_key_cb != NULL)
+    if (tctx->ext.ticket_key_evp_cb != NULL || tctx->ext.ticket_key_cb != NULL
+        || tctx->ext.ticket_keyring != NULL)
 #else
-    if (tctx->ext.ticket_key_evp_cb != NULL)
+    if (tctx->ext.ticket_key_evp_cb != NULL
+        || tctx->ext.ticket_keyring != NULL)
 #endif
     {
         unsigned char *nctick = (unsigned char *)etick;
@@ -3252,6 +3254,10 @@ SSL_TICKET_STATUS tls_decrypt_ticket(SSL_CONNECTION *s,
                 nctick + TLSEXT_KEYNAME_LENGTH,
                 ctx, ssl_hmac_get0_HMAC_CTX(&hctx), 0);
 #endif
+        else
+            rv = ssl_ticket_keyring_decrypt_init(tctx->ext.ticket_keyring,
+                etick, etick + TLSEXT_KEYNAME_LENGTH,
+                ctx, &hctx);
         if (rv < 0) {
             ret = SSL_TICKET_FATAL_ERR_OTHER;
             goto end;
@@ -3274,10 +3280,9 @@ SSL_TICKET_STATUS tls_decrypt_ticket(SSL_CONNECTION *s,
         if (ssl_hmac_init(&hctx, tctx->ext.secure->tick_hmac_key,
                 sizeof(tctx->ext.secure->tick_hmac_key), "SHA256")
                 <= 0
-            || EVP_DecryptInit_ex(ctx, tctx->tktenc, NULL,
-                   tctx->ext.secure->tick_aes_key,
-                   etick + TLSEXT_KEYNAME_LENGTH)
-                <= 0) {
+            || !ssl_ctx_pool_cipher_init(ctx, tctx->tktenc,
+                tctx->ext.secure->tick_aes_key,
+                etick + TLSEXT_KEYNAME_LENGTH, 0)) {
             ret = SSL_TICKET_FATAL_ERR_OTHER;
             goto end;
         }
@@ -3369,7 +3374,7 @@ SSL_TICKET_STATUS tls_decrypt_ticket(SSL_CONNECTION *s,
     ret = SSL_TICKET_NO_DECRYPT;
 
 end:
-    EVP_CIPHER_CTX_free(ctx);
+    ssl_ctx_pool_put_cipher(tctx, ctx);
     ssl_hmac_destruct(constructed_hctx);
 
     /*
@@ -4971,6 +4976,9 @@ SSL_HMAC *ssl_hmac_construct(const SSL_CTX *ctx, SSL_HMAC *hctx)
         && ctx->ext.ticket_key_cb != NULL)
         return ssl_hmac_old_construct(hctx);
 #endif
+    /* The key ring hands out ready keyed contexts */
+    if (ctx->ext.ticket_key_evp_cb == NULL && ctx->ext.ticket_keyring != NULL)
+        return hctx;
     hctx->ctx = EVP_MAC_CTX_new(ctx->hmac);
     return hctx->ctx != NULL ? hctx : NULL;
 }
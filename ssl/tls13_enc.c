@@ -592,22 +592,22 @@ int tls13_change_cipher_state(SSL_CONNECTION *s, int which)
              * the session. We haven't yet selected our ciphersuite so we can't
              * use ssl_handshake_md().
              */
-            mdctx = EVP_MD_CTX_new();
+            md = ssl_md(sctx, sslcipher->algorithm2);
+            mdctx = ssl_ctx_pool_get_md(s->session_ctx, md);
             if (mdctx == NULL) {
                 SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_EVP_LIB);
                 goto err;
             }
 
-            md = ssl_md(sctx, sslcipher->algorithm2);
             if (md == NULL || !EVP_DigestInit_ex(mdctx, md, NULL)
                 || !EVP_DigestUpdate(mdctx, hdata, handlen)
                 || !EVP_DigestFinal_ex(mdctx, hashval, &hashlenui)) {
                 SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
-                EVP_MD_CTX_free(mdctx);
+                ssl_ctx_pool_put_md(s->session_ctx, mdctx);
                 goto err;
             }
             hashlen = hashlenui;
-            EVP_MD_CTX_free(mdctx);
+            ssl_ctx_pool_put_md(s->session_ctx, mdctx);
 
             if (!tls13_hkdf_expand(s, md, insecret,
                     early_exporter_master_secret,
@@ -873,7 +873,7 @@ int tls13_export_keying_material(SSL_CONNECTION *s,
     static const unsigned char exporterlabel[] = "\x65\x78\x70\x6F\x72\x74\x65\x72";
     unsigned char hash[EVP_MAX_MD_SIZE], data[EVP_MAX_MD_SIZE];
     const EVP_MD *md = ssl_handshake_md(s);
-    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    EVP_MD_CTX *ctx = ssl_ctx_pool_get_md(s->session_ctx, md);
     unsigned int hashsize, datalen;
     int ret = 0;
 
@@ -898,7 +898,7 @@ int tls13_export_keying_material(SSL_CONNECTION *s,
 
     ret = 1;
 err:
-    EVP_MD_CTX_free(ctx);
+    ssl_ctx_pool_put_md(s->session_ctx, ctx);
     return ret;
 }
 
@@ -913,12 +913,12 @@ int tls13_export_keying_material_early(SSL_CONNECTION *s,
     unsigned char exportsecret[EVP_MAX_MD_SIZE];
     unsigned char hash[EVP_MAX_MD_SIZE], data[EVP_MAX_MD_SIZE];
     const EVP_MD *md;
-    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    EVP_MD_CTX *ctx = NULL;
     unsigned int hashsize, datalen;
     int ret = 0;
     const SSL_CIPHER *sslcipher;
 
-    if (ctx == NULL || !ossl_statem_export_early_allowed(s))
+    if (!ossl_statem_export_early_allowed(s))
         goto err;
 
     if (!s->server && s->max_early_data > 0
@@ -928,6 +928,8 @@ int tls13_export_keying_material_early(SSL_CONNECTION *s,
         sslcipher = SSL_SESSION_get0_cipher(s->session);
 
     md = ssl_md(SSL_CONNECTION_GET_CTX(s), sslcipher->algorithm2);
+    if ((ctx = ssl_ctx_pool_get_md(s->session_ctx, md)) == NULL)
+        goto err;
 
     /*
      * Calculate the hash value and store it in |data|. The reason why
@@ -960,6 +962,6 @@ int tls13_export_keying_material_early(SSL_CONNECTION *s,
 
     ret = 1;
 err:
-    EVP_MD_CTX_free(ctx);
+    ssl_ctx_pool_put_md(s->session_ctx, ctx);
     return ret;
 }
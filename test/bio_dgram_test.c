@@ -97,7 +97,7 @@ static int do_recvmmsg(BIO *b, BIO_MSG *msg,
     return 1;
 }
 
-static int test_bio_dgram_impl(int af, int use_local)
+static int test_bio_dgram_impl(int af, int use_local, int use_gso)
 {
     int testresult = 0;
     BIO *b1 = NULL, *b2 = NULL;
@@ -115,6 +115,7 @@ static int test_bio_dgram_impl(int af, int use_local)
     BIO_MSG tx_msg[128], rx_msg[128];
     char tx_buf[128];
     size_t num_processed = 0;
+    int enabled = 0;
 
     if (af == AF_INET) {
         TEST_info("# Testing with AF_INET, local=%d\n", use_local);
@@ -204,6 +205,17 @@ static int test_bio_dgram_impl(int af, int use_local)
     if (!TEST_ptr(b2))
         goto err;
 
+    /* Enable GSO if we are using it; messages must still arrive one by one */
+    if (use_gso && BIO_dgram_get_gso_cap(b1) > 0) {
+        if (!TEST_int_eq(BIO_dgram_set_gso_enable(b1, 1), 1)
+            || !TEST_int_eq(BIO_dgram_get_gso_enable(b1, &enabled), 1)
+            || !TEST_int_eq(enabled, 1))
+            goto err;
+    } else if (!TEST_int_eq(BIO_dgram_get_gso_enable(b1, &enabled), 1)
+        || !TEST_int_eq(enabled, 0)) {
+        goto err;
+    }
+
     if (!TEST_int_gt(BIO_dgram_set_peer(b1, addr2), 0))
         goto err;
 
@@ -430,26 +442,150 @@ err:
 }
 
 struct bio_dgram_case {
-    int af, local;
+    int af, local, gso;
 };
 
 static const struct bio_dgram_case bio_dgram_cases[] = {
     /* Test without local */
-    { AF_INET, 0 },
+    { AF_INET, 0, 0 },
 #if OPENSSL_USE_IPV6
-    { AF_INET6, 0 },
+    { AF_INET6, 0, 0 },
 #endif
     /* Test with local */
-    { AF_INET, 1 },
+    { AF_INET, 1, 0 },
 #if OPENSSL_USE_IPV6
-    { AF_INET6, 1 }
+    { AF_INET6, 1, 0 },
+#endif
+    /* Test with GSO */
+    { AF_INET, 0, 1 },
+#if OPENSSL_USE_IPV6
+    { AF_INET6, 1, 1 }
 #endif
 };
 
 static int test_bio_dgram(int idx)
 {
     return test_bio_dgram_impl(bio_dgram_cases[idx].af,
-        bio_dgram_cases[idx].local);
+        bio_dgram_cases[idx].local,
+        bio_dgram_cases[idx].gso);
+}
+
+/*
+ * Test that GSO keeps the datagram boundaries: a run of messages of the same
+ * size followed by a shorter one must arrive as that many datagrams.
+ * Test 0: AF_INET
+ * Test 1: AF_INET6
+ * Test 2: AF_INET on a socket on which the kernel rejects GSO
+ */
+static int test_bio_dgram_gso(int idx)
+{
+    static const size_t lens[] = { 100, 100, 100, 100, 37, 60, 60 };
+    int af = idx == 1 ? AF_INET6 : AF_INET;
+    int testresult = 0, fd1 = -1, fd2 = -1, enabled = 0;
+    BIO *b1 = NULL, *b2 = NULL;
+    BIO_ADDR *addr1 = NULL, *addr2 = NULL;
+    union BIO_sock_info_u info = { 0 };
+    struct in_addr ina;
+#if OPENSSL_USE_IPV6
+    struct in6_addr ina6;
+#endif
+    void *pina = &ina;
+    size_t inal = sizeof(ina), i, off, num_processed = 0;
+    unsigned char tx_buf[600], rx_buf[OSSL_NELEM(lens)][128];
+    BIO_MSG tx_msg[OSSL_NELEM(lens)], rx_msg[OSSL_NELEM(lens)];
+
+    ina.s_addr = htonl(0x7f000001UL);
+#if OPENSSL_USE_IPV6
+    memset(&ina6, 0, sizeof(ina6));
+    ina6.s6_addr[15] = 1;
+    if (af == AF_INET6) {
+        pina = &ina6;
+        inal = sizeof(ina6);
+    }
+#else
+    if (af == AF_INET6)
+        return TEST_skip("No IPv6 support");
+#endif
+
+    if (!TEST_ptr(addr1 = BIO_ADDR_new())
+        || !TEST_ptr(addr2 = BIO_ADDR_new())
+        || !TEST_int_eq(BIO_ADDR_rawmake(addr1, af, pina, inal, 0), 1)
+        || !TEST_int_eq(BIO_ADDR_rawmake(addr2, af, pina, inal, 0), 1)
+        || !TEST_int_ge(fd1 = BIO_socket(af, SOCK_DGRAM, IPPROTO_UDP, 0), 0)
+        || !TEST_int_ge(fd2 = BIO_socket(af, SOCK_DGRAM, IPPROTO_UDP, 0), 0))
+        goto err;
+    if (BIO_bind(fd1, addr1, 0) <= 0 || BIO_bind(fd2, addr2, 0) <= 0) {
+        testresult = TEST_skip("BIO_bind() failed - assuming it's an unavailable address family");
+        goto err;
+    }
+    info.addr = addr2;
+    if (!TEST_int_gt(BIO_sock_info(fd2, BIO_SOCK_INFO_ADDRESS, &info), 0)
+        || !TEST_ptr(b1 = BIO_new_dgram(fd1, 0))
+        || !TEST_ptr(b2 = BIO_new_dgram(fd2, 0)))
+        goto err;
+    if (BIO_dgram_get_gso_cap(b1) <= 0) {
+        testresult = TEST_skip("GSO is not supported");
+        goto err;
+    }
+    if (idx == 2) {
+#ifdef SO_NO_CHECK
+        /* Linux refuses to segment datagrams that are sent without checksums */
+        int one = 1;
+
+        if (!TEST_int_eq(setsockopt(fd1, SOL_SOCKET, SO_NO_CHECK, &one,
+                             sizeof(one)),
+                0))
+            goto err;
+#else
+        testresult = TEST_skip("Cannot make the kernel reject GSO");
+        goto err;
+#endif
+    }
+    if (!TEST_int_eq(BIO_dgram_set_gso_enable(b1, 1), 1))
+        goto err;
+
+    for (i = 0, off = 0; i < OSSL_NELEM(lens); off += lens[i++]) {
+        memset(tx_buf + off, (int)i + 1, lens[i]);
+        tx_msg[i].data = tx_buf + off;
+        tx_msg[i].data_len = lens[i];
+        tx_msg[i].peer = addr2;
+        tx_msg[i].local = NULL;
+        tx_msg[i].flags = 0;
+        rx_msg[i].data = rx_buf[i];
+        rx_msg[i].data_len = sizeof(rx_buf[i]);
+        rx_msg[i].peer = NULL;
+        rx_msg[i].local = NULL;
+        rx_msg[i].flags = 0;
+    }
+    if (!TEST_true(do_sendmmsg(b1, tx_msg, OSSL_NELEM(tx_msg), 0,
+            &num_processed))
+        || !TEST_size_t_eq(num_processed, OSSL_NELEM(tx_msg))
+        || !TEST_true(do_recvmmsg(b2, rx_msg, OSSL_NELEM(rx_msg), 0,
+            &num_processed))
+        || !TEST_size_t_eq(num_processed, OSSL_NELEM(rx_msg)))
+        goto err;
+    for (i = 0; i < OSSL_NELEM(lens); i++)
+        if (!TEST_mem_eq(rx_msg[i].data, rx_msg[i].data_len,
+                tx_msg[i].data, lens[i]))
+            goto err;
+
+    /* A rejection disables GSO and is counted */
+    if (!TEST_int_eq(BIO_dgram_get_gso_enable(b1, &enabled), 1)
+        || !TEST_int_eq(enabled, idx == 2 ? 0 : 1)
+        || !TEST_uint_eq(BIO_dgram_get_gso_fallbacks(b1), idx == 2 ? 1 : 0))
+        goto err;
+
+    testresult = 1;
+err:
+    BIO_free(b1);
+    BIO_free(b2);
+    if (fd1 >= 0)
+        BIO_closesocket(fd1);
+    if (fd2 >= 0)
+        BIO_closesocket(fd2);
+    BIO_ADDR_free(addr1);
+    BIO_ADDR_free(addr2);
+    return testresult;
 }
 
 #if !defined(OPENSSL_NO_CHACHA)
@@ -803,6 +939,7 @@ int setup_tests(void)
 
 #if !defined(OPENSSL_NO_DGRAM) && !defined(OPENSSL_NO_SOCK)
     ADD_ALL_TESTS(test_bio_dgram, OSSL_NELEM(bio_dgram_cases));
+    ADD_ALL_TESTS(test_bio_dgram_gso, 3);
 #if !defined(OPENSSL_NO_CHACHA)
     ADD_ALL_TESTS(test_bio_dgram_pair, 3);
 #endif
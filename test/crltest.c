@@ -9,6 +9,7 @@
 
 #include <time.h>
 #include <openssl/bio.h>
+#include <openssl/bn.h>
 #include <openssl/crypto.h>
 #include <openssl/err.h>
 #include <openssl/pem.h>
@@ -682,6 +683,32 @@ static const char *kInvalidDateMM[] = {
     NULL
 };
 
+/*
+ * kInvalidDateMM with its first malformed entry revoking kLeaf (serial
+ * 0x1000) instead, valid at kVerify and signed again with kRoot. It can only
+ * be decoded with d2i_X509_CRL_lazy().
+ */
+static const char *kLazyLeafInvalidDate[] = {
+    "-----BEGIN X509 CRL-----\n",
+    "MIICsTCCAZkCAQEwDQYJKoZIhvcNAQELBQAweTELMAkGA1UEBhMCVVMxEzARBgNV\n",
+    "BAgMCkNhbGlmb3JuaWExFjAUBgNVBAcMDVNhbiBGcmFuY2lzY28xEzARBgNVBAoM\n",
+    "Ck15IENvbXBhbnkxEzARBgNVBAMMCk15IFJvb3QgQ0ExEzARBgNVBAsMCk15IFJv\n",
+    "b3QgQ0EXDTI2MDEwMTAwMDAwMFoXDTI3MDEwMTAwMDAwMFowgawwJQIUHIACLvgf\n",
+    "JAXulqYS3LYf4KxwHl4XDTI1MDQxNzEwMTY1MVowOQICEAAXDTI1MDMwNDAwMDAw\n",
+    "MFowJDAKBgNVHRUEAwoBADAWBgNVHRgEDxgNMjAxMTEzMTIyNDQ2WjBIAhEAjLgZ\n",
+    "PszmcewAAAAAWCyKehcNMjUwMzA0MDAwMDAwWjAkMAoGA1UdFQQDCgEEMBYGA1Ud\n",
+    "GAQPGA0yMDEyMTMxMjI1NDdaoD0wOzAYBgNVHRQEEQIPGc//3tp07fL2pEYMzuFA\n",
+    "MB8GA1UdIwQYMBaAFNdhiR+Tlot2VBbp5XfcfLdlG4AkMA0GCSqGSIb3DQEBCwUA\n",
+    "A4IBAQCi717G4Gsx0LMWUaZAvABdpC0+t6ZC8GPDJA5uTTJcJiEXavpYppr8i8BZ\n",
+    "5UmYaOhtUgvX9Yx9PrcEFO2rgd0/AsAUumI8FJLUHp1JiiGF0vKAp7YljziVfMBd\n",
+    "2UFyYpQrTBh4c6eYsFe3nbewbvRen7ksLVzE1/mSB+/KcNGgz6uLfgxF+sBZXXVK\n",
+    "6iWoRjI8GRDfdffWxGsXefictVyZ2WJ6wXLTZIrmggaD/LaqlOf49JZWMe9suSrg\n",
+    "jYAK7fyUMOEsCxheGuGKHx3lTvPKFhFbJ3GhgkuDyzsxEynBA3t4KIvBNCjQ8Vh3\n",
+    "cFgRpb6rb3r34O0Xa+eeNeBA8pCd\n",
+    "-----END X509 CRL-----\n",
+    NULL
+};
+
 static const char *kInvalidDateSS[] = {
     "-----BEGIN X509 CRL-----\n",
     "MIICdTCCAV0CAQEwDQYJKoZIhvcNAQELBQAweTELMAkGA1UEBhMCVVMxEzARBgNV\n",
@@ -2000,6 +2027,134 @@ static int test_crl_delta_valid(void)
     return test;
 }
 
+/*
+ * Create a lazy CRL, see d2i_X509_CRL_lazy(), from an array of strings.
+ */
+static X509_CRL *lazy_CRL_from_strings(const char **pem)
+{
+    X509_CRL *crl = NULL;
+    unsigned char *der = NULL;
+    const unsigned char *p;
+    char *str;
+    size_t len = 0;
+    long derlen;
+    BIO *b;
+
+    if (!TEST_ptr(str = glue_strings(pem, &len)))
+        return NULL;
+    if (TEST_ptr(b = BIO_new_mem_buf(str, (int)len))
+        && TEST_true(PEM_bytes_read_bio(&der, &derlen, NULL, PEM_STRING_X509_CRL,
+            b, NULL, NULL))) {
+        p = der;
+        crl = d2i_X509_CRL_lazy(NULL, &p, derlen);
+    }
+    OPENSSL_free(der);
+    OPENSSL_free(str);
+    BIO_free(b);
+    return crl;
+}
+
+static int lazy_lookup_eq(X509_CRL *crl, X509_CRL *lazy,
+    const ASN1_INTEGER *serial)
+{
+    X509_REVOKED *rev = NULL, *lazy_rev = NULL;
+    int ret = X509_CRL_get0_by_serial(crl, &rev, serial);
+
+    if (!TEST_int_eq(X509_CRL_get0_by_serial(lazy, &lazy_rev, serial), ret))
+        return 0;
+    if (ret == 0)
+        return 1;
+    return TEST_int_eq(ASN1_INTEGER_cmp(X509_REVOKED_get0_serialNumber(lazy_rev),
+                           serial),
+               0)
+        && TEST_int_eq(ASN1_TIME_compare(X509_REVOKED_get0_revocationDate(lazy_rev),
+                           X509_REVOKED_get0_revocationDate(rev)),
+            0);
+}
+
+static int test_crl_lazy(void)
+{
+    X509 *root = X509_from_strings(kRoot);
+    X509 *leaf = X509_from_strings(kLeaf);
+    X509_CRL *crl = CRL_from_strings(kCrlExtensionDuplicateSerial);
+    X509_CRL *lazy = lazy_CRL_from_strings(kCrlExtensionDuplicateSerial);
+    X509_CRL *bad = lazy_CRL_from_strings(kInvalidDateMM);
+    X509_CRL *badleaf = lazy_CRL_from_strings(kLazyLeafInvalidDate);
+    STACK_OF(X509_REVOKED) *revoked;
+    X509_REVOKED *rev = NULL;
+    ASN1_INTEGER *serial = ASN1_INTEGER_new();
+    BIGNUM *bn = NULL;
+    unsigned char *der = NULL, *lazy_der = NULL;
+    int i, derlen, test = 0;
+
+    if (!TEST_ptr(root)
+        || !TEST_ptr(leaf)
+        || !TEST_ptr(crl)
+        || !TEST_ptr(lazy)
+        || !TEST_ptr(serial))
+        goto err;
+
+    /* Lookups find the same entries as in the CRL decoded as usual */
+    revoked = X509_CRL_get_REVOKED(crl);
+    for (i = 0; i < sk_X509_REVOKED_num(revoked); i++)
+        if (!lazy_lookup_eq(crl, lazy,
+                X509_REVOKED_get0_serialNumber(sk_X509_REVOKED_value(revoked, i))))
+            goto err;
+    if (!TEST_true(ASN1_INTEGER_set(serial, 0x4242))
+        || !lazy_lookup_eq(crl, lazy, serial))
+        goto err;
+
+    if (!TEST_int_eq(verify(leaf, root, make_CRL_stack(lazy, NULL),
+                         X509_V_FLAG_CRL_CHECK, kVerify),
+            X509_V_ERR_CERT_REVOKED))
+        goto err;
+
+    /* All entries are there when asked for, and encoded again */
+    if (!TEST_int_eq(sk_X509_REVOKED_num(X509_CRL_get_REVOKED(lazy)),
+            sk_X509_REVOKED_num(revoked))
+        || !TEST_int_gt(derlen = i2d_X509_CRL(crl, &der), 0)
+        || !TEST_mem_eq(der, derlen, lazy_der, i2d_X509_CRL(lazy, &lazy_der)))
+        goto err;
+
+    /*
+     * An entry with a malformed invalidity date is only noticed when it is
+     * looked up, and then fails the lookup, as decoding the CRL in full
+     * would have failed. Other entries work.
+     */
+    if (!TEST_ptr(bad)
+        || !TEST_true(BN_hex2bn(&bn, "1C80022EF81F2405EE96A612DCB61FE0AC701E5E"))
+        || !TEST_ptr(BN_to_ASN1_INTEGER(bn, serial))
+        || !TEST_int_eq(X509_CRL_get0_by_serial(bad, &rev, serial), 1)
+        || !TEST_int_eq(X509_REVOKED_get_ext_count(rev), 0)
+        || !TEST_true(BN_hex2bn(&bn, "8CB8193ECCE671EC00000000582C8A7A"))
+        || !TEST_ptr(BN_to_ASN1_INTEGER(bn, serial))
+        || !TEST_int_eq(X509_CRL_get0_by_serial(bad, &rev, serial), -1)
+        || !TEST_err_s("CRL: malformed revoked entry")
+        || !TEST_ptr_null(X509_CRL_get_REVOKED(bad)))
+        goto err;
+
+    /* Nor can a certificate be checked against such an entry */
+    if (!TEST_ptr(badleaf)
+        || !TEST_int_eq(verify(leaf, root, make_CRL_stack(badleaf, NULL),
+                            X509_V_FLAG_CRL_CHECK, kVerify),
+            X509_V_ERR_UNABLE_TO_GET_CRL))
+        goto err;
+
+    test = 1;
+err:
+    OPENSSL_free(der);
+    OPENSSL_free(lazy_der);
+    BN_free(bn);
+    ASN1_INTEGER_free(serial);
+    X509_CRL_free(crl);
+    X509_CRL_free(lazy);
+    X509_CRL_free(bad);
+    X509_CRL_free(badleaf);
+    X509_free(leaf);
+    X509_free(root);
+    return test;
+}
+
 int setup_tests(void)
 {
     ADD_TEST(test_private_keys);
@@ -2034,5 +2189,6 @@ int setup_tests(void)
     ADD_ALL_TESTS(test_reuse_crl, 6);
     ADD_MFAIL_TEST(test_crl_diff_mfail);
     ADD_TEST(test_crl_sigalg_mismatch);
+    ADD_TEST(test_crl_lazy);
     return 1;
 }
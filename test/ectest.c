@@ -1222,6 +1222,39 @@ static const struct nistp_test_params nistp_tests_params[] = {
         /* d */
         "c477f9f65c22cce20657faa5b2d1d8122336f851a508a1ed04e479c34985bf96",
     },
+    {
+        /* P-384 */
+        NID_secp384r1,
+        384,
+        192,
+        /* p */
+        "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffe"
+        "ffffffff0000000000000000ffffffff",
+        /* a */
+        "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffe"
+        "ffffffff0000000000000000fffffffc",
+        /* b */
+        "b3312fa7e23ee7e4988e056be3f82d19181d9c6efe8141120314088f5013875a"
+        "c656398d8a2ed19d2a85c8edd3ec2aef",
+        /* Qx */
+        "59d9a790d9ecd1bd16b1f4e1574083d47f34a5ef284b8d54aa86da6c8942f918"
+        "d91b5c0fd956e6b7c83d5d973fc1c1f9",
+        /* Qy */
+        "fb3f5bc0e78c42dda8014c643c2614d876b1bcfbf98993cd452ac07c56381946"
+        "374ad128134a6103b08cd37da6ea6310",
+        /* Gx */
+        "aa87ca22be8b05378eb1c71ef320ad746e1d3b628ba79b9859f741e082542a38"
+        "5502f25dbf55296c3a545e3872760ab7",
+        /* Gy */
+        "3617de4a96262c6f5d9e98bf9292dc29f8f41dbd289a147ce9da3113b5f0b8c0"
+        "0a60b1ce1d7e819d7a431d7c90ea0e5f",
+        /* order */
+        "ffffffffffffffffffffffffffffffffffffffffffffffffc7634d81f4372ddf"
+        "581a0db248b0a77aecec196accc52973",
+        /* d */
+        "3f1345c0064fcd18483b7481db7f21bf82a341fcef7fa502668136bcae7d6c46"
+        "907d8b8a9cf7365059a5e13f361714dc",
+    },
     {
         /* P-521 */
         NID_secp521r1,
@@ -1274,7 +1307,7 @@ static int nistp_single_test(int idx)
     BIGNUM *n = NULL, *m = NULL, *order = NULL, *yplusone = NULL;
     EC_GROUP *NISTP = NULL;
     EC_POINT *G = NULL, *P = NULL, *Q = NULL, *Q_CHECK = NULL;
-    int r = 0;
+    int i, r = 0;
 
     TEST_note("NIST curve P-%d (optimised implementation):",
         test->degree);
@@ -1383,6 +1416,32 @@ static int nistp_single_test(int idx)
         || !TEST_int_eq(0, EC_POINT_cmp(NISTP, Q, G, ctx)))
         goto err;
 
+    /*
+     * fixed point multiplication, which may use a table of multiples of the
+     * generator, must agree with random point multiplication: for the order
+     * and its neighbours, for all ones, and for random scalars
+     */
+    for (i = 0; i < 20; i++) {
+        if (i < 3) {
+            if (!TEST_true(BN_copy(m, order))
+                || !TEST_true(BN_add_word(m, 1))
+                || !TEST_true(BN_sub_word(m, i)))
+                goto err;
+        } else if (i == 3) {
+            if (!TEST_true(BN_set_word(m, 0))
+                || !TEST_true(BN_set_bit(m, test->degree))
+                || !TEST_true(BN_sub_word(m, 1)))
+                goto err;
+        } else if (!TEST_true(BN_rand(m, test->degree, BN_RAND_TOP_ANY,
+                       BN_RAND_BOTTOM_ANY))) {
+            goto err;
+        }
+        if (!TEST_true(EC_POINT_mul(NISTP, Q, m, NULL, NULL, ctx))
+            || !TEST_true(EC_POINT_mul(NISTP, P, NULL, G, m, ctx))
+            || !TEST_int_eq(0, EC_POINT_cmp(NISTP, Q, P, ctx)))
+            goto err;
+    }
+
     r = 1;
 err:
     EC_GROUP_free(NISTP);
@@ -1790,6 +1790,266 @@ out:
     return ret;
 }
 
+#define BATCH_NUM 70
+
+/*
+ * Sign and verify a batch of messages with Ed25519 and with ECDSA, both of
+ * which go through the generic one at a time fallback.
+ */
+static int test_EVP_PKEY_batch(int tst)
+{
+    int ret = 0;
+    EVP_PKEY *pkey = NULL;
+    EVP_PKEY_CTX *ctx = NULL;
+    EVP_SIGNATURE *alg = NULL;
+    unsigned char msgs[BATCH_NUM + 32];
+    unsigned char *sigs[BATCH_NUM] = { NULL };
+    const unsigned char *tbs[BATCH_NUM];
+    size_t tbslens[BATCH_NUM], siglens[BATCH_NUM], sig_len = 0;
+    int results[BATCH_NUM];
+    size_t i;
+
+    if (tst == 0) {
+#ifndef OPENSSL_NO_ECX
+        pkey = EVP_PKEY_Q_keygen(testctx, testpropq, "ED25519");
+        if (!TEST_ptr(alg = EVP_SIGNATURE_fetch(testctx, "ED25519", testpropq)))
+            goto out;
+#else
+        return TEST_skip("ECX is disabled");
+#endif
+    } else {
+#ifndef OPENSSL_NO_EC
+        pkey = EVP_PKEY_Q_keygen(testctx, testpropq, "EC", "P-256");
+#else
+        return TEST_skip("EC is disabled");
+#endif
+    }
+    if (!TEST_ptr(pkey))
+        goto out;
+
+    for (i = 0; i < sizeof(msgs); i++)
+        msgs[i] = (unsigned char)i;
+
+    ctx = EVP_PKEY_CTX_new_from_pkey(testctx, pkey, testpropq);
+    if (!TEST_ptr(ctx)
+        || !TEST_int_gt(alg != NULL
+                            ? EVP_PKEY_sign_message_init(ctx, alg, NULL)
+                            : EVP_PKEY_sign_init(ctx),
+            0)
+        || !TEST_int_gt(EVP_PKEY_sign(ctx, NULL, &sig_len, msgs, 32), 0))
+        goto out;
+
+    for (i = 0; i < BATCH_NUM; i++) {
+        /* ECDSA signs digests, so only Ed25519 gets messages of any length */
+        tbs[i] = msgs + i;
+        tbslens[i] = tst == 0 ? i % 32 : 32;
+        siglens[i] = sig_len;
+        if (!TEST_ptr(sigs[i] = OPENSSL_malloc(sig_len)))
+            goto out;
+    }
+
+    if (!TEST_int_eq(EVP_PKEY_sign_batch(ctx, BATCH_NUM, sigs, siglens,
+                         tbs, tbslens),
+            1)
+        || !TEST_int_gt(alg != NULL
+                            ? EVP_PKEY_verify_message_init(ctx, alg, NULL)
+                            : EVP_PKEY_verify_init(ctx),
+            0)
+        || !TEST_int_eq(EVP_PKEY_verify_batch(ctx, BATCH_NUM,
+                            (const unsigned char **)sigs, siglens,
+                            tbs, tbslens, NULL),
+            1)
+        || !TEST_int_eq(EVP_PKEY_verify_batch(ctx, BATCH_NUM,
+                            (const unsigned char **)sigs, siglens,
+                            tbs, tbslens, results),
+            1))
+        goto out;
+    for (i = 0; i < BATCH_NUM; i++)
+        if (!TEST_int_eq(results[i], 1))
+            goto out;
+
+    /* A single bad signature must fail the batch and be pointed out */
+    sigs[BATCH_NUM - 3][siglens[BATCH_NUM - 3] / 2] ^= 0x01;
+    if (!TEST_int_eq(EVP_PKEY_verify_batch(ctx, BATCH_NUM,
+                         (const unsigned char **)sigs, siglens,
+                         tbs, tbslens, NULL),
+            0)
+        || !TEST_int_eq(EVP_PKEY_verify_batch(ctx, BATCH_NUM,
+                            (const unsigned char **)sigs, siglens,
+                            tbs, tbslens, results),
+            0))
+        goto out;
+    for (i = 0; i < BATCH_NUM; i++)
+        if (!TEST_int_eq(results[i], i != BATCH_NUM - 3))
+            goto out;
+
+    /* Signatures do not verify against a different message */
+    tbs[0] = msgs + 1;
+    tbslens[0] = 32;
+    if (!TEST_int_eq(EVP_PKEY_verify_batch(ctx, 1,
+                         (const unsigned char **)sigs, siglens,
+                         tbs, tbslens, results),
+            0)
+        || !TEST_int_eq(results[0], 0))
+        goto out;
+
+    ret = 1;
+out:
+    for (i = 0; i < BATCH_NUM; i++)
+        OPENSSL_free(sigs[i]);
+    EVP_SIGNATURE_free(alg);
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(pkey);
+    return ret;
+}
+
+#ifndef OPENSSL_NO_ECX
+/*
+ * Ed25519 signatures with small order components, which pass the cofactored
+ * verification equation but not the cofactorless one used by
+ * EVP_PKEY_verify().  Batch verification must reach the same verdicts.
+ */
+static const unsigned char ed25519_seed[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+/* Signed with |ed25519_seed|, R has an added component of order 8 */
+static const unsigned char ed25519_mixed_r_sig[] = {
+    0x4c, 0x26, 0x19, 0x51, 0xfb, 0xa9, 0xf4, 0xba,
+    0x7e, 0xce, 0x40, 0x43, 0x1f, 0x21, 0x22, 0x69,
+    0xf5, 0x8b, 0xec, 0xc2, 0x47, 0x3c, 0x54, 0xce,
+    0xcd, 0xa0, 0xe8, 0xf1, 0xe6, 0xf9, 0xd2, 0x53,
+    0xd3, 0xa7, 0x1a, 0x15, 0x9b, 0x58, 0x74, 0xf0,
+    0xdb, 0x9d, 0x42, 0x86, 0x12, 0x9e, 0xab, 0xc0,
+    0x56, 0x1e, 0x4d, 0xbe, 0xb7, 0x63, 0x85, 0xf8,
+    0x2f, 0x98, 0xe3, 0xf2, 0xc0, 0xad, 0x58, 0x09
+};
+
+/* A point of order 8 */
+static const unsigned char ed25519_order8_pub[] = {
+    0x26, 0xe8, 0x95, 0x8f, 0xc2, 0xb2, 0x27, 0xb0,
+    0x45, 0xc3, 0xf4, 0x89, 0xf2, 0xef, 0x98, 0xf0,
+    0xd5, 0xdf, 0xac, 0x05, 0xd3, 0xc6, 0x33, 0x39,
+    0xb1, 0x38, 0x02, 0x88, 0x6d, 0x53, 0xfc, 0x05
+};
+
+/*
+ * R is the neutral element and S is zero, which is valid for
+ * |ed25519_order8_pub| exactly when the hash is a multiple of 8.  That is
+ * the case for the message 0x08 but not for 0x00.
+ */
+static const unsigned char ed25519_neutral_sig[] = {
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+#define SMALL_ORDER_NUM 5
+
+static int test_EVP_PKEY_batch_small_order(int tst)
+{
+    static const unsigned char mixed_r_msg[] = "small order component";
+    static const unsigned char neutral_msgs[] = { 0x00, 0x08 };
+    int ret = 0;
+    EVP_PKEY *pkey = NULL;
+    EVP_PKEY_CTX *ctx = NULL;
+    EVP_SIGNATURE *alg = NULL;
+    unsigned char sigbuf[SMALL_ORDER_NUM][64];
+    const unsigned char *sigs[SMALL_ORDER_NUM], *tbs[SMALL_ORDER_NUM];
+    size_t siglens[SMALL_ORDER_NUM], tbslens[SMALL_ORDER_NUM];
+    int results[SMALL_ORDER_NUM], expected[SMALL_ORDER_NUM];
+    size_t i, num;
+
+    if (!TEST_ptr(alg = EVP_SIGNATURE_fetch(testctx, "ED25519", testpropq)))
+        goto out;
+
+    if (tst == 0) {
+        /* Valid signatures surrounding one with a mixed order R */
+        num = SMALL_ORDER_NUM;
+        pkey = EVP_PKEY_new_raw_private_key_ex(testctx, "ED25519", testpropq,
+            ed25519_seed, sizeof(ed25519_seed));
+        ctx = EVP_PKEY_CTX_new_from_pkey(testctx, pkey, testpropq);
+        if (!TEST_ptr(pkey)
+            || !TEST_ptr(ctx)
+            || !TEST_int_gt(EVP_PKEY_sign_message_init(ctx, alg, NULL), 0))
+            goto out;
+        for (i = 0; i < num; i++) {
+            tbs[i] = mixed_r_msg + i;
+            tbslens[i] = sizeof(mixed_r_msg) - 1 - i;
+            siglens[i] = sizeof(sigbuf[i]);
+            sigs[i] = sigbuf[i];
+            expected[i] = 1;
+            if (!TEST_int_gt(EVP_PKEY_sign(ctx, sigbuf[i], &siglens[i],
+                                 tbs[i], tbslens[i]),
+                    0))
+                goto out;
+        }
+        memcpy(sigbuf[2], ed25519_mixed_r_sig, sizeof(ed25519_mixed_r_sig));
+        expected[2] = 0;
+    } else {
+        /* A public key of order 8 */
+        num = 2;
+        pkey = EVP_PKEY_new_raw_public_key_ex(testctx, "ED25519", testpropq,
+            ed25519_order8_pub,
+            sizeof(ed25519_order8_pub));
+        ctx = EVP_PKEY_CTX_new_from_pkey(testctx, pkey, testpropq);
+        if (!TEST_ptr(pkey) || !TEST_ptr(ctx))
+            goto out;
+        for (i = 0; i < num; i++) {
+            tbs[i] = neutral_msgs + i;
+            tbslens[i] = 1;
+            sigs[i] = ed25519_neutral_sig;
+            siglens[i] = sizeof(ed25519_neutral_sig);
+            expected[i] = neutral_msgs[i] == 0x08;
+        }
+    }
+
+    for (i = 0; i < num; i++)
+        if (!TEST_int_gt(EVP_PKEY_verify_message_init(ctx, alg, NULL), 0)
+            || !TEST_int_eq(EVP_PKEY_verify(ctx, sigs[i], siglens[i],
+                                tbs[i], tbslens[i]) > 0,
+                expected[i]))
+            goto out;
+
+    if (!TEST_int_gt(EVP_PKEY_verify_message_init(ctx, alg, NULL), 0)
+        || !TEST_int_eq(EVP_PKEY_verify_batch(ctx, num, sigs, siglens,
+                            tbs, tbslens, NULL),
+            0)
+        || !TEST_int_eq(EVP_PKEY_verify_batch(ctx, num, sigs, siglens,
+                            tbs, tbslens, results),
+            0))
+        goto out;
+    for (i = 0; i < num; i++)
+        if (!TEST_int_eq(results[i], expected[i]))
+            goto out;
+
+    /* The signatures that verify on their own also do so as a batch */
+    if (!TEST_int_eq(EVP_PKEY_verify_batch(ctx, 1, sigs + num - 1,
+                         siglens + num - 1, tbs + num - 1,
+                         tbslens + num - 1, NULL),
+            1)
+        || !TEST_int_eq(EVP_PKEY_verify_batch(ctx, 2, sigs, siglens,
+                            tbs, tbslens, NULL),
+            tst == 0))
+        goto out;
+
+    ret = 1;
+out:
+    EVP_SIGNATURE_free(alg);
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(pkey);
+    return ret;
+}
+#endif
+
 #ifndef OPENSSL_NO_DEPRECATED_3_0
 static int test_EVP_PKEY_sign_with_app_method(int tst)
 {
@@ -2293,6 +2553,64 @@ out:
     return ret;
 }
 
+static const char *multi_digests[] = {
+    "SHA2-224", "SHA2-256", "SHA2-384", "SHA2-512", "SHA1"
+};
+
+/* Check that EVP_Digest_multi() gives the same digests as EVP_Digest() */
+static int test_EVP_Digest_multi(int idx)
+{
+    static const size_t lens[] = {
+        0, 1, 55, 56, 63, 64, 111, 112, 127, 128, 1000
+    };
+    int ret = 0;
+    EVP_MD *md = NULL;
+    unsigned char *data = NULL;
+    unsigned char digests[17][EVP_MAX_MD_SIZE];
+    unsigned char expected[EVP_MAX_MD_SIZE];
+    const unsigned char *in[17];
+    unsigned char *out[17];
+    size_t inl[17], n, i, j;
+    unsigned int mdlen;
+
+    if (!TEST_ptr(md = EVP_MD_fetch(testctx, multi_digests[idx], testpropq))
+        || !TEST_ptr(data = OPENSSL_malloc(17 * 1000)))
+        goto out;
+    for (i = 0; i < 17 * 1000; i++)
+        data[i] = (unsigned char)(i * 7 + i / 251);
+
+    for (n = 0; n <= OSSL_NELEM(in); n++) {
+        /* Messages of the same length, and then of mixed lengths */
+        for (j = 0; j <= OSSL_NELEM(lens); j++) {
+            for (i = 0; i < n; i++) {
+                in[i] = data + i * 1000;
+                if (j < OSSL_NELEM(lens))
+                    inl[i] = lens[j];
+                else
+                    inl[i] = lens[(i * 5 + n) % OSSL_NELEM(lens)];
+                out[i] = digests[i];
+            }
+            if (!TEST_true(EVP_Digest_multi(md, n, in, inl, out)))
+                goto out;
+            for (i = 0; i < n; i++) {
+                if (!TEST_true(EVP_Digest(in[i], inl[i], expected, &mdlen, md,
+                        NULL))
+                    || !TEST_mem_eq(digests[i], mdlen, expected, mdlen)) {
+                    TEST_note("%zu messages, message %zu of length %zu",
+                        n, i, inl[i]);
+                    goto out;
+                }
+            }
+        }
+    }
+    ret = 1;
+
+out:
+    OPENSSL_free(data);
+    EVP_MD_free(md);
+    return ret;
+}
+
 static int test_EVP_md_null(void)
 {
     int ret = 0;
@@ -8624,15 +8942,29 @@ end:
 }
 #endif /*OPENSSL_NO_DES */
 
-static int test_evp_cipher_pipeline(void)
+static const struct {
+    const char *name;
+    const char *propq;
+    size_t keylen;
+} pipeline_ciphers[] = {
+    { "AES-256-GCM", "provider=fake-pipeline", 32 },
+    { "AES-128-GCM", "provider!=fake-pipeline", 16 },
+    { "AES-256-GCM", "provider!=fake-pipeline", 32 },
+#if !defined(OPENSSL_NO_CHACHA) && !defined(OPENSSL_NO_POLY1305)
+    { "ChaCha20-Poly1305", "provider!=fake-pipeline", 32 },
+#endif
+};
+
+static int test_evp_cipher_pipeline(int idx)
 {
     OSSL_PROVIDER *fake_pipeline = NULL;
     int testresult = 0;
     EVP_CIPHER *cipher = NULL;
     EVP_CIPHER *pipeline_cipher = NULL;
+    EVP_CIPHER *ccm_cipher = NULL;
     EVP_CIPHER_CTX *ctx = NULL;
     unsigned char key[32];
-    size_t keylen = 32;
+    size_t keylen = pipeline_ciphers[idx].keylen;
     size_t ivlen = EVP_GCM_TLS_EXPLICIT_IV_LEN + EVP_GCM_TLS_FIXED_IV_LEN;
     size_t taglen = EVP_GCM_TLS_TAG_LEN;
     unsigned char *iv_array[EVP_MAX_PIPES], *tag_array[EVP_MAX_PIPES];
@@ -8649,16 +8981,25 @@ static int test_evp_cipher_pipeline(void)
 
     if (!TEST_ptr(fake_pipeline = fake_pipeline_start(testctx)))
         return 0;
-    if (!TEST_ptr(pipeline_cipher = EVP_CIPHER_fetch(testctx, "AES-256-GCM",
-                      "provider=fake-pipeline"))
-        || !TEST_ptr(cipher = EVP_CIPHER_fetch(testctx, "AES-256-GCM",
+    /* The FIPS provider has no ChaCha20-Poly1305 */
+    if (idx == 3 && OSSL_PROVIDER_available(testctx, "fips")) {
+        testresult = TEST_skip("ChaCha20-Poly1305 not available");
+        goto end;
+    }
+    if (!TEST_ptr(pipeline_cipher = EVP_CIPHER_fetch(testctx,
+                      pipeline_ciphers[idx].name,
+                      pipeline_ciphers[idx].propq))
+        || !TEST_ptr(cipher = EVP_CIPHER_fetch(testctx,
+                         pipeline_ciphers[idx].name,
+                         "provider!=fake-pipeline"))
+        || !TEST_ptr(ccm_cipher = EVP_CIPHER_fetch(testctx, "AES-256-CCM",
                          "provider!=fake-pipeline"))
         || !TEST_ptr(ctx = EVP_CIPHER_CTX_new()))
         goto end;
     memset(key, 0x01, sizeof(key));
 
     /* Negative tests */
-    if (!TEST_false(EVP_CIPHER_can_pipeline(cipher, 1)))
+    if (!TEST_false(EVP_CIPHER_can_pipeline(ccm_cipher, 1)))
         goto end;
     if (!TEST_false(EVP_CIPHER_can_pipeline(EVP_aes_256_gcm(), 1)))
         goto end;
@@ -8832,6 +9173,7 @@ end:
     EVP_CIPHER_CTX_free(ctx);
     EVP_CIPHER_free(cipher);
     EVP_CIPHER_free(pipeline_cipher);
+    EVP_CIPHER_free(ccm_cipher);
     fake_pipeline_finish(fake_pipeline);
     return testresult;
 }
@@ -9355,11 +9697,16 @@ int setup_tests(void)
     ADD_TEST(test_siphash_digestsign);
 #endif
     ADD_TEST(test_EVP_Digest);
+    ADD_ALL_TESTS(test_EVP_Digest_multi, OSSL_NELEM(multi_digests));
     ADD_TEST(test_EVP_md_null);
 #ifndef OPENSSL_NO_POLY1305
     ADD_TEST(test_evp_mac_poly1305_no_key);
 #endif
     ADD_ALL_TESTS(test_EVP_PKEY_sign, 3);
+    ADD_ALL_TESTS(test_EVP_PKEY_batch, 2);
+#ifndef OPENSSL_NO_ECX
+    ADD_ALL_TESTS(test_EVP_PKEY_batch_small_order, 2);
+#endif
 #ifndef OPENSSL_NO_DEPRECATED_3_0
     ADD_ALL_TESTS(test_EVP_PKEY_sign_with_app_method, 2);
 #endif
@@ -9493,7 +9840,7 @@ int setup_tests(void)
     ADD_TEST(test_evp_cipher_negative_length);
     ADD_TEST(test_aes_xts_rejects_missing_iv);
 
-    ADD_TEST(test_evp_cipher_pipeline);
+    ADD_ALL_TESTS(test_evp_cipher_pipeline, OSSL_NELEM(pipeline_ciphers));
 
 #ifndef OPENSSL_NO_ML_KEM
     ADD_ALL_TESTS(test_ml_kem_seed_only, 2);
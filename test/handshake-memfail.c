@@ -43,12 +43,15 @@ static int mcount, rcount, fcount, scount, srcount;
  * establishment. It is intended for use in testing scenarios to validate
  * handshake behavior using specified certificates and keys.
  *
+ * @param libctx     Library context to use.
+ * @param arena_size Size of the handshake arena, or 0 to use none.
+ *
  * @return 1 on successful handshake, 0 on failure.
  *
  * @note The function uses @c TEST_true() macros to validate intermediate
  *       steps. All SSL objects and contexts are freed before returning.
  */
-static int do_handshake(OSSL_LIB_CTX *libctx)
+static int do_handshake(OSSL_LIB_CTX *libctx, long arena_size)
 {
     SSL_CTX *cctx = NULL, *sctx = NULL;
     SSL *clientssl = NULL, *serverssl = NULL;
@@ -60,6 +63,9 @@ static int do_handshake(OSSL_LIB_CTX *libctx)
             &sctx, &cctx, cert, privkey)))
         return 0;
 
+    SSL_CTX_set_handshake_arena_size(sctx, arena_size);
+    SSL_CTX_set_handshake_arena_size(cctx, arena_size);
+
     /* Now do a handshake */
     if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl,
             &clientssl, NULL, NULL))
@@ -78,11 +84,21 @@ end:
     return testresult;
 }
 
+/**
+ * @brief Performs a handshake without and then with a handshake arena.
+ *
+ * @return 1 if both handshakes succeed, 0 otherwise.
+ */
+static int do_workload(OSSL_LIB_CTX *libctx)
+{
+    return do_handshake(libctx, 0) && do_handshake(libctx, 16384);
+}
+
 /**
  * @brief run our workload to count the number of allocations we make.
  *
- * Creates a new OpenSSL library context and performs a test SSL/TLS
- * handshake. The number of malloc operations is recorded and printed for
+ * Creates a new OpenSSL library context and performs the test SSL/TLS
+ * handshakes. The number of malloc operations is recorded and printed for
  * diagnostic purposes.
  *
  * @return 1 if the handshake succeeds, 0 otherwise.
@@ -96,7 +112,7 @@ static int test_record_alloc_counts(void)
     if (!TEST_ptr(libctx))
         return 0;
 
-    ret = do_handshake(libctx);
+    ret = do_workload(libctx);
 
     OSSL_LIB_CTX_free(libctx);
     libctx = NULL;
@@ -107,8 +123,8 @@ static int test_record_alloc_counts(void)
 /**
  * @brief run our workload to count the number of allocations we make.
  *
- * Creates a new OpenSSL library context and performs a test SSL/TLS
- * handshake.
+ * Creates a new OpenSSL library context and performs the test SSL/TLS
+ * handshakes.
  *
  * Note this is exactly the same as test_record_alloc_counts with 1 difference
  * The test always returns 1.  We do this because with allocation failures
@@ -123,7 +139,7 @@ static int test_alloc_failures(void)
     if (!TEST_ptr(libctx))
         return 1;
 
-    do_handshake(libctx);
+    do_workload(libctx);
 
     OSSL_LIB_CTX_free(libctx);
     libctx = NULL;
@@ -80,6 +80,7 @@ static int test_sign_verify(int evp_type)
             NULL, 0 /* no context */,
             NULL, 0 /* deterministic */,
             1 /* encode */,
+            0 /* threads */,
             sig, &sig_len, params->sig_len)))
         goto err;
     if (!TEST_size_t_eq(sig_len, params->sig_len))
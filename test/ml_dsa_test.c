@@ -1,5 +1,5 @@
 /*
- * Copyright 2024-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2024-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -11,6 +11,7 @@
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/proverr.h>
+#include <openssl/thread.h>
 #include "internal/nelem.h"
 #include "testutil.h"
 #include "ml_dsa.inc"
@@ -122,19 +123,24 @@ err:
     return ret;
 }
 
-static int ml_dsa_siggen_test(int tst_id)
+/*
+ * With |precompute| set, the KAT signature is made with a duplicate of a key
+ * that is precomputed for signing.  With |threads| set, it is made on that
+ * many threads.
+ */
+static int do_ml_dsa_siggen(int tst_id, int precompute, uint32_t threads)
 {
     int ret = 0;
     const ML_DSA_SIG_GEN_TEST_DATA *td = &ml_dsa_siggen_testdata[tst_id];
     EVP_PKEY_CTX *sctx = NULL;
-    EVP_PKEY *pkey = NULL;
+    EVP_PKEY *pkey = NULL, *pkey_copy = NULL;
     EVP_SIGNATURE *sig_alg = NULL;
-    OSSL_PARAM params[4], *p = params;
+    OSSL_PARAM params[5], *p = params;
     uint8_t *psig = NULL;
     size_t psig_len = 0, sig_len2 = 0;
     uint8_t digest[32];
     size_t digest_len = sizeof(digest);
-    int encode = 0, deterministic = 1;
+    int encode = 0, deterministic = 1, flag = 0;
 
     *p++ = OSSL_PARAM_construct_int(OSSL_SIGNATURE_PARAM_DETERMINISTIC, &deterministic);
     *p++ = OSSL_PARAM_construct_int(OSSL_SIGNATURE_PARAM_MESSAGE_ENCODING, &encode);
@@ -142,6 +148,9 @@ static int ml_dsa_siggen_test(int tst_id)
         *p++ = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_TEST_ENTROPY,
             (char *)td->add_random,
             td->add_random_len);
+    if (threads != 0)
+        *p++ = OSSL_PARAM_construct_uint32(OSSL_SIGNATURE_PARAM_THREADS,
+            &threads);
     *p = OSSL_PARAM_construct_end();
 
     /*
@@ -149,8 +158,21 @@ static int ml_dsa_siggen_test(int tst_id)
      * The keygen path is tested via ml_dsa_keygen_test
      */
     if (!TEST_true(ml_dsa_create_keypair(&pkey, td->alg, td->priv, td->priv_len,
-            NULL, 0, 1))
-        || !TEST_ptr(sctx = EVP_PKEY_CTX_new_from_pkey(lib_ctx, pkey, NULL))
+            NULL, 0, 1)))
+        goto err;
+    if (precompute) {
+        if (!TEST_true(EVP_PKEY_set_int_param(pkey,
+                OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE, 1))
+            || !TEST_ptr(pkey_copy = EVP_PKEY_dup(pkey))
+            || !TEST_true(EVP_PKEY_get_int_param(pkey_copy,
+                OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE, &flag))
+            || !TEST_int_eq(flag, 1))
+            goto err;
+        EVP_PKEY_free(pkey);
+        pkey = pkey_copy;
+        pkey_copy = NULL;
+    }
+    if (!TEST_ptr(sctx = EVP_PKEY_CTX_new_from_pkey(lib_ctx, pkey, NULL))
         || !TEST_ptr(sig_alg = EVP_SIGNATURE_fetch(lib_ctx, td->alg, NULL))
         || !TEST_int_eq(EVP_PKEY_sign_message_init(sctx, sig_alg, params), 1)
         || !TEST_int_eq(EVP_PKEY_sign(sctx, NULL, &psig_len,
@@ -172,11 +194,34 @@ static int ml_dsa_siggen_test(int tst_id)
 err:
     EVP_SIGNATURE_free(sig_alg);
     EVP_PKEY_free(pkey);
+    EVP_PKEY_free(pkey_copy);
     EVP_PKEY_CTX_free(sctx);
     OPENSSL_free(psig);
     return ret;
 }
 
+static int ml_dsa_siggen_test(int tst_id)
+{
+    return do_ml_dsa_siggen(tst_id, 0, 0);
+}
+
+static int ml_dsa_siggen_precompute_test(int tst_id)
+{
+    return do_ml_dsa_siggen(tst_id, 1, 0);
+}
+
+/* Running the rejection loop on several threads must not change signatures */
+static int ml_dsa_siggen_threads_test(int tst_id)
+{
+    /* Without thread pool support this signs on the calling thread */
+    if ((OSSL_get_thread_support_flags()
+            & OSSL_THREAD_SUPPORT_FLAG_DEFAULT_SPAWN)
+            != 0
+        && !TEST_int_eq(OSSL_set_max_threads(lib_ctx, 3), 1))
+        return 0;
+    return do_ml_dsa_siggen(tst_id, tst_id % 2, 4);
+}
+
 static int ml_dsa_sigver_test(int tst_id)
 {
     int ret = 0;
@@ -787,6 +832,12 @@ int setup_tests(void)
         ADD_ALL_TESTS(ml_dsa_siggen_upd_test, OSSL_NELEM(ml_dsa_siggen_testdata));
         ADD_ALL_TESTS(ml_dsa_sigver_upd_test, OSSL_NELEM(ml_dsa_sigver_testdata));
     }
+    if (fips_provider_version_ge(lib_ctx, 4, 1, 0)) {
+        ADD_ALL_TESTS(ml_dsa_siggen_precompute_test,
+            OSSL_NELEM(ml_dsa_siggen_testdata));
+        ADD_ALL_TESTS(ml_dsa_siggen_threads_test,
+            OSSL_NELEM(ml_dsa_siggen_testdata));
+    }
     ADD_TEST(ml_dsa_key_dup_test);
     ADD_TEST(ml_dsa_key_internal_test);
     ADD_TEST(ml_dsa_keygen_drbg_test);
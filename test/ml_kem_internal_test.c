@@ -1,5 +1,5 @@
 /*
- * Copyright 2024-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2024-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -15,6 +15,7 @@
 #include <stdio.h>
 #endif
 #include <crypto/ml_kem.h>
+#include "../crypto/ml_kem/ml_kem_local.h"
 #include "testutil.h"
 #include "testutil/output.h"
 
@@ -311,6 +312,240 @@ err:
     return ret;
 }
 
+#if ML_KEM_AVX2_ELIGIBLE || ML_KEM_NEON_ELIGIBLE
+/*
+ * Straightforward renditions of the FIPS 203 algorithms, against which the
+ * vectorised polynomial arithmetic is checked.
+ */
+#define Q 3329
+
+typedef struct {
+    const char *name;
+    int (*capable)(void);
+    void (*ntt)(uint16_t c[256]);
+    void (*inverse_ntt)(uint16_t c[256]);
+    void (*mult)(uint16_t out[256], const uint16_t lhs[256],
+        const uint16_t rhs[256]);
+    void (*mult_add)(uint16_t out[256], const uint16_t lhs[256],
+        const uint16_t rhs[256]);
+    void (*compress)(uint16_t c[256], int bits);
+    void (*decompress)(uint16_t c[256], int bits);
+    void (*cbd_2)(uint16_t out[256], const uint8_t in[128]);
+    void (*cbd_3)(uint16_t out[256], const uint8_t in[192]);
+} ML_KEM_KERNELS;
+
+#define ML_KEM_KERNELS_ENTRY(arch) { #arch, ossl_ml_kem_##arch##_capable, \
+    ossl_ml_kem_ntt_##arch, ossl_ml_kem_inverse_ntt_##arch,               \
+    ossl_ml_kem_mult_##arch, ossl_ml_kem_mult_add_##arch,                 \
+    ossl_ml_kem_compress_##arch, ossl_ml_kem_decompress_##arch,           \
+    ossl_ml_kem_cbd_2_##arch, ossl_ml_kem_cbd_3_##arch }
+
+static const ML_KEM_KERNELS ml_kem_kernels[] = {
+#if ML_KEM_AVX2_ELIGIBLE
+    ML_KEM_KERNELS_ENTRY(avx2),
+#endif
+#if ML_KEM_NEON_ELIGIBLE
+    ML_KEM_KERNELS_ENTRY(neon),
+#endif
+};
+
+/* 17^e mod q, 17 being the primitive 256-th root of unity */
+static uint32_t zeta_pow(int e)
+{
+    uint32_t r = 1;
+
+    for (e = ((e % 256) + 256) % 256; e > 0; e--)
+        r = r * 17 % Q;
+    return r;
+}
+
+static int bitrev7(int i)
+{
+    int j, r = 0;
+
+    for (j = 0; j < 7; j++)
+        r |= ((i >> j) & 1) << (6 - j);
+    return r;
+}
+
+/* Algorithm 9 */
+static void ref_ntt(uint16_t f[256])
+{
+    int len, start, j, i = 1;
+
+    for (len = 128; len >= 2; len /= 2) {
+        for (start = 0; start < 256; start += 2 * len) {
+            uint32_t zeta = zeta_pow(bitrev7(i++));
+
+            for (j = start; j < start + len; j++) {
+                uint32_t t = zeta * f[j + len] % Q;
+
+                f[j + len] = (f[j] + Q - t) % Q;
+                f[j] = (f[j] + t) % Q;
+            }
+        }
+    }
+}
+
+/* Algorithm 10 */
+static void ref_inverse_ntt(uint16_t f[256])
+{
+    int len, start, j, i = 127;
+
+    for (len = 2; len <= 128; len *= 2) {
+        for (start = 0; start < 256; start += 2 * len) {
+            uint32_t zeta = zeta_pow(bitrev7(i--));
+
+            for (j = start; j < start + len; j++) {
+                uint32_t t = f[j];
+
+                f[j] = (t + f[j + len]) % Q;
+                f[j + len] = zeta * (f[j + len] + Q - t) % Q;
+            }
+        }
+    }
+    for (j = 0; j < 256; j++)
+        f[j] = f[j] * 3303u % Q; /* 128^-1 mod q */
+}
+
+/* Algorithms 11 and 12 */
+static void ref_mult(uint16_t h[256], const uint16_t f[256],
+    const uint16_t g[256])
+{
+    int i;
+
+    for (i = 0; i < 128; i++) {
+        uint32_t gamma = zeta_pow(2 * bitrev7(i) + 1);
+        uint32_t a0 = f[2 * i], a1 = f[2 * i + 1];
+        uint32_t b0 = g[2 * i], b1 = g[2 * i + 1];
+
+        h[2 * i] = (a0 * b0 + a1 * b1 % Q * gamma) % Q;
+        h[2 * i + 1] = (a0 * b1 + a1 * b0) % Q;
+    }
+}
+
+/* Algorithm 8 */
+static void ref_cbd(uint16_t f[256], const uint8_t *in, int eta)
+{
+    int i, j, bit;
+
+    for (i = 0; i < 256; i++) {
+        int x = 0, y = 0;
+
+        for (j = 0; j < eta; j++) {
+            bit = 2 * i * eta + j;
+            x += (in[bit / 8] >> (bit % 8)) & 1;
+            bit += eta;
+            y += (in[bit / 8] >> (bit % 8)) & 1;
+        }
+        f[i] = (uint16_t)((x - y + Q) % Q);
+    }
+}
+
+/* Compress_d and Decompress_d, rounding as in section 4.2.1 */
+static uint16_t ref_compress(uint16_t x, int d)
+{
+    return (uint16_t)((((uint32_t)x << (d + 1)) + Q) / (2 * Q) % (1u << d));
+}
+
+static uint16_t ref_decompress(uint16_t y, int d)
+{
+    return (uint16_t)(((uint32_t)y * Q + (1u << (d - 1))) >> d);
+}
+
+static void random_scalar(uint16_t c[256])
+{
+    int i;
+
+    for (i = 0; i < 256; i++)
+        c[i] = (uint16_t)(test_random() % Q);
+}
+
+static int kernels_test(int idx)
+{
+    const ML_KEM_KERNELS *k = &ml_kem_kernels[idx];
+    uint16_t a[256], b[256], expected[256], got[256];
+    uint8_t buf[192];
+    int i, n, d;
+
+    if (!k->capable()) {
+        TEST_note("%s is not supported on this CPU, skipping", k->name);
+        return 1;
+    }
+    TEST_info("Testing the %s ML-KEM kernels", k->name);
+
+    for (n = 0; n < 100; n++) {
+        random_scalar(a);
+        memcpy(expected, a, sizeof(a));
+        memcpy(got, a, sizeof(a));
+        ref_ntt(expected);
+        k->ntt(got);
+        if (!TEST_mem_eq(expected, sizeof(expected), got, sizeof(got)))
+            return 0;
+
+        random_scalar(a);
+        memcpy(expected, a, sizeof(a));
+        memcpy(got, a, sizeof(a));
+        ref_inverse_ntt(expected);
+        k->inverse_ntt(got);
+        if (!TEST_mem_eq(expected, sizeof(expected), got, sizeof(got)))
+            return 0;
+
+        random_scalar(a);
+        random_scalar(b);
+        ref_mult(expected, a, b);
+        k->mult(got, a, b);
+        if (!TEST_mem_eq(expected, sizeof(expected), got, sizeof(got)))
+            return 0;
+
+        random_scalar(got);
+        for (i = 0; i < 256; i++)
+            expected[i] = (expected[i] + got[i]) % Q;
+        k->mult_add(got, a, b);
+        if (!TEST_mem_eq(expected, sizeof(expected), got, sizeof(got)))
+            return 0;
+
+        for (i = 0; i < (int)sizeof(buf); i++)
+            buf[i] = (uint8_t)test_random();
+        ref_cbd(expected, buf, 2);
+        k->cbd_2(got, buf);
+        if (!TEST_mem_eq(expected, sizeof(expected), got, sizeof(got)))
+            return 0;
+        ref_cbd(expected, buf, 3);
+        k->cbd_3(got, buf);
+        if (!TEST_mem_eq(expected, sizeof(expected), got, sizeof(got)))
+            return 0;
+    }
+
+    /* All of the inputs of (de)compression */
+    for (d = 1; d <= 11; d++) {
+        for (n = 0; n < Q; n += 256) {
+            for (i = 0; i < 256; i++) {
+                got[i] = (uint16_t)((n + i) % Q);
+                expected[i] = ref_compress(got[i], d);
+            }
+            k->compress(got, d);
+            if (!TEST_mem_eq(expected, sizeof(expected), got, sizeof(got))) {
+                TEST_note("compress to %d bits", d);
+                return 0;
+            }
+        }
+        for (n = 0; n < (1 << d); n += 256) {
+            for (i = 0; i < 256; i++) {
+                got[i] = (uint16_t)((n + i) % (1 << d));
+                expected[i] = ref_decompress(got[i], d);
+            }
+            k->decompress(got, d);
+            if (!TEST_mem_eq(expected, sizeof(expected), got, sizeof(got))) {
+                TEST_note("decompress from %d bits", d);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+#endif
+
 int setup_tests(void)
 {
     if (!TEST_true(RAND_set_DRBG_type(NULL, "TEST-RAND", "fips=no", NULL, NULL)))
@@ -318,5 +553,8 @@ int setup_tests(void)
 
     ADD_TEST(sanity_test);
     ADD_MFAIL_TEST(decap_mfail_test);
+#if ML_KEM_AVX2_ELIGIBLE || ML_KEM_NEON_ELIGIBLE
+    ADD_ALL_TESTS(kernels_test, OSSL_NELEM(ml_kem_kernels));
+#endif
     return 1;
 }
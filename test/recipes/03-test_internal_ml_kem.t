@@ -1,5 +1,5 @@
 #! /usr/bin/env perl
-# Copyright 2024-2025 The OpenSSL Project Authors. All Rights Reserved.
+# Copyright 2024-2026 The OpenSSL Project Authors. All Rights Reserved.
 #
 # Licensed under the Apache License 2.0 (the "License").  You may not use
 # this file except in compliance with the License.  You can obtain a copy
@@ -13,6 +13,13 @@ use OpenSSL::Test qw/:DEFAULT srctop_file/;
 setup("ml_kem_internal_test");
 plan skip_all => 'EC is not supported in this build'
     if disabled('ml-kem');
-plan tests => 1;
+plan tests => 2;
 
 ok(run(test(["ml_kem_internal_test"])));
+
+# Again, without the AVX2 or NEON polynomial arithmetic
+{
+    local $ENV{OPENSSL_ia32cap} = ":~0x20";
+    local $ENV{OPENSSL_armcap} = "0";
+    ok(run(test(["ml_kem_internal_test"])), "without vector kernels");
+}
@@ -1,5 +1,5 @@
 #! /usr/bin/env perl
-# Copyright 2015-2025 The OpenSSL Project Authors. All Rights Reserved.
+# Copyright 2015-2026 The OpenSSL Project Authors. All Rights Reserved.
 #
 # Licensed under the Apache License 2.0 (the "License").  You may not use
 # this file except in compliance with the License.  You can obtain a copy
@@ -19,7 +19,7 @@ setup("test_ec");
 
 plan skip_all => 'EC is not supported in this build' if disabled('ec');
 
-plan tests => 20;
+plan tests => 21;
 
 my $no_fips = disabled('fips') || ($ENV{NO_FIPS} // 0);
 
@@ -27,6 +27,12 @@ require_ok(srctop_file('test','recipes','tconversion.pl'));
 
 ok(run(test(["ectest"])), "running ectest");
 
+# Again, without the BMI2/ADX field arithmetic on x86_64
+{
+    local $ENV{OPENSSL_ia32cap} = ":~0x80100";
+    ok(run(test(["ectest"])), "running ectest without BMI2/ADX");
+}
+
 # TODO: remove these when the 'ec' app is removed.
 # Also consider moving this to the 20-25 test section because it is testing
 # the command line tool in addition to the algorithm.
@@ -1,5 +1,5 @@
 #! /usr/bin/env perl
-# Copyright 2015-2018 The OpenSSL Project Authors. All Rights Reserved.
+# Copyright 2015-2026 The OpenSSL Project Authors. All Rights Reserved.
 #
 # Licensed under the Apache License 2.0 (the "License").  You may not use
 # this file except in compliance with the License.  You can obtain a copy
@@ -23,7 +23,7 @@ setup("test_rehash");
 plan skip_all => "test_rehash is not available on this platform"
     unless run(app(["openssl", "rehash", "-help"]));
 
-plan tests => 4;
+plan tests => 6;
 
 indir "rehash.$$" => sub {
     prepare();
@@ -42,6 +42,14 @@ indir "rehash.$$" => sub {
        'Testing rehash operations on empty directory');
 }, create => 1, cleanup => 1;
 
+indir "rehash-compile.$$" => sub {
+    prepare();
+    ok(run(app(["openssl", "rehash", "-compile", "certs.idx", curdir()])),
+       'Testing rehash -compile');
+    ok(-s "certs.idx" && !grep({ /^[0-9a-f]{8}\.r?\d+$/ } glob("*")),
+       'Testing that rehash -compile writes an index and no links');
+}, create => 1, cleanup => 1;
+
 indir "rehash.$$" => sub {
     prepare();
     chmod 0500, curdir();
@@ -7,6 +7,7 @@
 
 
 use OpenSSL::Test qw/:DEFAULT srctop_file/;
+use File::Temp qw(tempfile);
 
 $ENV{ASAN_OPTIONS} = "detect_leaks=1";
 
@@ -14,5 +15,9 @@ setup("test_load_cert_file");
 
 plan tests => 1;
 
+(undef, my $idxfile) = tempfile();
+
 ok(run(test(["x509_load_cert_file_test", srctop_file("test", "certs", "leaf-chain.pem"),
-             srctop_file("test", "certs", "cyrillic_crl.pem")])));
+             srctop_file("test", "certs", "cyrillic_crl.pem"), $idxfile])));
+
+unlink $idxfile;
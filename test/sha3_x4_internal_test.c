@@ -16,6 +16,9 @@
  * equivalent result produced by the scalar ossl_sha3_* API.
  *
  * Tests cover:
+ *   - The ossl_sha3_shake{128,256}_x4 dispatcher, on every platform
+ *   - The ossl_sha3_shake{128,256}_x4_init and ossl_sha3_shake_x4_squeeze
+ *     lock-step API, squeezing in two calls, on every platform
  *   - Single-call (ossl_sha3_shake{128,256}_x4_avx512vl) for many (inlen, outlen) pairs
  *   - Incremental init/absorb/squeeze for the same (inlen, outlen) pairs
  *   - Multi-absorb: input split at every possible block boundary
@@ -57,10 +60,6 @@ static unsigned char msg[MSG_BUF_SIZE];
 /* Maximum output length used in this file – must fit chunk1 + chunk2. */
 #define MAX_OUT 640
 
-#if defined(KECCAK1600_ASM)                                                               \
-    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
-    && !defined(OPENSSL_NO_ASM)
-
 /*
  * Input lengths exercising: empty, tiny, sub-block, block boundary ±1,
  * multiple blocks and a longer message for SHAKE-128 (rate=168) and
@@ -109,6 +108,109 @@ static void decode_idx(const int n, size_t *inlen, size_t *outlen)
     *outlen = output_sizes[n % (int)NUM_OUTPUT_SIZES];
 }
 
+/* Dispatcher tests, covering whichever implementation the CPU selects */
+
+static int test_shake_x4_dispatch(const unsigned int bitlen, const int n)
+{
+    size_t inlen, outlen;
+    const unsigned char *in[NUM_LANES];
+    unsigned char x4_out[NUM_LANES][MAX_OUT];
+    unsigned char ref_out[NUM_LANES][MAX_OUT];
+    int i;
+
+    decode_idx(n, &inlen, &outlen);
+
+    for (i = 0; i < NUM_LANES; i++)
+        in[i] = msg + i * LANE_STRIDE;
+
+    if (bitlen == 128)
+        ossl_sha3_shake128_x4(x4_out[0], x4_out[1], x4_out[2], x4_out[3],
+            outlen, in[0], in[1], in[2], in[3], inlen);
+    else
+        ossl_sha3_shake256_x4(x4_out[0], x4_out[1], x4_out[2], x4_out[3],
+            outlen, in[0], in[1], in[2], in[3], inlen);
+
+    for (i = 0; i < NUM_LANES; i++)
+        if (!TEST_true(scalar_shake(bitlen, in[i], inlen, ref_out[i], outlen)))
+            return 0;
+
+    for (i = 0; i < NUM_LANES; i++) {
+        if (!TEST_mem_eq(x4_out[i], outlen, ref_out[i], outlen)) {
+            TEST_info("SHAKE-%u x4 dispatch lane %d: inlen=%zu outlen=%zu",
+                bitlen, i, inlen, outlen);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int test_shake128_x4_dispatch(const int n)
+{
+    return test_shake_x4_dispatch(128, n);
+}
+
+static int test_shake256_x4_dispatch(const int n)
+{
+    return test_shake_x4_dispatch(256, n);
+}
+
+/*
+ * Lock-step tests, squeezing a third of the output and then the rest, so that
+ * the first call can leave part of a block behind for the second.
+ */
+static int test_shake_x4_lockstep(const unsigned int bitlen, const int n)
+{
+    size_t inlen, outlen, chunk1;
+    const unsigned char *in[NUM_LANES];
+    unsigned char x4_out[NUM_LANES][MAX_OUT];
+    unsigned char ref_out[NUM_LANES][MAX_OUT];
+    KECCAK1600_X4_CTX ctx;
+    int i;
+
+    decode_idx(n, &inlen, &outlen);
+    chunk1 = outlen / 3;
+
+    for (i = 0; i < NUM_LANES; i++)
+        in[i] = msg + i * LANE_STRIDE;
+
+    if (bitlen == 128)
+        ossl_sha3_shake128_x4_init(&ctx, in[0], in[1], in[2], in[3], inlen);
+    else
+        ossl_sha3_shake256_x4_init(&ctx, in[0], in[1], in[2], in[3], inlen);
+    ossl_sha3_shake_x4_squeeze(&ctx, x4_out[0], x4_out[1], x4_out[2],
+        x4_out[3], chunk1);
+    ossl_sha3_shake_x4_squeeze(&ctx, x4_out[0] + chunk1, x4_out[1] + chunk1,
+        x4_out[2] + chunk1, x4_out[3] + chunk1, outlen - chunk1);
+    ossl_sha3_shake_x4_cleanup(&ctx);
+
+    for (i = 0; i < NUM_LANES; i++)
+        if (!TEST_true(scalar_shake(bitlen, in[i], inlen, ref_out[i], outlen)))
+            return 0;
+
+    for (i = 0; i < NUM_LANES; i++) {
+        if (!TEST_mem_eq(x4_out[i], outlen, ref_out[i], outlen)) {
+            TEST_info("SHAKE-%u x4 lock-step lane %d: inlen=%zu outlen=%zu",
+                bitlen, i, inlen, outlen);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int test_shake128_x4_lockstep(const int n)
+{
+    return test_shake_x4_lockstep(128, n);
+}
+
+static int test_shake256_x4_lockstep(const int n)
+{
+    return test_shake_x4_lockstep(256, n);
+}
+
+#if defined(KECCAK1600_ASM)                                                               \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
+    && !defined(OPENSSL_NO_ASM)
+
 /* One-shot tests */
 
 static int test_shake_x4_oneshot(const unsigned int bitlen, const int n)
@@ -400,13 +502,21 @@ int setup_tests(void)
     OPENSSL_cpuid_setup();
 #endif
 
-#if !defined(KECCAK1600_ASM)                                                               \
-    || !(defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
-    || defined(OPENSSL_NO_ASM)
-    return TEST_skip("SHAKE x4 API not available in this build");
-#else
+    ADD_ALL_TESTS(test_shake128_x4_dispatch,
+        (int)(NUM_INPUT_SIZES * NUM_OUTPUT_SIZES));
+    ADD_ALL_TESTS(test_shake256_x4_dispatch,
+        (int)(NUM_INPUT_SIZES * NUM_OUTPUT_SIZES));
+    ADD_ALL_TESTS(test_shake128_x4_lockstep,
+        (int)(NUM_INPUT_SIZES * NUM_OUTPUT_SIZES));
+    ADD_ALL_TESTS(test_shake256_x4_lockstep,
+        (int)(NUM_INPUT_SIZES * NUM_OUTPUT_SIZES));
+
+#if defined(KECCAK1600_ASM)                                                               \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
+    && !defined(OPENSSL_NO_ASM)
     if (!SHA3_avx512vl_capable()) {
-        return TEST_skip("AVX-512VL not available; skipping SHAKE x4 tests");
+        TEST_note("AVX-512VL not available; skipping SHAKE x4 AVX-512VL tests");
+        return 1;
     }
 
     ADD_ALL_TESTS(test_shake128_x4_oneshot,
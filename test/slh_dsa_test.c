@@ -1,5 +1,5 @@
 /*
- * Copyright 2024-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2024-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -12,6 +12,7 @@
 #include <openssl/param_build.h>
 #include <openssl/rand.h>
 #include <openssl/pem.h>
+#include <openssl/thread.h>
 #include "crypto/slh_dsa.h"
 #include "internal/nelem.h"
 #include "testutil.h"
@@ -240,14 +241,14 @@ err:
     return ret;
 }
 
-static int slh_dsa_sign_verify_test(int tst_id)
+static int do_slh_dsa_sign_verify(int tst_id, uint32_t threads)
 {
     int ret = 0;
     SLH_DSA_SIG_TEST_DATA *td = &slh_dsa_sig_testdata[tst_id];
     EVP_PKEY_CTX *sctx = NULL;
     EVP_PKEY *pkey = NULL;
     EVP_SIGNATURE *sig_alg = NULL;
-    OSSL_PARAM params[4], *p = params;
+    OSSL_PARAM params[5], *p = params;
     uint8_t *psig = NULL;
     size_t psig_len = 0, sig_len2 = 0;
     uint8_t digest[32];
@@ -260,6 +261,9 @@ static int slh_dsa_sign_verify_test(int tst_id)
         *p++ = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_TEST_ENTROPY,
             (char *)td->add_random,
             td->add_random_len);
+    if (threads != 0)
+        *p++ = OSSL_PARAM_construct_uint32(OSSL_SIGNATURE_PARAM_THREADS,
+            &threads);
     *p = OSSL_PARAM_construct_end();
 
     /*
@@ -303,6 +307,23 @@ err:
     return ret;
 }
 
+static int slh_dsa_sign_verify_test(int tst_id)
+{
+    return do_slh_dsa_sign_verify(tst_id, 0);
+}
+
+/* Signing on several threads must produce the same signatures */
+static int slh_dsa_sign_verify_threads_test(int tst_id)
+{
+    /* Without thread pool support this signs on the calling thread */
+    if ((OSSL_get_thread_support_flags()
+            & OSSL_THREAD_SUPPORT_FLAG_DEFAULT_SPAWN)
+            != 0
+        && !TEST_int_eq(OSSL_set_max_threads(lib_ctx, 4), 1))
+        return 0;
+    return do_slh_dsa_sign_verify(tst_id, 4);
+}
+
 static EVP_PKEY *do_gen_key(const char *alg,
     const uint8_t *seed, size_t seed_len)
 {
@@ -668,6 +689,8 @@ int setup_tests(void)
     ADD_TEST(slh_dsa_usage_test);
     ADD_TEST(slh_dsa_deterministic_usage_test);
     ADD_ALL_TESTS(slh_dsa_sign_verify_test, OSSL_NELEM(slh_dsa_sig_testdata));
+    ADD_ALL_TESTS(slh_dsa_sign_verify_threads_test,
+        OSSL_NELEM(slh_dsa_sig_testdata));
     ADD_ALL_TESTS(slh_dsa_keygen_test, OSSL_NELEM(slh_dsa_keygen_testdata));
     ADD_TEST(slh_dsa_digest_sign_verify_test);
     ADD_TEST(slh_dsa_keygen_invalid_test);
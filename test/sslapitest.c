@@ -1997,11 +1997,13 @@ static int test_cleanse_plaintext(void)
 }
 
 #ifndef OPENSSL_NO_OCSP
-static OCSP_RESPONSE *create_ocsp_resp(X509 *ssl_cert, X509 *issuer, int status,
-    const char *signer_key_files, const char *signer_cert_files)
+/* Creates a response produced |age| seconds ago and valid for a day */
+static OCSP_RESPONSE *create_ocsp_resp_ex(X509 *ssl_cert, X509 *issuer,
+    int status, const char *signer_key_files, const char *signer_cert_files,
+    long age)
 {
-    ASN1_TIME *thisupd = X509_gmtime_adj(NULL, 0);
-    ASN1_TIME *nextupd = X509_time_adj_ex(NULL, 1, 0, NULL);
+    ASN1_TIME *thisupd = X509_gmtime_adj(NULL, -age);
+    ASN1_TIME *nextupd = X509_time_adj_ex(NULL, 1, -age, NULL);
     OCSP_CERTID *cert_id = NULL;
     char *signer_key_file = NULL;
     char *signer_cert_file = NULL;
@@ -2042,6 +2044,13 @@ end:
     return ocsp_resp;
 }
 
+static OCSP_RESPONSE *create_ocsp_resp(X509 *ssl_cert, X509 *issuer, int status,
+    const char *signer_key_files, const char *signer_cert_files)
+{
+    return create_ocsp_resp_ex(ssl_cert, issuer, status, signer_key_files,
+        signer_cert_files, 0);
+}
+
 static int ocsp_server_cb_single(SSL *s, void *arg)
 {
     int *argi = (int *)arg;
@@ -2640,6 +2649,220 @@ end:
     return testresult;
 }
 #endif
+
+static unsigned char *stapled_resp = NULL;
+static long stapled_resp_len = -1;
+
+static int ocsp_client_cb_stapler(SSL *s, void *arg)
+{
+    unsigned char *resp = NULL;
+
+    stapled_resp_len = SSL_get_tlsext_status_ocsp_resp(s, &resp);
+    OPENSSL_free(stapled_resp);
+    stapled_resp = NULL;
+    if (stapled_resp_len > 0
+        && (stapled_resp = OPENSSL_memdup(resp, stapled_resp_len)) == NULL)
+        return 0;
+    return 1;
+}
+
+/*
+ * Test the OCSP stapler: responses are only served once installed, exactly
+ * as installed, and failed refreshes keep their place in the schedule.
+ * Test 0: TLSv1.2
+ * Test 1: TLSv1.3
+ */
+static int test_ocsp_stapler(int tst)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    SSL_OCSP_STAPLER *st = NULL;
+    char *leaf_chain = test_mk_file_path(certsdir, "leaf-chain.pem");
+    char *skey = test_mk_file_path(certsdir, "leaf.key");
+    char *leaf = test_mk_file_path(certsdir, "leaf.pem");
+    char *issuer_file = test_mk_file_path(certsdir, "subinterCA.pem");
+    X509 *leafcert = NULL, *issuer = NULL;
+    OCSP_RESPONSE *ocsp_resp = NULL;
+    unsigned char *der = NULL, *bad = NULL, *forged = NULL, *older = NULL;
+    uint64_t hits, misses, refreshes, failures;
+    time_t now;
+    int derlen = 0, badlen = 0, forgedlen = 0, olderlen = 0, testresult = 0;
+    int version = tst == 0 ? TLS1_2_VERSION : TLS1_3_VERSION;
+
+#ifdef OPENSSL_NO_TLS1_2
+    if (tst == 0)
+        return TEST_skip("TLSv1.2 disabled");
+#endif
+#ifdef OSSL_NO_USABLE_TLS1_3
+    if (tst == 1)
+        return TEST_skip("No usable TLSv1.3");
+#endif
+
+    if (!TEST_ptr(leafcert = load_cert_pem(leaf, libctx))
+        || !TEST_ptr(issuer = load_cert_pem(issuer_file, libctx))
+        || !TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+            TLS_client_method(), version, version,
+            &sctx, &cctx, leaf, skey))
+        || !TEST_int_gt(SSL_CTX_use_certificate_chain_file(sctx, leaf_chain), 0)
+        || !TEST_true(SSL_CTX_set_tlsext_status_type(cctx,
+            TLSEXT_STATUSTYPE_ocsp)))
+        goto end;
+    SSL_CTX_set_tlsext_status_cb(cctx, ocsp_client_cb_stapler);
+
+    /* The response identifies the certificate with SHA-256 rather than SHA1 */
+    if (!TEST_ptr(ocsp_resp = create_ocsp_resp(leafcert, issuer,
+                      V_OCSP_CERTSTATUS_GOOD, "subinterCA.key",
+                      "subinterCA.pem"))
+        || !TEST_int_gt(derlen = i2d_OCSP_RESPONSE(ocsp_resp, &der), 0))
+        goto end;
+    OCSP_RESPONSE_free(ocsp_resp);
+    if (!TEST_ptr(ocsp_resp = create_ocsp_resp(NULL, NULL,
+                      OCSP_RESPONSE_STATUS_TRYLATER, NULL, NULL))
+        || !TEST_int_gt(badlen = i2d_OCSP_RESPONSE(ocsp_resp, &bad), 0))
+        goto end;
+    /* Signed with the key of the leaf rather than that of its issuer */
+    OCSP_RESPONSE_free(ocsp_resp);
+    if (!TEST_ptr(ocsp_resp = create_ocsp_resp(leafcert, issuer,
+                      V_OCSP_CERTSTATUS_GOOD, "leaf.key", "leaf.pem"))
+        || !TEST_int_gt(forgedlen = i2d_OCSP_RESPONSE(ocsp_resp, &forged), 0))
+        goto end;
+    /* Still valid, but produced an hour before |der| */
+    OCSP_RESPONSE_free(ocsp_resp);
+    if (!TEST_ptr(ocsp_resp = create_ocsp_resp_ex(leafcert, issuer,
+                      V_OCSP_CERTSTATUS_GOOD, "subinterCA.key",
+                      "subinterCA.pem", 60 * 60))
+        || !TEST_int_gt(olderlen = i2d_OCSP_RESPONSE(ocsp_resp, &older), 0))
+        goto end;
+
+    if (!TEST_ptr(st = SSL_OCSP_STAPLER_new(libctx, NULL))
+        || !TEST_false(SSL_OCSP_STAPLER_set1_response(st, leafcert, der,
+            derlen))
+        || !TEST_true(SSL_OCSP_STAPLER_add1_cert(st, leafcert, issuer, NULL))
+        || !TEST_true(SSL_OCSP_STAPLER_add1_cert(st, leafcert, issuer, NULL))
+        || !TEST_false(SSL_OCSP_STAPLER_set1_response(st, leafcert, bad,
+            badlen))
+        || !TEST_false(SSL_OCSP_STAPLER_set1_response(st, leafcert, der,
+            derlen - 1))
+        || !TEST_true(SSL_CTX_set1_ocsp_stapler(sctx, st))
+        || !TEST_ptr_eq(SSL_CTX_get0_ocsp_stapler(sctx), st))
+        goto end;
+    ERR_clear_error();
+
+    /* Nothing to staple yet */
+    if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+            NULL, NULL))
+        || !TEST_true(create_ssl_connection(serverssl, clientssl,
+            SSL_ERROR_NONE))
+        || !TEST_long_eq(stapled_resp_len, -1))
+        goto end;
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    serverssl = clientssl = NULL;
+
+    if (!TEST_true(SSL_OCSP_STAPLER_set1_response(st, leafcert, der, derlen))
+        || !TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+            NULL, NULL))
+        || !TEST_true(create_ssl_connection(serverssl, clientssl,
+            SSL_ERROR_NONE))
+        || !TEST_mem_eq(stapled_resp, stapled_resp_len, der, derlen))
+        goto end;
+
+    /*
+     * Responses that are not signed by the issuer, or whose signature does
+     * not match, are rejected and the previous one is kept, and so are
+     * responses older than the previous one
+     */
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    serverssl = clientssl = NULL;
+    if (!TEST_false(SSL_OCSP_STAPLER_set1_response(st, leafcert, forged,
+            forgedlen))
+        || !TEST_false(SSL_OCSP_STAPLER_set1_response(st, leafcert, older,
+            olderlen))
+        || !TEST_true(SSL_OCSP_STAPLER_set1_response(st, leafcert, der,
+            derlen)))
+        goto end;
+    OPENSSL_free(forged);
+    if (!TEST_ptr(forged = OPENSSL_memdup(der, derlen)))
+        goto end;
+    forged[derlen - 1] ^= 0x01;
+    if (!TEST_false(SSL_OCSP_STAPLER_set1_response(st, leafcert, forged,
+            derlen))
+        || !TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+            NULL, NULL))
+        || !TEST_true(create_ssl_connection(serverssl, clientssl,
+            SSL_ERROR_NONE))
+        || !TEST_mem_eq(stapled_resp, stapled_resp_len, der, derlen))
+        goto end;
+    ERR_clear_error();
+
+    /* A client that does not ask gets nothing and is not counted */
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    serverssl = clientssl = NULL;
+    stapled_resp_len = -1;
+    if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+            NULL, NULL))
+        || !TEST_true(SSL_set_tlsext_status_type(clientssl, -1))
+        || !TEST_true(create_ssl_connection(serverssl, clientssl,
+            SSL_ERROR_NONE))
+        || !TEST_long_eq(stapled_resp_len, -1))
+        goto end;
+
+    if (!TEST_true(SSL_OCSP_STAPLER_get_stats(st, &hits, &misses, &refreshes,
+            &failures))
+        || !TEST_uint64_t_eq(hits, 2)
+        || !TEST_uint64_t_eq(misses, 1)
+        || !TEST_uint64_t_eq(refreshes, 0)
+        || !TEST_uint64_t_eq(failures, 0))
+        goto end;
+
+    /*
+     * The response is valid for a day and due for renewal halfway through.
+     * A certificate without a response is due now, and when its responder
+     * cannot be reached it is tried again a little later. Any issuer does for
+     * this.
+     */
+    now = time(NULL);
+    if (!TEST_time_t_gt(SSL_OCSP_STAPLER_get_next_refresh(st), now + 60 * 60)
+        || !TEST_true(SSL_OCSP_STAPLER_refresh(st, 5))
+        || !TEST_true(SSL_OCSP_STAPLER_add1_cert(st, issuer, issuer,
+            "http://127.0.0.1:1/"))
+        || !TEST_time_t_le(SSL_OCSP_STAPLER_get_next_refresh(st), now)
+        || !TEST_false(SSL_OCSP_STAPLER_refresh(st, 5))
+        || !TEST_time_t_gt(SSL_OCSP_STAPLER_get_next_refresh(st), now)
+        || !TEST_true(SSL_OCSP_STAPLER_refresh(st, 5))
+        || !TEST_true(SSL_OCSP_STAPLER_get_stats(st, NULL, NULL, &refreshes,
+            &failures))
+        || !TEST_uint64_t_eq(refreshes, 0)
+        || !TEST_uint64_t_eq(failures, 1))
+        goto end;
+    ERR_clear_error();
+
+    testresult = 1;
+
+end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    SSL_OCSP_STAPLER_free(st);
+    OCSP_RESPONSE_free(ocsp_resp);
+    OPENSSL_free(forged);
+    OPENSSL_free(older);
+    OPENSSL_free(der);
+    OPENSSL_free(bad);
+    OPENSSL_free(stapled_resp);
+    stapled_resp = NULL;
+    stapled_resp_len = -1;
+    X509_free(leafcert);
+    X509_free(issuer);
+    OPENSSL_free(leaf_chain);
+    OPENSSL_free(skey);
+    OPENSSL_free(leaf);
+    OPENSSL_free(issuer_file);
+    return testresult;
+}
 #endif
 
 #if !defined(OSSL_NO_USABLE_TLS1_3) || !defined(OPENSSL_NO_TLS1_2)
@@ -9101,6 +9324,105 @@ end:
     return testresult;
 }
 
+#ifndef OSSL_NO_USABLE_TLS1_3
+static int records_read = 0;
+
+static const char *pipelining_ciphersuites[] = {
+    "TLS_AES_128_GCM_SHA256",
+    "TLS_AES_256_GCM_SHA384",
+#if !defined(OPENSSL_NO_CHACHA) && !defined(OPENSSL_NO_POLY1305)
+    "TLS_CHACHA20_POLY1305_SHA256",
+#endif
+};
+
+static void count_records_cb(int write_p, int version, int content_type,
+    const void *buf, size_t len, SSL *ssl, void *arg)
+{
+    if (!write_p && content_type == SSL3_RT_HEADER)
+        records_read++;
+}
+
+/*
+ * Test that with pipelining enabled a TLSv1.3 write is split into several
+ * records which are encrypted together by the pipeline capable cipher. The
+ * writes use different numbers of records, and the last one follows a key
+ * update.
+ */
+static int test_tls13_pipelining(int idx)
+{
+    static const int nrecs[] = { 4, 2, 4, 3 };
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    const char *ciphersuite = pipelining_ciphersuites[idx];
+    unsigned char *msg = NULL, *buf = NULL;
+    size_t msglen, written, readbytes, total, i, w;
+    int testresult = 0;
+
+    if (is_fips && strstr(ciphersuite, "CHACHA") != NULL)
+        return TEST_skip("ChaCha20-Poly1305 is not available in FIPS");
+
+    if (!TEST_ptr(msg = OPENSSL_malloc(4 * 4096))
+        || !TEST_ptr(buf = OPENSSL_malloc(4 * 4096)))
+        goto end;
+    for (i = 0; i < 4 * 4096; i++)
+        msg[i] = (unsigned char)i;
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+            TLS_client_method(),
+            TLS1_3_VERSION, TLS1_3_VERSION,
+            &sctx, &cctx, cert, privkey))
+        || !TEST_true(SSL_CTX_set_ciphersuites(cctx, ciphersuite))
+        || !TEST_true(SSL_CTX_set_max_pipelines(cctx, 4))
+        || !TEST_true(SSL_CTX_set_split_send_fragment(cctx, 4096))
+        || !TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+            NULL, NULL)))
+        goto end;
+
+    SSL_set_msg_callback(serverssl, count_records_cb);
+    if (!TEST_true(create_ssl_connection(serverssl, clientssl,
+            SSL_ERROR_NONE)))
+        goto end;
+
+    for (w = 0; w < OSSL_NELEM(nrecs); w++) {
+        msglen = nrecs[w] * 4096;
+        total = 0;
+        records_read = 0;
+        if (w == OSSL_NELEM(nrecs) - 1
+            && !TEST_true(SSL_key_update(clientssl,
+                SSL_KEY_UPDATE_NOT_REQUESTED)))
+            goto end;
+        if (!TEST_true(SSL_write_ex(clientssl, msg, msglen, &written))
+            || !TEST_size_t_eq(written, msglen))
+            goto end;
+        while (total < msglen) {
+            if (!TEST_true(SSL_read_ex(serverssl, buf + total, msglen - total,
+                    &readbytes)))
+                goto end;
+            total += readbytes;
+        }
+
+        /*
+         * Without pipelining all the data would fit into one record. The
+         * KeyUpdate message takes one more.
+         */
+        if (!TEST_mem_eq(buf, total, msg, msglen)
+            || !TEST_int_eq(records_read,
+                nrecs[w] + (w == OSSL_NELEM(nrecs) - 1)))
+            goto end;
+    }
+
+    testresult = 1;
+end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    OPENSSL_free(msg);
+    OPENSSL_free(buf);
+    return testresult;
+}
+#endif
+
 static int test_ssl_pending(int tst)
 {
     SSL_CTX *cctx = NULL, *sctx = NULL;
@@ -9173,6 +9495,95 @@ end:
     return testresult;
 }
 
+/*
+ * Test SSL_read_borrow() and SSL_read_release()
+ * Test 0: TLSv1.3
+ * Test 1: TLSv1.2
+ */
+static int test_ssl_read_borrow(int tst)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    int testresult = 0;
+    char msg1[] = "A test message";
+    char msg2[] = "Another test message";
+    char buf[3];
+    const unsigned char *data;
+    size_t written, readbytes, len;
+
+#ifdef OSSL_NO_USABLE_TLS1_3
+    if (tst == 0)
+        return TEST_skip("No usable TLSv1.3");
+#endif
+#ifdef OPENSSL_NO_TLS1_2
+    if (tst == 1)
+        return TEST_skip("TLSv1.2 is disabled");
+#endif
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+            TLS_client_method(),
+            tst == 0 ? TLS1_3_VERSION : TLS1_2_VERSION,
+            tst == 0 ? TLS1_3_VERSION : TLS1_2_VERSION,
+            &sctx, &cctx, cert, privkey))
+        || !TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+            NULL, NULL))
+        || !TEST_true(create_ssl_connection(serverssl, clientssl,
+            SSL_ERROR_NONE)))
+        goto end;
+
+    /* Nothing to borrow yet */
+    if (!TEST_false(SSL_read_borrow(clientssl, &data, &len))
+        || !TEST_int_eq(SSL_get_error(clientssl, 0), SSL_ERROR_WANT_READ)
+        || !TEST_false(SSL_read_release(clientssl, 1)))
+        goto end;
+
+    if (!TEST_true(SSL_write_ex(serverssl, msg1, sizeof(msg1), &written))
+        || !TEST_true(SSL_write_ex(serverssl, msg2, sizeof(msg2), &written)))
+        goto end;
+
+    /* Borrowing does not consume anything */
+    if (!TEST_true(SSL_read_borrow(clientssl, &data, &len))
+        || !TEST_mem_eq(data, len, msg1, sizeof(msg1))
+        || !TEST_true(SSL_read_borrow(clientssl, &data, &len))
+        || !TEST_mem_eq(data, len, msg1, sizeof(msg1))
+        || !TEST_false(SSL_read_release(clientssl, len + 1))
+        || !TEST_true(SSL_read_release(clientssl, 5))
+        || !TEST_int_eq(SSL_pending(clientssl), (int)(sizeof(msg1) - 5)))
+        goto end;
+
+    /* The rest of the record can be borrowed again or read normally */
+    if (!TEST_true(SSL_read_borrow(clientssl, &data, &len))
+        || !TEST_mem_eq(data, len, msg1 + 5, sizeof(msg1) - 5)
+        || !TEST_true(SSL_read_ex(clientssl, buf, sizeof(buf), &readbytes))
+        || !TEST_mem_eq(buf, readbytes, msg1 + 5, sizeof(buf))
+        /* The read invalidated the borrowed data */
+        || !TEST_false(SSL_read_release(clientssl, 1))
+        || !TEST_true(SSL_read_borrow(clientssl, &data, &len))
+        || !TEST_mem_eq(data, len, msg1 + 5 + sizeof(buf),
+            sizeof(msg1) - 5 - sizeof(buf))
+        || !TEST_true(SSL_read_release(clientssl, len)))
+        goto end;
+
+    /* Only one record is handed out at a time */
+    if (!TEST_true(SSL_read_borrow(clientssl, &data, &len))
+        || !TEST_mem_eq(data, len, msg2, sizeof(msg2))
+        || !TEST_true(SSL_read_release(clientssl, len))
+        || !TEST_int_eq(SSL_pending(clientssl), 0)
+        || !TEST_false(SSL_read_borrow(clientssl, &data, &len))
+        || !TEST_int_eq(SSL_get_error(clientssl, 0), SSL_ERROR_WANT_READ))
+        goto end;
+
+    testresult = 1;
+
+end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+
+    return testresult;
+}
+
 static struct {
     unsigned int maxprot;
     const char *clntciphers;
@@ -9659,6 +10070,384 @@ end:
     return testresult;
 }
 
+/*
+ * Connect using |sctx| and |cctx|, resuming |*sess| if it is not NULL, and
+ * replace |*sess| with the session of the new connection.
+ */
+static int keyring_connect(SSL_CTX *sctx, SSL_CTX *cctx, SSL_SESSION **sess,
+    int *reused)
+{
+    SSL *serverssl = NULL, *clientssl = NULL;
+    int ret = 0;
+
+    if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+            NULL, NULL))
+        || (*sess != NULL && !TEST_true(SSL_set_session(clientssl, *sess)))
+        || !TEST_true(create_ssl_connection(serverssl, clientssl,
+            SSL_ERROR_NONE)))
+        goto end;
+
+    *reused = SSL_session_reused(clientssl);
+    SSL_SESSION_free(*sess);
+    if (!TEST_ptr(*sess = SSL_get1_session(clientssl)))
+        goto end;
+    SSL_shutdown(clientssl);
+    SSL_shutdown(serverssl);
+    ret = 1;
+end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    return ret;
+}
+
+/*
+ * Test a ticket key ring shared between SSL_CTXs, and rotation of its keys
+ * Test 0: TLSv1.3
+ * Test 1: TLSv1.2
+ */
+static int test_ticket_keyring(int tst)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL, *sctx2 = NULL;
+    SSL_TICKET_KEYRING *ring = NULL, *ring2 = NULL;
+    SSL_SESSION *sess = NULL, *oldsess = NULL;
+    unsigned char keys[3][80];
+    int testresult = 0, reused = 0, prot, i;
+
+#ifdef OSSL_NO_USABLE_TLS1_3
+    if (tst == 0)
+        return TEST_skip("No usable TLSv1.3");
+#endif
+#ifdef OPENSSL_NO_TLS1_2
+    if (tst == 1)
+        return TEST_skip("TLSv1.2 is disabled");
+#endif
+    prot = tst == 0 ? TLS1_3_VERSION : TLS1_2_VERSION;
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+            TLS_client_method(), prot, prot,
+            &sctx, &cctx, cert, privkey))
+        || !TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+            NULL, prot, prot, &sctx2, NULL, cert, privkey))
+        || !TEST_true(SSL_CTX_set_session_cache_mode(sctx, SSL_SESS_CACHE_OFF))
+        || !TEST_true(SSL_CTX_set_session_cache_mode(sctx2,
+            SSL_SESS_CACHE_OFF))
+        || !TEST_ptr(ring = SSL_TICKET_KEYRING_new(libctx, NULL))
+        || !TEST_true(SSL_CTX_set1_ticket_keyring(sctx, ring))
+        || !TEST_true(SSL_CTX_set1_ticket_keyring(sctx2, ring))
+        || !TEST_ptr_eq(SSL_CTX_get0_ticket_keyring(sctx2), ring))
+        goto end;
+
+    /* A ticket issued through one SSL_CTX is accepted by the other */
+    if (!TEST_true(keyring_connect(sctx, cctx, &sess, &reused))
+        || !TEST_false(reused)
+        || !TEST_true(SSL_SESSION_up_ref(sess))
+        || !TEST_ptr(oldsess = sess)
+        || !TEST_true(keyring_connect(sctx2, cctx, &sess, &reused))
+        || !TEST_true(reused))
+        goto end;
+
+    /* It stays valid as the previous key after one rotation but not two */
+    if (!TEST_true(SSL_TICKET_KEYRING_rotate(ring, NULL, 0))
+        || !TEST_true(keyring_connect(sctx, cctx, &oldsess, &reused))
+        || !TEST_true(reused)
+        || !TEST_true(SSL_TICKET_KEYRING_rotate(ring, NULL, 0))
+        || !TEST_true(SSL_TICKET_KEYRING_rotate(ring, NULL, 0))
+        || !TEST_true(keyring_connect(sctx2, cctx, &sess, &reused))
+        || !TEST_false(reused))
+        goto end;
+
+    /* Rings fed the same keys interoperate */
+    for (i = 0; i < 3; i++)
+        if (!TEST_int_gt(RAND_bytes_ex(libctx, keys[i], sizeof(keys[i]), 0), 0))
+            goto end;
+    if (!TEST_ptr(ring2 = SSL_TICKET_KEYRING_new(libctx, NULL))
+        || !TEST_false(SSL_TICKET_KEYRING_rotate(ring2, keys[0], 79)))
+        goto end;
+    for (i = 0; i < 3; i++)
+        if (!TEST_true(SSL_TICKET_KEYRING_rotate(ring, keys[i], sizeof(keys[i])))
+            || !TEST_true(SSL_TICKET_KEYRING_rotate(ring2, keys[i],
+                sizeof(keys[i]))))
+            goto end;
+    if (!TEST_true(SSL_CTX_set1_ticket_keyring(sctx2, ring2))
+        || !TEST_true(keyring_connect(sctx, cctx, &sess, &reused))
+        || !TEST_true(keyring_connect(sctx2, cctx, &sess, &reused))
+        || !TEST_true(reused))
+        goto end;
+
+    /* A server that has rotated ahead still accepts the ticket */
+    if (!TEST_true(SSL_TICKET_KEYRING_rotate(ring2, NULL, 0))
+        || !TEST_true(keyring_connect(sctx, cctx, &sess, &reused))
+        || !TEST_true(keyring_connect(sctx2, cctx, &sess, &reused))
+        || !TEST_true(reused))
+        goto end;
+
+    testresult = 1;
+
+end:
+    SSL_SESSION_free(sess);
+    SSL_SESSION_free(oldsess);
+    SSL_TICKET_KEYRING_free(ring);
+    SSL_TICKET_KEYRING_free(ring2);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(sctx2);
+    SSL_CTX_free(cctx);
+
+    return testresult;
+}
+
+typedef struct {
+    int in_arena; /* Whether the ClientHello was allocated from the arena */
+    int fail; /* Whether to abort the handshake */
+} ARENA_CB_DATA;
+
+static int arena_client_hello_cb(SSL *s, int *al, void *arg)
+{
+    SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL_ONLY(s);
+    ARENA_CB_DATA *data = arg;
+    unsigned char *p;
+
+    if (sc == NULL || sc->clienthello == NULL)
+        return SSL_CLIENT_HELLO_ERROR;
+    p = (unsigned char *)sc->clienthello;
+    data->in_arena = sc->hs_arena.buf != NULL && sc->hs_arena.live > 0
+        && p >= sc->hs_arena.buf && p < sc->hs_arena.buf + sc->hs_arena.size;
+    return data->fail ? SSL_CLIENT_HELLO_ERROR : SSL_CLIENT_HELLO_SUCCESS;
+}
+
+/* Checks that nothing is left allocated from the arena of |s| */
+static int arena_is_drained(SSL *s, int released)
+{
+    SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL_ONLY(s);
+
+    return TEST_ptr(sc)
+        && TEST_size_t_eq(sc->hs_arena.live, 0)
+        && TEST_size_t_eq(sc->hs_arena.used, 0)
+        && (!released || TEST_ptr_null(sc->hs_arena.buf));
+}
+
+/*
+ * Test handshakes with allocations taken from a handshake arena
+ * Test 0: TLSv1.3, arena big enough for everything
+ * Test 1: TLSv1.3, arena too small, so that the heap is used instead
+ * Test 2: TLSv1.2, arena big enough for everything
+ * Test 3: TLSv1.3, handshake aborted while the ClientHello is in the arena
+ */
+static int test_handshake_arena(int tst)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *serverssl = NULL, *clientssl = NULL;
+    SSL_SESSION *sess = NULL;
+    ARENA_CB_DATA data = { -1, tst == 3 };
+    int testresult = 0, prot, i;
+    long size = tst == 1 ? 64 : 16384;
+
+#ifdef OSSL_NO_USABLE_TLS1_3
+    if (tst != 2)
+        return TEST_skip("No usable TLSv1.3");
+#endif
+#ifdef OPENSSL_NO_TLS1_2
+    if (tst == 2)
+        return TEST_skip("TLSv1.2 is disabled");
+#endif
+    prot = tst != 2 ? TLS1_3_VERSION : TLS1_2_VERSION;
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+            TLS_client_method(), prot, prot,
+            &sctx, &cctx, cert, privkey))
+        || !TEST_long_eq(SSL_CTX_get_handshake_arena_size(sctx), 0)
+        || !TEST_long_eq(SSL_CTX_set_handshake_arena_size(sctx, size), 0)
+        || !TEST_long_eq(SSL_CTX_set_handshake_arena_size(cctx, size), 0)
+        || !TEST_long_eq(SSL_CTX_get_handshake_arena_size(sctx), size))
+        goto end;
+    SSL_CTX_set_client_hello_cb(sctx, arena_client_hello_cb, &data);
+
+    if (tst == 3) {
+        /* The ClientHello must be given back on the error path too */
+        if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+                NULL, NULL))
+            || !TEST_false(create_ssl_connection(serverssl, clientssl,
+                SSL_ERROR_NONE))
+            || !TEST_int_eq(data.in_arena, 1)
+            || !arena_is_drained(serverssl, 0)
+            || !arena_is_drained(clientssl, 0))
+            goto end;
+        testresult = 1;
+        goto end;
+    }
+
+    /* A full handshake followed by a resumed one */
+    for (i = 0; i < 2; i++) {
+        data.in_arena = -1;
+        if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+                NULL, NULL))
+            || (sess != NULL && !TEST_true(SSL_set_session(clientssl, sess)))
+            || !TEST_true(create_ssl_connection(serverssl, clientssl,
+                SSL_ERROR_NONE))
+            || !TEST_int_eq(SSL_session_reused(clientssl), i)
+            || !TEST_int_eq(data.in_arena, tst != 1)
+            || !arena_is_drained(serverssl, 1)
+            || !arena_is_drained(clientssl, 1))
+            goto end;
+        SSL_SESSION_free(sess);
+        if (!TEST_ptr(sess = SSL_get1_session(clientssl)))
+            goto end;
+        SSL_shutdown(clientssl);
+        SSL_shutdown(serverssl);
+        SSL_free(serverssl);
+        SSL_free(clientssl);
+        serverssl = clientssl = NULL;
+    }
+
+    testresult = 1;
+end:
+    SSL_SESSION_free(sess);
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    return testresult;
+}
+
+/*
+ * Test the pools of digest and cipher contexts kept by an SSL_CTX
+ * Test 0: TLSv1.3
+ * Test 1: TLSv1.2
+ */
+static int test_ctx_pool(int tst)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL_SESSION *sess = NULL;
+    int testresult = 0, reused = 0, prot;
+    long hits, misses;
+
+#ifdef OSSL_NO_USABLE_TLS1_3
+    if (tst == 0)
+        return TEST_skip("No usable TLSv1.3");
+#endif
+#ifdef OPENSSL_NO_TLS1_2
+    if (tst == 1)
+        return TEST_skip("TLSv1.2 is disabled");
+#endif
+    prot = tst == 0 ? TLS1_3_VERSION : TLS1_2_VERSION;
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+            TLS_client_method(), prot, prot,
+            &sctx, &cctx, cert, privkey)))
+        goto end;
+
+    /* Nothing is pooled or counted by default */
+    if (!TEST_long_eq(SSL_CTX_get_ctx_pool_size(sctx), 0)
+        || !TEST_true(keyring_connect(sctx, cctx, &sess, &reused))
+        || !TEST_long_eq(SSL_CTX_ctx_pool_hits(sctx), 0)
+        || !TEST_long_eq(SSL_CTX_ctx_pool_misses(sctx), 0))
+        goto end;
+
+    if (!TEST_long_eq(SSL_CTX_set_ctx_pool_size(sctx, 8), 0)
+        || !TEST_long_eq(SSL_CTX_set_ctx_pool_size(cctx, 8), 0)
+        || !TEST_long_eq(SSL_CTX_get_ctx_pool_size(sctx), 8))
+        goto end;
+
+    /* The first connection fills the pools, the second one uses them */
+    SSL_SESSION_free(sess);
+    sess = NULL;
+    if (!TEST_true(keyring_connect(sctx, cctx, &sess, &reused))
+        || !TEST_long_gt(SSL_CTX_ctx_pool_misses(sctx), 0)
+        || !TEST_long_gt(SSL_CTX_ctx_pool_misses(cctx), 0))
+        goto end;
+    SSL_SESSION_free(sess);
+    sess = NULL;
+    if (!TEST_true(keyring_connect(sctx, cctx, &sess, &reused))
+        || !TEST_long_gt(SSL_CTX_ctx_pool_hits(sctx), 0)
+        || !TEST_long_gt(SSL_CTX_ctx_pool_hits(cctx), 0))
+        goto end;
+
+    /* Resumption works with pooled ticket contexts */
+    if (!TEST_true(keyring_connect(sctx, cctx, &sess, &reused))
+        || !TEST_true(reused))
+        goto end;
+
+    /* Shrinking keeps what fits, disabling stops the counting */
+    if (!TEST_long_eq(SSL_CTX_set_ctx_pool_size(sctx, 1), 8)
+        || !TEST_long_eq(SSL_CTX_get_ctx_pool_size(sctx), 1)
+        || !TEST_long_eq(SSL_CTX_set_ctx_pool_size(sctx, 0), 1)
+        || !TEST_long_eq(SSL_CTX_get_ctx_pool_size(sctx), 0))
+        goto end;
+    hits = SSL_CTX_ctx_pool_hits(sctx);
+    misses = SSL_CTX_ctx_pool_misses(sctx);
+    SSL_SESSION_free(sess);
+    sess = NULL;
+    if (!TEST_true(keyring_connect(sctx, cctx, &sess, &reused))
+        || !TEST_long_eq(SSL_CTX_ctx_pool_hits(sctx), hits)
+        || !TEST_long_eq(SSL_CTX_ctx_pool_misses(sctx), misses))
+        goto end;
+
+    testresult = 1;
+end:
+    SSL_SESSION_free(sess);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    return testresult;
+}
+
+/*
+ * Free the SSL_CTX that owns the pools before a connection that switched to
+ * another SSL_CTX from the servername callback: the connection must give its
+ * pooled contexts back while it still holds the last reference.
+ * Test 0: TLSv1.3
+ * Test 1: TLSv1.2
+ */
+static int test_ctx_pool_sni(int tst)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL, *snictx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    int testresult = 0, prot;
+
+#ifdef OSSL_NO_USABLE_TLS1_3
+    if (tst == 0)
+        return TEST_skip("No usable TLSv1.3");
+#endif
+#ifdef OPENSSL_NO_TLS1_2
+    if (tst == 1)
+        return TEST_skip("TLSv1.2 is disabled");
+#endif
+    prot = tst == 0 ? TLS1_3_VERSION : TLS1_2_VERSION;
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+            TLS_client_method(), prot, prot,
+            &sctx, &cctx, cert, privkey))
+        || !TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+            NULL, prot, prot, &snictx, NULL, cert, privkey))
+        || !TEST_long_eq(SSL_CTX_set_ctx_pool_size(sctx, 8), 0)
+        || !TEST_true(SSL_CTX_set_tlsext_servername_callback(sctx, sni_cb))
+        || !TEST_true(SSL_CTX_set_tlsext_servername_arg(sctx, snictx)))
+        goto end;
+
+    snicb = 0;
+    if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+            NULL, NULL))
+        || !TEST_true(SSL_set_tlsext_host_name(clientssl, "localhost"))
+        || !TEST_true(create_ssl_connection(serverssl, clientssl,
+            SSL_ERROR_NONE))
+        || !TEST_int_eq(snicb, 1)
+        || !TEST_ptr_eq(SSL_get_SSL_CTX(serverssl), snictx))
+        goto end;
+
+    /* serverssl now holds the only reference to sctx */
+    SSL_CTX_free(sctx);
+    sctx = NULL;
+    SSL_free(serverssl);
+    serverssl = NULL;
+
+    testresult = 1;
+end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(snictx);
+    SSL_CTX_free(cctx);
+    return testresult;
+}
+
 /*
  * Callback that always returns ABORT for successfully decrypted tickets.
  * Used by test_ticket_abort_session_leak to exercise the error path in
@@ -10798,6 +11587,84 @@ end:
     return testresult;
 }
 
+/*
+ * Test that a sharded session cache spreads the cache size over its shards
+ * and keeps the cached sessions when the mode is switched on and off.
+ */
+static int test_session_cache_sharded(void)
+{
+    SSL_CTX *ctx;
+    SSL_SESSION *sess[48] = { NULL };
+    size_t i;
+    int testresult = 0;
+
+    if (!TEST_ptr(ctx = SSL_CTX_new_ex(libctx, NULL, TLS_method())))
+        goto end;
+
+    /*
+     * Each shard gets a cache size of 3. As with an unsharded cache, a new
+     * session evicts the oldest one once that size would be reached, which
+     * leaves 2 sessions per shard.
+     */
+    SSL_CTX_sess_set_cache_size(ctx, 3 * SSL_SESSION_CACHE_SHARDS);
+    (void)SSL_CTX_set_session_cache_mode(ctx,
+        SSL_SESS_CACHE_SHARDED | SSL_CTX_get_session_cache_mode(ctx));
+    if (!TEST_true(SSL_CTX_get_session_cache_mode(ctx)
+            & SSL_SESS_CACHE_SHARDED))
+        goto end;
+
+    /* 3 sessions per shard */
+    for (i = 0; i < OSSL_NELEM(sess); i++) {
+        if (!TEST_ptr(sess[i] = SSL_SESSION_new()))
+            goto end;
+        sess[i]->session_id_length = SSL3_SSL_SESSION_ID_LENGTH;
+        memset(sess[i]->session_id, (int)i, SSL3_SSL_SESSION_ID_LENGTH);
+        if (!TEST_int_eq(SSL_CTX_add_session(ctx, sess[i]), 1))
+            goto end;
+    }
+    if (!TEST_long_eq(SSL_CTX_sess_number(ctx), 2 * SSL_SESSION_CACHE_SHARDS)
+        || !TEST_long_eq(SSL_CTX_sess_cache_full(ctx),
+            SSL_SESSION_CACHE_SHARDS))
+        goto end;
+    for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++)
+        if (!TEST_ptr_null(sess[i]->owner))
+            goto end;
+    for (; i < OSSL_NELEM(sess); i++)
+        if (!TEST_ptr(sess[i]->owner))
+            goto end;
+
+    /* Sessions survive switching back to a single cache, and back again */
+    (void)SSL_CTX_set_session_cache_mode(ctx,
+        SSL_CTX_get_session_cache_mode(ctx) & ~SSL_SESS_CACHE_SHARDED);
+    if (!TEST_long_eq(SSL_CTX_sess_number(ctx), 2 * SSL_SESSION_CACHE_SHARDS)
+        || !TEST_ptr_eq(sess[OSSL_NELEM(sess) - 1]->owner,
+            &ctx->session_cache))
+        goto end;
+    (void)SSL_CTX_set_session_cache_mode(ctx,
+        SSL_CTX_get_session_cache_mode(ctx) | SSL_SESS_CACHE_SHARDED);
+    if (!TEST_long_eq(SSL_CTX_sess_number(ctx), 2 * SSL_SESSION_CACHE_SHARDS)
+        || !TEST_ptr_ne(sess[OSSL_NELEM(sess) - 1]->owner,
+            &ctx->session_cache))
+        goto end;
+
+    /* Removal goes to the right shard */
+    if (!TEST_int_eq(SSL_CTX_remove_session(ctx, sess[OSSL_NELEM(sess) - 1]), 1)
+        || !TEST_long_eq(SSL_CTX_sess_number(ctx),
+            2 * SSL_SESSION_CACHE_SHARDS - 1))
+        goto end;
+
+    SSL_CTX_flush_sessions_ex(ctx, 0);
+    if (!TEST_long_eq(SSL_CTX_sess_number(ctx), 0))
+        goto end;
+
+    testresult = 1;
+end:
+    SSL_CTX_free(ctx);
+    for (i = 0; i < OSSL_NELEM(sess); i++)
+        SSL_SESSION_free(sess[i]);
+    return testresult;
+}
+
 /*
  * Test that a session cache overflow works as expected
  * Test 0: TLSv1.3, timeout on new session later than old session
@@ -15426,6 +16293,7 @@ int setup_tests(void)
 #ifndef OSSL_NO_USABLE_TLS1_3
     ADD_TEST(test_tlsext_status_type_multi);
 #endif
+    ADD_ALL_TESTS(test_ocsp_stapler, 2);
 #endif
     ADD_TEST(test_session_with_only_int_cache);
     ADD_TEST(test_session_with_only_ext_cache);
@@ -15532,8 +16400,16 @@ int setup_tests(void)
     ADD_ALL_TESTS(test_info_callback, 6);
 #endif
     ADD_ALL_TESTS(test_ssl_pending, 2);
+    ADD_ALL_TESTS(test_ssl_read_borrow, 2);
+#ifndef OSSL_NO_USABLE_TLS1_3
+    ADD_ALL_TESTS(test_tls13_pipelining, OSSL_NELEM(pipelining_ciphersuites));
+#endif
     ADD_ALL_TESTS(test_ssl_get_shared_ciphers, OSSL_NELEM(shared_ciphers_data));
     ADD_ALL_TESTS(test_ticket_callbacks, 20);
+    ADD_ALL_TESTS(test_ticket_keyring, 2);
+    ADD_ALL_TESTS(test_ctx_pool, 2);
+    ADD_ALL_TESTS(test_ctx_pool_sni, 2);
+    ADD_ALL_TESTS(test_handshake_arena, 4);
     ADD_TEST(test_ticket_abort_session_leak);
     ADD_ALL_TESTS(test_shutdown, 7);
     ADD_TEST(test_async_shutdown);
@@ -15581,6 +16457,7 @@ int setup_tests(void)
     ADD_TEST(test_set_verify_cert_store_ssl_ctx);
     ADD_TEST(test_set_verify_cert_store_ssl);
     ADD_ALL_TESTS(test_session_timeout, 1);
+    ADD_TEST(test_session_cache_sharded);
 #if !defined(OSSL_NO_USABLE_TLS1_3) || !defined(OPENSSL_NO_TLS1_2)
     ADD_ALL_TESTS(test_session_cache_overflow, 4);
 #endif
@@ -1406,6 +1406,76 @@ static int test_obj_stress(void)
         &test_obj_create_worker, 0, NULL);
 }
 
+/*
+ * Check that RAND_bytes() works from several new threads, with and without
+ * DRBG shards.  Every thread instantiates its own public DRBG from the shared
+ * DRBGs, and no two of them may produce the same output.
+ */
+#define RAND_SHARDS_THREADS 4
+#define RAND_SHARDS_ITERATIONS 16
+
+static OSSL_LIB_CTX *rand_shards_ctx;
+static CRYPTO_RWLOCK *rand_shards_lock;
+static int rand_shards_next;
+static unsigned char rand_shards_out[RAND_SHARDS_THREADS][32];
+
+static void rand_shards_worker(void)
+{
+    unsigned char buf[32];
+    int i, n;
+
+    if (!CRYPTO_atomic_add(&rand_shards_next, 1, &n, rand_shards_lock)
+        || n > RAND_SHARDS_THREADS) {
+        multi_set_success(0);
+        return;
+    }
+    for (i = 0; i < RAND_SHARDS_ITERATIONS; i++)
+        if (RAND_bytes_ex(rand_shards_ctx, buf, sizeof(buf), 0) <= 0) {
+            multi_set_success(0);
+            return;
+        }
+    memcpy(rand_shards_out[n - 1], buf, sizeof(buf));
+}
+
+static int test_rand_shards(int idx)
+{
+    thread_t threads[RAND_SHARDS_THREADS];
+    unsigned int shards = idx == 0 ? 0 : 2;
+    int i, j, ret = 0;
+
+    rand_shards_next = 0;
+    if (!TEST_ptr(rand_shards_lock = CRYPTO_THREAD_lock_new())
+        || !TEST_ptr(rand_shards_ctx = OSSL_LIB_CTX_new())
+        || !TEST_true(RAND_set_DRBG_shards(rand_shards_ctx, shards)))
+        goto err;
+
+    multi_set_success(1);
+    for (i = 0; i < RAND_SHARDS_THREADS; i++)
+        if (!TEST_true(run_thread(&threads[i], rand_shards_worker)))
+            goto err;
+    for (i = 0; i < RAND_SHARDS_THREADS; i++)
+        if (!TEST_true(wait_for_thread(threads[i])))
+            goto err;
+    if (!TEST_true(multi_success))
+        goto err;
+    for (i = 0; i < RAND_SHARDS_THREADS; i++)
+        for (j = i + 1; j < RAND_SHARDS_THREADS; j++)
+            if (!TEST_mem_ne(rand_shards_out[i], sizeof(rand_shards_out[i]),
+                    rand_shards_out[j], sizeof(rand_shards_out[j])))
+                goto err;
+
+    /* The shards can't be added once the DRBGs exist */
+    if (!TEST_false(RAND_set_DRBG_shards(rand_shards_ctx, 4)))
+        goto err;
+    ret = 1;
+err:
+    OSSL_LIB_CTX_free(rand_shards_ctx);
+    rand_shards_ctx = NULL;
+    CRYPTO_THREAD_lock_free(rand_shards_lock);
+    rand_shards_lock = NULL;
+    return ret;
+}
+
 typedef enum OPTION_choice {
     OPT_ERR = -1,
     OPT_EOF = 0,
@@ -1497,6 +1567,7 @@ int setup_tests(void)
     ADD_TEST(test_pem_read);
     ADD_TEST(test_x509_store);
     ADD_TEST(test_obj_stress);
+    ADD_ALL_TESTS(test_rand_shards, 2);
     return 1;
 }
 
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Measure how RAND_bytes() scales with the number of threads, with and
+ * without DRBG shards. Every thread is new, so each one instantiates its own
+ * public DRBG from the shared DRBGs, as a server that starts a thread per
+ * connection would.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include <openssl/e_os2.h>
+#include <openssl/crypto.h>
+
+#if defined(OPENSSL_THREADS) && defined(OPENSSL_SYS_UNIX)
+#include <pthread.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <openssl/err.h>
+#include <openssl/rand.h>
+
+static char *prog;
+static OSSL_LIB_CTX *libctx;
+static int iterations = 256;
+static int failed;
+
+static void *worker(void *arg)
+{
+    unsigned char buf[32];
+    int i;
+
+    for (i = 0; i < iterations; i++)
+        if (RAND_bytes_ex(libctx, buf, sizeof(buf), 0) <= 0) {
+            failed = 1;
+            break;
+        }
+    OPENSSL_thread_stop();
+    return NULL;
+}
+
+/* Returns the number of RAND_bytes() calls per second, or -1 on error */
+static double run(int nthreads)
+{
+    pthread_t *threads;
+    struct timeval start, end;
+    double secs;
+    int i, n;
+
+    if ((threads = OPENSSL_malloc_array(nthreads, sizeof(*threads))) == NULL)
+        return -1;
+    gettimeofday(&start, NULL);
+    for (n = 0; n < nthreads; n++)
+        if (pthread_create(&threads[n], NULL, worker, NULL) != 0)
+            break;
+    for (i = 0; i < n; i++)
+        pthread_join(threads[i], NULL);
+    gettimeofday(&end, NULL);
+    OPENSSL_free(threads);
+    if (n < nthreads || failed)
+        return -1;
+
+    secs = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1e6;
+    return secs > 0 ? (double)nthreads * iterations / secs : 0;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: %s [flags]\n", prog);
+    fprintf(stderr, "  -c #  RAND_bytes() calls per thread, default 256\n");
+    fprintf(stderr, "  -s #  DRBG shards, default 0 and 8 in turn\n");
+    fprintf(stderr, "  -t #  Maximum number of threads, default 128\n");
+    exit(EXIT_FAILURE);
+}
+
+static int parse_int(const char *s, int min)
+{
+    unsigned long ul;
+
+    if (!OPENSSL_strtoul(s, NULL, 10, &ul) || ul > INT_MAX || ul < (unsigned long)min)
+        usage();
+    return (int)ul;
+}
+
+int main(int ac, char **av)
+{
+    int i, shards = -1, max_threads = 128, nthreads, pass;
+    double rate;
+
+    prog = av[0];
+    while ((i = getopt(ac, av, "c:s:t:")) != EOF) {
+        switch (i) {
+        default:
+            usage();
+            break;
+        case 'c':
+            iterations = parse_int(optarg, 1);
+            break;
+        case 's':
+            shards = parse_int(optarg, 0);
+            break;
+        case 't':
+            max_threads = parse_int(optarg, 1);
+            break;
+        }
+    }
+
+    for (pass = 0; pass < 2; pass++) {
+        unsigned int s = shards >= 0 ? (unsigned int)shards : pass == 0 ? 0 : 8;
+
+        if ((libctx = OSSL_LIB_CTX_new()) == NULL
+            || !RAND_set_DRBG_shards(libctx, s)) {
+            ERR_print_errors_fp(stderr);
+            exit(EXIT_FAILURE);
+        }
+        for (nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+            if ((rate = run(nthreads)) < 0) {
+                ERR_print_errors_fp(stderr);
+                OSSL_LIB_CTX_free(libctx);
+                exit(EXIT_FAILURE);
+            }
+            printf("%u shards, %3d threads: %e RAND_bytes calls/second\n",
+                s, nthreads, rate);
+            if (nthreads > INT_MAX / 2)
+                break;
+        }
+        OSSL_LIB_CTX_free(libctx);
+        if (shards >= 0)
+            break;
+    }
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(int ac, char **av)
+{
+    fprintf(stderr,
+        "This tool is not supported on this platform for lack of POSIX threads\n");
+    return EXIT_FAILURE;
+}
+
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2016-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -225,6 +225,16 @@ void ssl_evp_md_free(const EVP_MD *md)
 {
 }
 
+EVP_MD_CTX *ssl_ctx_pool_get_md(SSL_CTX *ctx, const EVP_MD *md)
+{
+    return EVP_MD_CTX_new();
+}
+
+void ssl_ctx_pool_put_md(SSL_CTX *ctx, EVP_MD_CTX *mctx)
+{
+    EVP_MD_CTX_free(mctx);
+}
+
 int ssl_set_new_record_layer(SSL_CONNECTION *s, int version, int direction,
     int level, unsigned char *secret, size_t secretlen,
     unsigned char *key, size_t keylen,
@@ -15,6 +15,8 @@
 #include <openssl/x509v3.h>
 #include <openssl/pem.h>
 #include <openssl/err.h>
+#include <openssl/ocsp.h>
+#include <openssl/thread.h>
 #include "testutil.h"
 
 static const char *certs_dir;
@@ -766,6 +768,526 @@ static int test_purpose_any(void)
     return do_test_purpose(X509_PURPOSE_ANY, 1);
 }
 
+static int verify_with_root(X509 *ee, X509 *ca, X509 *root)
+{
+    X509_STORE *store = X509_STORE_new();
+    X509_STORE_CTX *ctx = X509_STORE_CTX_new();
+    STACK_OF(X509) *untrusted = sk_X509_new_null();
+    int ret = -1;
+
+    if (TEST_ptr(store)
+        && TEST_ptr(ctx)
+        && TEST_ptr(untrusted)
+        && TEST_true(X509_STORE_add_cert(store, root))
+        && TEST_true(sk_X509_push(untrusted, ca))
+        && TEST_true(X509_STORE_CTX_init(ctx, store, ee, untrusted)))
+        ret = X509_verify_cert(ctx);
+
+    sk_X509_free(untrusted);
+    X509_STORE_CTX_free(ctx);
+    X509_STORE_free(store);
+    return ret;
+}
+
+/*
+ * Signatures that were found to be good are remembered on the certificate,
+ * make sure that this does not survive modifying it.
+ */
+static int test_signature_memo(void)
+{
+    X509 *eecert = load_cert_from_file(ee_cert);
+    X509 *cacert = load_cert_from_file(ca_cert);
+    X509 *root = load_cert_from_file(sroot_cert);
+    ASN1_TIME *later = ASN1_TIME_set(NULL, (time_t)4800000000LL);
+    int testresult = 0;
+
+    if (!TEST_ptr(eecert)
+        || !TEST_ptr(cacert)
+        || !TEST_ptr(root)
+        || !TEST_ptr(later))
+        goto err;
+
+    if (!TEST_int_eq(verify_with_root(eecert, cacert, root), 1)
+        || !TEST_int_eq(verify_with_root(eecert, cacert, root), 1))
+        goto err;
+
+    if (!TEST_true(X509_set1_notAfter(cacert, later))
+        || !TEST_int_eq(verify_with_root(eecert, cacert, root), 0))
+        goto err;
+
+    testresult = 1;
+err:
+    ASN1_TIME_free(later);
+    X509_free(eecert);
+    X509_free(cacert);
+    X509_free(root);
+    return testresult;
+}
+
+static int chain_cache_cb(int ok, X509_STORE_CTX *ctx)
+{
+    return ok;
+}
+
+/*
+ * Verify ee_cert with the chain cache of |store| and check that the cache
+ * counted a hit if |hit| is 1, a miss if it is 0 and neither if it is -1.
+ */
+static int do_chain_cache_verify(X509_STORE *store, X509 *ee,
+    STACK_OF(X509) *untrusted, const char *host,
+    time_t when, int cb, int expected, int hit)
+{
+    X509_STORE_CTX *ctx = X509_STORE_CTX_new();
+    uint64_t hits, misses, hits2, misses2;
+    int testresult = 0;
+
+    if (!TEST_ptr(ctx)
+        || !TEST_true(X509_STORE_get_chain_cache_stats(store, &hits, &misses))
+        || !TEST_true(X509_STORE_CTX_init(ctx, store, ee, untrusted)))
+        goto err;
+    if (host != NULL
+        && !TEST_true(X509_VERIFY_PARAM_set1_host(X509_STORE_CTX_get0_param(ctx),
+            host, 0)))
+        goto err;
+    if (when != 0)
+        X509_STORE_CTX_set_time(ctx, 0, when);
+    if (cb)
+        X509_STORE_CTX_set_verify_cb(ctx, chain_cache_cb);
+
+    if (!TEST_int_eq(X509_verify_cert(ctx), expected)
+        || (expected == 1
+            && !TEST_int_eq(sk_X509_num(X509_STORE_CTX_get0_chain(ctx)), 3))
+        || !TEST_true(X509_STORE_get_chain_cache_stats(store, &hits2,
+            &misses2))
+        || !TEST_uint64_t_eq(hits2, hits + (hit == 1))
+        || !TEST_uint64_t_eq(misses2, misses + (hit == 0)))
+        goto err;
+
+    testresult = 1;
+err:
+    X509_STORE_CTX_free(ctx);
+    return testresult;
+}
+
+static int test_chain_cache(void)
+{
+    X509 *eecert = load_cert_from_file(ee_cert);
+    X509 *untrcert = load_cert_from_file(ca_cert);
+    X509 *trcert = load_cert_from_file(sroot_cert);
+    X509 *other = load_cert_from_file(root_f);
+    STACK_OF(X509) *untrusted = sk_X509_new_null();
+    X509_STORE *store = X509_STORE_new();
+    time_t expired = (time_t)4700000000LL; /* in 2118, after the EE expired */
+    int testresult = 0;
+
+    if (!TEST_ptr(eecert)
+        || !TEST_ptr(untrcert)
+        || !TEST_ptr(trcert)
+        || !TEST_ptr(other)
+        || !TEST_ptr(untrusted)
+        || !TEST_ptr(store)
+        || !TEST_true(X509_STORE_add_cert(store, trcert))
+        || !TEST_true(sk_X509_push(untrusted, untrcert)))
+        goto err;
+    untrcert = NULL;
+
+    if (!TEST_true(X509_STORE_set_chain_cache_size(store, 8))
+        || !TEST_size_t_eq(X509_STORE_get_chain_cache_size(store), 8))
+        goto err;
+
+    /* The second verification of the same chain is served by the cache */
+    if (!do_chain_cache_verify(store, eecert, untrusted, NULL, 0, 0, 1, 0)
+        || !do_chain_cache_verify(store, eecert, untrusted, NULL, 0, 0, 1, 1))
+        goto err;
+
+    /* The host name is checked even on a hit */
+    if (!do_chain_cache_verify(store, eecert, untrusted, "server.example", 0,
+            0, 1, 1)
+        || !do_chain_cache_verify(store, eecert, untrusted, "bad.example", 0,
+            0, 0, 1))
+        goto err;
+
+    /* So is the time */
+    if (!do_chain_cache_verify(store, eecert, untrusted, NULL, 1700000000, 0,
+            1, 0)
+        || !do_chain_cache_verify(store, eecert, untrusted, NULL, expired, 0,
+            0, 0))
+        goto err;
+
+    /* A verify callback bypasses the cache */
+    if (!do_chain_cache_verify(store, eecert, untrusted, NULL, 0, 1, 1, -1))
+        goto err;
+
+    /* Adding to the store empties the cache */
+    if (!TEST_true(X509_STORE_add_cert(store, other))
+        || !do_chain_cache_verify(store, eecert, untrusted, NULL, 0, 0, 1, 0)
+        || !do_chain_cache_verify(store, eecert, untrusted, NULL, 0, 0, 1, 1))
+        goto err;
+
+    /* Disabling the cache stops it from being used */
+    if (!TEST_true(X509_STORE_set_chain_cache_size(store, 0))
+        || !do_chain_cache_verify(store, eecert, untrusted, NULL, 0, 0, 1, -1))
+        goto err;
+
+    testresult = 1;
+err:
+    OSSL_STACK_OF_X509_free(untrusted);
+    X509_STORE_free(store);
+    X509_free(eecert);
+    X509_free(untrcert);
+    X509_free(trcert);
+    X509_free(other);
+    return testresult;
+}
+
+/* A version 1 certificate for |pkey| with the given names, signed by |signer| */
+static X509 *make_v1_cert(const char *subject, const char *issuer,
+    EVP_PKEY *pkey, EVP_PKEY *signer)
+{
+    X509 *x = X509_new();
+    X509_NAME *sname = X509_NAME_new(), *iname = X509_NAME_new();
+    int ok = 0;
+
+    if (TEST_ptr(x)
+        && TEST_ptr(sname)
+        && TEST_ptr(iname)
+        && TEST_true(X509_NAME_add_entry_by_txt(sname, "CN", MBSTRING_ASC,
+            (const unsigned char *)subject, -1, -1, 0))
+        && TEST_true(X509_NAME_add_entry_by_txt(iname, "CN", MBSTRING_ASC,
+            (const unsigned char *)issuer, -1, -1, 0))
+        && TEST_true(X509_set_subject_name(x, sname))
+        && TEST_true(X509_set_issuer_name(x, iname))
+        && TEST_true(ASN1_INTEGER_set(X509_get_serialNumber(x), 1))
+        && TEST_ptr(X509_gmtime_adj(X509_getm_notBefore(x), -3600))
+        && TEST_ptr(X509_gmtime_adj(X509_getm_notAfter(x), 3600))
+        && TEST_true(X509_set_pubkey(x, pkey))
+        && TEST_int_gt(X509_sign(x, signer, EVP_sha256()), 0))
+        ok = 1;
+
+    X509_NAME_free(sname);
+    X509_NAME_free(iname);
+    if (!ok) {
+        X509_free(x);
+        return NULL;
+    }
+    return x;
+}
+
+/*
+ * Two trusted certificates have the name of the issuer of the target, which
+ * carries no key identifiers to tell them apart, but only the second one has
+ * the right key. Without X509_V_FLAG_PARALLEL_CHECKS the first one is picked
+ * and the verification fails, with it the signatures of both are checked and
+ * the second one is picked. The thread pool is set up in a library context of
+ * its own, so that it does not outlive the test.
+ */
+static int test_parallel_checks(void)
+{
+    EVP_PKEY *wrong = EVP_EC_gen("P-256");
+    EVP_PKEY *right = EVP_EC_gen("P-256");
+    EVP_PKEY *eekey = EVP_EC_gen("P-256");
+    X509 *ca1 = NULL, *ca2 = NULL, *ee = NULL;
+    X509_STORE *store = X509_STORE_new();
+    OSSL_LIB_CTX *threadctx = OSSL_LIB_CTX_new();
+    X509_STORE_CTX *ctx = X509_STORE_CTX_new_ex(threadctx, NULL);
+    int threads, testresult = 0;
+
+    if (!TEST_ptr(threadctx)
+        || !TEST_ptr(wrong)
+        || !TEST_ptr(right)
+        || !TEST_ptr(eekey)
+        || !TEST_ptr(store)
+        || !TEST_ptr(ctx)
+        || !TEST_ptr(ca1 = make_v1_cert("CA", "CA", wrong, wrong))
+        || !TEST_ptr(ca2 = make_v1_cert("CA", "CA", right, right))
+        || !TEST_ptr(ee = make_v1_cert("EE", "CA", eekey, right))
+        || !TEST_true(X509_STORE_add_cert(store, ca1))
+        || !TEST_true(X509_STORE_add_cert(store, ca2)))
+        goto err;
+
+    if (!TEST_true(X509_STORE_CTX_init(ctx, store, ee, NULL))
+        || !TEST_int_eq(X509_verify_cert(ctx), 0))
+        goto err;
+
+    /* Once on the calling thread only, once with the thread pool */
+    for (threads = 0; threads <= 2; threads += 2) {
+        if (threads > 0 && !OSSL_set_max_threads(threadctx, threads)) {
+            TEST_info("No thread pool, skipping the threaded run");
+            break;
+        }
+        X509_STORE_CTX_cleanup(ctx);
+        if (!TEST_true(X509_STORE_CTX_init(ctx, store, ee, NULL)))
+            goto err;
+        X509_STORE_CTX_set_flags(ctx, X509_V_FLAG_PARALLEL_CHECKS);
+        if (!TEST_int_eq(X509_verify_cert(ctx), 1)
+            || !TEST_ptr_eq(sk_X509_value(X509_STORE_CTX_get0_chain(ctx), 1),
+                ca2))
+            goto err;
+    }
+
+    testresult = 1;
+err:
+    X509_STORE_CTX_free(ctx);
+    OSSL_LIB_CTX_free(threadctx);
+    X509_STORE_free(store);
+    X509_free(ca1);
+    X509_free(ca2);
+    X509_free(ee);
+    EVP_PKEY_free(wrong);
+    EVP_PKEY_free(right);
+    EVP_PKEY_free(eekey);
+    return testresult;
+}
+
+/* A CRL issued by "CA" and signed with |signer| that revokes |serial| */
+static X509_CRL *make_crl(EVP_PKEY *signer, long serial)
+{
+    X509_CRL *crl = X509_CRL_new();
+    X509_NAME *name = X509_NAME_new();
+    X509_REVOKED *rev = X509_REVOKED_new();
+    ASN1_INTEGER *sn = ASN1_INTEGER_new();
+    ASN1_TIME *last = X509_gmtime_adj(NULL, -3600);
+    ASN1_TIME *next = X509_gmtime_adj(NULL, 3600);
+    int ok = 0;
+
+    if (TEST_ptr(crl)
+        && TEST_ptr(name)
+        && TEST_ptr(rev)
+        && TEST_ptr(sn)
+        && TEST_ptr(last)
+        && TEST_ptr(next)
+        && TEST_true(X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+            (const unsigned char *)"CA", -1, -1, 0))
+        && TEST_true(X509_CRL_set_issuer_name(crl, name))
+        && TEST_true(X509_CRL_set1_lastUpdate(crl, last))
+        && TEST_true(X509_CRL_set1_nextUpdate(crl, next))
+        && TEST_true(ASN1_INTEGER_set(sn, serial))
+        && TEST_true(X509_REVOKED_set_serialNumber(rev, sn))
+        && TEST_true(X509_REVOKED_set_revocationDate(rev, last))
+        && TEST_true(X509_CRL_add0_revoked(crl, rev))) {
+        rev = NULL;
+        ok = TEST_int_gt(X509_CRL_sign(crl, signer, EVP_sha256()), 0);
+    }
+
+    X509_NAME_free(name);
+    X509_REVOKED_free(rev);
+    ASN1_INTEGER_free(sn);
+    ASN1_TIME_free(last);
+    ASN1_TIME_free(next);
+    if (!ok) {
+        X509_CRL_free(crl);
+        return NULL;
+    }
+    return crl;
+}
+
+/*
+ * Verify |ee| with the CRL or OCSP response |crl| or |resp| and check the
+ * result and whether the revocation cache of |store| was hit.
+ */
+static int do_revocation_cache_verify(X509_STORE *store, X509 *ee,
+    X509_CRL *crl, STACK_OF(OCSP_RESPONSE) *resp, int expected, int hit)
+{
+    X509_STORE_CTX *ctx = X509_STORE_CTX_new();
+    STACK_OF(X509_CRL) *crls = sk_X509_CRL_new_null();
+    uint64_t hits, misses, hits2, misses2;
+    int ret = 0;
+
+    if (!TEST_ptr(ctx)
+        || !TEST_ptr(crls)
+        || !TEST_true(X509_STORE_get_revocation_cache_stats(store, &hits,
+            &misses))
+        || !TEST_true(X509_STORE_CTX_init(ctx, store, ee, NULL)))
+        goto err;
+    if (crl != NULL) {
+        if (!TEST_true(sk_X509_CRL_push(crls, crl)))
+            goto err;
+        X509_STORE_CTX_set0_crls(ctx, crls);
+        X509_STORE_CTX_set_flags(ctx, X509_V_FLAG_CRL_CHECK);
+    }
+#ifndef OPENSSL_NO_OCSP
+    if (resp != NULL) {
+        X509_STORE_CTX_set_ocsp_resp(ctx, resp);
+        X509_STORE_CTX_set_flags(ctx, X509_V_FLAG_OCSP_RESP_CHECK);
+    }
+#endif
+    if (!TEST_int_eq(X509_verify_cert(ctx), expected)
+        || !TEST_true(X509_STORE_get_revocation_cache_stats(store, &hits2,
+            &misses2))
+        || !TEST_uint64_t_eq(hits2 - hits, hit ? 1 : 0)
+        || !TEST_uint64_t_eq(misses2 - misses, hit ? 0 : 1))
+        goto err;
+    ret = 1;
+err:
+    X509_STORE_CTX_free(ctx);
+    sk_X509_CRL_free(crls);
+    return ret;
+}
+
+static int test_revocation_cache_crl(void)
+{
+    EVP_PKEY *cakey = EVP_EC_gen("P-256");
+    EVP_PKEY *eekey = EVP_EC_gen("P-256");
+    X509 *ca = NULL, *ee = NULL;
+    X509_CRL *good = NULL, *revoked = NULL, *forged = NULL;
+    X509_STORE *store = X509_STORE_new();
+    /* The revoked entry of |good|: its serial number and revocation date */
+    static const unsigned char entry[] = { 0x02, 0x01, 0x02, 0x17 };
+    unsigned char *der = NULL, *p;
+    const unsigned char *q;
+    int derlen = 0, i, testresult = 0;
+
+    if (!TEST_ptr(cakey)
+        || !TEST_ptr(eekey)
+        || !TEST_ptr(store)
+        || !TEST_ptr(ca = make_v1_cert("CA", "CA", cakey, cakey))
+        || !TEST_ptr(ee = make_v1_cert("EE", "CA", eekey, cakey))
+        || !TEST_ptr(good = make_crl(cakey, 2))
+        || !TEST_ptr(revoked = make_crl(cakey, 1))
+        || !TEST_true(X509_STORE_add_cert(store, ca))
+        || !TEST_true(X509_STORE_set_revocation_cache_size(store, 8))
+        || !TEST_size_t_eq(X509_STORE_get_revocation_cache_size(store), 8))
+        goto err;
+
+    /* |good| revoking serial number 3 instead, with the same signature */
+    if (!TEST_int_gt(derlen = i2d_X509_CRL(good, &der), 0))
+        goto err;
+    for (i = 0, p = NULL; i + (int)sizeof(entry) <= derlen && p == NULL; i++)
+        if (memcmp(der + i, entry, sizeof(entry)) == 0)
+            p = der + i;
+    if (!TEST_ptr(p))
+        goto err;
+    p[2] = 0x03;
+    q = der;
+    if (!TEST_ptr(forged = d2i_X509_CRL(NULL, &q, derlen)))
+        goto err;
+
+    /* The status is cached the first time and found the second */
+    if (!do_revocation_cache_verify(store, ee, good, NULL, 1, 0)
+        || !do_revocation_cache_verify(store, ee, good, NULL, 1, 1))
+        goto err;
+
+    /* A different CRL does not use the cached status */
+    if (!do_revocation_cache_verify(store, ee, revoked, NULL, 0, 0)
+        || !do_revocation_cache_verify(store, ee, good, NULL, 1, 1))
+        goto err;
+
+    /* Nor does a CRL that only has the same signature */
+    if (!do_revocation_cache_verify(store, ee, forged, NULL, 0, 0))
+        goto err;
+
+    /* Nor does anything after the cache was emptied */
+    X509_STORE_flush_revocation_cache(store);
+    if (!do_revocation_cache_verify(store, ee, good, NULL, 1, 0))
+        goto err;
+
+    testresult = 1;
+err:
+    X509_STORE_free(store);
+    X509_free(ca);
+    X509_free(ee);
+    X509_CRL_free(good);
+    X509_CRL_free(revoked);
+    X509_CRL_free(forged);
+    OPENSSL_free(der);
+    EVP_PKEY_free(cakey);
+    EVP_PKEY_free(eekey);
+    return testresult;
+}
+
+#ifndef OPENSSL_NO_OCSP
+/* An OCSP response with |status| for |ee| signed by its issuer |ca| */
+static STACK_OF(OCSP_RESPONSE) *make_ocsp_resp(X509 *ee, X509 *ca,
+    EVP_PKEY *cakey, int status)
+{
+    STACK_OF(OCSP_RESPONSE) *sk = sk_OCSP_RESPONSE_new_null();
+    OCSP_BASICRESP *bs = OCSP_BASICRESP_new();
+    OCSP_RESPONSE *resp = NULL;
+    OCSP_CERTID *id = OCSP_cert_to_id(NULL, ee, ca);
+    ASN1_TIME *thisupd = X509_gmtime_adj(NULL, -60);
+    ASN1_TIME *nextupd = X509_gmtime_adj(NULL, 3600);
+    int ok = 0;
+
+    if (TEST_ptr(sk)
+        && TEST_ptr(bs)
+        && TEST_ptr(id)
+        && TEST_ptr(thisupd)
+        && TEST_ptr(nextupd)
+        && TEST_ptr(OCSP_basic_add1_status(bs, id, status,
+            OCSP_REVOKED_STATUS_KEYCOMPROMISE, thisupd, thisupd, nextupd))
+        && TEST_true(OCSP_basic_sign(bs, ca, cakey, EVP_sha256(), NULL, 0))
+        && TEST_ptr(resp = OCSP_response_create(OCSP_RESPONSE_STATUS_SUCCESSFUL,
+            bs))
+        && TEST_true(sk_OCSP_RESPONSE_push(sk, resp))) {
+        resp = NULL;
+        ok = 1;
+    }
+
+    OCSP_RESPONSE_free(resp);
+    OCSP_BASICRESP_free(bs);
+    OCSP_CERTID_free(id);
+    ASN1_TIME_free(thisupd);
+    ASN1_TIME_free(nextupd);
+    if (!ok) {
+        sk_OCSP_RESPONSE_pop_free(sk, OCSP_RESPONSE_free);
+        return NULL;
+    }
+    return sk;
+}
+
+static int test_revocation_cache_ocsp(void)
+{
+    EVP_PKEY *cakey = EVP_EC_gen("P-256");
+    EVP_PKEY *eekey = EVP_EC_gen("P-256");
+    X509 *ca = NULL, *ee = NULL, *other = NULL;
+    STACK_OF(OCSP_RESPONSE) *good = NULL, *revoked = NULL;
+    X509_STORE *store = X509_STORE_new();
+    int testresult = 0;
+
+    if (!TEST_ptr(cakey)
+        || !TEST_ptr(eekey)
+        || !TEST_ptr(store)
+        || !TEST_ptr(ca = make_v1_cert("CA", "CA", cakey, cakey))
+        || !TEST_ptr(ee = make_v1_cert("EE", "CA", eekey, cakey))
+        || !TEST_ptr(other = make_v1_cert("Other", "Other", eekey, eekey))
+        || !TEST_ptr(good = make_ocsp_resp(ee, ca, cakey,
+            V_OCSP_CERTSTATUS_GOOD))
+        || !TEST_ptr(revoked = make_ocsp_resp(ee, ca, cakey,
+            V_OCSP_CERTSTATUS_REVOKED))
+        || !TEST_true(X509_STORE_add_cert(store, ca))
+        || !TEST_true(X509_STORE_set_revocation_cache_size(store, 8)))
+        goto err;
+
+    /* Both good and revoked statuses are cached */
+    if (!do_revocation_cache_verify(store, ee, NULL, good, 1, 0)
+        || !do_revocation_cache_verify(store, ee, NULL, good, 1, 1)
+        || !do_revocation_cache_verify(store, ee, NULL, revoked, 0, 0)
+        || !do_revocation_cache_verify(store, ee, NULL, revoked, 0, 1))
+        goto err;
+
+    /* Adding a certificate to the store empties the cache */
+    if (!TEST_true(X509_STORE_add_cert(store, other))
+        || !do_revocation_cache_verify(store, ee, NULL, good, 1, 0))
+        goto err;
+
+    if (!TEST_true(X509_STORE_set_revocation_cache_size(store, 0))
+        || !TEST_size_t_eq(X509_STORE_get_revocation_cache_size(store), 0))
+        goto err;
+
+    testresult = 1;
+err:
+    X509_STORE_free(store);
+    X509_free(ca);
+    X509_free(ee);
+    X509_free(other);
+    sk_OCSP_RESPONSE_pop_free(good, OCSP_RESPONSE_free);
+    sk_OCSP_RESPONSE_pop_free(revoked, OCSP_RESPONSE_free);
+    EVP_PKEY_free(cakey);
+    EVP_PKEY_free(eekey);
+    return testresult;
+}
+#endif
+
 OPT_TEST_DECLARE_USAGE("certs-dir\n")
 
 int setup_tests(void)
@@ -800,6 +1322,13 @@ int setup_tests(void)
     ADD_TEST(test_purpose_any);
     ADD_TEST(test_multiname_selfsigned);
     ADD_TEST(test_vpm_input_validation);
+    ADD_TEST(test_chain_cache);
+    ADD_TEST(test_signature_memo);
+    ADD_TEST(test_parallel_checks);
+    ADD_TEST(test_revocation_cache_crl);
+#ifndef OPENSSL_NO_OCSP
+    ADD_TEST(test_revocation_cache_ocsp);
+#endif
     return 1;
 err:
     cleanup_tests();
@@ -9,12 +9,14 @@
 
 #include <stdio.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
 #include <openssl/x509_vfy.h>
 
 #include "testutil.h"
 
 static const char *chain;
 static const char *crl;
+static const char *idxfile;
 
 static const char *cn_cert1[] = {
     "-----BEGIN CERTIFICATE-----\n",
@@ -113,6 +115,101 @@ err:
     return ret;
 }
 
+/*
+ * Write the certificates of |chain| to an index, with one of them twice, and
+ * look them up in it by subject and by fingerprint.
+ */
+static int test_cert_index(void)
+{
+    int ret = 0, i;
+    X509_STORE *store = NULL, *istore = NULL;
+    X509_STORE_CTX *s_ctx = NULL;
+    X509_LOOKUP *lookup = NULL;
+    X509_OBJECT *obj = NULL;
+    STACK_OF(X509) *certs = NULL;
+    STACK_OF(X509_OBJECT) *objs = NULL;
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned int mdlen;
+    BIO *out = NULL;
+
+    if (!TEST_ptr(store = X509_STORE_new())
+        || !TEST_ptr(lookup = X509_STORE_add_lookup(store, X509_LOOKUP_file()))
+        || !TEST_true(X509_load_cert_file(lookup, chain, X509_FILETYPE_PEM))
+        || !TEST_ptr(certs = X509_STORE_get1_all_certs(store))
+        || !TEST_true(X509_add_cert(certs, sk_X509_value(certs, 0),
+            X509_ADD_FLAG_UP_REF))
+        || !TEST_ptr(out = BIO_new_file(idxfile, "wb"))
+        || !TEST_true(X509_cert_index_write(out, certs, NULL, NULL)))
+        goto err;
+    BIO_free(out);
+    out = NULL;
+
+    if (!TEST_ptr(istore = X509_STORE_new())
+        || !TEST_ptr(lookup = X509_STORE_add_lookup(istore,
+                         X509_LOOKUP_cert_index()))
+        || !TEST_false(X509_LOOKUP_load_cert_index(lookup, chain))
+        || !TEST_true(X509_LOOKUP_load_cert_index(lookup, idxfile))
+        || !TEST_ptr(s_ctx = X509_STORE_CTX_new())
+        || !TEST_true(X509_STORE_CTX_init(s_ctx, istore, NULL, NULL)))
+        goto err;
+    ERR_clear_error();
+
+    /* Nothing is decoded before it is looked up */
+    if (!TEST_ptr(objs = X509_STORE_get1_objects(istore))
+        || !TEST_int_eq(sk_X509_OBJECT_num(objs), 0))
+        goto err;
+    sk_X509_OBJECT_pop_free(objs, X509_OBJECT_free);
+    objs = NULL;
+
+    for (i = 0; i < sk_X509_num(certs) - 1; i++) {
+        X509 *x = sk_X509_value(certs, i);
+
+        if (!TEST_ptr(obj = X509_STORE_CTX_get_obj_by_subject(s_ctx,
+                          X509_LU_X509, X509_get_subject_name(x)))
+            || !TEST_int_eq(X509_cmp(X509_OBJECT_get0_X509(obj), x), 0))
+            goto err;
+        X509_OBJECT_free(obj);
+        obj = NULL;
+    }
+    if (!TEST_ptr(objs = X509_STORE_get1_objects(istore))
+        || !TEST_int_eq(sk_X509_OBJECT_num(objs), 4))
+        goto err;
+
+    /* A fresh store that only finds the certificate by fingerprint */
+    X509_STORE_CTX_free(s_ctx);
+    s_ctx = NULL;
+    X509_STORE_free(istore);
+    if (!TEST_ptr(istore = X509_STORE_new())
+        || !TEST_ptr(lookup = X509_STORE_add_lookup(istore,
+                         X509_LOOKUP_cert_index()))
+        || !TEST_true(X509_LOOKUP_load_cert_index(lookup, idxfile))
+        || !TEST_true(X509_digest(sk_X509_value(certs, 1), EVP_sha256(),
+            md, &mdlen))
+        || !TEST_ptr(obj = X509_OBJECT_new())
+        || !TEST_false(X509_LOOKUP_by_fingerprint(lookup, X509_LU_X509,
+            md, (int)mdlen - 1, obj))
+        || !TEST_true(X509_LOOKUP_by_fingerprint(lookup, X509_LU_X509,
+            md, (int)mdlen, obj))
+        || !TEST_true(X509_OBJECT_up_ref_count(obj))
+        || !TEST_int_eq(X509_cmp(X509_OBJECT_get0_X509(obj),
+                            sk_X509_value(certs, 1)),
+            0))
+        goto err;
+
+    ret = 1;
+
+err:
+    BIO_free(out);
+    X509_OBJECT_free(obj);
+    sk_X509_OBJECT_pop_free(objs, X509_OBJECT_free);
+    OSSL_STACK_OF_X509_free(certs);
+    X509_STORE_CTX_free(s_ctx);
+    X509_STORE_free(istore);
+    X509_STORE_free(store);
+    remove(idxfile);
+    return ret;
+}
+
 /*
  * Test loading multiple certificates and a CRL with identical CN into
  * X509_STORE.
@@ -243,7 +340,7 @@ static int test_x509_pem_read_mfail(void)
     return 1;
 }
 
-OPT_TEST_DECLARE_USAGE("cert.pem [crl.pem]\n")
+OPT_TEST_DECLARE_USAGE("cert.pem [crl.pem [index]]\n")
 
 int setup_tests(void)
 {
@@ -257,8 +354,11 @@ int setup_tests(void)
         return 0;
 
     crl = test_get_argument(1);
+    idxfile = test_get_argument(2);
 
     ADD_TEST(test_load_cert_file);
+    if (idxfile != NULL)
+        ADD_TEST(test_cert_index);
     ADD_TEST(test_load_same_cn_certs);
     ADD_MFAIL_NO_CHECK_TEST(test_x509_pem_read_mfail);
     ADD_MFAIL_TEST(test_x509_store_add_mfail);
@@ -473,6 +473,7 @@ my %params = (
     'OSSL_PKEY_PARAM_ML_DSA_PREFER_SEED' =>      "ml-dsa.prefer_seed",
     'OSSL_PKEY_PARAM_ML_DSA_INPUT_FORMATS' =>    "ml-dsa.input_formats",
     'OSSL_PKEY_PARAM_ML_DSA_OUTPUT_FORMATS' =>   "ml-dsa.output_formats",
+    'OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE' =>       "ml-dsa.precompute",
 
 # SLH_DSA Key generation parameters
     'OSSL_PKEY_PARAM_SLH_DSA_SEED' =>              "seed",
@@ -518,6 +519,7 @@ my %params = (
     'OSSL_SIGNATURE_PARAM_TEST_ENTROPY' =>       "test-entropy",
     'OSSL_SIGNATURE_PARAM_ADD_RANDOM' =>         "additional-random",
     'OSSL_SIGNATURE_PARAM_TLS_VERSION' =>        "tls-version",
+    'OSSL_SIGNATURE_PARAM_THREADS' =>            '*OSSL_KDF_PARAM_THREADS',
 
 # Asym cipher parameters
     'OSSL_ASYM_CIPHER_PARAM_DIGEST' =>                   '*OSSL_PKEY_PARAM_DIGEST',